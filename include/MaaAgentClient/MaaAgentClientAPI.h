@@ -11,6 +11,14 @@ extern "C"
 
     MAA_AGENT_CLIENT_API MaaAgentClient* MaaAgentClientCreateTcp(uint16_t port);
 
+    /**
+     * @brief Same as MaaAgentClientCreateTcp, with the socket tuned by transport_options.
+     *
+     * @param transport_options json, e.g. {"send_hwm": 1000, "tcp_keepalive": 1, "heartbeat_interval": 1000, "heartbeat_timeout": 3000}.
+     * Missing fields keep the defaults. See MaaAgentServerSetTransportOptions for the server side.
+     */
+    MAA_AGENT_CLIENT_API MaaAgentClient* MaaAgentClientCreateTcpV2(uint16_t port, const char* transport_options);
+
     MAA_AGENT_CLIENT_API void MaaAgentClientDestroy(MaaAgentClient* client);
 
     MAA_AGENT_CLIENT_API MaaBool MaaAgentClientIdentifier(MaaAgentClient* client, MaaStringBuffer* identifier);
@@ -27,6 +35,13 @@ extern "C"
     MAA_AGENT_CLIENT_API MaaBool MaaAgentClientAlive(MaaAgentClient* client);
     MAA_AGENT_CLIENT_API MaaBool MaaAgentClientSetTimeout(MaaAgentClient* client, int64_t milliseconds);
 
+    /**
+     * @brief Measure the round trip of the channel by sending count pings one after another.
+     *
+     * @param stats [out] json, {"count", "failed", "min_us", "p50_us", "p90_us", "p99_us", "max_us", "mean_us"}, in microseconds.
+     */
+    MAA_AGENT_CLIENT_API MaaBool MaaAgentClientProbeLatency(MaaAgentClient* client, MaaSize count, /* out */ MaaStringBuffer* stats);
+
     MAA_AGENT_CLIENT_API MaaBool MaaAgentClientGetCustomRecognitionList(MaaAgentClient* client, /* out */ MaaStringListBuffer* buffer);
     MAA_AGENT_CLIENT_API MaaBool MaaAgentClientGetCustomActionList(MaaAgentClient* client, /* out */ MaaStringListBuffer* buffer);
 
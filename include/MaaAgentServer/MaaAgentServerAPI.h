@@ -10,6 +10,14 @@ extern "C"
     MAA_AGENT_SERVER_API
     MaaBool MaaAgentServerRegisterCustomRecognition(const char* name, MaaCustomRecognitionCallback recognition, void* trans_arg);
 
+    /**
+     * @brief Register the batch form of a custom recognition. See MaaResourceRegisterCustomRecognitionBatch.
+     *
+     * The single form with the same name must be registered first; registering it again drops the batch form.
+     */
+    MAA_AGENT_SERVER_API MaaBool
+        MaaAgentServerRegisterCustomRecognitionBatch(const char* name, MaaCustomRecognitionBatchCallback recognition, void* trans_arg);
+
     MAA_AGENT_SERVER_API MaaBool MaaAgentServerRegisterCustomAction(const char* name, MaaCustomActionCallback action, void* trans_arg);
 
     MAA_AGENT_SERVER_API MaaSinkId MaaAgentServerAddResourceSink(MaaEventCallback sink, void* trans_arg);
@@ -17,6 +25,29 @@ extern "C"
     MAA_AGENT_SERVER_API MaaSinkId MaaAgentServerAddTaskerSink(MaaEventCallback sink, void* trans_arg);
     MAA_AGENT_SERVER_API MaaSinkId MaaAgentServerAddContextSink(MaaEventCallback sink, void* trans_arg);
 
+    /**
+     * @brief Only forward the given messages from the client, takes effect on the next connection so call it before StartUp.
+     *
+     * @param msg_filter full message names or dot-separated prefixes, e.g. "Node.Recognition". null or empty to receive all.
+     */
+    MAA_AGENT_SERVER_API MaaBool MaaAgentServerSetEventSubscription(const MaaStringListBuffer* msg_filter);
+
+    /**
+     * @brief Set how many custom recognitions/actions may run at the same time, call it before StartUp. Default is 1.
+     *
+     * Requests from the same context always run one after another in order. Callbacks may be called from different threads when
+     * concurrency is greater than 1.
+     */
+    MAA_AGENT_SERVER_API MaaBool MaaAgentServerSetConcurrency(MaaSize concurrency);
+
+    /**
+     * @brief Tune the underlying socket, call it before StartUp.
+     *
+     * @param options_json e.g. {"send_hwm": 1000, "tcp_keepalive": 1, "reconnect_interval": 100, "reconnect_interval_max": 5000,
+     * "heartbeat_interval": 1000, "heartbeat_timeout": 3000}. Missing fields keep the defaults. null or empty to reset all.
+     */
+    MAA_AGENT_SERVER_API MaaBool MaaAgentServerSetTransportOptions(const char* options_json);
+
     MAA_AGENT_SERVER_API MaaBool MaaAgentServerStartUp(const char* identifier);
     MAA_AGENT_SERVER_API void MaaAgentServerShutDown();
     MAA_AGENT_SERVER_API void MaaAgentServerJoin();
@@ -3,6 +3,7 @@
 #include <chrono>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <meojson/json.hpp>
 
@@ -27,6 +28,7 @@ public:
     virtual bool start_app(const std::string& intent) = 0;
     virtual bool stop_app(const std::string& intent) = 0;
 
+    // The returned image is adopted by the framework without copying, so the unit must not modify its buffer afterwards.
     virtual bool screencap(/*out*/ cv::Mat& image) = 0;
 
     virtual bool click(int x, int y) = 0;
@@ -65,6 +67,37 @@ public:
     virtual bool relative_move(int dx, int dy) = 0;
 };
 
+struct TouchEvent
+{
+    enum class Type
+    {
+        Down,
+        Move,
+        Up,
+    };
+
+    Type type = Type::Move;
+    int contact = 0;
+    int x = 0;
+    int y = 0;
+    int pressure = 0;
+    std::chrono::milliseconds time { 0 }; // offset from the start of the trajectory
+};
+
+// Events are sorted by time.
+using TouchTrajectory = std::vector<TouchEvent>;
+
+class TrajectoryUnit
+{
+public:
+    virtual ~TrajectoryUnit() = default;
+
+    // Whether the current input method can replay a whole trajectory with device-side timing.
+    virtual bool touch_trajectory_available() const = 0;
+    // Blocks until the trajectory has been played.
+    virtual bool touch_trajectory(const TouchTrajectory& trajectory) = 0;
+};
+
 class ShellableUnit
 {
 public:
@@ -79,6 +112,7 @@ public:
 class AdbControlUnitAPI
     : public ControlUnitAPI
     , public ShellableUnit
+    , public TrajectoryUnit
 {
 public:
     virtual ~AdbControlUnitAPI() = default;
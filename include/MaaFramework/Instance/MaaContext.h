@@ -56,6 +56,16 @@ extern "C"
         const MaaRect* box,
         const char* reco_detail);
 
+    /**
+     * @brief Run recognition directly on a frame registered by MaaTaskerRegisterFrame.
+     *
+     * @param frame_id Frame id
+     * @param reco_type Recognition type string (e.g., "OCR", "TemplateMatch")
+     * @param reco_param Recognition parameters json
+     */
+    MAA_FRAMEWORK_API MaaRecoId
+        MaaContextRunRecognitionOnFrame(MaaContext* context, MaaFrameId frame_id, const char* reco_type, const char* reco_param);
+
     MAA_FRAMEWORK_API MaaBool MaaContextWaitFreezes(MaaContext* context, MaaSize time, const MaaRect* box, const char* wait_freezes_param);
 
     MAA_FRAMEWORK_API MaaBool MaaContextOverridePipeline(MaaContext* context, const char* pipeline_override);
@@ -23,6 +23,8 @@ extern "C"
 
     MAA_FRAMEWORK_API void MaaResourceDestroy(MaaResource* res);
 
+    MAA_FRAMEWORK_API MaaBool MaaResourceCompileBundle(const char* bundle_path, const char* output_path);
+
     MAA_FRAMEWORK_API MaaSinkId MaaResourceAddSink(MaaResource* res, MaaEventCallback sink, void* trans_arg);
 
     MAA_FRAMEWORK_API void MaaResourceRemoveSink(MaaResource* res, MaaSinkId sink_id);
@@ -32,6 +34,19 @@ extern "C"
     MAA_FRAMEWORK_API MaaBool
         MaaResourceRegisterCustomRecognition(MaaResource* res, const char* name, MaaCustomRecognitionCallback recognition, void* trans_arg);
 
+    /**
+     * @brief Register the batch form of a custom recognition, see MaaCustomRecognitionBatchCallback.
+     *
+     * Optional. Nodes in a next list that use the same recognizer are then recognized with one call per frame.
+     * The single form should still be registered under the same name as the fallback, and before this call:
+     * registering the single form again drops the batch form.
+     */
+    MAA_FRAMEWORK_API MaaBool MaaResourceRegisterCustomRecognitionBatch(
+        MaaResource* res,
+        const char* name,
+        MaaCustomRecognitionBatchCallback recognition,
+        void* trans_arg);
+
     MAA_FRAMEWORK_API MaaBool MaaResourceUnregisterCustomRecognition(MaaResource* res, const char* name);
 
     MAA_FRAMEWORK_API MaaBool MaaResourceClearCustomRecognition(MaaResource* res);
@@ -77,6 +92,13 @@ extern "C"
 
     MAA_FRAMEWORK_API MaaBool MaaResourceGetCustomActionList(const MaaResource* res, /* out */ MaaStringListBuffer* buffer);
 
+    /**
+     * @brief Get statistics of the template image cache as a JSON object string.
+     *
+     * Fields: budget, bytes, entries, pinned, hits, misses, evictions.
+     */
+    MAA_FRAMEWORK_API MaaBool MaaResourceGetTemplateCacheStats(const MaaResource* res, /* out */ MaaStringBuffer* buffer);
+
     /**
      * @brief Get default recognition parameters for the specified type from DefaultPipelineMgr.
      *
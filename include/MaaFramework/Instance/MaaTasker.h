@@ -35,6 +35,17 @@ extern "C"
 
     MAA_FRAMEWORK_API void MaaTaskerClearContextSinks(MaaTasker* tasker);
 
+    /**
+     * @brief Only deliver the given messages to the sink, details of messages nobody subscribes are not built.
+     *
+     * @param msg_filter full message names or dot-separated prefixes, e.g. "Node.Recognition". null or empty to receive all.
+     */
+    MAA_FRAMEWORK_API MaaBool
+        MaaTaskerSetSinkSubscription(MaaTasker* tasker, MaaSinkId sink_id, const MaaStringListBuffer* msg_filter);
+
+    MAA_FRAMEWORK_API MaaBool
+        MaaTaskerSetContextSinkSubscription(MaaTasker* tasker, MaaSinkId sink_id, const MaaStringListBuffer* msg_filter);
+
     /**
      * @param[in] value
      */
@@ -73,6 +84,30 @@ extern "C"
         const MaaRect* box,
         const char* reco_detail);
 
+    /**
+     * @brief Register a frame for repeated recognitions.
+     *
+     * The image is copied once. Recognitions posted on the returned frame share derived data such as OCR results,
+     * until the frame is unregistered.
+     *
+     * @param image Frame to register
+     * @return Frame id, or MaaInvalidId on failure
+     */
+    MAA_FRAMEWORK_API MaaFrameId MaaTaskerRegisterFrame(MaaTasker* tasker, const MaaImageBuffer* image);
+
+    /**
+     * @brief Unregister a frame. Recognitions already posted on it still complete.
+     */
+    MAA_FRAMEWORK_API MaaBool MaaTaskerUnregisterFrame(MaaTasker* tasker, MaaFrameId frame_id);
+
+    /**
+     * @param frame_id Frame returned by MaaTaskerRegisterFrame
+     * @param reco_type Recognition type string
+     * @param reco_param Recognition parameters json
+     */
+    MAA_FRAMEWORK_API MaaTaskId
+        MaaTaskerPostRecognitionOnFrame(MaaTasker* tasker, MaaFrameId frame_id, const char* reco_type, const char* reco_param);
+
     MAA_FRAMEWORK_API MaaStatus MaaTaskerStatus(const MaaTasker* tasker, MaaTaskId id);
 
     MAA_FRAMEWORK_API MaaStatus MaaTaskerWait(const MaaTasker* tasker, MaaTaskId id);
@@ -174,6 +209,15 @@ extern "C"
         const char* node_name,
         /* out */ MaaNodeId* latest_id);
 
+    /**
+     * @brief Get latency histograms of screencap, resize, recognition, node, action and wait_freezes.
+     *
+     * @param[out] buffer json object, grouped by category then name, see docs for details
+     */
+    MAA_FRAMEWORK_API MaaBool MaaTaskerGetLatencyStats(const MaaTasker* tasker, /* out */ MaaStringBuffer* buffer);
+
+    MAA_FRAMEWORK_API MaaBool MaaTaskerClearLatencyStats(MaaTasker* tasker);
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,6 +28,7 @@ typedef MaaId MaaActId;
 typedef MaaId MaaNodeId;
 typedef MaaId MaaWfId;
 typedef MaaId MaaSinkId;
+typedef MaaId MaaFrameId;
 #define MaaInvalidId ((MaaId)0)
 
 typedef struct MaaStringBuffer MaaStringBuffer;
@@ -183,6 +184,35 @@ enum MaaResOptionEnum
     /// value: MaaInferenceExecutionProvider, eg: 0; val_size: sizeof(MaaInferenceExecutionProvider)
     /// default value is MaaInferenceExecutionProvider_Auto
     MaaResOption_InferenceExecutionProvider = 2,
+
+    /// Decode all templates referenced by the loaded pipeline on a worker pool at load time,
+    /// instead of on their first use during a task.
+    ///
+    /// value: bool, eg: true; val_size: sizeof(bool)
+    /// default value is false
+    MaaResOption_TemplateWarmUp = 3,
+
+    /// Memory budget of the decoded template cache, in bytes.
+    /// When exceeded, the least recently used templates that are not pinned are evicted and
+    /// read from disk again on their next use.
+    ///
+    /// value: int64_t, eg: 268435456; val_size: sizeof(int64_t)
+    /// default value is 0, which means unlimited
+    MaaResOption_TemplateCacheBudget = 4,
+
+    /// Nodes whose templates are pinned in the template cache and never evicted.
+    /// Applies to nodes loaded later as well. Each set replaces the previous list.
+    ///
+    /// value: string, JSON array of node names, eg: "[\"StartUp\", \"Battle\"]"; val_size: string length
+    /// default value is []
+    MaaResOption_TemplatePinnedNodes = 5,
+
+    /// Check a compiled bundle against every file in its source directory before using it.
+    /// By default only the default pipeline, the pipeline files and their directories are checked.
+    ///
+    /// value: bool, eg: true; val_size: sizeof(bool)
+    /// default value is false
+    MaaResOption_CompiledBundleVerifySources = 6,
 };
 
 typedef MaaOption MaaCtrlOption;
@@ -634,6 +664,12 @@ typedef uint64_t MaaControllerFeature;
 /// When set, ControllerAgent will skip coordinate scaling for touch operations.
 #define MaaControllerFeature_NoScalingTouchPoints (1ULL << 2)
 
+/// Controller allows screencap to run concurrently with input operations.
+/// When set, ControllerAgent runs screencap and input on separate lanes: an input may start while an earlier
+/// screencap is still running, but a screencap still waits for the inputs posted before it, and app/shell
+/// operations run alone in post order. Otherwise all operations run one at a time in post order.
+#define MaaControllerFeature_ConcurrentScreencapAndInput (1ULL << 3)
+
 typedef struct MaaRect
 {
     int32_t x;
@@ -668,6 +704,19 @@ typedef MaaBool(MAA_CALL* MaaCustomRecognitionCallback)(
     /* out */ MaaRect* out_box,
     /* out */ MaaStringBuffer* out_detail);
 
+/// Batch form of a custom recognition, called once with every node in a next list that uses the same recognizer.
+/// entries_json: [{"node_name": string, "roi": [x, y, w, h], "param": any}, ...]
+/// out_results: json array of the same length, [{"hit": bool, "box": [x, y, w, h], "detail": any}, ...]
+/// Return false to fall back to calling MaaCustomRecognitionCallback node by node.
+typedef MaaBool(MAA_CALL* MaaCustomRecognitionBatchCallback)(
+    MaaContext* context,
+    MaaTaskId task_id,
+    const char* custom_recognition_name,
+    const char* entries_json,
+    const MaaImageBuffer* image,
+    void* trans_arg,
+    /* out */ MaaStringBuffer* out_results);
+
 typedef MaaBool(MAA_CALL* MaaCustomActionCallback)(
     MaaContext* context,
     MaaTaskId task_id,
@@ -23,6 +23,7 @@ extern "C"
 
     MAA_TOOLKIT_API MaaBool MaaToolkitAdbDeviceFind(/* out */ MaaToolkitAdbDeviceList* buffer);
     MAA_TOOLKIT_API MaaBool MaaToolkitAdbDeviceFindSpecified(const char* adb_path, /* out */ MaaToolkitAdbDeviceList* buffer);
+    MAA_TOOLKIT_API MaaBool MaaToolkitAdbDeviceWatch(/* out */ MaaToolkitAdbDeviceList* added, /* out */ MaaToolkitAdbDeviceList* removed);
 
     MAA_TOOLKIT_API MaaSize MaaToolkitAdbDeviceListSize(const MaaToolkitAdbDeviceList* list);
     MAA_TOOLKIT_API const MaaToolkitAdbDevice* MaaToolkitAdbDeviceListAt(const MaaToolkitAdbDeviceList* list, MaaSize index);
@@ -0,0 +1,420 @@
+#include "MaaAgent/MessageCodec.h"
+
+#include <charconv>
+#include <cstring>
+
+#include "MaaAgent/Message.hpp"
+#include "MaaUtils/Logger.h"
+
+MAA_AGENT_NS_BEGIN
+
+namespace
+{
+
+constexpr size_t kMaxDepth = 256;
+
+bool is_envelope_key(std::string_view key)
+{
+    return key == kMsgIdKey || key == kMsgParentKey || key == kMsgReplyToKey;
+}
+
+class Encoder
+{
+public:
+    explicit Encoder(std::string& out)
+        : out_(out)
+    {
+    }
+
+    void value(const json::value& j)
+    {
+        if (j.is_null()) {
+            byte(0xc0);
+        }
+        else if (j.is_boolean()) {
+            byte(j.as_boolean() ? 0xc3 : 0xc2);
+        }
+        else if (j.is_number()) {
+            number(j);
+        }
+        else if (j.is_string()) {
+            string(j.as_string());
+        }
+        else if (j.is_array()) {
+            const auto& arr = j.as_array();
+            header(arr.size(), 0x90, 0xdc, 0xdd, 16);
+            for (const auto& item : arr) {
+                value(item);
+            }
+        }
+        else if (j.is_object()) {
+            object(j.as_object(), { });
+        }
+        else {
+            byte(0xc0);
+        }
+    }
+
+    void object(const json::object& obj, std::string_view skip_key)
+    {
+        header(obj.size() - (skip_key.empty() ? 0 : 1), 0x80, 0xde, 0xdf, 16);
+        for (const auto& [key, item] : obj) {
+            if (key == skip_key) {
+                continue;
+            }
+            string(key);
+            value(item);
+        }
+    }
+
+private:
+    void number(const json::value& j)
+    {
+        const std::string raw = j.to_string();
+        const char* first = raw.data();
+        const char* last = raw.data() + raw.size();
+
+        int64_t i = 0;
+        if (auto [ptr, ec] = std::from_chars(first, last, i); ec == std::errc() && ptr == last) {
+            integer(i);
+            return;
+        }
+        uint64_t u = 0;
+        if (auto [ptr, ec] = std::from_chars(first, last, u); ec == std::errc() && ptr == last) {
+            byte(0xcf);
+            big_endian(u, 8);
+            return;
+        }
+
+        // 非整数按 float64 编码
+        const double d = j.as_double();
+        uint64_t bits = 0;
+        std::memcpy(&bits, &d, sizeof(bits));
+        byte(0xcb);
+        big_endian(bits, 8);
+    }
+
+    void integer(int64_t i)
+    {
+        if (i >= 0 && i <= 0x7f) {
+            byte(static_cast<uint8_t>(i));
+        }
+        else if (i < 0 && i >= -32) {
+            byte(static_cast<uint8_t>(i));
+        }
+        else if (i >= INT16_MIN && i <= INT16_MAX) {
+            byte(0xd1);
+            big_endian(static_cast<uint64_t>(i), 2);
+        }
+        else if (i >= INT32_MIN && i <= INT32_MAX) {
+            byte(0xd2);
+            big_endian(static_cast<uint64_t>(i), 4);
+        }
+        else {
+            byte(0xd3);
+            big_endian(static_cast<uint64_t>(i), 8);
+        }
+    }
+
+    void string(std::string_view str)
+    {
+        if (str.size() < 32) {
+            byte(static_cast<uint8_t>(0xa0 | str.size()));
+        }
+        else if (str.size() <= 0xff) {
+            byte(0xd9);
+            byte(static_cast<uint8_t>(str.size()));
+        }
+        else {
+            header(str.size(), 0, 0xda, 0xdb, 0);
+        }
+        out_.append(str);
+    }
+
+    // fix_limit 为 0 表示没有 fix 形式
+    void header(size_t size, uint8_t fix, uint8_t tag16, uint8_t tag32, size_t fix_limit)
+    {
+        if (size < fix_limit) {
+            byte(static_cast<uint8_t>(fix | size));
+        }
+        else if (size <= 0xffff) {
+            byte(tag16);
+            big_endian(size, 2);
+        }
+        else {
+            byte(tag32);
+            big_endian(size, 4);
+        }
+    }
+
+    void byte(uint8_t b) { out_.push_back(static_cast<char>(b)); }
+
+    void big_endian(uint64_t v, int bytes)
+    {
+        for (int i = bytes - 1; i >= 0; --i) {
+            byte(static_cast<uint8_t>(v >> (i * 8)));
+        }
+    }
+
+private:
+    std::string& out_;
+};
+
+class Decoder
+{
+public:
+    explicit Decoder(std::string_view data)
+        : data_(data)
+    {
+    }
+
+    std::optional<json::value> value(size_t depth = 0)
+    {
+        uint8_t b = 0;
+        if (depth > kMaxDepth || !byte(b)) {
+            return std::nullopt;
+        }
+
+        if (b <= 0x7f) {
+            return json::value(static_cast<int>(b));
+        }
+        if (b >= 0xe0) {
+            return json::value(static_cast<int>(static_cast<int8_t>(b)));
+        }
+        if ((b & 0xf0) == 0x80) {
+            return object(b & 0x0f, depth);
+        }
+        if ((b & 0xf0) == 0x90) {
+            return array(b & 0x0f, depth);
+        }
+        if ((b & 0xe0) == 0xa0) {
+            return string(b & 0x1f);
+        }
+
+        uint64_t n = 0;
+        switch (b) {
+        case 0xc0:
+            return json::value();
+        case 0xc2:
+            return json::value(false);
+        case 0xc3:
+            return json::value(true);
+        case 0xcc:
+        case 0xcd:
+        case 0xce:
+        case 0xcf:
+            if (!big_endian(n, 1 << (b - 0xcc))) {
+                return std::nullopt;
+            }
+            return json::value(static_cast<unsigned long long>(n));
+        case 0xd0:
+        case 0xd1:
+        case 0xd2:
+        case 0xd3:
+            return signed_integer(1 << (b - 0xd0));
+        case 0xca:
+        case 0xcb:
+            return floating(b == 0xca ? 4 : 8);
+        case 0xd9:
+        case 0xda:
+        case 0xdb:
+            if (!big_endian(n, 1 << (b - 0xd9))) {
+                return std::nullopt;
+            }
+            return string(n);
+        case 0xdc:
+        case 0xdd:
+            if (!big_endian(n, b == 0xdc ? 2 : 4)) {
+                return std::nullopt;
+            }
+            return array(n, depth);
+        case 0xde:
+        case 0xdf:
+            if (!big_endian(n, b == 0xde ? 2 : 4)) {
+                return std::nullopt;
+            }
+            return object(n, depth);
+        default:
+            LogError << "unsupported msgpack type" << VAR(static_cast<int>(b));
+            return std::nullopt;
+        }
+    }
+
+    bool finished() const { return pos_ == data_.size(); }
+
+private:
+    std::optional<json::value> object(uint64_t size, size_t depth)
+    {
+        json::object obj;
+        for (uint64_t i = 0; i < size; ++i) {
+            auto key = value(depth + 1);
+            auto item = value(depth + 1);
+            if (!key || !key->is_string() || !item) {
+                return std::nullopt;
+            }
+            obj[key->as_string()] = *std::move(item);
+        }
+        return json::value(std::move(obj));
+    }
+
+    std::optional<json::value> array(uint64_t size, size_t depth)
+    {
+        json::array arr;
+        for (uint64_t i = 0; i < size; ++i) {
+            auto item = value(depth + 1);
+            if (!item) {
+                return std::nullopt;
+            }
+            arr.emplace_back(*std::move(item));
+        }
+        return json::value(std::move(arr));
+    }
+
+    std::optional<json::value> string(uint64_t size)
+    {
+        auto str = bytes(size);
+        if (!str) {
+            return std::nullopt;
+        }
+        return json::value(std::string(*str));
+    }
+
+    std::optional<json::value> signed_integer(int size)
+    {
+        uint64_t n = 0;
+        if (!big_endian(n, size)) {
+            return std::nullopt;
+        }
+        const int shift = 64 - size * 8;
+        // 符号扩展
+        auto i = static_cast<int64_t>(n << shift) >> shift;
+        return json::value(static_cast<long long>(i));
+    }
+
+    std::optional<json::value> floating(int size)
+    {
+        uint64_t n = 0;
+        if (!big_endian(n, size)) {
+            return std::nullopt;
+        }
+        if (size == 4) {
+            auto bits = static_cast<uint32_t>(n);
+            float f = 0;
+            std::memcpy(&f, &bits, sizeof(f));
+            return json::value(f);
+        }
+        double d = 0;
+        std::memcpy(&d, &n, sizeof(d));
+        return json::value(d);
+    }
+
+    bool byte(uint8_t& b)
+    {
+        if (pos_ >= data_.size()) {
+            return false;
+        }
+        b = static_cast<uint8_t>(data_[pos_++]);
+        return true;
+    }
+
+    std::optional<std::string_view> bytes(uint64_t size)
+    {
+        if (data_.size() - pos_ < size) {
+            return std::nullopt;
+        }
+        auto view = data_.substr(pos_, size);
+        pos_ += size;
+        return view;
+    }
+
+    bool big_endian(uint64_t& v, int size)
+    {
+        auto raw = bytes(size);
+        if (!raw) {
+            return false;
+        }
+        v = 0;
+        for (char c : *raw) {
+            v = (v << 8) | static_cast<uint8_t>(c);
+        }
+        return true;
+    }
+
+private:
+    std::string_view data_;
+    size_t pos_ = 0;
+};
+
+} // namespace
+
+std::string encode_message(const json::value& j, WireFormat format)
+{
+    if (format == WireFormat::Json || !j.is_object()) {
+        return j.dumps();
+    }
+
+    const std::string_view type = message_type(j);
+    if (type.empty() || type.size() > 0xff) {
+        return j.dumps();
+    }
+
+    std::string out;
+    out.reserve(64 + type.size());
+    out.push_back(static_cast<char>(kBinaryMagic));
+    out.push_back(static_cast<char>(kBinaryVersion));
+    out.push_back(static_cast<char>(type.size()));
+    out.append(type);
+
+    // 占位字段只承载类型，已经写在帧头
+    std::string placeholder = std::string("_").append(type);
+    Encoder(out).object(j.as_object(), placeholder);
+    return out;
+}
+
+std::optional<json::value> decode_message(std::string_view data)
+{
+    if (data.empty()) {
+        return std::nullopt;
+    }
+
+    if (static_cast<uint8_t>(data.front()) != kBinaryMagic) {
+        return json::parse(data);
+    }
+
+    if (data.size() < 3 || static_cast<uint8_t>(data[1]) != kBinaryVersion) {
+        LogError << "unsupported binary frame" << VAR(data.size());
+        return std::nullopt;
+    }
+    const size_t type_size = static_cast<uint8_t>(data[2]);
+    if (data.size() < 3 + type_size) {
+        return std::nullopt;
+    }
+    const std::string_view type = data.substr(3, type_size);
+
+    Decoder decoder(data.substr(3 + type_size));
+    auto j = decoder.value();
+    if (!j || !j->is_object() || !decoder.finished()) {
+        LogError << "failed to decode binary frame" << VAR(type);
+        return std::nullopt;
+    }
+
+    j->as_object()[std::string("_").append(type)] = 1;
+    return j;
+}
+
+std::string_view message_type(const json::value& j)
+{
+    if (!j.is_object()) {
+        return { };
+    }
+
+    // 消息结构体只有占位字段以下划线开头
+    for (const auto& [key, _] : j.as_object()) {
+        if (key.size() > 1 && key.front() == '_' && !is_envelope_key(key)) {
+            return std::string_view(key).substr(1);
+        }
+    }
+    return { };
+}
+
+MAA_AGENT_NS_END
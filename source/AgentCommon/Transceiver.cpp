@@ -1,12 +1,15 @@
 #include "MaaAgent/Transceiver.h"
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <cerrno>
 #include <cstdlib>
 #include <format>
 #include <fstream>
+#include <iterator>
 #include <optional>
+#include <ranges>
 #include <string_view>
 
 #ifdef _WIN32
@@ -23,41 +26,40 @@
 
 MAA_AGENT_NS_BEGIN
 
-Transceiver::~Transceiver()
+namespace
 {
-    LogFunc;
 
-    uninit_socket();
-}
+// io 线程空闲时的轮询间隔，同时决定 alive() 的刷新频率
+constexpr auto kIoPollInterval = std::chrono::milliseconds(100);
+// 停止 io 线程前等待已投递消息发出的最长时间
+constexpr auto kFlushTimeout = std::chrono::milliseconds(1000);
 
-bool Transceiver::handle_image_header(const json::value& j)
+struct InboundFrame
 {
-    if (!j.is<ImageHeader>()) {
-        return false;
-    }
-
-    const ImageHeader& header = j.as<ImageHeader>();
+    const void* transceiver = nullptr;
+    int64_t id = 0;
+};
 
-    LogTrace << VAR(header) << VAR(ipc_addr_);
+// 当前线程正在处理的对端请求，嵌套处理时成栈
+thread_local std::vector<InboundFrame> t_inbound_frames;
 
-    handle_image(header);
-
-    return true;
-}
-
-bool Transceiver::handle_image_encoded_header(const json::value& j)
+template <typename PredT>
+bool wait_for(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, std::chrono::milliseconds timeout, PredT pred)
 {
-    if (!j.is<ImageEncodedHeader>()) {
-        return false;
+    if (timeout == std::chrono::milliseconds::max()) {
+        cv.wait(lock, pred);
+        return true;
     }
+    return cv.wait_for(lock, timeout, pred);
+}
 
-    const ImageEncodedHeader& header = j.as<ImageEncodedHeader>();
-
-    LogTrace << VAR(header) << VAR(ipc_addr_);
+} // namespace
 
-    handle_image_encoded(header);
+Transceiver::~Transceiver()
+{
+    LogFunc;
 
-    return true;
+    uninit_socket();
 }
 
 static std::string temp_directory()
@@ -112,9 +114,7 @@ void Transceiver::init_socket(const std::string& identifier, bool bind)
     LogInfo << VAR(ipc_addr_) << VAR(identifier);
 
     zmq_sock_ = zmq::socket_t(zmq_ctx_, zmq::socket_type::pair);
-
-    zmq_pollitem_send_ = zmq::pollitem_t(zmq_sock_.handle(), 0, ZMQ_POLLOUT, 0);
-    zmq_pollitem_recv_ = zmq::pollitem_t(zmq_sock_.handle(), 0, ZMQ_POLLIN, 0);
+    apply_transport_options();
 
     is_bound_ = bind;
 
@@ -124,6 +124,8 @@ void Transceiver::init_socket(const std::string& identifier, bool bind)
     else {
         zmq_sock_.connect(ipc_addr_);
     }
+
+    start_io();
 }
 
 static uint16_t parse_port_from_endpoint(const std::string& endpoint)
@@ -149,9 +151,7 @@ uint16_t Transceiver::init_tcp_socket(uint16_t port, bool bind)
     is_tcp_ = true;
 
     zmq_sock_ = zmq::socket_t(zmq_ctx_, zmq::socket_type::pair);
-
-    zmq_pollitem_send_ = zmq::pollitem_t(zmq_sock_.handle(), 0, ZMQ_POLLOUT, 0);
-    zmq_pollitem_recv_ = zmq::pollitem_t(zmq_sock_.handle(), 0, ZMQ_POLLIN, 0);
+    apply_transport_options();
 
     is_bound_ = bind;
 
@@ -176,6 +176,8 @@ uint16_t Transceiver::init_tcp_socket(uint16_t port, bool bind)
         LogInfo << "TCP socket connected" << VAR(ipc_addr_);
     }
 
+    start_io();
+
     return tcp_port_;
 }
 
@@ -228,6 +230,8 @@ void Transceiver::uninit_socket()
 {
     LogFunc << VAR(ipc_addr_);
 
+    stop_io();
+
     // if (connected()) {
     //     if (is_bound_) {
     //         zmq_sock_.unbind(ipc_addr_);
@@ -252,10 +256,44 @@ void Transceiver::uninit_socket()
     }
 }
 
+void Transceiver::set_transport_options(TransportOptions options)
+{
+    LogInfo << VAR(options);
+
+    transport_options_ = std::move(options);
+}
+
+void Transceiver::apply_transport_options()
+{
+    const TransportOptions& opt = transport_options_;
+
+    auto set_if = [&](auto sockopt, int value) {
+        if (value >= 0) {
+            zmq_sock_.set(sockopt, value);
+        }
+    };
+
+    try {
+        set_if(zmq::sockopt::sndhwm, opt.send_hwm);
+        set_if(zmq::sockopt::rcvhwm, opt.recv_hwm);
+        set_if(zmq::sockopt::tcp_keepalive, opt.tcp_keepalive);
+        set_if(zmq::sockopt::tcp_keepalive_idle, opt.tcp_keepalive_idle);
+        set_if(zmq::sockopt::tcp_keepalive_intvl, opt.tcp_keepalive_interval);
+        set_if(zmq::sockopt::tcp_keepalive_cnt, opt.tcp_keepalive_count);
+        set_if(zmq::sockopt::reconnect_ivl, opt.reconnect_interval);
+        set_if(zmq::sockopt::reconnect_ivl_max, opt.reconnect_interval_max);
+        set_if(zmq::sockopt::heartbeat_ivl, opt.heartbeat_interval);
+        set_if(zmq::sockopt::heartbeat_timeout, opt.heartbeat_timeout);
+        set_if(zmq::sockopt::heartbeat_ttl, opt.heartbeat_ttl);
+    }
+    catch (const zmq::error_t& e) {
+        LogError << "failed to apply transport options" << VAR(e.what()) << VAR(opt);
+    }
+}
+
 bool Transceiver::alive()
 {
-    std::unique_lock lock(socket_mutex_);
-    return zmq_sock_.handle() != nullptr && zmq::detail::poll(&zmq_pollitem_send_, 1, 0);
+    return io_running_ && writable_;
 }
 
 void Transceiver::set_timeout(const std::chrono::milliseconds& timeout)
@@ -264,85 +302,400 @@ void Transceiver::set_timeout(const std::chrono::milliseconds& timeout)
     timeout_ = timeout;
 }
 
-bool Transceiver::poll(zmq::pollitem_t& pollitem)
+void Transceiver::set_wire_format(WireFormat format)
 {
-    const auto start_clock = std::chrono::steady_clock::now();
+    LogInfo << VAR(static_cast<int>(format)) << VAR(ipc_addr_);
+    wire_format_ = format;
+}
 
-    while (true) {
-        auto elapsed = duration_since(start_clock);
-        auto remaining_time = timeout_ > elapsed ? timeout_ - elapsed : std::chrono::milliseconds(0);
-        auto interval = std::min(remaining_time, std::chrono::milliseconds(1000));
+zmq::message_t Transceiver::make_message(const json::value& j) const
+{
+    std::string data = encode_message(j, wire_format_);
+    return zmq::message_t(data.data(), data.size());
+}
 
-        try {
-            if (zmq::poll(&pollitem, 1, interval)) {
-                return true;
-            }
+bool Transceiver::send(const json::value& j)
+{
+    json::value msg = j;
+    if (auto reply_to = current_inbound_id()) {
+        msg[kMsgReplyToKey] = reply_to;
+    }
+
+    std::vector<zmq::message_t> frames;
+    frames.emplace_back(make_message(msg));
+    return enqueue(std::move(frames));
+}
+
+bool Transceiver::reply(const json::value& request, const json::value& j)
+{
+    json::value msg = j;
+    if (auto id = request.find<int64_t>(kMsgIdKey)) {
+        msg[kMsgReplyToKey] = *id;
+    }
+
+    std::vector<zmq::message_t> frames;
+    frames.emplace_back(make_message(msg));
+    return enqueue(std::move(frames));
+}
+
+bool Transceiver::post(const json::value& j)
+{
+    json::value msg = j;
+    msg[kMsgIdKey] = ++s_req_id_;
+    if (auto parent = current_inbound_id()) {
+        msg[kMsgParentKey] = parent;
+    }
+
+    std::vector<zmq::message_t> frames;
+    frames.emplace_back(make_message(msg));
+    return enqueue(std::move(frames));
+}
+
+std::optional<json::value> Transceiver::request(json::value j)
+{
+    const int64_t parent = current_inbound_id();
+    const bool top_level = parent == 0;
+
+    std::unique_lock lock(pending_mutex_);
+
+    if (top_level) {
+        if (!wait_for(in_flight_cv_, lock, timeout_, [&]() { return in_flight_ < kMaxInFlight || !io_running_; })) {
+            LogError << "too many requests in flight" << VAR(in_flight_) << VAR(ipc_addr_);
+            return std::nullopt;
         }
-        catch (const zmq::error_t& e) {
-            // Android/Linux: signals may interrupt poll; retry with remaining timeout.
-            if (e.num() != EINTR) {
-                throw;
-            }
+        ++in_flight_;
+    }
+
+    const int64_t req_id = ++s_req_id_;
+    auto pending = std::make_shared<PendingRequest>();
+    pending_.emplace(req_id, pending);
+
+    // 调用时须持有 pending_mutex_
+    auto finish = [&]() {
+        pending_.erase(req_id);
+        if (top_level) {
+            --in_flight_;
+            in_flight_cv_.notify_one();
         }
+    };
 
-        if (elapsed > timeout_) {
-            LogWarn << "socket is not alive" << VAR(elapsed) << VAR(timeout_) << VAR(ipc_addr_);
-            return false;
+    lock.unlock();
+
+    j[kMsgIdKey] = req_id;
+    if (!top_level) {
+        j[kMsgParentKey] = parent;
+    }
+    std::vector<zmq::message_t> frames;
+    frames.emplace_back(make_message(j));
+    bool sent = enqueue(std::move(frames));
+
+    lock.lock();
+
+    if (!sent) {
+        LogError << "failed to send req" << VAR(req_id);
+        finish();
+        return std::nullopt;
+    }
+
+    auto ready = [&]() {
+        return pending->response || pending->failed || !pending->inserted.empty();
+    };
+
+    while (true) {
+        if (!wait_for(pending->cv, lock, timeout_, ready)) {
+            LogError << "request timeout" << VAR(req_id) << VAR(timeout_) << VAR(ipc_addr_);
+            finish();
+            return std::nullopt;
+        }
+        if (pending->response) {
+            auto resp = *std::move(pending->response);
+            finish();
+            return resp;
+        }
+        if (pending->failed) {
+            LogError << "failed to recv resp" << VAR(req_id) << VAR(ipc_addr_);
+            finish();
+            return std::nullopt;
         }
+
+        // 对端处理本请求期间发来的请求，在当前线程处理
+        json::value inserted = std::move(pending->inserted.front());
+        pending->inserted.pop_front();
+
+        lock.unlock();
+        dispatch_request(inserted);
+        lock.lock();
     }
-    // unreachable code
-    // return false;
 }
 
-bool Transceiver::send(const json::value& j)
+std::optional<json::value> Transceiver::recv_request()
 {
-    // LogTrace << VAR(j.to_string()) << VAR(ipc_addr_);
+    std::unique_lock lock(pending_mutex_);
 
-    std::unique_lock lock(socket_mutex_);
+    requests_cv_.wait(lock, [&]() { return !requests_.empty() || !io_running_; });
+    if (requests_.empty()) {
+        return std::nullopt;
+    }
 
-    if (!poll(zmq_pollitem_send_)) {
-        LogError << "send canceled";
-        return false;
+    json::value j = std::move(requests_.front());
+    requests_.pop_front();
+    return j;
+}
+
+bool Transceiver::dispatch_request(const json::value& j)
+{
+    t_inbound_frames.emplace_back(InboundFrame { .transceiver = this, .id = j.get(kMsgIdKey, int64_t(0)) });
+    bool ret = handle_inserted_request(j);
+    t_inbound_frames.pop_back();
+    return ret;
+}
+
+int64_t Transceiver::current_inbound_id() const
+{
+    for (const auto& frame : t_inbound_frames | std::views::reverse) {
+        if (frame.transceiver == this) {
+            return frame.id;
+        }
     }
+    return 0;
+}
 
-    std::string jstr = j.dumps();
-    zmq::message_t msg(jstr.data(), jstr.size());
+bool Transceiver::enqueue(std::vector<zmq::message_t> frames)
+{
+    std::unique_lock lock(out_mutex_);
 
-    bool sent = zmq_sock_.send(std::move(msg), zmq::send_flags::dontwait).has_value();
-    if (!sent) {
-        LogError << "failed to send msg" << VAR(j);
+    if (!io_running_) {
+        LogError << "io thread is not running" << VAR(ipc_addr_);
         return false;
     }
+
+    const bool was_empty = outbox_.empty();
+    for (auto& frame : frames) {
+        outbox_.emplace_back(std::move(frame));
+    }
+    if (was_empty) {
+        std::ignore = wake_send_.send(zmq::message_t(), zmq::send_flags::dontwait);
+    }
     return true;
 }
 
-std::optional<json::value> Transceiver::recv()
+void Transceiver::start_io()
 {
-    std::unique_lock lock(socket_mutex_);
+    stop_io();
 
-    if (!poll(zmq_pollitem_recv_)) {
-        LogError << "recv canceled";
-        return std::nullopt;
+    std::string wake_addr = std::format("inproc://maafw-agent-wake-{}", static_cast<const void*>(this));
+    wake_recv_ = zmq::socket_t(zmq_ctx_, zmq::socket_type::pair);
+    wake_recv_.bind(wake_addr);
+    wake_send_ = zmq::socket_t(zmq_ctx_, zmq::socket_type::pair);
+    wake_send_.connect(wake_addr);
+
+    io_running_ = true;
+    io_thread_ = std::thread(&Transceiver::io_loop, this);
+}
+
+void Transceiver::stop_io()
+{
+    if (!io_thread_.joinable()) {
+        return;
     }
 
-    zmq::message_t msg;
+    LogFunc << VAR(ipc_addr_);
 
-    auto size_opt = zmq_sock_.recv(msg, zmq::recv_flags::dontwait);
-    if (!size_opt || *size_opt == 0) {
-        LogError << "failed to recv msg" << VAR(ipc_addr_);
-        return std::nullopt;
+    {
+        std::unique_lock lock(out_mutex_);
+        io_running_ = false;
+        std::ignore = wake_send_.send(zmq::message_t(), zmq::send_flags::dontwait);
+    }
+    io_thread_.join();
+
+    std::unique_lock lock(out_mutex_);
+    wake_send_.close();
+    wake_recv_.close();
+}
+
+void Transceiver::io_loop()
+{
+    LogFunc << VAR(ipc_addr_);
+
+    std::deque<zmq::message_t> outgoing;
+    bool broken = false;
+
+    auto take_outbox = [&]() {
+        std::unique_lock lock(out_mutex_);
+        std::ranges::move(outbox_, std::back_inserter(outgoing));
+        outbox_.clear();
+    };
+
+    while (io_running_) {
+        std::array<zmq::pollitem_t, 2> items { {
+            { zmq_sock_.handle(), 0, static_cast<short>(outgoing.empty() ? ZMQ_POLLIN : ZMQ_POLLIN | ZMQ_POLLOUT), 0 },
+            { wake_recv_.handle(), 0, ZMQ_POLLIN, 0 },
+        } };
+
+        try {
+            zmq::poll(items.data(), items.size(), kIoPollInterval);
+
+            if (items[1].revents & ZMQ_POLLIN) {
+                zmq::message_t dummy;
+                while (wake_recv_.recv(dummy, zmq::recv_flags::dontwait)) {
+                }
+            }
+
+            take_outbox();
+            flush_outgoing(outgoing);
+
+            if (items[0].revents & ZMQ_POLLIN) {
+                zmq::message_t msg;
+                while (zmq_sock_.recv(msg, zmq::recv_flags::dontwait)) {
+                    route(msg);
+                }
+            }
+
+            zmq::pollitem_t out_item { zmq_sock_.handle(), 0, ZMQ_POLLOUT, 0 };
+            writable_ = zmq::poll(&out_item, 1, std::chrono::milliseconds(0)) > 0;
+        }
+        catch (const zmq::error_t& e) {
+            // Android/Linux: signals may interrupt poll; retry.
+            if (e.num() == EINTR) {
+                continue;
+            }
+            LogError << "socket error" << VAR(e.what()) << VAR(ipc_addr_);
+            broken = true;
+            break;
+        }
+    }
+
+    // 退出前尽量把已投递的消息发完，如 ShutDownResponse
+    if (!broken) {
+        take_outbox();
+        const auto start_clock = std::chrono::steady_clock::now();
+        try {
+            while (!outgoing.empty() && duration_since(start_clock) < kFlushTimeout) {
+                zmq::pollitem_t out_item { zmq_sock_.handle(), 0, ZMQ_POLLOUT, 0 };
+                if (zmq::poll(&out_item, 1, kIoPollInterval) > 0) {
+                    flush_outgoing(outgoing);
+                }
+            }
+        }
+        catch (const zmq::error_t& e) {
+            LogWarn << "failed to flush" << VAR(e.what()) << VAR(ipc_addr_);
+        }
+    }
+    if (!outgoing.empty()) {
+        LogWarn << "drop unsent msg" << VAR(outgoing.size()) << VAR(ipc_addr_);
+    }
+
+    {
+        std::unique_lock lock(out_mutex_);
+        io_running_ = false;
+        outbox_.clear();
     }
+    writable_ = false;
+    fail_all_pending();
+}
+
+void Transceiver::flush_outgoing(std::deque<zmq::message_t>& outgoing)
+{
+    while (!outgoing.empty()) {
+        // 对端未连接或缓冲已满，等下次可写
+        if (!zmq_sock_.send(outgoing.front(), zmq::send_flags::dontwait)) {
+            return;
+        }
+        outgoing.pop_front();
+    }
+}
 
-    std::string_view init_str = msg.to_string_view();
-    auto jopt = json::parse(init_str);
+void Transceiver::route(zmq::message_t& msg)
+{
+    if (image_header_) {
+        json::value header = *std::move(image_header_);
+        image_header_.reset();
+        store_image(header, msg);
+        return;
+    }
+
+    auto jopt = decode_message(msg.to_string_view());
     if (!jopt) {
         LogError << "failed to parse msg" << VAR(ipc_addr_);
-        return std::nullopt;
+        return;
     }
-    auto j = *std::move(jopt);
+    json::value& j = *jopt;
     // LogTrace << VAR(j.to_string()) << VAR(ipc_addr_);
 
-    return j;
+    // 图片数据紧跟在头之后单独一帧
+    if (auto type = message_type(j); type == "ImageHeader" || type == "ImageEncodedHeader") {
+        image_header_ = std::move(j);
+        return;
+    }
+
+    std::unique_lock lock(pending_mutex_);
+
+    if (auto reply_to = j.find<int64_t>(kMsgReplyToKey)) {
+        auto it = pending_.find(*reply_to);
+        if (it == pending_.end()) {
+            // 单向请求（事件）的回复，或是已超时放弃的请求
+            LogTrace << "no pending request" << VAR(*reply_to) << VAR(ipc_addr_);
+            return;
+        }
+        it->second->response = std::move(j);
+        it->second->cv.notify_all();
+        return;
+    }
+
+    if (!j.contains(kMsgIdKey)) {
+        // 旧协议的对端不带信封，只能按顺序对应唯一在途的请求，至少让 StartUp 能报告版本不匹配
+        if (pending_.size() == 1) {
+            auto& pending = pending_.begin()->second;
+            pending->response = std::move(j);
+            pending->cv.notify_all();
+        }
+        else if (!is_bound_) {
+            requests_.emplace_back(std::move(j));
+            requests_cv_.notify_one();
+        }
+        else {
+            LogError << "msg without envelope" << VAR(j) << VAR(ipc_addr_);
+        }
+        return;
+    }
+
+    if (auto parent = j.find<int64_t>(kMsgParentKey)) {
+        auto it = pending_.find(*parent);
+        if (it != pending_.end()) {
+            it->second->inserted.emplace_back(std::move(j));
+            it->second->cv.notify_all();
+            return;
+        }
+        // 父请求是单向请求（post）或已超时放弃，没有线程在等它，按顶层请求处理
+        LogDebug << "parent request is not pending, treat as top-level" << VAR(*parent) << VAR(ipc_addr_);
+    }
+
+    // 顶层请求只会由 AgentClient 发往 AgentServer（connect 的一端）
+    if (is_bound_) {
+        LogError << "unexpected request" << VAR(j) << VAR(ipc_addr_);
+        // 回一个空回复，对端的 request 会以不匹配的回复失败返回，而不是一直等下去
+        json::value reject;
+        reject[kMsgReplyToKey] = j.get(kMsgIdKey, int64_t(0));
+        lock.unlock();
+        std::vector<zmq::message_t> frames;
+        frames.emplace_back(make_message(reject));
+        std::ignore = enqueue(std::move(frames));
+        return;
+    }
+    requests_.emplace_back(std::move(j));
+    requests_cv_.notify_one();
+}
+
+void Transceiver::fail_all_pending()
+{
+    std::unique_lock lock(pending_mutex_);
+
+    for (auto& [id, pending] : pending_) {
+        pending->failed = true;
+        pending->cv.notify_all();
+    }
+    in_flight_cv_.notify_all();
+    requests_cv_.notify_all();
 }
 
 std::string Transceiver::send_image(const cv::Mat& mat)
@@ -352,8 +705,6 @@ std::string Transceiver::send_image(const cv::Mat& mat)
         return { };
     }
 
-    std::unique_lock lock(socket_mutex_);
-
     ImageHeader header {
         .uuid = make_uuid(),
         .rows = mat.rows,
@@ -362,24 +713,13 @@ std::string Transceiver::send_image(const cv::Mat& mat)
         .size = mat.total() * mat.elemSize(),
     };
 
-    // send header
-    if (!poll(zmq_pollitem_send_)) {
-        LogError << "send header canceled";
-        return { };
-    }
-    std::string jstr = json::value(header).dumps();
-    zmq::message_t header_msg(jstr.data(), jstr.size());
-    bool sent = zmq_sock_.send(std::move(header_msg), zmq::send_flags::dontwait).has_value();
-    if (!sent) {
-        LogError << "failed to send header" << VAR(header) << VAR(ipc_addr_);
-        return { };
-    }
+    // 头和数据作为连续的两帧投递，不会被其他线程的消息插入
+    std::vector<zmq::message_t> frames;
+    frames.emplace_back(make_message(json::value(header)));
+    frames.emplace_back(mat.data, header.size);
 
-    // send image data
-    zmq::message_t img_msg(mat.data, mat.total() * mat.elemSize());
-    sent = zmq_sock_.send(img_msg, zmq::send_flags::none).has_value();
-    if (!sent) {
-        LogError << "failed to send msg" << VAR(ipc_addr_);
+    if (!enqueue(std::move(frames))) {
+        LogError << "failed to send image" << VAR(header) << VAR(ipc_addr_);
         return { };
     }
     return header.uuid;
@@ -392,31 +732,17 @@ std::string Transceiver::send_image_encoded(const ImageEncodedBuffer& encoded_da
         return { };
     }
 
-    std::unique_lock lock(socket_mutex_);
-
     ImageEncodedHeader header {
         .uuid = make_uuid(),
         .size = encoded_data.size(),
     };
 
-    // send header
-    if (!poll(zmq_pollitem_send_)) {
-        LogError << "send encoded header canceled";
-        return { };
-    }
-    std::string jstr = json::value(header).dumps();
-    zmq::message_t header_msg(jstr.data(), jstr.size());
-    bool sent = zmq_sock_.send(std::move(header_msg), zmq::send_flags::dontwait).has_value();
-    if (!sent) {
-        LogError << "failed to send encoded header" << VAR(header) << VAR(ipc_addr_);
-        return { };
-    }
+    std::vector<zmq::message_t> frames;
+    frames.emplace_back(make_message(json::value(header)));
+    frames.emplace_back(encoded_data.data(), encoded_data.size());
 
-    // send encoded image data
-    zmq::message_t img_msg(encoded_data.data(), encoded_data.size());
-    sent = zmq_sock_.send(img_msg, zmq::send_flags::none).has_value();
-    if (!sent) {
-        LogError << "failed to send encoded image data" << VAR(ipc_addr_);
+    if (!enqueue(std::move(frames))) {
+        LogError << "failed to send encoded image" << VAR(header) << VAR(ipc_addr_);
         return { };
     }
     return header.uuid;
@@ -429,6 +755,8 @@ cv::Mat Transceiver::get_image_cache(const std::string& uuid)
         return { };
     }
 
+    std::unique_lock lock(images_mutex_);
+
     auto it = recved_images_.find(uuid);
     if (it == recved_images_.end()) {
         LogError << "image not found" << VAR(uuid) << VAR(ipc_addr_);
@@ -448,6 +776,8 @@ Transceiver::ImageEncodedBuffer Transceiver::get_image_encoded_cache(const std::
         return { };
     }
 
+    std::unique_lock lock(images_mutex_);
+
     auto it = recved_images_encoded_.find(uuid);
     if (it == recved_images_encoded_.end()) {
         LogError << "encoded image not found" << VAR(uuid) << VAR(ipc_addr_);
@@ -460,48 +790,30 @@ Transceiver::ImageEncodedBuffer Transceiver::get_image_encoded_cache(const std::
     return encoded_data;
 }
 
-void Transceiver::handle_image(const ImageHeader& header)
-{
-    LogFunc << VAR(header);
-
-    std::unique_lock lock(socket_mutex_);
-
-    zmq::message_t msg;
-    auto size_opt = zmq_sock_.recv(msg);
-    if (!size_opt || *size_opt == 0) {
-        LogError << "failed to recv msg" << VAR(ipc_addr_);
-        return;
-    }
-
-    if (header.size != msg.size()) {
-        LogError << "size mismatch" << VAR(header.size) << VAR(msg.size());
-        return;
-    }
-
-    cv::Mat image = cv::Mat(header.rows, header.cols, header.type, msg.data()).clone();
-    recved_images_.insert_or_assign(header.uuid, std::move(image));
-}
-
-void Transceiver::handle_image_encoded(const ImageEncodedHeader& header)
+void Transceiver::store_image(const json::value& header_json, const zmq::message_t& msg)
 {
-    LogFunc << VAR(header);
-
-    std::unique_lock lock(socket_mutex_);
+    if (header_json.is<ImageHeader>()) {
+        const ImageHeader& header = header_json.as<ImageHeader>();
+        if (header.size != msg.size()) {
+            LogError << "size mismatch" << VAR(header.size) << VAR(msg.size());
+            return;
+        }
 
-    zmq::message_t msg;
-    auto size_opt = zmq_sock_.recv(msg);
-    if (!size_opt || *size_opt == 0) {
-        LogError << "failed to recv encoded image data" << VAR(ipc_addr_);
-        return;
+        cv::Mat image = cv::Mat(header.rows, header.cols, header.type, const_cast<void*>(msg.data())).clone();
+        std::unique_lock lock(images_mutex_);
+        recved_images_.insert_or_assign(header.uuid, std::move(image));
     }
+    else {
+        const ImageEncodedHeader& header = header_json.as<ImageEncodedHeader>();
+        if (header.size != msg.size()) {
+            LogError << "encoded size mismatch" << VAR(header.size) << VAR(msg.size());
+            return;
+        }
 
-    if (header.size != msg.size()) {
-        LogError << "encoded size mismatch" << VAR(header.size) << VAR(msg.size());
-        return;
+        auto data = static_cast<const uint8_t*>(msg.data());
+        std::unique_lock lock(images_mutex_);
+        recved_images_encoded_.insert_or_assign(header.uuid, ImageEncodedBuffer(data, data + msg.size()));
     }
-
-    ImageEncodedBuffer encoded_data(static_cast<const uint8_t*>(msg.data()), static_cast<const uint8_t*>(msg.data()) + msg.size());
-    recved_images_encoded_.insert_or_assign(header.uuid, std::move(encoded_data));
 }
 
 MAA_AGENT_NS_END
@@ -198,6 +198,34 @@ MaaActId MaaContextRunActionDirect(
     return context->run_action_direct(action_type, *param_opt, cv_box, reco_detail);
 }
 
+MaaRecoId MaaContextRunRecognitionOnFrame(MaaContext* context, MaaFrameId frame_id, const char* reco_type, const char* reco_param)
+{
+    LogFunc << VAR_VOIDP(context) << VAR(frame_id) << VAR(reco_type) << VAR(reco_param);
+
+    if (!context) {
+        LogError << "handle is null";
+        return MaaInvalidId;
+    }
+
+    if (!reco_type) {
+        LogError << "reco_type is null";
+        return MaaInvalidId;
+    }
+
+    if (!reco_param) {
+        LogError << "reco_param is null";
+        return MaaInvalidId;
+    }
+
+    auto param_opt = json::parse(reco_param);
+    if (!param_opt) {
+        LogError << "failed to parse" << VAR(reco_param);
+        return MaaInvalidId;
+    }
+
+    return context->run_recognition_on_frame(frame_id, reco_type, *param_opt);
+}
+
 MaaBool MaaContextWaitFreezes(MaaContext* context, MaaSize time, const MaaRect* box, const char* wait_freezes_param)
 {
     LogFunc << VAR_VOIDP(context) << VAR(time) << VAR(wait_freezes_param);
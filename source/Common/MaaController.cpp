@@ -366,7 +366,8 @@ MaaBool MaaControllerCachedImage(const MaaController* ctrl, MaaImageBuffer* buff
         return false;
     }
 
-    buffer->set(std::move(img));
+    // 缓存帧与识别共享且不可写，而 buffer 可经 MaaImageBufferGetRawData 被调用方修改，这里交出副本
+    buffer->set(img.clone());
     return true;
 }
 
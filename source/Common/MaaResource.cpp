@@ -54,6 +54,20 @@ MaaBool MaaResourceRegisterCustomRecognition(MaaResource* res, const char* name,
     return true;
 }
 
+MaaBool
+    MaaResourceRegisterCustomRecognitionBatch(MaaResource* res, const char* name, MaaCustomRecognitionBatchCallback recognition, void* trans_arg)
+{
+    LogFunc << VAR_VOIDP(res) << VAR(name) << VAR_VOIDP(recognition) << VAR_VOIDP(trans_arg);
+
+    if (!res || !name || !recognition) {
+        LogError << "handle is null";
+        return false;
+    }
+
+    res->register_custom_recognition_batch(name, recognition, trans_arg);
+    return true;
+}
+
 MaaBool MaaResourceUnregisterCustomRecognition(MaaResource* res, const char* name)
 {
     LogFunc << VAR_VOIDP(res) << VAR(name);
@@ -412,6 +426,23 @@ MaaBool MaaResourceGetCustomActionList(const MaaResource* res, /* out */ MaaStri
     return true;
 }
 
+MaaBool MaaResourceGetTemplateCacheStats(const MaaResource* res, /* out */ MaaStringBuffer* buffer)
+{
+    if (!res || !buffer) {
+        LogError << "handle is null";
+        return false;
+    }
+
+    auto stats = res->get_template_cache_stats();
+    if (stats.empty()) {
+        LogError << "stats is empty";
+        return false;
+    }
+
+    buffer->set(std::move(stats));
+    return true;
+}
+
 MaaBool MaaResourceGetDefaultRecognitionParam(const MaaResource* res, const char* reco_type, MaaStringBuffer* buffer)
 {
     if (!res || !buffer) {
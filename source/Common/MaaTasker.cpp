@@ -77,6 +77,44 @@ void MaaTaskerClearContextSinks(MaaTasker* tasker)
     tasker->clear_context_sinks();
 }
 
+static std::vector<std::string> to_msg_filter(const MaaStringListBuffer* msg_filter)
+{
+    std::vector<std::string> result;
+    if (!msg_filter) {
+        return result;
+    }
+
+    size_t size = msg_filter->size();
+    for (size_t i = 0; i < size; ++i) {
+        result.emplace_back(msg_filter->at(i).get());
+    }
+    return result;
+}
+
+MaaBool MaaTaskerSetSinkSubscription(MaaTasker* tasker, MaaSinkId sink_id, const MaaStringListBuffer* msg_filter)
+{
+    LogInfo << VAR_VOIDP(tasker) << VAR(sink_id);
+
+    if (!tasker) {
+        LogError << "handle is null";
+        return false;
+    }
+
+    return tasker->set_sink_subscription(sink_id, to_msg_filter(msg_filter));
+}
+
+MaaBool MaaTaskerSetContextSinkSubscription(MaaTasker* tasker, MaaSinkId sink_id, const MaaStringListBuffer* msg_filter)
+{
+    LogInfo << VAR_VOIDP(tasker) << VAR(sink_id);
+
+    if (!tasker) {
+        LogError << "handle is null";
+        return false;
+    }
+
+    return tasker->set_context_sink_subscription(sink_id, to_msg_filter(msg_filter));
+}
+
 MaaBool MaaTaskerSetOption(MaaTasker* tasker, MaaTaskerOption key, MaaOptionValue value, MaaOptionValueSize val_size)
 {
     LogFunc << VAR_VOIDP(tasker) << VAR(key) << VAR_VOIDP(value) << VAR(val_size);
@@ -224,6 +262,63 @@ MaaTaskId
     return tasker->post_action(action_type, *param_opt, cv_box, reco_detail);
 }
 
+MaaFrameId MaaTaskerRegisterFrame(MaaTasker* tasker, const MaaImageBuffer* image)
+{
+    LogFunc << VAR_VOIDP(tasker);
+
+    if (!tasker) {
+        LogError << "handle is null";
+        return MaaInvalidId;
+    }
+
+    if (!image) {
+        LogError << "image is null";
+        return MaaInvalidId;
+    }
+
+    return tasker->register_frame(image->get());
+}
+
+MaaBool MaaTaskerUnregisterFrame(MaaTasker* tasker, MaaFrameId frame_id)
+{
+    LogFunc << VAR_VOIDP(tasker) << VAR(frame_id);
+
+    if (!tasker) {
+        LogError << "handle is null";
+        return false;
+    }
+
+    return tasker->unregister_frame(frame_id);
+}
+
+MaaTaskId MaaTaskerPostRecognitionOnFrame(MaaTasker* tasker, MaaFrameId frame_id, const char* reco_type, const char* reco_param)
+{
+    LogFunc << VAR_VOIDP(tasker) << VAR(frame_id) << VAR(reco_type) << VAR(reco_param);
+
+    if (!tasker) {
+        LogError << "handle is null";
+        return MaaInvalidId;
+    }
+
+    if (!reco_type) {
+        LogError << "reco_type is null";
+        return MaaInvalidId;
+    }
+
+    if (!reco_param) {
+        LogError << "reco_param is null";
+        return MaaInvalidId;
+    }
+
+    auto param_opt = json::parse(reco_param);
+    if (!param_opt) {
+        LogError << "failed to parse" << VAR(reco_param);
+        return MaaInvalidId;
+    }
+
+    return tasker->post_recognition_on_frame(frame_id, reco_type, *param_opt);
+}
+
 MaaStatus MaaTaskerStatus(const MaaTasker* tasker, MaaTaskId id)
 {
     // LogFunc << VAR_VOIDP(tasker) << VAR(id);
@@ -387,12 +482,12 @@ MaaBool MaaTaskerGetRecognitionDetail(
     }
     CheckNullAndWarn(raw)
     {
-        raw->set(result.raw);
+        raw->set(result.raw.get());
     }
     CheckNullAndWarn(draws)
     {
         for (auto& d : result.draws) {
-            draws->append(MAA_NS::ImageBuffer(d));
+            draws->append(MAA_NS::ImageBuffer(d.get()));
         }
     }
 
@@ -626,3 +721,32 @@ MaaBool MaaTaskerGetLatestNode(const MaaTasker* tasker, const char* node_name, M
 
     return true;
 }
+
+MaaBool MaaTaskerGetLatencyStats(const MaaTasker* tasker, MaaStringBuffer* buffer)
+{
+    if (!tasker) {
+        LogError << "handle is null";
+        return false;
+    }
+
+    if (!buffer) {
+        LogError << "buffer is null";
+        return false;
+    }
+
+    buffer->set(tasker->get_latency_stats().to_string());
+    return true;
+}
+
+MaaBool MaaTaskerClearLatencyStats(MaaTasker* tasker)
+{
+    LogFunc << VAR_VOIDP(tasker);
+
+    if (!tasker) {
+        LogError << "handle is null";
+        return false;
+    }
+
+    tasker->clear_latency_stats();
+    return true;
+}
@@ -93,6 +93,14 @@ public:
     virtual bool touch_move(int contact, int x, int y, int pressure) = 0;
     virtual bool touch_up(int contact) = 0;
 
+    virtual bool touch_trajectory_available() const { return false; }
+
+    virtual bool touch_trajectory(const TouchTrajectory& trajectory)
+    {
+        std::ignore = trajectory;
+        return false;
+    }
+
     virtual bool click_key(int key) = 0;
     virtual bool input_text(const std::string& text) = 0;
 
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <format>
 #include <ranges>
+#include <thread>
 
 #include "MaaUtils/Logger.h"
 #include "MaaUtils/Platform.h"
@@ -281,6 +282,57 @@ bool MtouchHelper::touch_up(int contact)
     return true;
 }
 
+bool MtouchHelper::touch_trajectory(const TouchTrajectory& trajectory)
+{
+    if (!pipe_ios_) {
+        LogError << type_name() << "pipe_ios_ is nullptr";
+        return false;
+    }
+    if (trajectory.empty()) {
+        return true;
+    }
+
+    // 同一时刻的事件合并为一次 commit，事件间隔交给设备端的 w 计时，整条轨迹只写一次管道
+    std::string script;
+    std::chrono::milliseconds cursor = trajectory.front().time;
+
+    for (const TouchEvent& event : trajectory) {
+        if (event.time > cursor) {
+            script += kBatchCommit;
+            script += std::format(kBatchWaitFormat, (event.time - cursor).count());
+            cursor = event.time;
+        }
+
+        switch (event.type) {
+        case TouchEvent::Type::Down: {
+            auto [touch_x, touch_y] = screen_to_touch(event.x, event.y);
+            script += std::format(kBatchDownFormat, event.contact, touch_x, touch_y, event.pressure);
+        } break;
+        case TouchEvent::Type::Move: {
+            auto [touch_x, touch_y] = screen_to_touch(event.x, event.y);
+            script += std::format(kBatchMoveFormat, event.contact, touch_x, touch_y, event.pressure);
+        } break;
+        case TouchEvent::Type::Up:
+            script += std::format(kBatchUpFormat, event.contact);
+            break;
+        }
+    }
+    script += kBatchCommit;
+
+    LogInfo << type_name() << VAR(trajectory.size()) << VAR(trajectory.back().time.count()) << VAR(script.size());
+
+    const auto start = std::chrono::steady_clock::now();
+    if (!pipe_ios_->write(script)) {
+        LogError << type_name() << "failed to write";
+        return false;
+    }
+
+    // 设备端按 w 播放，这里等到轨迹结束，保证调用方看到的仍是同步语义
+    std::this_thread::sleep_until(start + (trajectory.back().time - trajectory.front().time));
+
+    return true;
+}
+
 bool MtouchHelper::parse(const json::value& config)
 {
     return device_info_->parse(config);
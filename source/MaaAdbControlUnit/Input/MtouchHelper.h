@@ -30,6 +30,10 @@ public: // from InputBase
     virtual bool touch_move(int contact, int x, int y, int pressure) override;
     virtual bool touch_up(int contact) override;
 
+    virtual bool touch_trajectory_available() const override { return pipe_ios_ != nullptr; }
+
+    virtual bool touch_trajectory(const TouchTrajectory& trajectory) override;
+
     virtual bool parse(const json::value& config) override;
 
     virtual bool click_key(int key) override;
@@ -56,6 +60,13 @@ protected:
     static constexpr std::string_view kMoveFormat = "m {} {} {} {}\nc\n";
     static constexpr std::string_view kUpFormat = "u {}\nc\n";
 
+    // 轨迹批量写入时使用，不自带 commit；w 由设备端计时
+    static constexpr std::string_view kBatchDownFormat = "d {} {} {} {}\n";
+    static constexpr std::string_view kBatchMoveFormat = "m {} {} {} {}\n";
+    static constexpr std::string_view kBatchUpFormat = "u {}\n";
+    static constexpr std::string_view kBatchCommit = "c\n";
+    static constexpr std::string_view kBatchWaitFormat = "w {}\n";
+
     std::shared_ptr<ChildPipeIOStream> pipe_ios_ = nullptr;
 
     int display_width_ = 0;
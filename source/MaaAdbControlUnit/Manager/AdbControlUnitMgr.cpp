@@ -1,8 +1,10 @@
 #include "AdbControlUnitMgr.h"
 
-#include <meojson/json.hpp>
+#include <format>
 #include <thread>
 
+#include <meojson/json.hpp>
+
 #include "MaaFramework/MaaMsg.h"
 #include "MaaUtils/Logger.h"
 #include "MaaUtils/Platform.h"
@@ -53,6 +55,7 @@ bool AdbControlUnitMgr::connect()
         screencap_ = std::make_shared<ScreencapAgent>(screencap_methods_, agent_path_);
         screencap_->parse(config_);
         screencap_->set_replacement(unit_replacement_);
+        screencap_->set_cache_key(screencap_cache_key());
 
         if (!screencap_->init()) {
             LogError << "failed to init screencap";
@@ -162,6 +165,10 @@ bool AdbControlUnitMgr::screencap(cv::Mat& image)
         }
 
         LogWarn << "screencap failed after retries, force re-connect" << VAR(i);
+        if (screencap_) {
+            // 当前方式已不可用，重连后重新测速
+            screencap_->invalidate_cache();
+        }
         connection_.kill_server();
         if (!connect()) {
             LogError << "re-connect failed" << VAR(i);
@@ -222,6 +229,21 @@ bool AdbControlUnitMgr::touch_up(int contact)
     return input_->touch_up(contact);
 }
 
+bool AdbControlUnitMgr::touch_trajectory_available() const
+{
+    return input_ && input_->touch_trajectory_available();
+}
+
+bool AdbControlUnitMgr::touch_trajectory(const TouchTrajectory& trajectory)
+{
+    if (!input_) {
+        LogError << "input_ is null";
+        return false;
+    }
+
+    return input_->touch_trajectory(trajectory);
+}
+
 bool AdbControlUnitMgr::click_key(int key)
 {
     if (!input_) {
@@ -326,6 +348,25 @@ bool AdbControlUnitMgr::_screencap(cv::Mat& image)
     return true;
 }
 
+std::string AdbControlUnitMgr::screencap_cache_key()
+{
+    auto uuid_opt = device_info_.request_uuid();
+    if (!uuid_opt || uuid_opt->empty()) {
+        LogWarn << "failed to get uuid, screencap method will not be cached";
+        return { };
+    }
+
+    // 同一设备在不同模拟器扩展、不同可选方式下测速结果不同
+    std::string emulator;
+    for (const auto& [name, extra] : config_.get("extras", json::object())) {
+        if (extra.get("enable", false)) {
+            emulator += name + ';';
+        }
+    }
+
+    return std::format("{}|{}|{}", *uuid_opt, emulator, screencap_methods_);
+}
+
 void AdbControlUnitMgr::on_image_resolution_changed(const std::pair<int, int>& pre, const std::pair<int, int>& cur)
 {
     LogFunc;
@@ -15,6 +15,8 @@
 
 MAA_CTRL_UNIT_NS_BEGIN
 
+class ScreencapAgent;
+
 class AdbControlUnitMgr
     : public AdbControlUnitAPI
     , public Dispatcher<ControlUnitSink>
@@ -64,8 +66,12 @@ public:
     virtual bool
         shell(const std::string& cmd, std::string& output, std::chrono::milliseconds timeout = std::chrono::milliseconds(20000)) override;
 
+    virtual bool touch_trajectory_available() const override;
+    virtual bool touch_trajectory(const TouchTrajectory& trajectory) override;
+
 private:
     bool _screencap(/*out*/ cv::Mat& image);
+    std::string screencap_cache_key();
     void on_image_resolution_changed(const std::pair<int, int>& pre, const std::pair<int, int>& cur);
     void on_app_started(const std::string& intent);
     void on_app_stopped(const std::string& intent);
@@ -86,7 +92,7 @@ private:
     AdbCommand adb_command_;
 
     std::shared_ptr<InputBase> input_ = nullptr;
-    std::shared_ptr<ScreencapBase> screencap_ = nullptr;
+    std::shared_ptr<ScreencapAgent> screencap_ = nullptr;
 
     bool screencap_available_ = false;
     std::pair<int, int> image_resolution_;
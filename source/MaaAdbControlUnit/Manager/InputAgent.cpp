@@ -186,6 +186,21 @@ bool InputAgent::touch_up(int contact)
     return active_unit_->touch_up(contact);
 }
 
+bool InputAgent::touch_trajectory_available() const
+{
+    return active_unit_ && active_unit_->touch_trajectory_available();
+}
+
+bool InputAgent::touch_trajectory(const TouchTrajectory& trajectory)
+{
+    if (!active_unit_) {
+        LogError << "No available input method" << VAR(active_unit_);
+        return false;
+    }
+
+    return active_unit_->touch_trajectory(trajectory);
+}
+
 bool InputAgent::click_key(int key)
 {
     if (!active_unit_) {
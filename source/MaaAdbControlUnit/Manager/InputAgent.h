@@ -38,6 +38,9 @@ public: // from InputBase
     virtual bool touch_move(int contact, int x, int y, int pressure) override;
     virtual bool touch_up(int contact) override;
 
+    virtual bool touch_trajectory_available() const override;
+    virtual bool touch_trajectory(const TouchTrajectory& trajectory) override;
+
     virtual bool click_key(int key) override;
     virtual bool input_text(const std::string& text) override;
 
@@ -1,7 +1,10 @@
 #include "ScreencapAgent.h"
 
+#include <array>
 #include <format>
+#include <map>
 #include <ranges>
+#include <thread>
 #include <unordered_set>
 
 #include "EmulatorExtras/AVDExtras.h"
@@ -10,6 +13,7 @@
 #include "EmulatorExtras/MuMuPlayerExtras.h"
 #include "MaaUtils/Logger.h"
 #include "MaaUtils/NoWarningCV.hpp"
+#include "MaaUtils/Platform.h"
 #include "Screencap/Encode.h"
 #include "Screencap/EncodeToFile.h"
 #include "Screencap/Minicap/MinicapDirect.h"
@@ -19,6 +23,43 @@
 
 MAA_CTRL_UNIT_NS_BEGIN
 
+namespace
+{
+
+using Method = ScreencapAgent::Method;
+
+// 持久化时按名称保存，枚举顺序变化不影响已有缓存
+constexpr std::array<std::pair<Method, std::string_view>, 10> kMethodNames = { {
+    { Method::EncodeToFileAndPull, "EncodeToFileAndPull" },
+    { Method::Encode, "Encode" },
+    { Method::RawWithGzip, "RawWithGzip" },
+    { Method::RawByNetcat, "RawByNetcat" },
+    { Method::MinicapDirect, "MinicapDirect" },
+    { Method::MinicapStream, "MinicapStream" },
+    { Method::MuMuPlayerExtras, "MuMuPlayerExtras" },
+    { Method::LDPlayerExtras, "LDPlayerExtras" },
+    { Method::AVDExtras, "AVDExtras" },
+    { Method::AndrowsExtras, "AndrowsExtras" },
+} };
+
+std::string_view method_name(Method method)
+{
+    auto it = std::ranges::find(kMethodNames, method, &std::pair<Method, std::string_view>::first);
+    return it == kMethodNames.end() ? std::string_view { } : it->second;
+}
+
+std::optional<Method> method_from_name(std::string_view name)
+{
+    auto it = std::ranges::find(kMethodNames, name, &std::pair<Method, std::string_view>::second);
+    return it == kMethodNames.end() ? std::nullopt : std::optional<Method>(it->first);
+}
+
+// RawByNetcat 第一次速度很慢，但后面快
+// MinicapStream 是从缓存拉数据，只取一次不准
+const std::unordered_set<Method> kDropFirst = { Method::RawByNetcat, Method::MinicapStream };
+
+} // namespace
+
 ScreencapAgent::ScreencapAgent(MaaAdbScreencapMethod methods, const std::filesystem::path& agent_path)
 {
     std::unordered_set<Method> method_set;
@@ -121,6 +162,9 @@ ScreencapAgent::ScreencapAgent(MaaAdbScreencapMethod methods, const std::filesys
 
 bool ScreencapAgent::parse(const json::value& config)
 {
+    cache_path_ = MAA_NS::path(config.get("screencap", "cache", std::string()));
+    force_benchmark_ = config.get("screencap", "benchmark", false);
+
     bool ret = false;
 
     for (auto it = units_.begin(); it != units_.end();) {
@@ -146,25 +190,41 @@ bool ScreencapAgent::init()
         return false;
     }
 
-    for (auto it = units_.begin(); it != units_.end();) {
-        if (it->second->init()) {
-            ++it;
-        }
-        else {
-            it = units_.erase(it);
-        }
+    auto& cache = ScreencapMethodCache::get_instance();
+    cache.load(cache_path_);
+
+    if (!force_benchmark_) {
+        active_unit_ = try_cached_method();
     }
 
-    active_unit_ = speed_test();
     if (!active_unit_) {
-        LogError << "No available screencap method";
-        return false;
+        init_units();
+
+        ScreencapMethodCache::Entry result;
+        active_unit_ = speed_test(result);
+        if (!active_unit_) {
+            LogError << "No available screencap method";
+            return false;
+        }
+
+        if (!cache_key_.empty()) {
+            cache.put(cache_key_, std::move(result), cache_path_);
+        }
     }
 
     units_.clear();
+    inited_units_.clear();
     return true;
 }
 
+void ScreencapAgent::invalidate_cache()
+{
+    if (cache_key_.empty()) {
+        return;
+    }
+    ScreencapMethodCache::get_instance().invalidate(cache_key_, cache_path_);
+}
+
 std::optional<cv::Mat> ScreencapAgent::screencap()
 {
     if (!active_unit_) {
@@ -205,42 +265,143 @@ void ScreencapAgent::on_app_stopped(const std::string& intent)
     active_unit_->on_app_stopped(intent);
 }
 
-std::shared_ptr<ScreencapBase> ScreencapAgent::speed_test()
+std::shared_ptr<ScreencapBase> ScreencapAgent::try_cached_method()
 {
-    LogFunc;
+    if (cache_key_.empty()) {
+        return nullptr;
+    }
 
-    Method fastest = Method::UnknownYet;
-    std::chrono::milliseconds cost(INT64_MAX);
+    auto& cache = ScreencapMethodCache::get_instance();
+    auto entry_opt = cache.get(cache_key_);
+    if (!entry_opt) {
+        return nullptr;
+    }
+    const auto& entry = *entry_opt;
 
-    auto check = [&fastest, &cost](Method method, std::chrono::steady_clock::time_point start) {
-        auto duration = duration_since(start);
-        if (duration < cost) {
-            fastest = method;
-            cost = duration;
+    auto method_opt = method_from_name(entry.method);
+    auto it = method_opt ? units_.find(*method_opt) : units_.end();
+    if (it == units_.end()) {
+        LogWarn << "cached method is not available" << VAR(cache_key_) << VAR(entry);
+        cache.invalidate(cache_key_, cache_path_);
+        return nullptr;
+    }
+
+    // 只初始化缓存的方式，截一张图确认仍然可用，且分辨率（允许旋转）没有变化
+    auto [method, unit] = *it;
+    auto start_time = std::chrono::steady_clock::now();
+
+    if (!unit->init()) {
+        LogWarn << "cached method failed to init, benchmark again" << VAR(cache_key_) << VAR(entry);
+        cache.invalidate(cache_key_, cache_path_);
+        units_.erase(it);
+        return nullptr;
+    }
+    // 已经初始化成功，无论是否通过校验都保留给测速，只是不再重复初始化
+    inited_units_.emplace(method);
+
+    bool ok = true;
+    if (kDropFirst.contains(method)) {
+        ok = unit->screencap().has_value();
+    }
+    auto image = ok ? unit->screencap() : std::nullopt;
+
+    // 分辨率变化（如切换了模拟器分辨率）只说明缓存的测速结果过期，该方式本身仍可参与测速
+    const bool same_size = image
+                           && ((image->cols == entry.width && image->rows == entry.height)
+                               || (image->cols == entry.height && image->rows == entry.width));
+    if (!same_size) {
+        LogWarn << "cached method failed validation, benchmark again" << VAR(cache_key_) << VAR(entry);
+        cache.invalidate(cache_key_, cache_path_);
+        return nullptr;
+    }
+
+    LogInfo << "reuse cached method" << VAR(entry) << VAR(duration_since(start_time));
+    return unit;
+}
+
+void ScreencapAgent::init_units()
+{
+    LogFunc;
+
+    // 各方式的初始化（推送 minicap、获取 netcat 地址、加载模拟器扩展库等）互不依赖，按组并行；
+    // 两种 minicap 推送同一个文件，模拟器扩展各自加载动态库，组内仍串行
+    auto group_of = [](Method method) {
+        switch (method) {
+        case Method::MinicapDirect:
+        case Method::MinicapStream:
+            return 0;
+        case Method::MuMuPlayerExtras:
+        case Method::LDPlayerExtras:
+        case Method::AVDExtras:
+        case Method::AndrowsExtras:
+            return 1;
+        default:
+            return 2 + static_cast<int>(method);
         }
-        LogInfo << VAR(method) << VAR(duration);
     };
 
-    // RawByNetcat 第一次速度很慢，但后面快
-    // MinicapStream 是从缓存拉数据，只取一次不准
-    static const std::unordered_set<Method> kDropFirst = { Method::RawByNetcat, Method::MinicapStream };
+    std::map<int, std::vector<Method>> groups;
+    std::unordered_map<Method, bool> ready;
+    for (const auto& [method, unit] : units_) {
+        groups[group_of(method)].emplace_back(method);
+        ready.emplace(method, false);
+    }
 
-    for (auto& [method, unit] : units_) {
-        if (kDropFirst.contains(method)) {
-            LogInfo << "Testing" << method << "drop first";
-            if (!unit->screencap()) {
-                LogWarn << "failed to test" << method;
-                continue;
-            }
+    {
+        std::vector<std::jthread> workers;
+        for (const auto& group : groups) {
+            workers.emplace_back([&, &methods = group.second]() {
+                for (Method method : methods) {
+                    if (inited_units_.contains(method)) {
+                        ready.at(method) = true;
+                        continue;
+                    }
+                    auto& unit = units_.at(method);
+                    bool ok = unit->init();
+                    if (ok && kDropFirst.contains(method)) {
+                        LogInfo << "Testing" << method << "drop first";
+                        ok = unit->screencap().has_value();
+                    }
+                    ready.at(method) = ok;
+                }
+            });
         }
+    }
+
+    std::erase_if(units_, [&](const auto& pair) {
+        if (ready.at(pair.first)) {
+            return false;
+        }
+        LogWarn << "failed to init" << pair.first;
+        return true;
+    });
+}
+
+std::shared_ptr<ScreencapBase> ScreencapAgent::speed_test(ScreencapMethodCache::Entry& result)
+{
+    LogFunc;
+
+    Method fastest = Method::UnknownYet;
+    std::chrono::milliseconds cost(INT64_MAX);
+    cv::Size size;
 
+    // 各方式都要占用设备截图，同时截图会互相拖慢，测速本身仍逐个进行
+    for (auto& [method, unit] : units_) {
         LogInfo << "Testing" << method;
         auto now = std::chrono::steady_clock::now();
-        if (!unit->screencap()) {
+        auto image = unit->screencap();
+        if (!image) {
             LogWarn << "failed to test" << method;
             continue;
         }
-        check(method, now);
+
+        auto duration = duration_since(now);
+        if (duration < cost) {
+            fastest = method;
+            cost = duration;
+            size = image->size();
+        }
+        LogInfo << VAR(method) << VAR(duration);
     }
 
     if (fastest == Method::UnknownYet) {
@@ -249,6 +410,13 @@ std::shared_ptr<ScreencapBase> ScreencapAgent::speed_test()
     }
 
     LogInfo << "The fastest method is" << fastest << VAR(cost);
+
+    result = ScreencapMethodCache::Entry {
+        .method = std::string(method_name(fastest)),
+        .cost = cost.count(),
+        .width = size.width,
+        .height = size.height,
+    };
     return units_[fastest];
 }
 
@@ -3,6 +3,7 @@
 #include <unordered_set>
 
 #include "Base/UnitBase.h"
+#include "ScreencapMethodCache.h"
 
 #include "Common/Conf.h"
 
@@ -38,16 +39,31 @@ public: // from ScreencapBase
 
     virtual std::optional<cv::Mat> screencap() override;
 
+public:
+    // 设置后 init 优先复用该设备上次测速选出的方式；为空则每次都测速
+    void set_cache_key(std::string key) { cache_key_ = std::move(key); }
+
+    // 当前方式截图失败时调用，下次 init 重新测速
+    void invalidate_cache();
+
 public: // from ControlUnitSink
     virtual void on_image_resolution_changed(const std::pair<int, int>& pre, const std::pair<int, int>& cur) override;
     virtual void on_app_started(const std::string& intent) override;
     virtual void on_app_stopped(const std::string& intent) override;
 
 private:
-    std::shared_ptr<ScreencapBase> speed_test();
+    std::shared_ptr<ScreencapBase> try_cached_method();
+    void init_units();
+    std::shared_ptr<ScreencapBase> speed_test(/*out*/ ScreencapMethodCache::Entry& result);
 
     std::unordered_map<Method, std::shared_ptr<ScreencapBase>> units_;
+    // 复用缓存时已初始化过、但没通过校验的方式，测速时不再重复初始化
+    std::unordered_set<Method> inited_units_;
     std::shared_ptr<ScreencapBase> active_unit_;
+
+    std::string cache_key_;
+    std::filesystem::path cache_path_;
+    bool force_benchmark_ = false;
 };
 
 MAA_CTRL_UNIT_NS_END
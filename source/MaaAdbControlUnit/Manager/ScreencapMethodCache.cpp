@@ -0,0 +1,87 @@
+#include "ScreencapMethodCache.h"
+
+#include <fstream>
+
+#include "MaaUtils/Logger.h"
+
+MAA_CTRL_UNIT_NS_BEGIN
+
+void ScreencapMethodCache::load(const std::filesystem::path& path)
+{
+    if (path.empty()) {
+        return;
+    }
+
+    std::unique_lock lock(mutex_);
+
+    if (!loaded_paths_.emplace(path).second || !std::filesystem::exists(path)) {
+        return;
+    }
+
+    auto json_opt = json::open(path, true, true);
+    if (!json_opt || !json_opt->is<std::unordered_map<std::string, Entry>>()) {
+        LogWarn << "invalid screencap method cache, ignored" << VAR(path);
+        return;
+    }
+
+    // 内存中已有的结果更新，不被文件覆盖
+    for (auto& [key, entry] : json_opt->as<std::unordered_map<std::string, Entry>>()) {
+        entries_.try_emplace(key, std::move(entry));
+    }
+    LogInfo << VAR(path) << VAR(entries_.size());
+}
+
+std::optional<ScreencapMethodCache::Entry> ScreencapMethodCache::get(const std::string& key) const
+{
+    std::unique_lock lock(mutex_);
+
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void ScreencapMethodCache::put(const std::string& key, Entry entry, const std::filesystem::path& path)
+{
+    LogInfo << VAR(key) << VAR(entry);
+
+    std::unique_lock lock(mutex_);
+    entries_.insert_or_assign(key, std::move(entry));
+    save(path);
+}
+
+void ScreencapMethodCache::invalidate(const std::string& key, const std::filesystem::path& path)
+{
+    LogInfo << VAR(key);
+
+    std::unique_lock lock(mutex_);
+    if (entries_.erase(key) > 0) {
+        save(path);
+    }
+}
+
+void ScreencapMethodCache::save(const std::filesystem::path& path) const
+{
+    if (path.empty()) {
+        return;
+    }
+
+    if (path.has_parent_path()) {
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+        if (ec) {
+            LogError << "Failed to create cache directory" << path.parent_path() << VAR(ec.message());
+            return;
+        }
+    }
+
+    std::ofstream ofs(path, std::ios::out | std::ios::trunc);
+    if (!ofs.is_open()) {
+        LogError << "Failed to open cache file" << path;
+        return;
+    }
+    ofs << json::value(entries_);
+}
+
+MAA_CTRL_UNIT_NS_END
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include <meojson/json.hpp>
+
+#include "MaaUtils/SingletonHolder.hpp"
+
+#include "Common/Conf.h"
+
+MAA_CTRL_UNIT_NS_BEGIN
+
+// 记录每台设备测速选出的截图方式，重连时直接复用，免去逐个初始化、逐个截图的测速。
+// 键由调用方拼出（设备 uuid、模拟器类型、可选的截图方式），进程内共享；指定了文件时同时持久化
+class ScreencapMethodCache : public SingletonHolder<ScreencapMethodCache>
+{
+    friend class SingletonHolder<ScreencapMethodCache>;
+
+public:
+    struct Entry
+    {
+        std::string method;
+        int64_t cost = 0; // ms
+        int width = 0;
+        int height = 0;
+
+        MEO_JSONIZATION(method, cost, width, height);
+    };
+
+public:
+    virtual ~ScreencapMethodCache() = default;
+
+    // 每个文件只在首次用到时读取一次
+    void load(const std::filesystem::path& path);
+
+    std::optional<Entry> get(const std::string& key) const;
+    void put(const std::string& key, Entry entry, const std::filesystem::path& path);
+    void invalidate(const std::string& key, const std::filesystem::path& path);
+
+private:
+    ScreencapMethodCache() = default;
+
+    void save(const std::filesystem::path& path) const;
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::set<std::filesystem::path> loaded_paths_;
+};
+
+MAA_CTRL_UNIT_NS_END
@@ -59,7 +59,8 @@ std::optional<cv::Mat> MinicapStream::screencap()
     using namespace std::chrono_literals;
     cond_.wait_for(locker, 2s); // 等下一帧
 
-    return image_.empty() ? std::nullopt : std::make_optional(image_.clone());
+    // image_ 每帧整体替换，不会原地修改，共享即可
+    return image_.empty() ? std::nullopt : std::make_optional(image_);
 }
 
 std::optional<std::string> MinicapStream::read_exact(size_t count)
@@ -30,6 +30,20 @@ MaaAgentClient* MaaAgentClientCreateTcp(uint16_t port)
     return client;
 }
 
+MaaAgentClient* MaaAgentClientCreateTcpV2(uint16_t port, const char* transport_options)
+{
+    LogFunc << VAR(port) << VAR(transport_options);
+
+    auto* client = new MAA_AGENT_CLIENT_NS::AgentClient();
+    if (!client->set_transport_options(transport_options ? transport_options : "")) {
+        delete client;
+        return nullptr;
+    }
+    client->create_tcp_socket(port);
+
+    return client;
+}
+
 void MaaAgentClientDestroy(MaaAgentClient* client)
 {
     LogFunc << VAR_VOIDP(client);
@@ -182,6 +196,24 @@ MaaBool MaaAgentClientSetTimeout(MaaAgentClient* client, int64_t milliseconds)
     return true;
 }
 
+MaaBool MaaAgentClientProbeLatency(MaaAgentClient* client, MaaSize count, MaaStringBuffer* stats)
+{
+    LogFunc << VAR_VOIDP(client) << VAR(count) << VAR_VOIDP(stats);
+
+    if (!client || !stats) {
+        LogError << "handle is null";
+        return false;
+    }
+
+    auto result_opt = client->probe_latency(count);
+    if (!result_opt) {
+        return false;
+    }
+
+    stats->set(json::value(*std::move(result_opt)).dumps());
+    return true;
+}
+
 MaaBool MaaAgentClientGetCustomRecognitionList(MaaAgentClient* client, /* out */ MaaStringListBuffer* buffer)
 {
     LogFunc << VAR_VOIDP(client) << VAR_VOIDP(buffer);
@@ -1,5 +1,13 @@
 #include "AgentClient.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
 #include <meojson/json.hpp>
 
 #include "Common/MaaTypes.h"
@@ -46,6 +54,10 @@ AgentClient::~AgentClient()
     clear_controller_sink();
     clear_resource_sink();
     clear_tasker_sink();
+
+    // 转发线程可能正等着对端确认，先停掉 io 让它返回
+    stop_io();
+    stop_event_forwarding();
 }
 
 std::string AgentClient::identifier() const
@@ -108,6 +120,8 @@ void AgentClient::register_tasker_sink(MaaTasker* tasker)
     reg_tasker_sink_id_ = tasker->add_sink(&AgentClient::tasker_event_sink, this);
     reg_context_sink_id_ = tasker->add_context_sink(&AgentClient::ctx_event_sink, this);
     reg_tasker_ = tasker;
+
+    apply_tasker_sink_subscription();
 }
 
 std::string AgentClient::create_socket(const std::string& identifier)
@@ -138,6 +152,25 @@ std::string AgentClient::create_socket(const std::string& identifier)
     return identifier_;
 }
 
+bool AgentClient::set_transport_options(const std::string& options_json)
+{
+    LogFunc << VAR(options_json);
+
+    if (!identifier_.empty()) {
+        LogError << "socket already created, transport options must be set before" << VAR(identifier_);
+        return false;
+    }
+
+    auto options_opt = parse_transport_options(options_json);
+    if (!options_opt) {
+        LogError << "invalid transport options" << VAR(options_json);
+        return false;
+    }
+
+    Transceiver::set_transport_options(*std::move(options_opt));
+    return true;
+}
+
 std::string AgentClient::create_tcp_socket(uint16_t port)
 {
     LogFunc << VAR(port);
@@ -166,7 +199,9 @@ bool AgentClient::connect()
 
     clear_custom_registration();
 
-    auto resp_opt = send_and_recv<StartUpResponse>(StartUpRequest { });
+    // 握手总是用 json，对端同意后再切换到二进制编码
+    set_wire_format(WireFormat::Json);
+    auto resp_opt = send_and_recv<StartUpResponse>(StartUpRequest { .wire_formats = { kBinaryWireFormatName } });
 
     if (!resp_opt) {
         LogError << "failed to send_and_recv";
@@ -182,10 +217,20 @@ bool AgentClient::connect()
         return false;
     }
 
+    set_wire_format(resp.wire_format == kBinaryWireFormatName ? WireFormat::Binary : WireFormat::Json);
+
+    event_filter_ = resp.event_filter;
+    apply_tasker_sink_subscription();
+    start_event_forwarding();
+
     for (const auto& reco : resp.recognitions) {
         LogInfo << "register recognition" << VAR(reco);
         bound_res_->register_custom_recognition(reco, reco_agent, this);
     }
+    for (const auto& reco : resp.batch_recognitions) {
+        LogInfo << "register batch recognition" << VAR(reco);
+        bound_res_->register_custom_recognition_batch(reco, reco_batch_agent, this);
+    }
     for (const auto& act : resp.actions) {
         LogInfo << "register action" << VAR(act);
         bound_res_->register_custom_action(act, action_agent, this);
@@ -206,6 +251,7 @@ bool AgentClient::disconnect()
     clear_controller_sink();
     clear_resource_sink();
     clear_tasker_sink();
+    stop_event_forwarding();
 
     if (!connected()) {
         return true;
@@ -244,273 +290,162 @@ std::vector<std::string> AgentClient::get_custom_action_list() const
     return registered_actions_;
 }
 
-bool AgentClient::handle_inserted_request(const json::value& j)
+std::optional<json::object> AgentClient::probe_latency(size_t count)
 {
-    // LogFunc << VAR(j) << VAR(ipc_addr_);
+    LogFunc << VAR(count) << VAR(ipc_addr_);
 
-    if (handle_image_header(j)) {
-        return true;
-    }
-    else if (handle_image_encoded_header(j)) {
-        return true;
+    if (count == 0 || !connected() || !alive()) {
+        LogError << "not connected or count is zero" << VAR(count) << VAR(ipc_addr_);
+        return std::nullopt;
     }
 
-    else if (handle_context_run_task(j)) {
-        return true;
-    }
-    else if (handle_context_run_recognition(j)) {
-        return true;
-    }
-    else if (handle_context_run_action(j)) {
-        return true;
-    }
-    else if (handle_context_run_recognition_direct(j)) {
-        return true;
-    }
-    else if (handle_context_run_action_direct(j)) {
-        return true;
-    }
-    else if (handle_context_override_pipeline(j)) {
-        return true;
-    }
-    else if (handle_context_override_next(j)) {
-        return true;
-    }
-    else if (handle_context_override_image(j)) {
-        return true;
-    }
-    else if (handle_context_get_node_data(j)) {
-        return true;
-    }
-    else if (handle_context_clone(j)) {
-        return true;
-    }
-    else if (handle_context_task_id(j)) {
-        return true;
-    }
-    else if (handle_context_tasker(j)) {
-        return true;
-    }
-    else if (handle_context_set_anchor(j)) {
-        return true;
-    }
-    else if (handle_context_get_anchor(j)) {
-        return true;
-    }
-    else if (handle_context_get_hit_count(j)) {
-        return true;
-    }
-    else if (handle_context_clear_hit_count(j)) {
-        return true;
-    }
-    else if (handle_context_wait_freezes(j)) {
-        return true;
-    }
+    std::vector<int64_t> samples;
+    samples.reserve(count);
+    size_t failed = 0;
 
-    else if (handle_tasker_inited(j)) {
-        return true;
-    }
-    else if (handle_tasker_post_task(j)) {
-        return true;
-    }
-    else if (handle_tasker_post_recognition(j)) {
-        return true;
-    }
-    else if (handle_tasker_post_action(j)) {
-        return true;
-    }
-    else if (handle_tasker_status(j)) {
-        return true;
-    }
-    else if (handle_tasker_wait(j)) {
-        return true;
-    }
-    else if (handle_tasker_running(j)) {
-        return true;
-    }
-    else if (handle_tasker_post_stop(j)) {
-        return true;
-    }
-    else if (handle_tasker_stopping(j)) {
-        return true;
-    }
-    else if (handle_tasker_resource(j)) {
-        return true;
-    }
-    else if (handle_tasker_controller(j)) {
-        return true;
-    }
-    else if (handle_tasker_clear_cache(j)) {
-        return true;
-    }
-    else if (handle_tasker_override_pipeline(j)) {
-        return true;
-    }
-    else if (handle_tasker_get_task_detail(j)) {
-        return true;
-    }
-    else if (handle_tasker_get_node_detail(j)) {
-        return true;
-    }
-    else if (handle_tasker_get_reco_result(j)) {
-        return true;
-    }
-    else if (handle_tasker_get_action_result(j)) {
-        return true;
-    }
-    else if (handle_tasker_get_wf_detail(j)) {
-        return true;
-    }
-    else if (handle_tasker_get_latest_node(j)) {
-        return true;
+    for (size_t i = 0; i < count; ++i) {
+        auto start_time = std::chrono::steady_clock::now();
+        if (!send_and_recv<PingResponse>(PingRequest { })) {
+            ++failed;
+            continue;
+        }
+        auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time);
+        samples.emplace_back(cost.count());
     }
 
-    else if (handle_resource_post_bundle(j)) {
-        return true;
-    }
-    else if (handle_resource_post_ocr_model(j)) {
-        return true;
-    }
-    else if (handle_resource_post_pipeline(j)) {
-        return true;
-    }
-    else if (handle_resource_post_image(j)) {
-        return true;
-    }
-    else if (handle_resource_status(j)) {
-        return true;
-    }
-    else if (handle_resource_wait(j)) {
-        return true;
-    }
-    else if (handle_resource_valid(j)) {
-        return true;
-    }
-    else if (handle_resource_running(j)) {
-        return true;
-    }
-    else if (handle_resource_clear(j)) {
-        return true;
-    }
-    else if (handle_resource_override_pipeline(j)) {
-        return true;
-    }
-    else if (handle_resource_override_next(j)) {
-        return true;
-    }
-    else if (handle_resource_override_image(j)) {
-        return true;
-    }
-    else if (handle_resource_get_node_data(j)) {
-        return true;
-    }
-    else if (handle_resource_get_hash(j)) {
-        return true;
-    }
-    else if (handle_resource_get_node_list(j)) {
-        return true;
-    }
-    else if (handle_resource_get_custom_recognition_list(j)) {
-        return true;
-    }
-    else if (handle_resource_get_custom_action_list(j)) {
-        return true;
-    }
-    else if (handle_resource_get_default_recognition_param(j)) {
-        return true;
-    }
-    else if (handle_resource_get_default_action_param(j)) {
-        return true;
+    json::object result {
+        { "count", samples.size() },
+        { "failed", failed },
+    };
+    if (samples.empty()) {
+        LogError << "all probes failed" << VAR(failed);
+        return result;
     }
 
-    else if (handle_controller_post_connection(j)) {
-        return true;
-    }
-    else if (handle_controller_post_click(j)) {
-        return true;
-    }
-    else if (handle_controller_post_swipe(j)) {
-        return true;
-    }
-    else if (handle_controller_post_click_key(j)) {
-        return true;
-    }
-    else if (handle_controller_post_input_text(j)) {
-        return true;
-    }
-    else if (handle_controller_post_start_app(j)) {
-        return true;
-    }
-    else if (handle_controller_post_stop_app(j)) {
-        return true;
-    }
-    else if (handle_controller_post_screencap(j)) {
-        return true;
-    }
-    else if (handle_controller_post_shell(j)) {
-        return true;
-    }
-    else if (handle_controller_post_touch_down(j)) {
-        return true;
-    }
-    else if (handle_controller_post_touch_move(j)) {
-        return true;
-    }
-    else if (handle_controller_post_relative_move(j)) {
-        return true;
-    }
-    else if (handle_controller_post_touch_up(j)) {
-        return true;
-    }
-    else if (handle_controller_post_key_down(j)) {
-        return true;
-    }
-    else if (handle_controller_post_key_up(j)) {
-        return true;
-    }
-    else if (handle_controller_post_scroll(j)) {
-        return true;
-    }
-    else if (handle_controller_post_inactive(j)) {
-        return true;
-    }
-    else if (handle_controller_status(j)) {
-        return true;
-    }
-    else if (handle_controller_wait(j)) {
-        return true;
-    }
-    else if (handle_controller_connected(j)) {
-        return true;
-    }
-    else if (handle_controller_running(j)) {
-        return true;
-    }
-    else if (handle_controller_cached_image(j)) {
-        return true;
-    }
-    else if (handle_controller_get_shell_output(j)) {
-        return true;
-    }
-    else if (handle_controller_get_uuid(j)) {
-        return true;
-    }
-    else if (handle_controller_get_resolution(j)) {
-        return true;
-    }
-    else if (handle_controller_get_info(j)) {
-        return true;
-    }
-    else if (handle_controller_set_option(j)) {
-        return true;
-    }
-    else if (handle_event_response(j)) {
-        return true;
-    }
-    else {
+    std::ranges::sort(samples);
+    // 最近秩法
+    auto percentile = [&](double p) {
+        size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * samples.size()));
+        return samples.at(std::clamp<size_t>(rank, 1, samples.size()) - 1);
+    };
+
+    result["min_us"] = samples.front();
+    result["p50_us"] = percentile(50);
+    result["p90_us"] = percentile(90);
+    result["p99_us"] = percentile(99);
+    result["max_us"] = samples.back();
+    result["mean_us"] = std::accumulate(samples.begin(), samples.end(), int64_t(0)) / static_cast<int64_t>(samples.size());
+
+    LogInfo << VAR(result);
+    return result;
+}
+
+bool AgentClient::handle_inserted_request(const json::value& j)
+{
+    // LogFunc << VAR(j) << VAR(ipc_addr_);
+
+    // 按消息类型名直接查表，不再逐个类型试探
+    using Handler = bool (AgentClient::*)(const json::value&);
+    static const std::unordered_map<std::string_view, Handler> kHandlers = {
+        { "ContextRunTaskReverseRequest", &AgentClient::handle_context_run_task },
+        { "ContextRunRecognitionReverseRequest", &AgentClient::handle_context_run_recognition },
+        { "ContextRunActionReverseRequest", &AgentClient::handle_context_run_action },
+        { "ContextRunRecognitionDirectReverseRequest", &AgentClient::handle_context_run_recognition_direct },
+        { "ContextRunActionDirectReverseRequest", &AgentClient::handle_context_run_action_direct },
+        { "ContextRunRecognitionOnFrameReverseRequest", &AgentClient::handle_context_run_recognition_on_frame },
+        { "ContextOverridePipelineReverseRequest", &AgentClient::handle_context_override_pipeline },
+        { "ContextOverrideNextReverseRequest", &AgentClient::handle_context_override_next },
+        { "ContextOverrideImageReverseRequest", &AgentClient::handle_context_override_image },
+        { "ContextGetNodeDataReverseRequest", &AgentClient::handle_context_get_node_data },
+        { "ContextCloneReverseRequest", &AgentClient::handle_context_clone },
+        { "ContextTaskIdReverseRequest", &AgentClient::handle_context_task_id },
+        { "ContextTaskerReverseRequest", &AgentClient::handle_context_tasker },
+        { "ContextSetAnchorReverseRequest", &AgentClient::handle_context_set_anchor },
+        { "ContextGetAnchorReverseRequest", &AgentClient::handle_context_get_anchor },
+        { "ContextGetHitCountReverseRequest", &AgentClient::handle_context_get_hit_count },
+        { "ContextClearHitCountReverseRequest", &AgentClient::handle_context_clear_hit_count },
+        { "ContextWaitFreezesReverseRequest", &AgentClient::handle_context_wait_freezes },
+
+        { "TaskerInitedReverseRequest", &AgentClient::handle_tasker_inited },
+        { "TaskerPostTaskReverseRequest", &AgentClient::handle_tasker_post_task },
+        { "TaskerPostRecognitionReverseRequest", &AgentClient::handle_tasker_post_recognition },
+        { "TaskerPostActionReverseRequest", &AgentClient::handle_tasker_post_action },
+        { "TaskerRegisterFrameReverseRequest", &AgentClient::handle_tasker_register_frame },
+        { "TaskerUnregisterFrameReverseRequest", &AgentClient::handle_tasker_unregister_frame },
+        { "TaskerPostRecognitionOnFrameReverseRequest", &AgentClient::handle_tasker_post_recognition_on_frame },
+        { "TaskerStatusReverseRequest", &AgentClient::handle_tasker_status },
+        { "TaskerWaitReverseRequest", &AgentClient::handle_tasker_wait },
+        { "TaskerRunningReverseRequest", &AgentClient::handle_tasker_running },
+        { "TaskerPostStopReverseRequest", &AgentClient::handle_tasker_post_stop },
+        { "TaskerStoppingReverseRequest", &AgentClient::handle_tasker_stopping },
+        { "TaskerResourceReverseRequest", &AgentClient::handle_tasker_resource },
+        { "TaskerControllerReverseRequest", &AgentClient::handle_tasker_controller },
+        { "TaskerClearCacheReverseRequest", &AgentClient::handle_tasker_clear_cache },
+        { "TaskerOverridePipelineReverseRequest", &AgentClient::handle_tasker_override_pipeline },
+        { "TaskerGetTaskDetailReverseRequest", &AgentClient::handle_tasker_get_task_detail },
+        { "TaskerGetNodeDetailReverseRequest", &AgentClient::handle_tasker_get_node_detail },
+        { "TaskerGetRecoResultReverseRequest", &AgentClient::handle_tasker_get_reco_result },
+        { "TaskerGetActionResultReverseRequest", &AgentClient::handle_tasker_get_action_result },
+        { "TaskerGetWfDetailReverseRequest", &AgentClient::handle_tasker_get_wf_detail },
+        { "TaskerGetLatestNodeReverseRequest", &AgentClient::handle_tasker_get_latest_node },
+        { "TaskerGetLatencyStatsReverseRequest", &AgentClient::handle_tasker_get_latency_stats },
+        { "TaskerClearLatencyStatsReverseRequest", &AgentClient::handle_tasker_clear_latency_stats },
+
+        { "ResourcePostBundleReverseRequest", &AgentClient::handle_resource_post_bundle },
+        { "ResourcePostOcrModelReverseRequest", &AgentClient::handle_resource_post_ocr_model },
+        { "ResourcePostPipelineReverseRequest", &AgentClient::handle_resource_post_pipeline },
+        { "ResourcePostImageReverseRequest", &AgentClient::handle_resource_post_image },
+        { "ResourceStatusReverseRequest", &AgentClient::handle_resource_status },
+        { "ResourceWaitReverseRequest", &AgentClient::handle_resource_wait },
+        { "ResourceValidReverseRequest", &AgentClient::handle_resource_valid },
+        { "ResourceRunningReverseRequest", &AgentClient::handle_resource_running },
+        { "ResourceClearReverseRequest", &AgentClient::handle_resource_clear },
+        { "ResourceOverridePipelineReverseRequest", &AgentClient::handle_resource_override_pipeline },
+        { "ResourceOverrideNextReverseRequest", &AgentClient::handle_resource_override_next },
+        { "ResourceOverrideImageReverseRequest", &AgentClient::handle_resource_override_image },
+        { "ResourceGetNodeDataReverseRequest", &AgentClient::handle_resource_get_node_data },
+        { "ResourceGetHashReverseRequest", &AgentClient::handle_resource_get_hash },
+        { "ResourceGetNodeListReverseRequest", &AgentClient::handle_resource_get_node_list },
+        { "ResourceGetCustomRecognitionListReverseRequest", &AgentClient::handle_resource_get_custom_recognition_list },
+        { "ResourceGetCustomActionListReverseRequest", &AgentClient::handle_resource_get_custom_action_list },
+        { "ResourceGetDefaultRecognitionParamReverseRequest", &AgentClient::handle_resource_get_default_recognition_param },
+        { "ResourceGetDefaultActionParamReverseRequest", &AgentClient::handle_resource_get_default_action_param },
+
+        { "ControllerPostConnectionReverseRequest", &AgentClient::handle_controller_post_connection },
+        { "ControllerPostClickReverseRequest", &AgentClient::handle_controller_post_click },
+        { "ControllerPostSwipeReverseRequest", &AgentClient::handle_controller_post_swipe },
+        { "ControllerPostClickKeyReverseRequest", &AgentClient::handle_controller_post_click_key },
+        { "ControllerPostInputTextReverseRequest", &AgentClient::handle_controller_post_input_text },
+        { "ControllerPostStartAppReverseRequest", &AgentClient::handle_controller_post_start_app },
+        { "ControllerPostStopAppReverseRequest", &AgentClient::handle_controller_post_stop_app },
+        { "ControllerPostScreencapReverseRequest", &AgentClient::handle_controller_post_screencap },
+        { "ControllerPostShellReverseRequest", &AgentClient::handle_controller_post_shell },
+        { "ControllerPostTouchDownReverseRequest", &AgentClient::handle_controller_post_touch_down },
+        { "ControllerPostTouchMoveReverseRequest", &AgentClient::handle_controller_post_touch_move },
+        { "ControllerPostRelativeMoveReverseRequest", &AgentClient::handle_controller_post_relative_move },
+        { "ControllerPostTouchUpReverseRequest", &AgentClient::handle_controller_post_touch_up },
+        { "ControllerPostKeyDownReverseRequest", &AgentClient::handle_controller_post_key_down },
+        { "ControllerPostKeyUpReverseRequest", &AgentClient::handle_controller_post_key_up },
+        { "ControllerPostScrollReverseRequest", &AgentClient::handle_controller_post_scroll },
+        { "ControllerPostInactiveReverseRequest", &AgentClient::handle_controller_post_inactive },
+        { "ControllerStatusReverseRequest", &AgentClient::handle_controller_status },
+        { "ControllerWaitReverseRequest", &AgentClient::handle_controller_wait },
+        { "ControllerConnectedReverseRequest", &AgentClient::handle_controller_connected },
+        { "ControllerRunningReverseRequest", &AgentClient::handle_controller_running },
+        { "ControllerCachedImageReverseRequest", &AgentClient::handle_controller_cached_image },
+        { "ControllerGetShellOutputReverseRequest", &AgentClient::handle_controller_get_shell_output },
+        { "ControllerGetUuidReverseRequest", &AgentClient::handle_controller_get_uuid },
+        { "ControllerGetResolutionReverseRequest", &AgentClient::handle_controller_get_resolution },
+        { "ControllerGetInfoReverseRequest", &AgentClient::handle_controller_get_info },
+        { "ControllerSetOptionReverseRequest", &AgentClient::handle_controller_set_option },
+    };
+
+    auto it = kHandlers.find(message_type(j));
+    if (it == kHandlers.end() || !(this->*it->second)(j)) {
         LogError << "unexpected msg" << VAR(j) << VAR(ipc_addr_);
         return false;
     }
+    return true;
 }
 
 bool AgentClient::handle_context_run_task(const json::value& j)
@@ -643,6 +578,31 @@ bool AgentClient::handle_context_run_action_direct(const json::value& j)
     return true;
 }
 
+bool AgentClient::handle_context_run_recognition_on_frame(const json::value& j)
+{
+    if (!j.is<ContextRunRecognitionOnFrameReverseRequest>()) {
+        return false;
+    }
+
+    const ContextRunRecognitionOnFrameReverseRequest& req = j.as<ContextRunRecognitionOnFrameReverseRequest>();
+    LogFunc << VAR(req) << VAR(ipc_addr_);
+
+    MaaContext* context = query_context(req.context_id);
+    if (!context) {
+        LogError << "context not found" << VAR(req.context_id);
+        return false;
+    }
+
+    MaaRecoId reco_id = context->run_recognition_on_frame(req.frame_id, req.reco_type, req.reco_param);
+
+    ContextRunRecognitionOnFrameReverseResponse resp {
+        .reco_id = reco_id,
+    };
+    send(resp);
+
+    return true;
+}
+
 bool AgentClient::handle_context_override_pipeline(const json::value& j)
 {
     if (!j.is<ContextOverridePipelineReverseRequest>()) {
@@ -1031,6 +991,75 @@ bool AgentClient::handle_tasker_post_action(const json::value& j)
     return true;
 }
 
+bool AgentClient::handle_tasker_register_frame(const json::value& j)
+{
+    if (!j.is<TaskerRegisterFrameReverseRequest>()) {
+        return false;
+    }
+    const TaskerRegisterFrameReverseRequest& req = j.as<TaskerRegisterFrameReverseRequest>();
+    LogFunc << VAR(req) << VAR(ipc_addr_);
+
+    MaaTasker* tasker = query_tasker(req.tasker_id);
+    if (!tasker) {
+        LogError << "tasker not found" << VAR(req.tasker_id);
+        return false;
+    }
+
+    MaaFrameId frame_id = tasker->register_frame(get_image_cache(req.image));
+
+    TaskerRegisterFrameReverseResponse resp {
+        .frame_id = frame_id,
+    };
+    send(resp);
+    return true;
+}
+
+bool AgentClient::handle_tasker_unregister_frame(const json::value& j)
+{
+    if (!j.is<TaskerUnregisterFrameReverseRequest>()) {
+        return false;
+    }
+    const TaskerUnregisterFrameReverseRequest& req = j.as<TaskerUnregisterFrameReverseRequest>();
+    LogFunc << VAR(req) << VAR(ipc_addr_);
+
+    MaaTasker* tasker = query_tasker(req.tasker_id);
+    if (!tasker) {
+        LogError << "tasker not found" << VAR(req.tasker_id);
+        return false;
+    }
+
+    bool ret = tasker->unregister_frame(req.frame_id);
+
+    TaskerUnregisterFrameReverseResponse resp {
+        .ret = ret,
+    };
+    send(resp);
+    return true;
+}
+
+bool AgentClient::handle_tasker_post_recognition_on_frame(const json::value& j)
+{
+    if (!j.is<TaskerPostRecognitionOnFrameReverseRequest>()) {
+        return false;
+    }
+    const TaskerPostRecognitionOnFrameReverseRequest& req = j.as<TaskerPostRecognitionOnFrameReverseRequest>();
+    LogFunc << VAR(req) << VAR(ipc_addr_);
+
+    MaaTasker* tasker = query_tasker(req.tasker_id);
+    if (!tasker) {
+        LogError << "tasker not found" << VAR(req.tasker_id);
+        return false;
+    }
+
+    MaaTaskId task_id = tasker->post_recognition_on_frame(req.frame_id, req.reco_type, req.reco_param);
+
+    TaskerPostRecognitionOnFrameReverseResponse resp {
+        .task_id = task_id,
+    };
+    send(resp);
+    return true;
+}
+
 bool AgentClient::handle_tasker_status(const json::value& j)
 {
     if (!j.is<TaskerStatusReverseRequest>()) {
@@ -1290,7 +1319,7 @@ bool AgentClient::handle_tasker_get_reco_result(const json::value& j)
         if (draw.empty()) {
             continue;
         }
-        draws.emplace_back(send_image_encoded(draw));
+        draws.emplace_back(send_image_encoded(draw.get()));
     }
 
     TaskerGetRecoResultReverseResponse resp {
@@ -1302,7 +1331,7 @@ bool AgentClient::handle_tasker_get_reco_result(const json::value& j)
         .box = detail.box ? std::array<int32_t, 4> { detail.box->x, detail.box->y, detail.box->width, detail.box->height }
                           : std::array<int32_t, 4> { },
         .detail = detail.detail,
-        .raw = detail.raw.empty() ? std::string() : send_image_encoded(detail.raw),
+        .raw = detail.raw.empty() ? std::string() : send_image_encoded(detail.raw.get()),
         .draws = std::move(draws),
     };
     send(resp);
@@ -1397,6 +1426,49 @@ bool AgentClient::handle_tasker_get_latest_node(const json::value& j)
     return true;
 }
 
+bool AgentClient::handle_tasker_get_latency_stats(const json::value& j)
+{
+    if (!j.is<TaskerGetLatencyStatsReverseRequest>()) {
+        return false;
+    }
+    const TaskerGetLatencyStatsReverseRequest& req = j.as<TaskerGetLatencyStatsReverseRequest>();
+    LogFunc << VAR(req) << VAR(ipc_addr_);
+
+    MaaTasker* tasker = query_tasker(req.tasker_id);
+    if (!tasker) {
+        LogError << "tasker not found" << VAR(req.tasker_id);
+        return false;
+    }
+
+    TaskerGetLatencyStatsReverseResponse resp {
+        .stats = tasker->get_latency_stats(),
+    };
+    send(resp);
+
+    return true;
+}
+
+bool AgentClient::handle_tasker_clear_latency_stats(const json::value& j)
+{
+    if (!j.is<TaskerClearLatencyStatsReverseRequest>()) {
+        return false;
+    }
+    const TaskerClearLatencyStatsReverseRequest& req = j.as<TaskerClearLatencyStatsReverseRequest>();
+    LogFunc << VAR(req) << VAR(ipc_addr_);
+
+    MaaTasker* tasker = query_tasker(req.tasker_id);
+    if (!tasker) {
+        LogError << "tasker not found" << VAR(req.tasker_id);
+        return false;
+    }
+
+    tasker->clear_latency_stats();
+    TaskerClearLatencyStatsReverseResponse resp { };
+    send(resp);
+
+    return true;
+}
+
 bool AgentClient::handle_resource_post_bundle(const json::value& j)
 {
     if (!j.is<ResourcePostBundleReverseRequest>()) {
@@ -2491,17 +2563,6 @@ bool AgentClient::handle_controller_set_option(const json::value& j)
     return true;
 }
 
-// FIXME: 不应该存在这个函数
-// 等 send_and_recv 支持在子线程中使用后，应该删除这个函数
-bool AgentClient::handle_event_response(const json::value& j)
-{
-    if (j.is<ResourceEventResponse>() || j.is<ControllerEventResponse>() || j.is<TaskerEventResponse>()) {
-        LogTrace << "handle event response" << VAR(j);
-        return true;
-    }
-    return false;
-}
-
 MaaBool AgentClient::reco_agent(
     MaaContext* context,
     MaaTaskId task_id,
@@ -2567,6 +2628,56 @@ MaaBool AgentClient::reco_agent(
     return resp.ret;
 }
 
+MaaBool AgentClient::reco_batch_agent(
+    MaaContext* context,
+    MaaTaskId task_id,
+    const char* custom_recognition_name,
+    const char* entries_json,
+    const MaaImageBuffer* image,
+    void* trans_arg,
+    MaaStringBuffer* out_results)
+{
+    LogTrace << VAR_VOIDP(context) << VAR(task_id) << VAR(custom_recognition_name) << VAR(entries_json);
+
+    AgentClient* pthis = reinterpret_cast<AgentClient*>(trans_arg);
+    if (!pthis) {
+        LogError << "pthis is null";
+        return false;
+    }
+
+    if (!image) {
+        LogError << "image is null";
+        return false;
+    }
+
+    if (!pthis->alive()) {
+        LogError << "server is not alive" << VAR(pthis->ipc_addr_);
+        return false;
+    }
+
+    // 整组只传一次图像
+    CustomRecognitionBatchRequest req {
+        .context_id = pthis->context_id(context),
+        .task_id = task_id,
+        .custom_recognition_name = custom_recognition_name,
+        .entries = entries_json,
+        .image = pthis->send_image(image->get()),
+    };
+
+    auto resp_opt = pthis->send_and_recv<CustomRecognitionBatchResponse>(req);
+    if (!resp_opt) {
+        LogError << "failed to send_and_recv" << VAR(req);
+        return false;
+    }
+    const CustomRecognitionBatchResponse& resp = *resp_opt;
+    LogTrace << VAR(resp);
+
+    if (out_results) {
+        out_results->set(resp.results);
+    }
+    return resp.ret;
+}
+
 MaaBool AgentClient::action_agent(
     MaaContext* context,
     MaaTaskId task_id,
@@ -2618,12 +2729,14 @@ std::string AgentClient::context_id(MaaContext* context)
     ss << context;
     std::string id = std::move(ss).str();
 
+    std::unique_lock lock(id_mutex_);
     context_map_.insert_or_assign(id, context);
     return id;
 }
 
 MaaContext* AgentClient::query_context(const std::string& context_id)
 {
+    std::unique_lock lock(id_mutex_);
     auto it = context_map_.find(context_id);
     if (it == context_map_.end()) {
         LogError << "context not found" << VAR(context_id);
@@ -2638,12 +2751,14 @@ std::string AgentClient::tasker_id(MaaTasker* tasker)
     ss << tasker;
     std::string id = std::move(ss).str();
 
+    std::unique_lock lock(id_mutex_);
     tasker_map_.insert_or_assign(id, tasker);
     return id;
 }
 
 MaaTasker* AgentClient::query_tasker(const std::string& tasker_id)
 {
+    std::unique_lock lock(id_mutex_);
     auto it = tasker_map_.find(tasker_id);
     if (it == tasker_map_.end()) {
         LogError << "tasker not found" << VAR(tasker_id);
@@ -2658,12 +2773,14 @@ std::string AgentClient::controller_id(MaaController* controller)
     ss << controller;
     std::string id = std::move(ss).str();
 
+    std::unique_lock lock(id_mutex_);
     controller_map_.insert_or_assign(id, controller);
     return id;
 }
 
 MaaController* AgentClient::query_controller(const std::string& controller_id)
 {
+    std::unique_lock lock(id_mutex_);
     auto it = controller_map_.find(controller_id);
     if (it == controller_map_.end()) {
         LogError << "controller not found" << VAR(controller_id);
@@ -2678,12 +2795,14 @@ std::string AgentClient::resource_id(MaaResource* resource)
     ss << resource;
     std::string id = std::move(ss).str();
 
+    std::unique_lock lock(id_mutex_);
     resource_map_.insert_or_assign(id, resource);
     return id;
 }
 
 MaaResource* AgentClient::query_resource(const std::string& resource_id)
 {
+    std::unique_lock lock(id_mutex_);
     auto it = resource_map_.find(resource_id);
     if (it == resource_map_.end()) {
         LogError << "resource not found" << VAR(resource_id);
@@ -2692,6 +2811,57 @@ MaaResource* AgentClient::query_resource(const std::string& resource_id)
     return it->second;
 }
 
+void AgentClient::start_event_forwarding()
+{
+    auto forwarder = std::make_shared<EventForwarder>(
+        [this](const EventBatchRequest& batch) { return send_and_recv<EventBatchResponse>(batch).has_value(); },
+        event_filter_);
+
+    std::shared_ptr<EventForwarder> previous;
+    {
+        std::unique_lock lock(forwarder_mutex_);
+        previous = std::exchange(forwarder_, std::move(forwarder));
+    }
+    if (previous) {
+        previous->stop();
+    }
+}
+
+void AgentClient::stop_event_forwarding()
+{
+    std::shared_ptr<EventForwarder> forwarder;
+    {
+        std::unique_lock lock(forwarder_mutex_);
+        forwarder = std::exchange(forwarder_, nullptr);
+    }
+    if (forwarder) {
+        forwarder->stop();
+    }
+}
+
+std::shared_ptr<EventForwarder> AgentClient::event_forwarder(std::string_view message)
+{
+    std::unique_lock lock(forwarder_mutex_);
+    if (!forwarder_ || !forwarder_->subscribed(message)) {
+        return nullptr;
+    }
+    return forwarder_;
+}
+
+void AgentClient::apply_tasker_sink_subscription()
+{
+    // tasker 支持按订阅过滤，没人订阅的消息连 details 都不会构造
+    if (!reg_tasker_) {
+        return;
+    }
+    if (reg_tasker_sink_id_ != MaaInvalidId) {
+        reg_tasker_->set_sink_subscription(reg_tasker_sink_id_, event_filter_);
+    }
+    if (reg_context_sink_id_ != MaaInvalidId) {
+        reg_tasker_->set_context_sink_subscription(reg_context_sink_id_, event_filter_);
+    }
+}
+
 void AgentClient::res_event_sink(void* handle, const char* message, const char* details_json, void* trans_arg)
 {
     LogTrace << VAR_VOIDP(handle) << VAR(message) << VAR(details_json) << VAR_VOIDP(trans_arg);
@@ -2712,17 +2882,17 @@ void AgentClient::res_event_sink(void* handle, const char* message, const char*
         return;
     }
 
-    ResourceEventRequest req {
-        .resource_id = pthis->resource_id(reinterpret_cast<MaaResource*>(handle)),
-        .message = message,
-        .details = json::parse(details_json).value_or(json::value { }),
-    };
+    auto forwarder = pthis->event_forwarder(message);
+    if (!forwarder) {
+        return;
+    }
 
-    // FIXME: 应该用 send_and_recv 但是暂时用 send 代替
-    // 由于 sink 在 async_runner 的子线程中的，recv 会被其他线程抢掉。
-    // 一直接收不到 recv 导致卡死在这里
-    // std::ignore = pthis->send_and_recv<ControllerEventResponse>(req);
-    std::ignore = pthis->send(req);
+    forwarder->post(ForwardedEvent {
+        .category = EventCategory::Resource,
+        .handle_id = pthis->resource_id(reinterpret_cast<MaaResource*>(handle)),
+        .message = message,
+        .details = details_json,
+    });
 }
 
 void AgentClient::ctrl_event_sink(void* handle, const char* message, const char* details_json, void* trans_arg)
@@ -2745,17 +2915,17 @@ void AgentClient::ctrl_event_sink(void* handle, const char* message, const char*
         return;
     }
 
-    ControllerEventRequest req {
-        .controller_id = pthis->controller_id(reinterpret_cast<MaaController*>(handle)),
-        .message = message,
-        .details = json::parse(details_json).value_or(json::value { }),
-    };
+    auto forwarder = pthis->event_forwarder(message);
+    if (!forwarder) {
+        return;
+    }
 
-    // FIXME: 应该用 send_and_recv 但是暂时用 send 代替
-    // 由于 sink 在 async_runner 的子线程中的，recv 会被其他线程抢掉。
-    // 一直接收不到 recv 导致卡死在这里
-    // std::ignore = pthis->send_and_recv<ControllerEventResponse>(req);
-    std::ignore = pthis->send(req);
+    forwarder->post(ForwardedEvent {
+        .category = EventCategory::Controller,
+        .handle_id = pthis->controller_id(reinterpret_cast<MaaController*>(handle)),
+        .message = message,
+        .details = details_json,
+    });
 }
 
 void AgentClient::tasker_event_sink(void* handle, const char* message, const char* details_json, void* trans_arg)
@@ -2778,17 +2948,17 @@ void AgentClient::tasker_event_sink(void* handle, const char* message, const cha
         return;
     }
 
-    TaskerEventRequest req {
-        .tasker_id = pthis->tasker_id(reinterpret_cast<MaaTasker*>(handle)),
-        .message = message,
-        .details = json::parse(details_json).value_or(json::value { }),
-    };
+    auto forwarder = pthis->event_forwarder(message);
+    if (!forwarder) {
+        return;
+    }
 
-    // FIXME: 应该用 send_and_recv 但是暂时用 send 代替
-    // 由于 sink 在 async_runner 的子线程中的，recv 会被其他线程抢掉。
-    // 一直接收不到 recv 导致卡死在这里
-    // std::ignore = pthis->send_and_recv<ControllerEventResponse>(req);
-    std::ignore = pthis->send(req);
+    forwarder->post(ForwardedEvent {
+        .category = EventCategory::Tasker,
+        .handle_id = pthis->tasker_id(reinterpret_cast<MaaTasker*>(handle)),
+        .message = message,
+        .details = details_json,
+    });
 }
 
 void AgentClient::ctx_event_sink(void* handle, const char* message, const char* details_json, void* trans_arg)
@@ -2811,13 +2981,31 @@ void AgentClient::ctx_event_sink(void* handle, const char* message, const char*
         return;
     }
 
-    ContextEventRequest req {
-        .context_id = pthis->context_id(reinterpret_cast<MaaContext*>(handle)),
+    auto forwarder = pthis->event_forwarder(message);
+    if (!forwarder) {
+        return;
+    }
+
+    ForwardedEvent event {
+        .category = EventCategory::Context,
+        .handle_id = pthis->context_id(reinterpret_cast<MaaContext*>(handle)),
         .message = message,
-        .details = json::parse(details_json).value_or(json::value { }),
+        .details = details_json,
     };
 
-    std::ignore = pthis->send_and_recv<ContextEventResponse>(req);
+    // 本线程正在处理 agent 的请求（如自定义识别里跑的子任务）时，agent 在等它返回，
+    // 交给转发线程作为顶层请求发出会互相等待，改为在本线程直接作为嵌套请求发出
+    if (pthis->current_inbound_id() != 0) {
+        EventBatchRequest batch;
+        batch.events.emplace_back(std::move(event));
+        if (!pthis->send_and_recv<EventBatchResponse>(batch)) {
+            LogError << "failed to forward context event" << VAR(message);
+        }
+        return;
+    }
+
+    // context 只在本回调期间有效，而 agent 的 sink 可能借它回调过来，所以等对端处理完再返回
+    forwarder->send(std::move(event));
 }
 
 MAA_AGENT_CLIENT_NS_END
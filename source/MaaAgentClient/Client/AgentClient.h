@@ -1,11 +1,15 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string_view>
 
 #include <meojson/json.hpp>
 
 #include "Common/Conf.h"
 #include "Common/MaaTypes.h"
+#include "EventForwarder.h"
 #include "MaaAgent/Transceiver.h"
 
 MAA_AGENT_CLIENT_NS_BEGIN
@@ -26,6 +30,7 @@ public: // MaaAgentClient
     virtual void register_controller_sink(MaaController* ctrl) override;
     virtual void register_tasker_sink(MaaTasker* tasker) override;
     virtual std::string create_socket(const std::string& identifier) override;
+    virtual bool set_transport_options(const std::string& options_json) override;
     virtual std::string create_tcp_socket(uint16_t port) override;
     virtual bool connect() override;
     virtual bool disconnect() override;
@@ -34,6 +39,7 @@ public: // MaaAgentClient
     virtual void set_timeout(const std::chrono::milliseconds& timeout) override;
     virtual std::vector<std::string> get_custom_recognition_list() const override;
     virtual std::vector<std::string> get_custom_action_list() const override;
+    virtual std::optional<json::object> probe_latency(size_t count) override;
 
 private: // Transceiver
     virtual bool handle_inserted_request(const json::value& j) override;
@@ -44,6 +50,7 @@ private:
     bool handle_context_run_action(const json::value& j);
     bool handle_context_run_recognition_direct(const json::value& j);
     bool handle_context_run_action_direct(const json::value& j);
+    bool handle_context_run_recognition_on_frame(const json::value& j);
     bool handle_context_override_pipeline(const json::value& j);
     bool handle_context_override_next(const json::value& j);
     bool handle_context_override_image(const json::value& j);
@@ -61,6 +68,9 @@ private:
     bool handle_tasker_post_task(const json::value& j);
     bool handle_tasker_post_recognition(const json::value& j);
     bool handle_tasker_post_action(const json::value& j);
+    bool handle_tasker_register_frame(const json::value& j);
+    bool handle_tasker_unregister_frame(const json::value& j);
+    bool handle_tasker_post_recognition_on_frame(const json::value& j);
     bool handle_tasker_status(const json::value& j);
     bool handle_tasker_wait(const json::value& j);
     bool handle_tasker_running(const json::value& j);
@@ -76,6 +86,8 @@ private:
     bool handle_tasker_get_action_result(const json::value& j);
     bool handle_tasker_get_wf_detail(const json::value& j);
     bool handle_tasker_get_latest_node(const json::value& j);
+    bool handle_tasker_get_latency_stats(const json::value& j);
+    bool handle_tasker_clear_latency_stats(const json::value& j);
 
     bool handle_resource_post_bundle(const json::value& j);
     bool handle_resource_post_ocr_model(const json::value& j);
@@ -125,8 +137,6 @@ private:
     bool handle_controller_get_info(const json::value& j);
     bool handle_controller_set_option(const json::value& j);
 
-    bool handle_event_response(const json::value& j);
-
 public:
     static MaaBool reco_agent(
         MaaContext* context,
@@ -140,6 +150,15 @@ public:
         /* out */ MaaRect* out_box,
         /* out */ MaaStringBuffer* out_detail);
 
+    static MaaBool reco_batch_agent(
+        MaaContext* context,
+        MaaTaskId task_id,
+        const char* custom_recognition_name,
+        const char* entries_json,
+        const MaaImageBuffer* image,
+        void* trans_arg,
+        /* out */ MaaStringBuffer* out_results);
+
     static MaaBool action_agent(
         MaaContext* context,
         MaaTaskId task_id,
@@ -173,6 +192,13 @@ public:
     static void tasker_event_sink(void* handle, const char* message, const char* details_json, void* trans_arg);
     static void ctx_event_sink(void* handle, const char* message, const char* details_json, void* trans_arg);
 
+private:
+    void start_event_forwarding();
+    void stop_event_forwarding();
+    // 未连接或 agent 未订阅该消息时返回 nullptr
+    std::shared_ptr<EventForwarder> event_forwarder(std::string_view message);
+    void apply_tasker_sink_subscription();
+
 private:
     // for bind_resource
     MaaResource* bound_res_ = nullptr;
@@ -189,6 +215,12 @@ private:
     bool connected_ = false;
     std::string identifier_;
 
+    std::vector<std::string> event_filter_; // agent 在 StartUp 时告知的事件订阅
+    std::mutex forwarder_mutex_;
+    std::shared_ptr<EventForwarder> forwarder_;
+
+    // 多个请求可能在不同线程上同时处理
+    std::mutex id_mutex_;
     std::map<std::string, MaaContext*> context_map_;
     std::map<std::string, MaaTasker*> tasker_map_;
     std::map<std::string, MaaController*> controller_map_;
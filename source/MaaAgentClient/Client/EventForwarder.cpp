@@ -0,0 +1,134 @@
+#include "EventForwarder.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "MaaUtils/Logger.h"
+#include "Utils/EventDispatcher.hpp"
+
+MAA_AGENT_CLIENT_NS_BEGIN
+
+EventForwarder::EventForwarder(BatchSender sender, std::vector<std::string> msg_filter)
+    : sender_(std::move(sender))
+    , msg_filter_(std::move(msg_filter))
+{
+    LogInfo << VAR(msg_filter_);
+
+    thread_ = std::thread(&EventForwarder::forward_loop, this);
+}
+
+EventForwarder::~EventForwarder()
+{
+    stop();
+}
+
+bool EventForwarder::subscribed(std::string_view msg) const
+{
+    return match_msg_filter(msg_filter_, msg);
+}
+
+void EventForwarder::post(ForwardedEvent event)
+{
+    enqueue(std::move(event), true);
+}
+
+void EventForwarder::send(ForwardedEvent event)
+{
+    // 转发线程在等对端确认期间处理对端的嵌套请求，这里再发出的事件若入队就会等自己，改为直接作为嵌套请求发出
+    if (std::this_thread::get_id() == thread_.get_id()) {
+        EventBatchRequest batch;
+        batch.events.emplace_back(std::move(event));
+        if (!sender_(batch)) {
+            LogError << "failed to forward event";
+        }
+        return;
+    }
+
+    const uint64_t seq = enqueue(std::move(event), false);
+
+    std::unique_lock lock(mutex_);
+    delivered_cv_.wait(lock, [&]() { return !running_ || delivered_seq_ >= seq; });
+}
+
+uint64_t EventForwarder::enqueue(ForwardedEvent event, bool droppable)
+{
+    std::unique_lock lock(mutex_);
+
+    if (!running_) {
+        return 0;
+    }
+
+    if (queue_.size() >= kQueueCapacity) {
+        auto it = std::ranges::find_if(queue_, [](const QueuedEvent& queued) { return queued.droppable; });
+        if (it != queue_.end()) {
+            if (dropped_++ % kQueueCapacity == 0) {
+                LogWarn << "agent is slow, dropping oldest events" << VAR(queue_.size()) << VAR(dropped_);
+            }
+            queue_.erase(it);
+        }
+    }
+
+    const uint64_t seq = next_seq_++;
+    queue_.emplace_back(QueuedEvent { .seq = seq, .droppable = droppable, .event = std::move(event) });
+    queue_cv_.notify_one();
+    return seq;
+}
+
+void EventForwarder::stop()
+{
+    {
+        std::unique_lock lock(mutex_);
+        if (!running_ && !thread_.joinable()) {
+            return;
+        }
+        running_ = false;
+        if (!queue_.empty()) {
+            LogWarn << "discard pending events" << VAR(queue_.size());
+            queue_.clear();
+        }
+    }
+    queue_cv_.notify_all();
+    delivered_cv_.notify_all();
+
+    if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) {
+        thread_.join();
+    }
+}
+
+void EventForwarder::forward_loop()
+{
+    LogFunc;
+
+    while (true) {
+        EventBatchRequest batch;
+        uint64_t last_seq = 0;
+        {
+            std::unique_lock lock(mutex_);
+            queue_cv_.wait(lock, [&]() { return !running_ || !queue_.empty(); });
+            if (!running_) {
+                break;
+            }
+
+            const size_t size = std::min(queue_.size(), kMaxBatchSize);
+            batch.events.reserve(size);
+            for (size_t i = 0; i < size; ++i) {
+                batch.events.emplace_back(std::move(queue_.front().event));
+                last_seq = queue_.front().seq;
+                queue_.pop_front();
+            }
+            batch.dropped = std::exchange(dropped_, 0);
+        }
+
+        if (!sender_(batch)) {
+            LogError << "failed to forward events" << VAR(batch.events.size());
+        }
+
+        {
+            std::unique_lock lock(mutex_);
+            delivered_seq_ = last_seq;
+        }
+        delivered_cv_.notify_all();
+    }
+}
+
+MAA_AGENT_CLIENT_NS_END
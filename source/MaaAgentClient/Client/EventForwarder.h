@@ -0,0 +1,70 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Common/Conf.h"
+#include "MaaAgent/Message.hpp"
+#include "MaaUtils/NonCopyable.hpp"
+
+MAA_AGENT_CLIENT_NS_BEGIN
+
+// 框架线程上的 sink 回调只把事件入队，由转发线程合并成批发给 agent。
+// 上一批被确认前新到的事件在队列中积压，下一次一起发出；积压超过上限时丢弃最旧的可丢弃事件
+class EventForwarder : public NonCopyable
+{
+public:
+    // 发送一批并等待对端确认，返回是否成功
+    using BatchSender = std::function<bool(const EventBatchRequest&)>;
+
+    inline static constexpr size_t kQueueCapacity = 1024;
+    inline static constexpr size_t kMaxBatchSize = 256;
+
+public:
+    EventForwarder(BatchSender sender, std::vector<std::string> msg_filter);
+    ~EventForwarder();
+
+    // agent 是否订阅了该消息
+    bool subscribed(std::string_view msg) const;
+
+    // 入队后立即返回，积压时可能被丢弃
+    void post(ForwardedEvent event);
+    // 不会被丢弃，等到对端确认（或转发停止）才返回
+    void send(ForwardedEvent event);
+
+    void stop();
+
+private:
+    struct QueuedEvent
+    {
+        uint64_t seq = 0;
+        bool droppable = true;
+        ForwardedEvent event;
+    };
+
+    uint64_t enqueue(ForwardedEvent event, bool droppable);
+    void forward_loop();
+
+private:
+    const BatchSender sender_;
+    const std::vector<std::string> msg_filter_;
+
+    std::mutex mutex_;
+    std::condition_variable queue_cv_;
+    std::condition_variable delivered_cv_;
+    std::deque<QueuedEvent> queue_;
+    uint64_t next_seq_ = 1;
+    uint64_t delivered_seq_ = 0;
+    uint64_t dropped_ = 0;
+    bool running_ = true;
+
+    std::thread thread_;
+};
+
+MAA_AGENT_CLIENT_NS_END
@@ -1,5 +1,6 @@
 #include "MaaAgentServer/MaaAgentServerAPI.h"
 
+#include "MaaUtils/Buffer/ListBuffer.hpp"
 #include "MaaUtils/Buffer/StringBuffer.hpp"
 #include "MaaUtils/Logger.h"
 #include "Server/AgentServer.h"
@@ -49,6 +50,18 @@ MaaBool MaaAgentServerRegisterCustomRecognition(const char* name, MaaCustomRecog
     return MAA_AGENT_SERVER_NS::AgentServer::get_instance().register_custom_recognition(name, recognition, trans_arg);
 }
 
+MaaBool MaaAgentServerRegisterCustomRecognitionBatch(const char* name, MaaCustomRecognitionBatchCallback recognition, void* trans_arg)
+{
+    LogFunc << VAR(name) << VAR_VOIDP(recognition) << VAR_VOIDP(trans_arg);
+
+    if (!name || !recognition) {
+        LogError << "name or recognition is null";
+        return false;
+    }
+
+    return MAA_AGENT_SERVER_NS::AgentServer::get_instance().register_custom_recognition_batch(name, recognition, trans_arg);
+}
+
 MaaBool MaaAgentServerRegisterCustomAction(const char* name, MaaCustomActionCallback action, void* trans_arg)
 {
     LogFunc << VAR(name) << VAR_VOIDP(action) << VAR_VOIDP(trans_arg);
@@ -108,3 +121,33 @@ MaaSinkId MaaAgentServerAddContextSink(MaaEventCallback sink, void* trans_arg)
 
     return MAA_AGENT_SERVER_NS::AgentServer::get_instance().add_context_sink(sink, trans_arg);
 }
+
+MaaBool MaaAgentServerSetEventSubscription(const MaaStringListBuffer* msg_filter)
+{
+    LogFunc << VAR_VOIDP(msg_filter);
+
+    std::vector<std::string> filter;
+    if (msg_filter) {
+        size_t size = msg_filter->size();
+        for (size_t i = 0; i < size; ++i) {
+            filter.emplace_back(msg_filter->at(i).get());
+        }
+    }
+
+    MAA_AGENT_SERVER_NS::AgentServer::get_instance().set_event_subscription(std::move(filter));
+    return true;
+}
+
+MaaBool MaaAgentServerSetConcurrency(MaaSize concurrency)
+{
+    LogFunc << VAR(concurrency);
+
+    return MAA_AGENT_SERVER_NS::AgentServer::get_instance().set_concurrency(concurrency);
+}
+
+MaaBool MaaAgentServerSetTransportOptions(const char* options_json)
+{
+    LogFunc << VAR(options_json);
+
+    return MAA_AGENT_SERVER_NS::AgentServer::get_instance().set_transport_options(options_json ? options_json : "");
+}
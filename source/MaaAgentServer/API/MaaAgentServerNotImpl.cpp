@@ -96,6 +96,12 @@ void MaaResourceDestroy(MaaResource*)
     LogError << "MaaAgentServer Not implement this API, Please use MaaFramework";
 }
 
+MaaBool MaaResourceCompileBundle(const char*, const char*)
+{
+    LogError << "MaaAgentServer Not implement this API, Please use MaaFramework";
+    return false;
+}
+
 MaaTasker* MaaTaskerCreate()
 {
     LogError << "MaaAgentServer Not implement this API, Please use MaaFramework";
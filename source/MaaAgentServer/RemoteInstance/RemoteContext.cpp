@@ -101,6 +101,22 @@ MaaActId RemoteContext::run_action_direct(
     return resp_opt->action_id;
 }
 
+MaaRecoId RemoteContext::run_recognition_on_frame(MaaFrameId frame_id, const std::string& reco_type, const json::value& reco_param)
+{
+    ContextRunRecognitionOnFrameReverseRequest req {
+        .context_id = context_id_,
+        .frame_id = frame_id,
+        .reco_type = reco_type,
+        .reco_param = reco_param,
+    };
+
+    auto resp_opt = server_.send_and_recv<ContextRunRecognitionOnFrameReverseResponse>(req);
+    if (!resp_opt) {
+        return MaaInvalidId;
+    }
+    return resp_opt->reco_id;
+}
+
 bool RemoteContext::override_pipeline(const json::value& pipeline_override)
 {
     ContextOverridePipelineReverseRequest req {
@@ -197,6 +197,11 @@ void RemoteResource::register_custom_recognition(const std::string& name, MaaCus
     LogError << "Can NOT register custom recognition at remote resource" << VAR(name) << VAR_VOIDP(recognition) << VAR_VOIDP(trans_arg);
 }
 
+void RemoteResource::register_custom_recognition_batch(const std::string& name, MaaCustomRecognitionBatchCallback recognition, void* trans_arg)
+{
+    LogError << "Can NOT register custom recognition at remote resource" << VAR(name) << VAR_VOIDP(recognition) << VAR_VOIDP(trans_arg);
+}
+
 void RemoteResource::unregister_custom_recognition(const std::string& name)
 {
     LogError << "Can NOT unregister custom recognition at remote resource" << VAR(name);
@@ -270,6 +275,12 @@ std::vector<std::string> RemoteResource::get_custom_action_list() const
     return resp_opt->custom_action_list;
 }
 
+std::string RemoteResource::get_template_cache_stats() const
+{
+    LogError << "Can NOT get template cache stats at remote resource";
+    return { };
+}
+
 std::optional<json::object> RemoteResource::get_default_recognition_param(const std::string& reco_type) const
 {
     ResourceGetDefaultRecognitionParamReverseRequest req {
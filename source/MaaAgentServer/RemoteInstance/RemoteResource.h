@@ -32,6 +32,8 @@ public:
     virtual std::optional<json::object> get_node_data(const std::string& node_name) const override;
 
     virtual void register_custom_recognition(const std::string& name, MaaCustomRecognitionCallback recognition, void* trans_arg) override;
+    virtual void
+        register_custom_recognition_batch(const std::string& name, MaaCustomRecognitionBatchCallback recognition, void* trans_arg) override;
     virtual void unregister_custom_recognition(const std::string& name) override;
     virtual void clear_custom_recognition() override;
     virtual void register_custom_action(const std::string& name, MaaCustomActionCallback action, void* trans_arg) override;
@@ -42,6 +44,7 @@ public:
     virtual std::vector<std::string> get_node_list() const override;
     virtual std::vector<std::string> get_custom_recognition_list() const override;
     virtual std::vector<std::string> get_custom_action_list() const override;
+    virtual std::string get_template_cache_stats() const override;
 
     virtual std::optional<json::object> get_default_recognition_param(const std::string& reco_type) const override;
     virtual std::optional<json::object> get_default_action_param(const std::string& action_type) const override;
@@ -99,6 +99,53 @@ MaaTaskId RemoteTasker::post_action(
     return resp_opt->task_id;
 }
 
+MaaFrameId RemoteTasker::register_frame(const cv::Mat& image)
+{
+    TaskerRegisterFrameReverseRequest req {
+        .tasker_id = tasker_id_,
+        .image = server_.send_image(image),
+    };
+
+    auto resp_opt = server_.send_and_recv<TaskerRegisterFrameReverseResponse>(req);
+    if (!resp_opt) {
+        return MaaInvalidId;
+    }
+
+    return resp_opt->frame_id;
+}
+
+bool RemoteTasker::unregister_frame(MaaFrameId frame_id)
+{
+    TaskerUnregisterFrameReverseRequest req {
+        .tasker_id = tasker_id_,
+        .frame_id = frame_id,
+    };
+
+    auto resp_opt = server_.send_and_recv<TaskerUnregisterFrameReverseResponse>(req);
+    if (!resp_opt) {
+        return false;
+    }
+
+    return resp_opt->ret;
+}
+
+MaaTaskId RemoteTasker::post_recognition_on_frame(MaaFrameId frame_id, const std::string& reco_type, const json::value& reco_param)
+{
+    TaskerPostRecognitionOnFrameReverseRequest req {
+        .tasker_id = tasker_id_,
+        .frame_id = frame_id,
+        .reco_type = reco_type,
+        .reco_param = reco_param,
+    };
+
+    auto resp_opt = server_.send_and_recv<TaskerPostRecognitionOnFrameReverseResponse>(req);
+    if (!resp_opt) {
+        return MaaInvalidId;
+    }
+
+    return resp_opt->task_id;
+}
+
 MaaStatus RemoteTasker::status(MaaTaskId task_id) const
 {
     TaskerStatusReverseRequest req {
@@ -371,6 +418,26 @@ std::optional<MaaNodeId> RemoteTasker::get_latest_node(const std::string& node_n
     return resp_opt->latest_id;
 }
 
+json::object RemoteTasker::get_latency_stats() const
+{
+    TaskerGetLatencyStatsReverseRequest req {
+        .tasker_id = tasker_id_,
+    };
+    auto resp_opt = server_.send_and_recv<TaskerGetLatencyStatsReverseResponse>(req);
+    if (!resp_opt || !resp_opt->stats.is_object()) {
+        return { };
+    }
+    return resp_opt->stats.as_object();
+}
+
+void RemoteTasker::clear_latency_stats()
+{
+    TaskerClearLatencyStatsReverseRequest req {
+        .tasker_id = tasker_id_,
+    };
+    server_.send_and_recv<TaskerClearLatencyStatsReverseResponse>(req);
+}
+
 MaaSinkId RemoteTasker::add_sink(MaaEventCallback callback, void* trans_arg)
 {
     LogError << "Can NOT add sink for remote instance, use AgentServer.add_tasker_sink instead" << VAR_VOIDP(callback)
@@ -405,4 +472,16 @@ void RemoteTasker::clear_context_sinks()
     LogError << "Can NOT clear sink for remote instance";
 }
 
+bool RemoteTasker::set_sink_subscription(MaaSinkId sink_id, std::vector<std::string> msg_filter)
+{
+    LogError << "Can NOT set sink subscription for remote instance" << VAR(sink_id) << VAR(msg_filter);
+    return false;
+}
+
+bool RemoteTasker::set_context_sink_subscription(MaaSinkId sink_id, std::vector<std::string> msg_filter)
+{
+    LogError << "Can NOT set sink subscription for remote instance" << VAR(sink_id) << VAR(msg_filter);
+    return false;
+}
+
 MAA_AGENT_SERVER_NS_END
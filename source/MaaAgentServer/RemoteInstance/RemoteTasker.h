@@ -29,6 +29,11 @@ public:
         post_action(const std::string& action_type, const json::value& action_param, const cv::Rect& box, const std::string& reco_detail)
             override;
 
+    virtual MaaFrameId register_frame(const cv::Mat& image) override;
+    virtual bool unregister_frame(MaaFrameId frame_id) override;
+    virtual MaaTaskId
+        post_recognition_on_frame(MaaFrameId frame_id, const std::string& reco_type, const json::value& reco_param) override;
+
     virtual bool override_pipeline(MaaTaskId task_id, const json::value& pipeline_override) override;
 
     virtual MaaStatus status(MaaTaskId task_id) const override;
@@ -49,6 +54,9 @@ public:
     virtual std::optional<MAA_TASK_NS::WaitFreezesDetail> get_wf_detail(MaaWfId wf_id) const override;
     virtual std::optional<MaaNodeId> get_latest_node(const std::string& node_name) const override;
 
+    virtual json::object get_latency_stats() const override;
+    virtual void clear_latency_stats() override;
+
     virtual MaaSinkId add_sink(MaaEventCallback callback, void* trans_arg) override;
     virtual void remove_sink(MaaSinkId sink_id) override;
     virtual void clear_sinks() override;
@@ -57,6 +65,9 @@ public:
     virtual void remove_context_sink(MaaSinkId sink_id) override;
     virtual void clear_context_sinks() override;
 
+    virtual bool set_sink_subscription(MaaSinkId sink_id, std::vector<std::string> msg_filter) override;
+    virtual bool set_context_sink_subscription(MaaSinkId sink_id, std::vector<std::string> msg_filter) override;
+
 private:
     Transceiver& server_;
     std::string tasker_id_;
@@ -1,5 +1,6 @@
 #include "AgentServer.h"
 
+#include <algorithm>
 #include <ranges>
 
 #include "MaaAgent/Message.hpp"
@@ -30,6 +31,7 @@ bool AgentServer::start_up(const std::string& identifier)
         init_socket(identifier, false);
     }
 
+    workers_ = std::make_unique<RequestWorkers>(concurrency_);
     msg_loop_running_ = true;
     msg_thread_ = std::thread(&AgentServer::request_msg_loop, this);
     if (!msg_thread_.joinable()) {
@@ -46,6 +48,9 @@ void AgentServer::shut_down()
 
     msg_loop_running_ = false;
 
+    // 停掉 io 线程以唤醒阻塞在 recv_request 中的消息循环
+    stop_io();
+
     if (msg_thread_.joinable()) {
         msg_thread_.join();
     }
@@ -87,9 +92,26 @@ bool AgentServer::register_custom_recognition(const std::string& name, MaaCustom
         return false;
     }
 
+    // 重新注册单个形式时，之前的批量形式不再对应它，一并清掉
+    custom_recognition_batches_.erase(name);
     return custom_recognitions_.insert_or_assign(name, CustomRecognitionSession { recognition, trans_arg }).second;
 }
 
+bool AgentServer::register_custom_recognition_batch(
+    const std::string& name,
+    MaaCustomRecognitionBatchCallback recognition,
+    void* trans_arg)
+{
+    LogInfo << VAR(name) << VAR_VOIDP(recognition) << VAR_VOIDP(trans_arg);
+
+    if (name.empty() || recognition == nullptr) {
+        LogError << "name or recognition is null";
+        return false;
+    }
+
+    return custom_recognition_batches_.insert_or_assign(name, CustomRecognitionBatchSession { recognition, trans_arg }).second;
+}
+
 bool AgentServer::register_custom_action(const std::string& name, MaaCustomActionCallback action, void* trans_arg)
 {
     LogInfo << VAR(name) << VAR_VOIDP(action) << VAR_VOIDP(trans_arg);
@@ -122,44 +144,67 @@ MaaSinkId AgentServer::add_context_sink(MaaEventCallback sink, void* trans_arg)
     return ctx_notifier_.add_sink(sink, trans_arg);
 }
 
-bool AgentServer::handle_inserted_request(const json::value& j)
+void AgentServer::set_event_subscription(std::vector<std::string> msg_filter)
 {
-    // LogInfo << VAR(j) << VAR(ipc_addr_);
+    LogInfo << VAR(msg_filter);
 
-    if (handle_image_header(j)) {
-        return true;
-    }
-    else if (handle_image_encoded_header(j)) {
-        return true;
-    }
-    else if (handle_recognition_request(j)) {
-        return true;
-    }
-    else if (handle_action_request(j)) {
-        return true;
-    }
-    else if (handle_resource_event(j)) {
-        return true;
-    }
-    else if (handle_controller_event(j)) {
-        return true;
-    }
-    else if (handle_tasker_event(j)) {
-        return true;
-    }
-    else if (handle_context_event(j)) {
-        return true;
+    event_filter_ = std::move(msg_filter);
+}
+
+bool AgentServer::set_concurrency(size_t concurrency)
+{
+    LogInfo << VAR(concurrency);
+
+    if (concurrency == 0) {
+        LogError << "concurrency must be greater than 0";
+        return false;
     }
-    else if (handle_start_up_request(j)) {
-        return true;
+
+    concurrency_ = concurrency;
+    return true;
+}
+
+bool AgentServer::set_transport_options(const std::string& options_json)
+{
+    LogInfo << VAR(options_json);
+
+    if (!ipc_addr_.empty()) {
+        LogError << "already started up, transport options must be set before" << VAR(ipc_addr_);
+        return false;
     }
-    else if (handle_shut_down_request(j)) {
-        return true;
+
+    auto options_opt = parse_transport_options(options_json);
+    if (!options_opt) {
+        LogError << "invalid transport options" << VAR(options_json);
+        return false;
     }
-    else {
-        LogError << "unexpected msg" << VAR(j);
+
+    Transceiver::set_transport_options(*std::move(options_opt));
+    return true;
+}
+
+bool AgentServer::handle_inserted_request(const json::value& j)
+{
+    // LogInfo << VAR(j) << VAR(ipc_addr_);
+
+    // 按消息类型名直接查表，不再逐个类型试探
+    using Handler = bool (AgentServer::*)(const json::value&);
+    static const std::unordered_map<std::string_view, Handler> kHandlers = {
+        { "CustomRecognitionRequest", &AgentServer::handle_recognition_request },
+        { "CustomRecognitionBatchRequest", &AgentServer::handle_recognition_batch_request },
+        { "CustomActionRequest", &AgentServer::handle_action_request },
+        { "EventBatchRequest", &AgentServer::handle_event_batch },
+        { "StartUpRequest", &AgentServer::handle_start_up_request },
+        { "ShutDownRequest", &AgentServer::handle_shut_down_request },
+        { "PingRequest", &AgentServer::handle_ping_request },
+    };
+
+    auto it = kHandlers.find(message_type(j));
+    if (it == kHandlers.end() || !(this->*it->second)(j)) {
+        LogError << "unexpected msg" << VAR(j) << VAR(ipc_addr_);
         return false;
     }
+    return true;
 }
 
 bool AgentServer::handle_recognition_request(const json::value& j)
@@ -215,6 +260,48 @@ bool AgentServer::handle_recognition_request(const json::value& j)
     return true;
 }
 
+bool AgentServer::handle_recognition_batch_request(const json::value& j)
+{
+    if (!j.is<CustomRecognitionBatchRequest>()) {
+        return false;
+    }
+
+    const CustomRecognitionBatchRequest& req = j.as<CustomRecognitionBatchRequest>();
+    LogInfo << VAR(req) << VAR(ipc_addr_);
+
+    auto it = custom_recognition_batches_.find(req.custom_recognition_name);
+    if (it == custom_recognition_batches_.end() || !it->second.recognition) {
+        LogError << "custom_recognition batch not found" << VAR(req);
+        send(CustomRecognitionBatchResponse { .ret = false });
+        return true;
+    }
+    const CustomRecognitionBatchSession& session = it->second;
+
+    RemoteContext context(*this, req.context_id);
+    cv::Mat mat = get_image_cache(req.image);
+    ImageBuffer mat_buffer(mat);
+    StringBuffer out_results;
+
+    MaaBool ret = session.recognition(
+        &context,
+        req.task_id,
+        req.custom_recognition_name.c_str(),
+        req.entries.c_str(),
+        &mat_buffer,
+        session.trans_arg,
+        &out_results);
+
+    CustomRecognitionBatchResponse resp {
+        .ret = static_cast<bool>(ret),
+        .results = out_results.get(),
+    };
+    LogInfo << VAR(resp) << VAR(ipc_addr_);
+
+    send(resp);
+
+    return true;
+}
+
 bool AgentServer::handle_action_request(const json::value& j)
 {
     if (!j.is<CustomActionRequest>()) {
@@ -276,13 +363,23 @@ bool AgentServer::handle_start_up_request(const json::value& j)
 
     auto action_names = custom_actions_ | std::views::keys;
     auto reco_names = custom_recognitions_ | std::views::keys;
+    auto batch_reco_names = custom_recognition_batches_ | std::views::keys;
+
+    const bool binary = std::ranges::find(req.wire_formats, kBinaryWireFormatName) != req.wire_formats.end();
 
     StartUpResponse msg {
         .actions = { action_names.begin(), action_names.end() },
         .recognitions = { reco_names.begin(), reco_names.end() },
+        .batch_recognitions = { batch_reco_names.begin(), batch_reco_names.end() },
+        .wire_format = binary ? kBinaryWireFormatName : "",
+        .event_filter = event_filter_,
     };
 
-    return send(msg);
+    // 回复本身仍用 json，之后的消息再切换
+    set_wire_format(WireFormat::Json);
+    bool ret = send(msg);
+    set_wire_format(binary ? WireFormat::Binary : WireFormat::Json);
+    return ret;
 }
 
 bool AgentServer::handle_shut_down_request(const json::value& j)
@@ -300,84 +397,104 @@ bool AgentServer::handle_shut_down_request(const json::value& j)
     return true;
 }
 
-bool AgentServer::handle_resource_event(const json::value& j)
+bool AgentServer::handle_event_batch(const json::value& j)
 {
-    if (!j.is<ResourceEventRequest>()) {
+    if (!j.is<EventBatchRequest>()) {
         return false;
     }
+    const EventBatchRequest& req = j.as<EventBatchRequest>();
+
+    if (req.dropped > 0) {
+        LogWarn << "events dropped by client" << VAR(req.dropped) << VAR(ipc_addr_);
+    }
+
+    for (const ForwardedEvent& event : req.events) {
+        switch (event.category) {
+        case EventCategory::Resource: {
+            RemoteResource resource(*this, event.handle_id);
+            res_notifier_.notify_raw(&resource, event.message, event.details);
+        } break;
+        case EventCategory::Controller: {
+            RemoteController controller(*this, event.handle_id);
+            ctrl_notifier_.notify_raw(&controller, event.message, event.details);
+        } break;
+        case EventCategory::Tasker: {
+            RemoteTasker tasker(*this, event.handle_id);
+            tasker_notifier_.notify_raw(&tasker, event.message, event.details);
+        } break;
+        case EventCategory::Context: {
+            RemoteContext context(*this, event.handle_id);
+            ctx_notifier_.notify_raw(&context, event.message, event.details);
+        } break;
+        }
+    }
 
-    const ResourceEventRequest& req = j.as<ResourceEventRequest>();
-    // LogFunc << VAR(req) << VAR(ipc_addr_) << VAR(req.message);
-
-    RemoteResource resource(*this, req.resource_id);
-    res_notifier_.notify(&resource, req.message, req.details);
-
-    send(ResourceEventResponse { });
+    send(EventBatchResponse { });
 
     return true;
 }
 
-bool AgentServer::handle_controller_event(const json::value& j)
+bool AgentServer::handle_ping_request(const json::value& j)
 {
-    if (!j.is<ControllerEventRequest>()) {
+    if (!j.is<PingRequest>()) {
         return false;
     }
-    const ControllerEventRequest& req = j.as<ControllerEventRequest>();
-    // LogFunc << VAR(req) << VAR(ipc_addr_) << VAR(req.message);
-
-    RemoteController controller(*this, req.controller_id);
-    ctrl_notifier_.notify(&controller, req.message, req.details);
-
-    send(ControllerEventResponse { });
 
+    send(PingResponse { });
     return true;
 }
 
-bool AgentServer::handle_tasker_event(const json::value& j)
+void AgentServer::request_msg_loop()
 {
-    if (!j.is<TaskerEventRequest>()) {
-        return false;
-    }
-    const TaskerEventRequest& req = j.as<TaskerEventRequest>();
-    // LogFunc << VAR(req) << VAR(ipc_addr_) << VAR(req.message);
+    LogFunc << VAR(ipc_addr_);
 
-    RemoteTasker tasker(*this, req.tasker_id);
-    tasker_notifier_.notify(&tasker, req.message, req.details);
+    // 本线程只负责收取和分发，耗时的自定义识别/动作交给工作线程，不阻塞事件和其他 context 的请求
+    while (msg_loop_running_) {
+        auto msg_opt = recv_request();
+        if (!msg_opt) {
+            if (msg_loop_running_) {
+                LogError << "failed to recv msg" << VAR(ipc_addr_);
+            }
+            break;
+        }
 
-    send(TaskerEventResponse { });
+        if (auto key = worker_key(*msg_opt)) {
+            workers_->submit(
+                *key,
+                [this, msg = *msg_opt]() { dispatch_request(msg); },
+                [this, msg = *msg_opt]() { reject_request(msg); });
+            continue;
+        }
+        dispatch_request(*msg_opt);
+    }
 
-    return true;
+    workers_->stop();
 }
 
-bool AgentServer::handle_context_event(const json::value& j)
+void AgentServer::reject_request(const json::value& j)
 {
-    if (!j.is<ContextEventRequest>()) {
-        return false;
-    }
-    const ContextEventRequest& req = j.as<ContextEventRequest>();
-    // LogFunc << VAR(req) << VAR(ipc_addr_) << VAR(req.message);
-
-    RemoteContext context(*this, req.context_id);
-    ctx_notifier_.notify(&context, req.message, req.details);
-
-    send(ContextEventResponse { });
+    LogWarn << "reject request" << VAR(message_type(j)) << VAR(ipc_addr_);
 
-    return true;
+    // 对端的 request 在等回复，给一个失败的结果让它尽快返回
+    const std::string_view type = message_type(j);
+    if (type == "CustomRecognitionRequest") {
+        std::ignore = reply(j, CustomRecognitionResponse { .ret = false });
+    }
+    else if (type == "CustomRecognitionBatchRequest") {
+        std::ignore = reply(j, CustomRecognitionBatchResponse { .ret = false });
+    }
+    else if (type == "CustomActionRequest") {
+        std::ignore = reply(j, CustomActionResponse { .ret = false });
+    }
 }
 
-void AgentServer::request_msg_loop()
+std::optional<std::string> AgentServer::worker_key(const json::value& j)
 {
-    LogFunc << VAR(ipc_addr_);
-
-    while (msg_loop_running_) {
-        auto msg_opt = recv();
-        if (!msg_opt) {
-            LogError << "failed to recv msg" << VAR(ipc_addr_);
-            return;
-        }
-        const json::value& j = *msg_opt;
-        handle_inserted_request(j);
+    const std::string_view type = message_type(j);
+    if (type != "CustomRecognitionRequest" && type != "CustomRecognitionBatchRequest" && type != "CustomActionRequest") {
+        return std::nullopt;
     }
+    return j.get("context_id", std::string());
 }
 
 MAA_AGENT_SERVER_NS_END
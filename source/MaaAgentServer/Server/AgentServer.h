@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+#include <optional>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -12,6 +14,7 @@
 #include "MaaAgent/Transceiver.h"
 #include "MaaAgentServer/MaaAgentServerDef.h"
 #include "MaaUtils/SingletonHolder.hpp"
+#include "RequestWorkers.h"
 #include "Utils/EventDispatcher.hpp"
 
 MAA_AGENT_SERVER_NS_BEGIN
@@ -26,6 +29,12 @@ class AgentServer
         void* trans_arg = nullptr;
     };
 
+    struct CustomRecognitionBatchSession
+    {
+        MaaCustomRecognitionBatchCallback recognition = nullptr;
+        void* trans_arg = nullptr;
+    };
+
     struct CustomActionSession
     {
         MaaCustomActionCallback action = nullptr;
@@ -41,37 +50,52 @@ public:
     void detach();
 
     bool register_custom_recognition(const std::string& name, MaaCustomRecognitionCallback recognition, void* trans_arg);
+    bool register_custom_recognition_batch(const std::string& name, MaaCustomRecognitionBatchCallback recognition, void* trans_arg);
     bool register_custom_action(const std::string& name, MaaCustomActionCallback action, void* trans_arg);
 
     MaaSinkId add_resource_sink(MaaEventCallback sink, void* trans_arg);
     MaaSinkId add_controller_sink(MaaEventCallback sink, void* trans_arg);
     MaaSinkId add_tasker_sink(MaaEventCallback sink, void* trans_arg);
     MaaSinkId add_context_sink(MaaEventCallback sink, void* trans_arg);
+    // 在 start_up 前设置，连接时告知客户端，未订阅的事件不再转发过来
+    void set_event_subscription(std::vector<std::string> msg_filter);
+    // 在 start_up 前设置，同时执行自定义识别/动作的线程数，同一 context 的请求总是按顺序执行
+    bool set_concurrency(size_t concurrency);
+    // 在 start_up 前设置，格式见 TransportOptions
+    bool set_transport_options(const std::string& options_json);
 
 public:
     virtual bool handle_inserted_request(const json::value& j) override;
 
 private:
     bool handle_recognition_request(const json::value& j);
+    bool handle_recognition_batch_request(const json::value& j);
     bool handle_action_request(const json::value& j);
     bool handle_start_up_request(const json::value& j);
     bool handle_shut_down_request(const json::value& j);
+    bool handle_ping_request(const json::value& j);
 
-    bool handle_resource_event(const json::value& j);
-    bool handle_controller_event(const json::value& j);
-    bool handle_tasker_event(const json::value& j);
-    bool handle_context_event(const json::value& j);
+    bool handle_event_batch(const json::value& j);
 
     void request_msg_loop();
+    // 交给工作线程执行的请求返回其排序用的 key，其余在消息线程上直接处理
+    static std::optional<std::string> worker_key(const json::value& j);
+    // 工作线程停止时尚未执行的请求，回复失败
+    void reject_request(const json::value& j);
 
 private:
     std::unordered_map<std::string, CustomRecognitionSession> custom_recognitions_;
+    std::unordered_map<std::string, CustomRecognitionBatchSession> custom_recognition_batches_;
     std::unordered_map<std::string, CustomActionSession> custom_actions_;
 
     EventDispatcher res_notifier_;
     EventDispatcher ctrl_notifier_ = EventDispatcher(false);
     EventDispatcher tasker_notifier_;
     EventDispatcher ctx_notifier_;
+    std::vector<std::string> event_filter_;
+
+    size_t concurrency_ = 1;
+    std::unique_ptr<RequestWorkers> workers_;
 
     bool msg_loop_running_ = false;
     std::thread msg_thread_;
@@ -0,0 +1,116 @@
+#include "RequestWorkers.h"
+
+#include <algorithm>
+
+#include "MaaUtils/Logger.h"
+
+MAA_AGENT_SERVER_NS_BEGIN
+
+RequestWorkers::RequestWorkers(size_t concurrency)
+{
+    LogInfo << VAR(concurrency);
+
+    concurrency = std::max<size_t>(concurrency, 1);
+    threads_.reserve(concurrency);
+    for (size_t i = 0; i < concurrency; ++i) {
+        threads_.emplace_back(&RequestWorkers::worker_loop, this);
+    }
+}
+
+RequestWorkers::~RequestWorkers()
+{
+    stop();
+}
+
+void RequestWorkers::submit(const std::string& key, Job job, Discard discard)
+{
+    std::unique_lock lock(mutex_);
+
+    if (!running_) {
+        LogWarn << "workers stopped, request discarded" << VAR(key);
+        lock.unlock();
+        if (discard) {
+            discard();
+        }
+        return;
+    }
+
+    auto [it, inserted] = queues_.try_emplace(key);
+    it->second.emplace_back(Task { .job = std::move(job), .discard = std::move(discard) });
+    if (inserted) {
+        ready_.emplace_back(key);
+        cv_.notify_one();
+    }
+}
+
+void RequestWorkers::stop()
+{
+    std::vector<Discard> discarded;
+    {
+        std::unique_lock lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+
+        // 正在执行的 key 仍留在 queues_ 中，只取出还没开始的
+        for (auto& [key, tasks] : queues_) {
+            for (auto& task : tasks) {
+                discarded.emplace_back(std::move(task.discard));
+            }
+            tasks.clear();
+        }
+        if (!discarded.empty()) {
+            LogWarn << "discard pending requests" << VAR(discarded.size());
+        }
+    }
+    cv_.notify_all();
+
+    for (auto& discard : discarded) {
+        if (discard) {
+            discard();
+        }
+    }
+
+    for (auto& thread : threads_) {
+        if (thread.joinable() && thread.get_id() != std::this_thread::get_id()) {
+            thread.join();
+        }
+    }
+}
+
+void RequestWorkers::worker_loop()
+{
+    while (true) {
+        std::string key;
+        Job job;
+        {
+            std::unique_lock lock(mutex_);
+            cv_.wait(lock, [&]() { return !running_ || !ready_.empty(); });
+            if (!running_) {
+                break;
+            }
+
+            key = std::move(ready_.front());
+            ready_.pop_front();
+            auto& tasks = queues_.at(key);
+            job = std::move(tasks.front().job);
+            tasks.pop_front();
+        }
+
+        job();
+
+        std::unique_lock lock(mutex_);
+        auto it = queues_.find(key);
+        if (it->second.empty()) {
+            queues_.erase(it);
+        }
+        else {
+            // 排到队尾，避免一个繁忙的 key 占住线程
+            ready_.emplace_back(std::move(key));
+            cv_.notify_one();
+        }
+    }
+}
+
+MAA_AGENT_SERVER_NS_END
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/Conf.h"
+#include "MaaUtils/NonCopyable.hpp"
+
+MAA_AGENT_SERVER_NS_BEGIN
+
+// 在固定数量的工作线程上执行对端请求。key 相同的请求按提交顺序逐个执行，不同 key 之间并行
+class RequestWorkers : public NonCopyable
+{
+public:
+    using Job = std::function<void()>;
+    // 请求未执行就被丢弃时调用，用来给对端一个失败的回复
+    using Discard = std::function<void()>;
+
+public:
+    explicit RequestWorkers(size_t concurrency);
+    ~RequestWorkers();
+
+    void submit(const std::string& key, Job job, Discard discard);
+    // 等正在执行的请求结束后返回，尚未开始的请求被丢弃，并对每个调用 discard
+    void stop();
+
+private:
+    struct Task
+    {
+        Job job;
+        Discard discard;
+    };
+
+    void worker_loop();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    // 有待执行请求、且没有线程正在执行的 key
+    std::deque<std::string> ready_;
+    // key 存在即表示它已在 ready_ 中或正被某个线程执行
+    std::unordered_map<std::string, std::deque<Task>> queues_;
+    bool running_ = true;
+
+    std::vector<std::thread> threads_;
+};
+
+MAA_AGENT_SERVER_NS_END
@@ -6,6 +6,7 @@
 #include "LibraryHolder/ControlUnit.h"
 #include "MaaUtils/Logger.h"
 #include "MaaUtils/Platform.h"
+#include "Resource/CompiledBundle.h"
 #include "Resource/ResourceMgr.h"
 #include "Tasker/Tasker.h"
 
@@ -369,6 +370,18 @@ void MaaResourceDestroy(MaaResource* res)
     delete res;
 }
 
+MaaBool MaaResourceCompileBundle(const char* bundle_path, const char* output_path)
+{
+    LogFunc << VAR(bundle_path) << VAR(output_path);
+
+    if (!bundle_path || !output_path) {
+        LogError << "path is null";
+        return false;
+    }
+
+    return MAA_RES_NS::CompiledBundle::compile(MAA_NS::path(bundle_path), MAA_NS::path(output_path));
+}
+
 MaaTasker* MaaTaskerCreate()
 {
     LogFunc;
@@ -3,6 +3,7 @@
 #include <condition_variable>
 #include <functional>
 #include <list>
+#include <map>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
@@ -31,13 +32,18 @@ public:
         failed = 4000,
     };
 
+    // 已完成的状态最多保留这么多条，更早的会被淘汰（查询返回 invalid）
+    static constexpr size_t kDefaultStatusRetention = 4096;
+
 public:
-    explicit AsyncRunner(ProcessFunc proc);
+    explicit AsyncRunner(ProcessFunc proc, size_t status_retention = kDefaultStatusRetention);
     virtual ~AsyncRunner();
     void release();
 
     Id post(Item item, bool block = false);
     void wait(Id id) const;
+    // 只在 id 仍为 pending / running 时等待；已结束、被 clear 或已淘汰的 id 立即返回
+    void wait_settled(Id id) const;
     void wait_all() const;
     Status status(Id id) const;
     std::optional<Item> get(Id id) const;
@@ -49,6 +55,7 @@ public:
 
 private:
     void working();
+    void prune_status();
 
     ProcessFunc process_;
 
@@ -62,6 +69,7 @@ private:
 
     mutable std::shared_mutex status_mutex_;
     std::map<Id, Status> status_map_;
+    const size_t status_retention_ = kDefaultStatusRetention;
 
     Id compl_id_ = 0;
     mutable std::mutex compl_mutex_;
@@ -74,8 +82,9 @@ private:
 };
 
 template <typename Item>
-inline AsyncRunner<Item>::AsyncRunner(ProcessFunc proc)
+inline AsyncRunner<Item>::AsyncRunner(ProcessFunc proc, size_t status_retention)
     : process_(proc)
+    , status_retention_(status_retention)
 {
     // LogFunc;
 
@@ -154,6 +163,7 @@ inline void AsyncRunner<Item>::working()
 
         status_lock.lock();
         status_map_[id] = ret ? Status::succeeded : Status::failed;
+        prune_status();
         status_lock.unlock();
 
         std::unique_lock compl_lock(compl_mutex_);
@@ -162,6 +172,20 @@ inline void AsyncRunner<Item>::working()
     }
 }
 
+template <typename Item>
+inline void AsyncRunner<Item>::prune_status()
+{
+    // 调用方需持有 status_mutex_。id 单调递增，从最旧的开始淘汰，未完成的保留
+    for (auto iter = status_map_.begin(); status_map_.size() > status_retention_ && iter != status_map_.end();) {
+        if (iter->second == Status::succeeded || iter->second == Status::failed) {
+            iter = status_map_.erase(iter);
+        }
+        else {
+            ++iter;
+        }
+    }
+}
+
 template <typename Item>
 inline typename AsyncRunner<Item>::Id AsyncRunner<Item>::post(Item item, bool block)
 {
@@ -208,6 +232,19 @@ inline void AsyncRunner<Item>::wait(Id id) const
     }
 }
 
+template <typename Item>
+inline void AsyncRunner<Item>::wait_settled(Id id) const
+{
+    std::unique_lock compl_lock(compl_mutex_);
+    compl_cond_.wait(compl_lock, [&]() {
+        if (exit_) {
+            return true;
+        }
+        auto s = status(id);
+        return s != Status::pending && s != Status::running;
+    });
+}
+
 template <typename Item>
 inline void AsyncRunner<Item>::wait_all() const
 {
@@ -276,15 +313,16 @@ inline void AsyncRunner<Item>::clear()
         queue_cond_.notify_all();
     }
 
+    // 先清状态再唤醒，wait_settled 醒来时才能看到 id 已失效
     {
-        std::unique_lock compl_lock(compl_mutex_);
-        compl_id_ = cross_inst_id_;
-        compl_cond_.notify_all();
+        std::unique_lock status_lock(status_mutex_);
+        status_map_.clear();
     }
 
     {
-        std::unique_lock status_lock(status_mutex_);
-        status_map_.clear();
+        std::unique_lock compl_lock(compl_mutex_);
+        compl_id_ = cross_inst_id_;
+        compl_cond_.notify_all();
     }
 }
 
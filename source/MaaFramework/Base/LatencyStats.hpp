@@ -0,0 +1,208 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+
+#include <meojson/json.hpp>
+
+#include "Common/Conf.h"
+#include "MaaUtils/NonCopyable.hpp"
+
+MAA_NS_BEGIN
+
+// 无锁直方图，桶按 2 的幂分段，每段再细分 4 个子桶，单位微秒
+// 相对误差 < 25%，足够看 p50/p99 了
+class LatencyHistogram : public NonCopyable
+{
+public:
+    static constexpr size_t kLinearBuckets = 16;
+    static constexpr size_t kSubBucketBits = 2;
+    static constexpr size_t kSubBuckets = 1 << kSubBucketBits;
+    static constexpr size_t kMaxExponent = 40;
+    static constexpr size_t kBucketCount = kLinearBuckets + (kMaxExponent - 4 + 1) * kSubBuckets;
+
+public:
+    void record(std::chrono::microseconds cost)
+    {
+        const uint64_t us = static_cast<uint64_t>(std::max<int64_t>(cost.count(), 0));
+
+        buckets_[bucket_index(us)].fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(us, std::memory_order_relaxed);
+
+        uint64_t cur_min = min_.load(std::memory_order_relaxed);
+        while (us < cur_min && !min_.compare_exchange_weak(cur_min, us, std::memory_order_relaxed)) {
+        }
+        uint64_t cur_max = max_.load(std::memory_order_relaxed);
+        while (us > cur_max && !max_.compare_exchange_weak(cur_max, us, std::memory_order_relaxed)) {
+        }
+    }
+
+    void clear()
+    {
+        for (auto& b : buckets_) {
+            b.store(0, std::memory_order_relaxed);
+        }
+        sum_.store(0, std::memory_order_relaxed);
+        min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    json::object to_json() const
+    {
+        std::array<uint64_t, kBucketCount> snapshot { };
+        uint64_t count = 0;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            snapshot[i] = buckets_[i].load(std::memory_order_relaxed);
+            count += snapshot[i];
+        }
+        if (count == 0) {
+            return { { "count", 0 } };
+        }
+
+        const uint64_t min = min_.load(std::memory_order_relaxed);
+        const uint64_t max = max_.load(std::memory_order_relaxed);
+
+        auto percentile = [&](double p) {
+            const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p * count)));
+            uint64_t seen = 0;
+            for (size_t i = 0; i < kBucketCount; ++i) {
+                seen += snapshot[i];
+                if (seen >= rank) {
+                    return std::clamp(bucket_upper_bound(i), min, max);
+                }
+            }
+            return max;
+        };
+
+        auto to_ms = [](uint64_t us) {
+            return static_cast<double>(us) / 1000.0;
+        };
+
+        return {
+            { "count", count },
+            { "avg", to_ms(sum_.load(std::memory_order_relaxed)) / count },
+            { "min", to_ms(min) },
+            { "max", to_ms(max) },
+            { "p50", to_ms(percentile(0.50)) },
+            { "p90", to_ms(percentile(0.90)) },
+            { "p99", to_ms(percentile(0.99)) },
+        };
+    }
+
+private:
+    static size_t bucket_index(uint64_t us)
+    {
+        if (us < kLinearBuckets) {
+            return static_cast<size_t>(us);
+        }
+        const size_t exponent = std::min<size_t>(std::bit_width(us) - 1, kMaxExponent);
+        const size_t sub = static_cast<size_t>(us >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+        return kLinearBuckets + (exponent - 4) * kSubBuckets + sub;
+    }
+
+    static uint64_t bucket_upper_bound(size_t index)
+    {
+        if (index < kLinearBuckets) {
+            return index;
+        }
+        const size_t exponent = (index - kLinearBuckets) / kSubBuckets + 4;
+        const size_t sub = (index - kLinearBuckets) % kSubBuckets;
+        const uint64_t width = uint64_t(1) << (exponent - kSubBucketBits);
+        return ((kSubBuckets + sub) << (exponent - kSubBucketBits)) + width - 1;
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_ { };
+    std::atomic<uint64_t> sum_ = 0;
+    std::atomic<uint64_t> min_ = std::numeric_limits<uint64_t>::max();
+    std::atomic<uint64_t> max_ = 0;
+};
+
+// category -> name -> histogram
+// 查找/插入走读写锁，写入直方图本身是无锁的
+class LatencyStats : public NonCopyable
+{
+public:
+    void record(std::string_view category, std::string_view name, std::chrono::steady_clock::duration cost)
+    {
+        if (name.empty()) {
+            return;
+        }
+        histogram(category, name).record(std::chrono::duration_cast<std::chrono::microseconds>(cost));
+    }
+
+    void record_since(std::string_view category, std::string_view name, std::chrono::steady_clock::time_point start)
+    {
+        record(category, name, std::chrono::steady_clock::now() - start);
+    }
+
+    json::object to_json() const
+    {
+        std::shared_lock lock(mutex_);
+
+        json::object result;
+        for (const auto& [category, names] : histograms_) {
+            json::object category_json;
+            for (const auto& [name, hist] : names) {
+                category_json[name] = hist->to_json();
+            }
+            result[category] = std::move(category_json);
+        }
+        return result;
+    }
+
+    void clear()
+    {
+        // 只清零不删除，避免其他线程持有的引用失效
+        std::shared_lock lock(mutex_);
+
+        for (const auto& [category, names] : histograms_) {
+            for (const auto& [name, hist] : names) {
+                hist->clear();
+            }
+        }
+    }
+
+private:
+    LatencyHistogram& histogram(std::string_view category, std::string_view name)
+    {
+        {
+            std::shared_lock lock(mutex_);
+            if (auto cat_it = histograms_.find(category); cat_it != histograms_.end()) {
+                if (auto it = cat_it->second.find(name); it != cat_it->second.end()) {
+                    return *it->second;
+                }
+            }
+        }
+
+        std::unique_lock lock(mutex_);
+        auto cat_it = histograms_.find(category);
+        if (cat_it == histograms_.end()) {
+            cat_it = histograms_.emplace(std::string(category), HistogramMap { }).first;
+        }
+        auto it = cat_it->second.find(name);
+        if (it == cat_it->second.end()) {
+            it = cat_it->second.emplace(std::string(name), std::make_unique<LatencyHistogram>()).first;
+        }
+        return *it->second;
+    }
+
+private:
+    using HistogramMap = std::map<std::string, std::unique_ptr<LatencyHistogram>, std::less<>>;
+
+    std::map<std::string, HistogramMap, std::less<>> histograms_;
+    mutable std::shared_mutex mutex_;
+};
+
+MAA_NS_END
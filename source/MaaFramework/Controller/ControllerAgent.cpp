@@ -1,5 +1,7 @@
 #include "ControllerAgent.h"
 
+#include <algorithm>
+
 #include "Global/OptionMgr.h"
 #include "Global/PluginMgr.h"
 #include "MaaFramework/MaaMsg.h"
@@ -21,13 +23,19 @@ ControllerAgent::ControllerAgent(std::shared_ptr<MAA_CTRL_UNIT_NS::ControlUnitAP
         add_sink(sink, this);
     }
 
-    action_runner_ =
-        std::make_unique<AsyncRunner<Action>>(std::bind(&ControllerAgent::run_action, this, std::placeholders::_1, std::placeholders::_2));
+    for (auto& lane : lanes_) {
+        lane = std::make_unique<AsyncRunner<Action>>(
+            std::bind(&ControllerAgent::run_lane_action, this, std::placeholders::_1, std::placeholders::_2));
+    }
 }
 
 ControllerAgent::~ControllerAgent()
 {
     LogFunc;
+
+    for (auto& lane : lanes_) {
+        lane->release();
+    }
 }
 
 bool ControllerAgent::set_option(MaaCtrlOption key, MaaOptionValue value, MaaOptionValueSize val_size)
@@ -176,25 +184,26 @@ MaaCtrlId ControllerAgent::post_inactive()
 
 MaaStatus ControllerAgent::status(MaaCtrlId ctrl_id) const
 {
-    if (!action_runner_) {
-        LogError << "action_runner_ is nullptr";
+    auto* runner = runner_of(ctrl_id);
+    if (!runner) {
         return MaaStatus_Invalid;
     }
-    return static_cast<MaaStatus>(action_runner_->status(ctrl_id));
+    return static_cast<MaaStatus>(runner->status(ctrl_id));
 }
 
 MaaStatus ControllerAgent::wait(MaaCtrlId ctrl_id) const
 {
-    if (!action_runner_) {
-        LogError << "action_runner_ is nullptr";
+    if (ctrl_id == MaaInvalidId) {
         return MaaStatus_Invalid;
     }
-    if (ctrl_id == MaaInvalidId) {
+
+    auto* runner = runner_of(ctrl_id);
+    if (!runner) {
         return MaaStatus_Invalid;
     }
 
-    action_runner_->wait(ctrl_id);
-    return status(ctrl_id);
+    runner->wait(ctrl_id);
+    return static_cast<MaaStatus>(runner->status(ctrl_id));
 }
 
 bool ControllerAgent::connected() const
@@ -207,8 +216,15 @@ bool ControllerAgent::connected() const
 
 cv::Mat ControllerAgent::cached_image() const
 {
+    // 帧缓冲区不会被原地修改，直接共享即可
     std::unique_lock lock(image_mutex_);
-    return image_.clone();
+    return frame_.image();
+}
+
+Frame ControllerAgent::cached_frame() const
+{
+    std::unique_lock lock(image_mutex_);
+    return frame_;
 }
 
 std::string ControllerAgent::cached_shell_output() const
@@ -262,14 +278,22 @@ void ControllerAgent::post_stop()
 
     need_to_stop_ = true;
 
-    if (action_runner_ && action_runner_->running()) {
-        action_runner_->clear();
+    {
+        // 被丢弃的动作不再作为屏障
+        std::unique_lock lock(post_mutex_);
+        last_posted_.fill(MaaInvalidId);
+    }
+
+    for (auto& lane : lanes_) {
+        if (lane->running()) {
+            lane->clear();
+        }
     }
 }
 
 bool ControllerAgent::running() const
 {
-    return action_runner_ && action_runner_->running();
+    return std::ranges::any_of(lanes_, [](const auto& lane) { return lane->running(); });
 }
 
 bool ControllerAgent::click(ClickParam p)
@@ -408,10 +432,58 @@ MaaCtrlId ControllerAgent::post(Action action)
         return MaaInvalidId;
     }
 
-    if (!action_runner_) {
-        return MaaInvalidId;
+    const Lane lane = concurrent_lanes() ? lane_of(action.type) : Lane::Input;
+
+    // 加锁保证屏障与 id 的先后一致
+    std::unique_lock lock(post_mutex_);
+
+    for (size_t i = 0; i < last_posted_.size(); ++i) {
+        const Lane other = static_cast<Lane>(i);
+        if (other == lane || last_posted_[i] == MaaInvalidId) {
+            continue;
+        }
+        // 唯一放开的顺序：输入不必等之前投递的截图
+        if (lane == Lane::Input && other == Lane::Capture) {
+            continue;
+        }
+        action.barriers.emplace_back(last_posted_[i]);
     }
-    return action_runner_->post(std::move(action));
+
+    const MaaCtrlId id = runner_of(lane)->post(std::move(action));
+    last_posted_[static_cast<size_t>(lane)] = id;
+    return id;
+}
+
+bool ControllerAgent::concurrent_lanes() const
+{
+    return control_unit_ && (control_unit_->get_features() & MaaControllerFeature_ConcurrentScreencapAndInput);
+}
+
+ControllerAgent::Lane ControllerAgent::lane_of(Action::Type type)
+{
+    switch (type) {
+    case Action::Type::screencap:
+        return Lane::Capture;
+
+    case Action::Type::connect:
+    case Action::Type::start_app:
+    case Action::Type::stop_app:
+    case Action::Type::shell:
+        return Lane::App;
+
+    default:
+        return Lane::Input;
+    }
+}
+
+AsyncRunner<Action>* ControllerAgent::runner_of(MaaCtrlId id) const
+{
+    for (const auto& lane : lanes_) {
+        if (lane->status(id) != AsyncRunner<Action>::Status::invalid) {
+            return lane.get();
+        }
+    }
+    return nullptr;
 }
 
 MaaCtrlId ControllerAgent::focus_id(MaaCtrlId id)
@@ -491,62 +563,29 @@ bool ControllerAgent::handle_swipe(const SwipeParam& param)
     }
 
     const bool use_touch_down_up = control_unit_->get_features() & MaaControllerFeature_UseMouseDownAndUpInsteadOfClick;
-    if (!use_touch_down_up) {
-        LogWarn << "touch not supported, use swipe instead. some features can not work";
+    if (use_touch_down_up) {
+        TouchTrajectory trajectory;
+        append_swipe_trajectory(param, param.contact, std::chrono::milliseconds(0), trajectory);
+        return !param.end.empty() && play_touch_trajectory(trajectory);
     }
 
+    LogWarn << "touch not supported, use swipe instead. some features can not work";
+
     cv::Point begin = preproc_touch_point(param.begin);
     bool ret = !param.end.empty();
 
-    if (!param.only_hover && use_touch_down_up) {
-        ret &= control_unit_->touch_down(param.contact, begin.x, begin.y, param.pressure);
-    }
-
     for (size_t i = 0; i < param.end.size(); ++i) {
         const cv::Point& end = preproc_touch_point(param.end.at(i));
         const uint duration = param.duration.empty() ? 200 : (i < param.duration.size()) ? param.duration.at(i) : param.duration.back();
         const uint end_hold = param.end_hold.empty() ? 0 : (i < param.end_hold.size()) ? param.end_hold.at(i) : param.end_hold.back();
 
-        if (use_touch_down_up) {
-            constexpr double kInterval = 10; // ms
-            const std::chrono::milliseconds delay(static_cast<int>(kInterval));
-
-            const double total_step = duration / kInterval;
-            const double x_step_len = (end.x - begin.x) / total_step;
-            const double y_step_len = (end.y - begin.y) / total_step;
-
-            auto now = std::chrono::steady_clock::now();
-
-            for (int step = 1; step < total_step; ++step) {
-                int mx = static_cast<int>(begin.x + step * x_step_len);
-                int my = static_cast<int>(begin.y + step * y_step_len);
-
-                std::this_thread::sleep_until(now + delay);
-
-                now = std::chrono::steady_clock::now();
-                ret &= control_unit_->touch_move(param.contact, mx, my, param.pressure);
-            }
-
-            std::this_thread::sleep_until(now + delay);
-
-            now = std::chrono::steady_clock::now();
-            ret &= control_unit_->touch_move(param.contact, end.x, end.y, param.pressure);
-
-            std::this_thread::sleep_until(now + delay);
-        }
-        else {
-            ret &= control_unit_->swipe(begin.x, begin.y, end.x, end.y, duration);
-        }
+        ret &= control_unit_->swipe(begin.x, begin.y, end.x, end.y, duration);
 
         std::this_thread::sleep_for(std::chrono::milliseconds(end_hold));
 
         begin = end;
     }
 
-    if (!param.only_hover && use_touch_down_up) {
-        ret &= control_unit_->touch_up(param.contact);
-    }
-
     return ret;
 }
 
@@ -562,110 +601,94 @@ bool ControllerAgent::handle_multi_swipe(const MultiSwipeParam& param)
         return false;
     }
 
-    constexpr double kInterval = 10; // ms
-    const std::chrono::milliseconds delay(static_cast<int>(kInterval));
+    TouchTrajectory trajectory;
+    for (size_t i = 0; i < param.swipes.size(); ++i) {
+        const SwipeParam& s = param.swipes.at(i);
+        int contact = s.contact != 0 ? s.contact : static_cast<int>(i);
+        append_swipe_trajectory(s, contact, std::chrono::milliseconds(s.starting), trajectory);
+    }
+    std::ranges::stable_sort(trajectory, std::less {}, &TouchEvent::time);
 
-    struct SegmentOperating
-    {
-        cv::Point begin { };
-        cv::Point end { };
-        double total_step = 0;
-        double x_step_len = 0;
-        double y_step_len = 0;
-        size_t step_index = 0;
-        uint duration = 0;
-        uint end_hold = 0;
-    };
+    return !param.swipes.empty() && play_touch_trajectory(trajectory);
+}
 
-    struct CotactOperating
-    {
-        std::vector<SegmentOperating> seg;
-        size_t seg_index = 0;
-    };
+void ControllerAgent::append_swipe_trajectory(
+    const SwipeParam& param,
+    int contact,
+    std::chrono::milliseconds starting,
+    TouchTrajectory& trajectory)
+{
+    constexpr uint kInterval = 10; // ms
 
-    // contact index < end index < op >>
-    std::vector<CotactOperating> operating(param.swipes.size());
+    cv::Point begin = preproc_touch_point(param.begin);
+    std::chrono::milliseconds time = starting;
 
-    for (size_t s_i = 0; s_i < param.swipes.size(); ++s_i) {
-        const SwipeParam& s = param.swipes.at(s_i);
+    if (!param.only_hover) {
+        trajectory.emplace_back(
+            TouchEvent {
+                .type = TouchEvent::Type::Down,
+                .contact = contact,
+                .x = begin.x,
+                .y = begin.y,
+                .pressure = param.pressure,
+                .time = time,
+            });
+    }
 
-        cv::Point begin = preproc_touch_point(s.begin);
-        for (size_t e_i = 0; e_i < s.end.size(); ++e_i) {
-            const cv::Point& end = preproc_touch_point(s.end.at(e_i));
-            const uint duration = s.duration.empty() ? 200 : (e_i < s.duration.size()) ? s.duration.at(e_i) : s.duration.back();
-            const uint end_hold = s.end_hold.empty() ? 0 : (e_i < s.end_hold.size()) ? s.end_hold.at(e_i) : s.end_hold.back();
+    for (size_t i = 0; i < param.end.size(); ++i) {
+        const cv::Point& end = preproc_touch_point(param.end.at(i));
+        const uint duration = param.duration.empty() ? 200 : (i < param.duration.size()) ? param.duration.at(i) : param.duration.back();
+        const uint end_hold = param.end_hold.empty() ? 0 : (i < param.end_hold.size()) ? param.end_hold.at(i) : param.end_hold.back();
 
-            SegmentOperating o;
-            o.begin = begin;
-            o.end = end;
-            o.total_step = duration / kInterval;
-            o.x_step_len = (end.x - begin.x) / o.total_step;
-            o.y_step_len = (end.y - begin.y) / o.total_step;
-            o.step_index = 0;
-            o.duration = duration;
-            o.end_hold = end_hold;
+        const uint total_step = std::max<uint>(1, (duration + kInterval - 1) / kInterval);
+        for (uint step = 1; step <= total_step; ++step) {
+            const double progress = static_cast<double>(step) / total_step;
+            trajectory.emplace_back(
+                TouchEvent {
+                    .type = TouchEvent::Type::Move,
+                    .contact = contact,
+                    .x = static_cast<int>(begin.x + (end.x - begin.x) * progress),
+                    .y = static_cast<int>(begin.y + (end.y - begin.y) * progress),
+                    .pressure = param.pressure,
+                    .time = time + std::chrono::milliseconds(duration * step / total_step),
+                });
+        }
 
-            operating.at(s_i).seg.emplace_back(std::move(o));
-            operating.at(s_i).seg_index = 0;
+        // 到达终点后停留一个间隔再进入 end_hold，与逐步移动时的节奏一致
+        time += std::chrono::milliseconds(duration + kInterval + end_hold);
+        begin = end;
+    }
 
-            begin = end;
-        }
+    if (!param.only_hover) {
+        trajectory.emplace_back(TouchEvent { .type = TouchEvent::Type::Up, .contact = contact, .time = time });
     }
+}
 
-    const auto starting = std::chrono::steady_clock::now();
-    auto now = starting;
-
-    bool ret = !param.swipes.empty();
-    size_t over_count = 0;
-    while (over_count < param.swipes.size()) {
-        uint now_point = static_cast<uint>(std::chrono::duration_cast<std::chrono::milliseconds>(now - starting).count());
-
-        for (size_t i = 0; i < param.swipes.size(); ++i) {
-            const SwipeParam& s = param.swipes.at(i);
-            if (now_point < s.starting) {
-                continue;
-            }
-
-            int contact = s.contact != 0 ? s.contact : static_cast<int>(i);
-
-            if (i >= operating.size()) {
-                LogError << "Invalid contact index" << VAR(i) << VAR(operating.size());
-                continue;
-            }
-            auto& contact_op = operating.at(i);
-
-            if (contact_op.seg_index >= contact_op.seg.size()) {
-                continue; // all segments done
-            }
-            auto& seg_op = contact_op.seg.at(contact_op.seg_index);
-
-            if (seg_op.step_index == 0) {
-                if (!s.only_hover) {
-                    ret &= control_unit_->touch_down(contact, seg_op.begin.x, seg_op.begin.y, s.pressure);
-                }
-                ++seg_op.step_index;
-            }
-            else if (seg_op.step_index < seg_op.total_step) {
-                int mx = static_cast<int>(seg_op.begin.x + seg_op.step_index * seg_op.x_step_len);
-                int my = static_cast<int>(seg_op.begin.y + seg_op.step_index * seg_op.y_step_len);
-                ret &= control_unit_->touch_move(contact, mx, my, s.pressure);
-                ++seg_op.step_index;
-            }
-            else if (seg_op.step_index == seg_op.total_step) {
-                if (!s.only_hover) {
-                    ret &= control_unit_->touch_up(contact);
-                }
-                ++seg_op.step_index;
-                ++over_count;
-            }
-            else { // step_index > total
-                ++contact_op.seg_index;
-                continue;
-            }
-        }
+bool ControllerAgent::play_touch_trajectory(const TouchTrajectory& trajectory)
+{
+    if (auto unit = std::dynamic_pointer_cast<MAA_CTRL_UNIT_NS::TrajectoryUnit>(control_unit_);
+        unit && unit->touch_trajectory_available()) {
+        return unit->touch_trajectory(trajectory);
+    }
+
+    // 按相对起点的绝对时刻回放，单步的调度抖动不会累积到后续事件
+    const auto start = std::chrono::steady_clock::now();
 
-        std::this_thread::sleep_until(now + delay);
-        now = std::chrono::steady_clock::now();
+    bool ret = true;
+    for (const TouchEvent& event : trajectory) {
+        std::this_thread::sleep_until(start + event.time);
+
+        switch (event.type) {
+        case TouchEvent::Type::Down:
+            ret &= control_unit_->touch_down(event.contact, event.x, event.y, event.pressure);
+            break;
+        case TouchEvent::Type::Move:
+            ret &= control_unit_->touch_move(event.contact, event.x, event.y, event.pressure);
+            break;
+        case TouchEvent::Type::Up:
+            ret &= control_unit_->touch_up(event.contact);
+            break;
+        }
     }
 
     return ret;
@@ -794,16 +817,19 @@ bool ControllerAgent::handle_screencap()
         return false;
     }
 
+    // 输入通道在缺少缩放信息时也会截图，截图本身始终串行
+    std::unique_lock lock(screencap_mutex_);
+
     cv::Mat raw_image;
+    auto screencap_start = std::chrono::steady_clock::now();
     bool screencaped = control_unit_->screencap(raw_image);
     if (!screencaped) {
         LogError << "controller screencap failed";
         return false;
     }
+    latency_stats_.record_since("controller", "screencap", screencap_start);
 
-    bool ret = postproc_screenshot(raw_image);
-
-    return ret;
+    return postproc_screenshot(raw_image, std::chrono::steady_clock::now());
 }
 
 bool ControllerAgent::handle_start_app(const AppParam& param)
@@ -923,6 +949,25 @@ bool ControllerAgent::check_stop()
     return true;
 }
 
+bool ControllerAgent::run_lane_action(typename AsyncRunner<Action>::Id id, Action action)
+{
+    for (MaaCtrlId barrier : action.barriers) {
+        // 按状态等待：clear 后 compl_id_ 可能回退到更小的 id，按 id 比较会永远等不到
+        if (auto* runner = runner_of(barrier)) {
+            runner->wait_settled(barrier);
+        }
+    }
+
+    // 应用与 shell 独占控制器，截图与输入可以同时进行
+    if (lane_of(action.type) != Lane::App && concurrent_lanes()) {
+        std::shared_lock lock(unit_mutex_);
+        return run_action(id, std::move(action));
+    }
+
+    std::unique_lock lock(unit_mutex_);
+    return run_action(id, std::move(action));
+}
+
 bool ControllerAgent::run_action(typename AsyncRunner<Action>::Id id, Action action)
 {
     bool ret = false;
@@ -1049,8 +1094,10 @@ cv::Point ControllerAgent::preproc_touch_point(const cv::Point& p)
         }
     }
 
-    double scale_width = static_cast<double>(image_raw_width_) / image_target_width_;
-    double scale_height = static_cast<double>(image_raw_height_) / image_target_height_;
+    // 优先用最近一帧自带的比例，截图通道可能正在并发更新分辨率
+    const Frame frame = cached_frame();
+    double scale_width = frame.empty() ? static_cast<double>(image_raw_width_) / image_target_width_ : frame.scale_x();
+    double scale_height = frame.empty() ? static_cast<double>(image_raw_height_) / image_target_height_ : frame.scale_y();
 
     int proced_x = static_cast<int>(std::round(p.x * scale_width));
     int proced_y = static_cast<int>(std::round(p.y * scale_height));
@@ -1058,10 +1105,15 @@ cv::Point ControllerAgent::preproc_touch_point(const cv::Point& p)
     return { proced_x, proced_y };
 }
 
-bool ControllerAgent::postproc_screenshot(const cv::Mat& raw)
+bool ControllerAgent::postproc_screenshot(const cv::Mat& raw, Frame::Clock::time_point timestamp)
 {
+    auto set_frame = [&](Frame frame) {
+        std::unique_lock lock(image_mutex_);
+        frame_ = std::move(frame);
+    };
+
     if (raw.empty()) {
-        image_ = cv::Mat();
+        set_frame({ });
         LogError << "Empty screenshot";
         return false;
     }
@@ -1073,14 +1125,22 @@ bool ControllerAgent::postproc_screenshot(const cv::Mat& raw)
         image_raw_height_ = raw.rows;
 
         if (!calc_target_image_size()) {
-            image_ = cv::Mat();
+            set_frame({ });
             LogError << "Invalid target image size";
             return false;
         }
+        resizer_.clear();
     }
 
-    cv::resize(raw, image_, { image_target_width_, image_target_height_ }, 0, 0, image_resize_method_);
-    return !image_.empty();
+    // 每帧写入独立的缓冲区（从池中复用），已发出的帧不会被覆盖
+    auto resized = resizer_.resize(raw, { image_target_width_, image_target_height_ }, image_resize_method_);
+    latency_stats_.record("controller", "resize", resized.cost);
+
+    const Frame::Id frame_id = ++last_frame_id_;
+    LogDebug << VAR(frame_id) << "resize" << VAR(FrameResizer::path_name(resized.path)) << VAR(resized.cost.count());
+
+    set_frame(Frame(frame_id, timestamp, raw.size(), std::move(resized.image), resized.cost));
+    return true;
 }
 
 bool ControllerAgent::calc_target_image_size()
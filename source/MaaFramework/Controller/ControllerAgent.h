@@ -1,12 +1,18 @@
 #pragma once
 
+#include <array>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <variant>
+#include <vector>
 
 #include "Base/AsyncRunner.hpp"
+#include "Base/LatencyStats.hpp"
 #include "Common/MaaTypes.h"
+#include "Frame.h"
+#include "FrameResizer.h"
 #include "MaaControlUnit/ControlUnitAPI.h"
 #include "MaaUtils/JsonExt.hpp"
 #include "MaaUtils/NoWarningCVMat.hpp"
@@ -123,6 +129,9 @@ struct ShellParam
     MEO_TOJSON(cmd, shell_timeout);
 };
 
+using TouchEvent = MAA_CTRL_UNIT_NS::TouchEvent;
+using TouchTrajectory = MAA_CTRL_UNIT_NS::TouchTrajectory;
+
 using Param = std::variant<
     std::monostate,
     ClickParam,
@@ -166,6 +175,9 @@ struct Action
     } type = Type::invalid;
 
     Param param;
+
+    // 执行前需等待完成的、先于它投递到其他通道的动作，投递时确定
+    std::vector<MaaCtrlId> barriers;
 };
 
 class ControllerAgent : public MaaController
@@ -240,6 +252,7 @@ public: // for Actuator
 
     bool input_text(InputTextParam p);
     cv::Mat screencap();
+    Frame cached_frame() const;
 
     bool start_app(AppParam p);
     bool stop_app(AppParam p);
@@ -249,12 +262,16 @@ public: // for Actuator
 
     std::shared_ptr<MAA_CTRL_UNIT_NS::ControlUnitAPI> control_unit() const { return control_unit_; }
 
+    LatencyStats& latency_stats() { return latency_stats_; }
+
 private:
     bool handle_connect();
     bool handle_click(const ClickParam& param);
     bool handle_long_press(const LongPressParam& param);
     bool handle_swipe(const SwipeParam& param);
     bool handle_multi_swipe(const MultiSwipeParam& param);
+    void append_swipe_trajectory(const SwipeParam& param, int contact, std::chrono::milliseconds starting, TouchTrajectory& trajectory);
+    bool play_touch_trajectory(const TouchTrajectory& trajectory);
     bool handle_touch_down(const TouchParam& param);
     bool handle_touch_move(const TouchParam& param);
     bool handle_touch_up(const TouchParam& param);
@@ -276,9 +293,26 @@ private:
     bool check_stop();
 
 private:
+    // 控制器未声明 MaaControllerFeature_ConcurrentScreencapAndInput 时，所有动作都走 Input 通道，按投递顺序逐个执行。
+    // 声明后截图、输入、应用与 shell 各走一条通道，通道内按投递顺序执行；跨通道只放开“输入不等之前的截图”，
+    // 截图仍等之前投递的输入，应用与 shell 与其他通道双向互等，并且独占控制器
+    enum class Lane
+    {
+        Capture,
+        Input,
+        App,
+        Count,
+    };
+
+    static Lane lane_of(Action::Type type);
+    bool concurrent_lanes() const;
+    AsyncRunner<Action>* runner_of(Lane lane) const { return lanes_.at(static_cast<size_t>(lane)).get(); }
+    AsyncRunner<Action>* runner_of(MaaCtrlId id) const;
+
+    bool run_lane_action(typename AsyncRunner<Action>::Id id, Action action);
     bool run_action(typename AsyncRunner<Action>::Id id, Action action);
     cv::Point preproc_touch_point(const cv::Point& p);
-    bool postproc_screenshot(const cv::Mat& raw);
+    bool postproc_screenshot(const cv::Mat& raw, Frame::Clock::time_point timestamp);
     bool calc_target_image_size();
     void clear_target_image_size();
     bool request_uuid();
@@ -298,9 +332,13 @@ private:
 private:
     const std::shared_ptr<MAA_CTRL_UNIT_NS::ControlUnitAPI> control_unit_ = nullptr;
     EventDispatcher notifier_ = EventDispatcher(false);
+    LatencyStats latency_stats_;
 
     mutable std::mutex image_mutex_;
-    cv::Mat image_;
+    std::mutex screencap_mutex_;
+    Frame frame_;
+    Frame::Id last_frame_id_ = Frame::kInvalidId;
+    FrameResizer resizer_;
     mutable std::mutex shell_output_mutex_;
     std::string shell_output_;
 
@@ -317,7 +355,12 @@ private:
 
     std::set<AsyncRunner<Action>::Id> focus_ids_;
     std::mutex focus_ids_mutex_;
-    std::unique_ptr<AsyncRunner<Action>> action_runner_ = nullptr;
+
+    std::mutex post_mutex_;
+    // 各通道最近投递的动作，用作之后投递到其他通道的动作的屏障
+    std::array<MaaCtrlId, static_cast<size_t>(Lane::Count)> last_posted_ { };
+    std::shared_mutex unit_mutex_;
+    std::array<std::unique_ptr<AsyncRunner<Action>>, static_cast<size_t>(Lane::Count)> lanes_;
 };
 
 MAA_CTRL_NS_END
@@ -0,0 +1,78 @@
+#include "Frame.h"
+
+#include <algorithm>
+
+MAA_CTRL_NS_BEGIN
+
+Frame::Frame(Id id, Clock::time_point timestamp, cv::Size raw_size, cv::Mat image, std::chrono::microseconds resize_cost)
+    : data_(std::make_shared<const Data>(Data {
+          .id = id,
+          .timestamp = timestamp,
+          .raw_size = raw_size,
+          .image = std::move(image),
+          .resize_cost = resize_cost,
+      }))
+{
+}
+
+double Frame::scale_x() const
+{
+    if (empty() || data_->image.cols == 0) {
+        return 1.0;
+    }
+    return static_cast<double>(data_->raw_size.width) / data_->image.cols;
+}
+
+double Frame::scale_y() const
+{
+    if (empty() || data_->image.rows == 0) {
+        return 1.0;
+    }
+    return static_cast<double>(data_->raw_size.height) / data_->image.rows;
+}
+
+const cv::Mat& Frame::image() const
+{
+    static const cv::Mat kEmpty;
+    return data_ ? data_->image : kEmpty;
+}
+
+FrameBufferPool::FrameBufferPool(size_t capacity)
+    : capacity_(capacity)
+{
+}
+
+cv::Mat FrameBufferPool::acquire(cv::Size size, int type)
+{
+    std::unique_lock lock(mutex_);
+
+    // refcount == 1 说明只剩池子自己持有，可以安全复用
+    auto unused = [](const cv::Mat& mat) {
+        return mat.u && CV_XADD(&mat.u->refcount, 0) == 1;
+    };
+
+    auto it = std::ranges::find_if(buffers_, [&](const cv::Mat& mat) { return unused(mat) && mat.size() == size && mat.type() == type; });
+    if (it != buffers_.end()) {
+        return *it;
+    }
+
+    cv::Mat buffer(size, type);
+
+    // 尺寸变化后旧缓冲区不再有用，优先淘汰空闲的
+    if (auto idle = std::ranges::find_if(buffers_, unused); idle != buffers_.end()) {
+        *idle = buffer;
+    }
+    else if (buffers_.size() < capacity_) {
+        buffers_.emplace_back(buffer);
+    }
+
+    return buffer;
+}
+
+void FrameBufferPool::clear()
+{
+    std::unique_lock lock(mutex_);
+    buffers_.clear();
+}
+
+MAA_CTRL_NS_END
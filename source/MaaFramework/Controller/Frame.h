@@ -0,0 +1,74 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Common/Conf.h"
+#include "MaaUtils/NoWarningCVMat.hpp"
+
+MAA_CTRL_NS_BEGIN
+
+// 一帧截图。图像缓冲区创建后不再修改，拷贝 Frame / image() 只增加引用计数
+class Frame
+{
+public:
+    using Id = uint64_t;
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr Id kInvalidId = 0;
+
+public:
+    Frame() = default;
+    Frame(Id id, Clock::time_point timestamp, cv::Size raw_size, cv::Mat image, std::chrono::microseconds resize_cost = { });
+
+    bool empty() const { return !data_ || data_->image.empty(); }
+
+    Id id() const { return data_ ? data_->id : kInvalidId; }
+
+    Clock::time_point timestamp() const { return data_ ? data_->timestamp : Clock::time_point { }; }
+
+    cv::Size raw_size() const { return data_ ? data_->raw_size : cv::Size { }; }
+
+    std::chrono::microseconds resize_cost() const { return data_ ? data_->resize_cost : std::chrono::microseconds { }; }
+
+    // raw / target，用于把目标坐标换算回设备坐标
+    double scale_x() const;
+    double scale_y() const;
+
+    // 不得原地修改返回的图像
+    const cv::Mat& image() const;
+
+private:
+    struct Data
+    {
+        Id id = kInvalidId;
+        Clock::time_point timestamp;
+        cv::Size raw_size;
+        cv::Mat image;
+        std::chrono::microseconds resize_cost { };
+    };
+
+    std::shared_ptr<const Data> data_;
+};
+
+// 复用截图缓冲区，只回收已没有任何 cv::Mat 引用的缓冲区
+class FrameBufferPool
+{
+public:
+    explicit FrameBufferPool(size_t capacity = 4);
+
+    // 返回的缓冲区内容未初始化
+    cv::Mat acquire(cv::Size size, int type);
+    void clear();
+
+private:
+    const size_t capacity_ = 0;
+
+    std::vector<cv::Mat> buffers_;
+    std::mutex mutex_;
+};
+
+MAA_CTRL_NS_END
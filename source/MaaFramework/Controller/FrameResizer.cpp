@@ -0,0 +1,65 @@
+#include "FrameResizer.h"
+
+#include "MaaUtils/NoWarningCV.hpp"
+
+#include "MaaUtils/Logger.h"
+
+MAA_CTRL_NS_BEGIN
+
+FrameResizer::Result FrameResizer::resize(const cv::Mat& raw, cv::Size target, int method)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    Result result { .path = choose_path(raw, target, method) };
+
+    switch (result.path) {
+    case Path::Noop:
+        // 控制器给出的图像不会再被修改（见 ControlUnitAPI::screencap），直接采用
+        result.image = raw;
+        break;
+
+    case Path::IntegerArea:
+        // OpenCV 对整数倍的 INTER_AREA 有向量化的快速实现（resizeAreaFast）
+        result.image = pool_.acquire(target, raw.type());
+        cv::resize(raw, result.image, target, 0, 0, cv::INTER_AREA);
+        break;
+
+    case Path::Generic:
+        result.image = pool_.acquire(target, raw.type());
+        cv::resize(raw, result.image, target, 0, 0, method);
+        break;
+    }
+
+    result.cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    return result;
+}
+
+std::string_view FrameResizer::path_name(Path path)
+{
+    switch (path) {
+    case Path::Noop:
+        return "noop";
+    case Path::IntegerArea:
+        return "integer_area";
+    case Path::Generic:
+        return "generic";
+    }
+    return "unknown";
+}
+
+FrameResizer::Path FrameResizer::choose_path(const cv::Mat& raw, cv::Size target, int method)
+{
+    if (raw.size() == target) {
+        return Path::Noop;
+    }
+
+    if (method != cv::INTER_AREA || target.empty() || raw.cols % target.width != 0 || raw.rows % target.height != 0) {
+        return Path::Generic;
+    }
+    if (raw.cols / target.width == raw.rows / target.height) {
+        return Path::IntegerArea;
+    }
+    return Path::Generic;
+}
+
+MAA_CTRL_NS_END
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chrono>
+#include <string_view>
+
+#include "Common/Conf.h"
+#include "Frame.h"
+#include "MaaUtils/NoWarningCVMat.hpp"
+
+MAA_CTRL_NS_BEGIN
+
+// 截图缩放：尺寸相同时直接复用原图；其余交给 cv::resize，目标缓冲来自缓冲池。
+// INTER_AREA 的整数倍缩小单独标出，便于在耗时统计里区分（OpenCV 对它有向量化的快速实现）
+class FrameResizer
+{
+public:
+    enum class Path
+    {
+        Noop,
+        IntegerArea,
+        Generic,
+    };
+
+    struct Result
+    {
+        cv::Mat image;
+        Path path = Path::Generic;
+        std::chrono::microseconds cost { };
+    };
+
+public:
+    Result resize(const cv::Mat& raw, cv::Size target, int method);
+    void clear() { pool_.clear(); }
+
+    static std::string_view path_name(Path path);
+
+private:
+    static Path choose_path(const cv::Mat& raw, cv::Size target, int method);
+
+private:
+    FrameBufferPool pool_;
+};
+
+MAA_CTRL_NS_END
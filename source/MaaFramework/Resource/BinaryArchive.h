@@ -0,0 +1,310 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <meojson/json.hpp>
+
+#include "Common/Conf.h"
+#include "MaaUtils/NoWarningCVMat.hpp"
+
+MAA_RES_NS_BEGIN
+
+// 结构体的字段列表，由使用方特化，读写共用同一份列表：
+// template <typename Ar> static auto apply(Ar& ar, T& v) { return ar(v.a, v.b); }
+template <typename T>
+struct BinaryFields;
+
+namespace binary_archive_detail
+{
+template <typename T, template <typename...> typename Tmpl>
+struct is_specialization : std::false_type
+{
+};
+
+template <template <typename...> typename Tmpl, typename... Args>
+struct is_specialization<Tmpl<Args...>, Tmpl> : std::true_type
+{
+};
+
+template <typename T>
+struct is_duration : std::false_type
+{
+};
+
+template <typename Rep, typename Period>
+struct is_duration<std::chrono::duration<Rep, Period>> : std::true_type
+{
+};
+
+template <typename T>
+inline constexpr bool is_map_v = is_specialization<T, std::map>::value || is_specialization<T, std::unordered_map>::value;
+} // namespace binary_archive_detail
+
+// 预编译资源包的二进制编码。数值按本机字节序和宽度原样写入，只保证同一平台的构建之间可读，
+// 由 CompiledBundle 的文件头校验；字段有增删时须提升 CompiledBundle::kVersion
+class BinaryWriter
+{
+public:
+    explicit BinaryWriter(std::string& out)
+        : out_(out)
+    {
+    }
+
+    template <typename... Ts>
+    void operator()(const Ts&... values)
+    {
+        (write(values), ...);
+    }
+
+private:
+    template <typename T>
+    void write(const T& value)
+    {
+        using namespace binary_archive_detail;
+
+        if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+            out_.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+        else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+            write(static_cast<uint64_t>(value.size()));
+            out_.append(value);
+        }
+        else if constexpr (std::is_same_v<T, std::wstring>) {
+            // wchar_t 在各平台宽度不同，统一按 32 位写
+            write(static_cast<uint64_t>(value.size()));
+            for (wchar_t ch : value) {
+                write(static_cast<uint32_t>(ch));
+            }
+        }
+        else if constexpr (is_duration<T>::value) {
+            write(static_cast<int64_t>(value.count()));
+        }
+        else if constexpr (std::is_same_v<T, cv::Rect>) {
+            write(value.x);
+            write(value.y);
+            write(value.width);
+            write(value.height);
+        }
+        else if constexpr (std::is_same_v<T, json::value>) {
+            write(value.to_string());
+        }
+        else if constexpr (std::is_same_v<T, json::object>) {
+            write(json::value(value).to_string());
+        }
+        else if constexpr (std::is_same_v<T, std::monostate>) {
+        }
+        else if constexpr (is_specialization<T, std::vector>::value) {
+            write(static_cast<uint64_t>(value.size()));
+            for (const auto& item : value) {
+                write(item);
+            }
+        }
+        else if constexpr (is_map_v<T>) {
+            write(static_cast<uint64_t>(value.size()));
+            for (const auto& [key, item] : value) {
+                write(key);
+                write(item);
+            }
+        }
+        else if constexpr (is_specialization<T, std::pair>::value) {
+            write(value.first);
+            write(value.second);
+        }
+        else if constexpr (is_specialization<T, std::variant>::value) {
+            write(static_cast<uint32_t>(value.index()));
+            std::visit([&](const auto& alt) { write(alt); }, value);
+        }
+        else if constexpr (is_specialization<T, std::shared_ptr>::value) {
+            write(static_cast<bool>(value));
+            if (value) {
+                write(*value);
+            }
+        }
+        else {
+            // 字段列表读写共用，写时不会修改
+            BinaryFields<T>::apply(*this, const_cast<T&>(value));
+        }
+    }
+
+private:
+    std::string& out_;
+};
+
+class BinaryReader
+{
+public:
+    explicit BinaryReader(std::string_view data)
+        : data_(data)
+    {
+    }
+
+    template <typename... Ts>
+    bool operator()(Ts&... values)
+    {
+        return (read(values) && ...);
+    }
+
+    size_t remaining() const { return data_.size() - pos_; }
+
+private:
+    template <typename T>
+    bool read(T& value)
+    {
+        using namespace binary_archive_detail;
+
+        if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+            return bytes(&value, sizeof(value));
+        }
+        else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+            // string_view 直接指向输入数据，不拷贝，调用方需保证输入数据的生命周期
+            uint64_t size = 0;
+            if (!read(size) || size > remaining()) {
+                return false;
+            }
+            value = T(data_.data() + pos_, static_cast<size_t>(size));
+            pos_ += static_cast<size_t>(size);
+            return true;
+        }
+        else if constexpr (std::is_same_v<T, std::wstring>) {
+            uint64_t size = 0;
+            if (!read(size) || size > remaining() / sizeof(uint32_t)) {
+                return false;
+            }
+            value.resize(static_cast<size_t>(size));
+            for (wchar_t& ch : value) {
+                uint32_t unit = 0;
+                if (!read(unit)) {
+                    return false;
+                }
+                ch = static_cast<wchar_t>(unit);
+            }
+            return true;
+        }
+        else if constexpr (is_duration<T>::value) {
+            int64_t count = 0;
+            if (!read(count)) {
+                return false;
+            }
+            value = T(static_cast<typename T::rep>(count));
+            return true;
+        }
+        else if constexpr (std::is_same_v<T, cv::Rect>) {
+            return read(value.x) && read(value.y) && read(value.width) && read(value.height);
+        }
+        else if constexpr (std::is_same_v<T, json::value> || std::is_same_v<T, json::object>) {
+            std::string text;
+            if (!read(text)) {
+                return false;
+            }
+            auto parsed = json::parse(text);
+            if (!parsed) {
+                return false;
+            }
+            if constexpr (std::is_same_v<T, json::object>) {
+                if (!parsed->is_object()) {
+                    return false;
+                }
+                value = parsed->as_object();
+            }
+            else {
+                value = *std::move(parsed);
+            }
+            return true;
+        }
+        else if constexpr (std::is_same_v<T, std::monostate>) {
+            return true;
+        }
+        else if constexpr (is_specialization<T, std::vector>::value) {
+            uint64_t size = 0;
+            // 每个元素至少占一个字节，防止损坏的长度导致巨量分配
+            if (!read(size) || size > remaining()) {
+                return false;
+            }
+            value.clear();
+            value.resize(static_cast<size_t>(size));
+            for (auto& item : value) {
+                if (!read(item)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        else if constexpr (is_map_v<T>) {
+            uint64_t size = 0;
+            if (!read(size) || size > remaining()) {
+                return false;
+            }
+            value.clear();
+            for (uint64_t i = 0; i < size; ++i) {
+                typename T::key_type key { };
+                typename T::mapped_type item { };
+                if (!read(key) || !read(item)) {
+                    return false;
+                }
+                value.insert_or_assign(std::move(key), std::move(item));
+            }
+            return true;
+        }
+        else if constexpr (is_specialization<T, std::pair>::value) {
+            return read(value.first) && read(value.second);
+        }
+        else if constexpr (is_specialization<T, std::variant>::value) {
+            uint32_t index = 0;
+            if (!read(index) || index >= std::variant_size_v<T>) {
+                return false;
+            }
+            return read_variant(value, index, std::make_index_sequence<std::variant_size_v<T>>());
+        }
+        else if constexpr (is_specialization<T, std::shared_ptr>::value) {
+            bool has_value = false;
+            if (!read(has_value)) {
+                return false;
+            }
+            if (!has_value) {
+                value = nullptr;
+                return true;
+            }
+            value = std::make_shared<typename T::element_type>();
+            return read(*value);
+        }
+        else {
+            return BinaryFields<T>::apply(*this, value);
+        }
+    }
+
+    template <typename V, size_t... I>
+    bool read_variant(V& value, uint32_t index, std::index_sequence<I...>)
+    {
+        bool ret = false;
+        std::ignore = ((index == I ? (ret = read(value.template emplace<I>()), true) : false) || ...);
+        return ret;
+    }
+
+    bool bytes(void* dst, size_t size)
+    {
+        if (size > remaining()) {
+            return false;
+        }
+        std::memcpy(dst, data_.data() + pos_, size);
+        pos_ += size;
+        return true;
+    }
+
+private:
+    std::string_view data_;
+    size_t pos_ = 0;
+};
+
+MAA_RES_NS_END
@@ -0,0 +1,263 @@
+#include "CompiledBundle.h"
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+
+#include "BinaryArchive.h"
+#include "DefaultPipelineMgr.h"
+#include "FileDigest.h"
+#include "MaaUtils/Logger.h"
+#include "MaaUtils/Platform.h"
+#include "PipelineChecker.h"
+#include "PipelineResMgr.h"
+#include "PipelineSerializer.h"
+
+MAA_RES_NS_BEGIN
+
+template <>
+struct BinaryFields<CompiledBundle::SourceFile>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, CompiledBundle::SourceFile& v)
+    {
+        return ar(v.path, v.size, v.mtime, v.digest);
+    }
+};
+
+template <>
+struct BinaryFields<CompiledBundle::ManifestEntry>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, CompiledBundle::ManifestEntry& v)
+    {
+        return ar(v.path, v.exists, v.size, v.mtime);
+    }
+};
+
+static CompiledBundle::ManifestEntry stat_entry(const std::filesystem::path& bundle_dir, const std::string& rel_path)
+{
+    CompiledBundle::ManifestEntry entry { .path = rel_path };
+
+    std::error_code ec;
+    const std::filesystem::directory_entry dir_entry(bundle_dir / MAA_NS::path(rel_path), ec);
+    if (ec || !dir_entry.exists(ec)) {
+        return entry;
+    }
+
+    entry.exists = true;
+    if (dir_entry.is_regular_file(ec)) {
+        entry.size = dir_entry.file_size(ec);
+    }
+    entry.mtime = static_cast<int64_t>(dir_entry.last_write_time(ec).time_since_epoch().count());
+    return entry;
+}
+
+bool CompiledBundle::compile(const std::filesystem::path& bundle_dir, const std::filesystem::path& output)
+{
+    LogFunc << VAR(bundle_dir) << VAR(output);
+
+    using namespace path_literals;
+
+    std::error_code ec;
+    const auto source = std::filesystem::canonical(bundle_dir, ec);
+    if (ec || !std::filesystem::is_directory(source)) {
+        LogError << "bundle path not exists or not a directory" << VAR(bundle_dir);
+        return false;
+    }
+
+    // 与 ResourceMgr::load_bundle 相同的流程完整解析、校验一遍，保证产物可以直接使用
+    DefaultPipelineMgr default_mgr;
+    json::value default_json;
+    for (const auto& filename : { "default_pipeline.jsonc"_path, "default_pipeline.json"_path }) {
+        auto p = source / filename;
+        if (!std::filesystem::exists(p)) {
+            continue;
+        }
+        auto json_opt = json::open(p, true, true);
+        if (!json_opt || !default_mgr.load(*json_opt)) {
+            LogError << "failed to load default pipeline" << VAR(p);
+            return false;
+        }
+        default_json = *std::move(json_opt);
+        break;
+    }
+
+    json::object nodes;
+    PipelineResMgr pipeline_mgr;
+    bool has_pipeline = false;
+    if (auto pipeline_dir = source / "pipeline"_path; std::filesystem::exists(pipeline_dir)) {
+        for (const auto& file : PipelineResMgr::list_json_files(pipeline_dir)) {
+            auto json_opt = json::open(file, true, true);
+            if (!json_opt || !json_opt->is_object()) {
+                LogError << "json::open failed or not object" << VAR(file);
+                return false;
+            }
+            for (const auto& [key, value] : json_opt->as_object()) {
+                if (key.starts_with(PipelineData::kNodePrefix_Ignore)) {
+                    continue;
+                }
+                if (nodes.contains(key)) {
+                    LogError << "key already exists" << VAR(key) << VAR(file);
+                    return false;
+                }
+                nodes.emplace(key, value);
+            }
+        }
+
+        has_pipeline = true;
+        std::set<std::string> existing_keys;
+        if (!pipeline_mgr.parse_and_override(nodes, existing_keys, default_mgr)
+            || !PipelineChecker::check_all_validity(pipeline_mgr.get_pipeline_data_map())) {
+            LogError << "pipeline is invalid" << VAR(pipeline_dir);
+            return false;
+        }
+    }
+
+    // 源目录按相对产物所在目录记录，产物与源目录一起移动后仍可使用；不在同一根目录下时只能记录绝对路径
+    const auto output_dir = std::filesystem::weakly_canonical(output, ec).parent_path();
+    auto rel_source = std::filesystem::relative(source, output_dir, ec);
+    if (ec || rel_source.empty()) {
+        rel_source = source;
+    }
+
+    std::string pipeline_data;
+    PipelineSerializer::write(pipeline_data, pipeline_mgr.get_pipeline_data_map());
+
+    std::string content(kMagic);
+    BinaryWriter writer(content);
+    writer(kVersion, kByteOrderMark);
+    writer(
+        path_to_utf8_string(rel_source),
+        make_manifest(source),
+        make_stamp(source, output, true),
+        default_json.is_null() ? std::string() : default_json.to_string(),
+        pipeline_data,
+        has_pipeline ? json::value(std::move(nodes)).to_string() : std::string());
+
+    std::ofstream ofs(output, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+        LogError << "failed to open output" << VAR(output);
+        return false;
+    }
+    ofs.write(content.data(), content.size());
+
+    LogInfo << "compiled" << VAR(source) << VAR(output) << VAR(content.size());
+    return ofs.good();
+}
+
+bool CompiledBundle::is_compiled(const std::filesystem::path& path)
+{
+    std::ifstream ifs(path, std::ios::binary);
+    std::string magic(kMagic.size(), '\0');
+    return ifs.read(magic.data(), magic.size()) && magic == kMagic;
+}
+
+std::optional<CompiledBundle> CompiledBundle::open(const std::filesystem::path& path)
+{
+    LogFunc << VAR(path);
+
+    auto file_opt = MappedFile::open(path);
+    if (!file_opt) {
+        LogError << "failed to open" << VAR(path);
+        return std::nullopt;
+    }
+
+    const auto data = file_opt->view();
+    if (!data.starts_with(kMagic)) {
+        LogError << "not a compiled bundle" << VAR(path);
+        return std::nullopt;
+    }
+
+    BinaryReader reader(data.substr(kMagic.size()));
+    uint32_t version = 0;
+    uint32_t byte_order = 0;
+    if (!reader(version) || version != kVersion) {
+        LogWarn << "compiled bundle version mismatch" << VAR(path) << VAR(version) << VAR(kVersion);
+        return std::nullopt;
+    }
+    if (!reader(byte_order) || byte_order != kByteOrderMark) {
+        LogWarn << "compiled bundle byte order mismatch" << VAR(path) << VAR(byte_order);
+        return std::nullopt;
+    }
+
+    // 各段直接引用映射的内存，不拷贝
+    CompiledBundle bundle;
+    std::string source;
+    if (!reader(source, bundle.manifest_, bundle.stamp_, bundle.default_pipeline_, bundle.pipeline_data_, bundle.pipeline_json_)
+        || reader.remaining() != 0) {
+        LogError << "corrupted compiled bundle" << VAR(path) << VAR(data.size());
+        return std::nullopt;
+    }
+    bundle.file_ = *std::move(file_opt);
+
+    auto source_path = MAA_NS::path(source);
+    if (source_path.is_relative()) {
+        source_path = (path.parent_path() / source_path).lexically_normal();
+    }
+    bundle.source_ = std::move(source_path);
+
+    return bundle;
+}
+
+CompiledBundle::SourceStamp
+    CompiledBundle::make_stamp(const std::filesystem::path& bundle_dir, const std::filesystem::path& exclude, bool with_digest)
+{
+    std::error_code ec;
+    const auto excluded = std::filesystem::weakly_canonical(exclude, ec);
+
+    SourceStamp stamp;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(bundle_dir, ec)) {
+        if (entry.path() == excluded) {
+            continue;
+        }
+        auto stat = FileDigestCache::stat_of(entry);
+        if (!stat) {
+            continue;
+        }
+
+        SourceFile file {
+            .path = path_to_utf8_string(std::filesystem::relative(entry.path(), bundle_dir)),
+            .size = stat->size,
+            .mtime = stat->mtime,
+        };
+        if (with_digest) {
+            file.digest = FileDigestCache::get_instance().digest(entry.path(), *stat).value_or(0);
+        }
+        stamp.emplace_back(std::move(file));
+    }
+    std::ranges::sort(stamp, { }, &SourceFile::path);
+    return stamp;
+}
+
+CompiledBundle::Manifest CompiledBundle::make_manifest(const std::filesystem::path& bundle_dir)
+{
+    using namespace path_literals;
+
+    // 根目录本身不记录：产物可能就写在根目录下，会改变其修改时间
+    Manifest manifest;
+    for (const auto& name : { "default_pipeline.jsonc"_path, "default_pipeline.json"_path, "pipeline"_path }) {
+        manifest.emplace_back(stat_entry(bundle_dir, path_to_utf8_string(name)));
+    }
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(bundle_dir / "pipeline"_path, ec)) {
+        manifest.emplace_back(stat_entry(bundle_dir, path_to_utf8_string(std::filesystem::relative(entry.path(), bundle_dir))));
+    }
+    std::ranges::sort(manifest, { }, &ManifestEntry::path);
+    return manifest;
+}
+
+bool CompiledBundle::is_fresh() const
+{
+    return std::ranges::all_of(manifest_, [&](const ManifestEntry& entry) { return stat_entry(source_, entry.path) == entry; });
+}
+
+bool CompiledBundle::is_fresh(const SourceStamp& current) const
+{
+    return std::ranges::equal(stamp_, current, [](const SourceFile& lhs, const SourceFile& rhs) {
+        return lhs.path == rhs.path && lhs.size == rhs.size && lhs.mtime == rhs.mtime;
+    });
+}
+
+MAA_RES_NS_END
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/Conf.h"
+#include "MappedFile.h"
+
+MAA_RES_NS_BEGIN
+
+// 预编译资源包：bundle 中的默认参数和所有 pipeline 节点合并、解析、校验后写入单个文件。
+// 节点以 PipelineSerializer 的二进制形式保存，加载时映射文件后直接还原 PipelineDataMap，不经过 JSON 和 PipelineParser；
+// 同时保留合并后的节点 JSON，叠加在已有资源之上时（默认参数可能不同）退回重新解析。
+// 过期检查只 stat 清单中记录的路径：默认参数文件、pipeline 目录下的文件及各级子目录（增删文件会改变目录的修改时间）；
+// 整个源目录的逐文件快照仍然保存，仅在显式要求时（MaaResOption_CompiledBundleVerifySources）比较。
+// 源目录记录为相对产物所在目录的路径，两者一起移动后仍可使用
+class CompiledBundle
+{
+public:
+    inline static constexpr std::string_view kMagic { "MAABNDL\0", 8 };
+    inline static constexpr uint32_t kVersion = 4;
+    // 数值按本机字节序写入，字节序不同的平台上不可用
+    inline static constexpr uint32_t kByteOrderMark = 0x01020304;
+
+    struct SourceFile
+    {
+        std::string path; // 相对 bundle 根目录
+        uintmax_t size = 0;
+        int64_t mtime = 0;
+        uint64_t digest = 0; // FileDigestCache::kAlgorithm，仅编译时计算
+    };
+
+    using SourceStamp = std::vector<SourceFile>;
+
+    struct ManifestEntry
+    {
+        std::string path; // 相对 bundle 根目录
+        bool exists = false;
+        uintmax_t size = 0; // 目录为 0
+        int64_t mtime = 0;
+
+        bool operator==(const ManifestEntry&) const = default;
+    };
+
+    using Manifest = std::vector<ManifestEntry>;
+
+public:
+    static bool compile(const std::filesystem::path& bundle_dir, const std::filesystem::path& output);
+    static bool is_compiled(const std::filesystem::path& path);
+    static std::optional<CompiledBundle> open(const std::filesystem::path& path);
+
+    // 遍历整个源目录。产物位于 bundle 目录内时需通过 exclude 排除自身；with_digest 为 false 时只取文件状态，不读内容
+    static SourceStamp make_stamp(const std::filesystem::path& bundle_dir, const std::filesystem::path& exclude, bool with_digest);
+
+public:
+    const std::filesystem::path& source() const { return source_; }
+
+    const SourceStamp& stamp() const { return stamp_; }
+
+    // 只 stat 清单中的路径
+    bool is_fresh() const;
+    // 逐文件比较完整快照，只比较路径、大小与修改时间
+    bool is_fresh(const SourceStamp& current) const;
+
+    // 以下视图指向映射的文件，生命周期与 CompiledBundle 相同
+
+    // 默认参数的 JSON 文本，没有 default_pipeline.json(c) 时为空
+    std::string_view default_pipeline() const { return default_pipeline_; }
+
+    // PipelineSerializer 写出的节点
+    std::string_view pipeline_data() const { return pipeline_data_; }
+
+    // 合并后的节点 JSON 文本，没有 pipeline 目录时为空
+    std::string_view pipeline_json() const { return pipeline_json_; }
+
+private:
+    static Manifest make_manifest(const std::filesystem::path& bundle_dir);
+
+private:
+    MappedFile file_;
+
+    std::filesystem::path source_;
+    Manifest manifest_;
+    SourceStamp stamp_;
+    std::string_view default_pipeline_;
+    std::string_view pipeline_data_;
+    std::string_view pipeline_json_;
+};
+
+MAA_RES_NS_END
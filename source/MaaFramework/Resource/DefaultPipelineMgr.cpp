@@ -18,9 +18,15 @@ bool DefaultPipelineMgr::load(const std::filesystem::path& path)
         LogError << "json::open failed" << VAR(path);
         return false;
     }
-    const auto& json = *json_opt;
+
+    return load(*json_opt);
+}
+
+bool DefaultPipelineMgr::load(const json::value& json)
+{
     LogInfo << VAR(json);
 
+    loaded_ = true;
     return parse_pipeline(json) && parse_recognition(json) && parse_action(json);
 }
 
@@ -17,11 +17,15 @@ class DefaultPipelineMgr : public NonCopyable
 {
 public:
     bool load(const std::filesystem::path& path);
+    bool load(const json::value& json);
     void clear();
 
 public:
     const PipelineData& get_pipeline() const { return pipeline_param_; }
 
+    // clear 不会重置 Default 节点，因此一旦加载过就不再视为初始状态
+    bool loaded() const { return loaded_; }
+
     template <typename T>
     struct is_shared_ptr : std::false_type
     {
@@ -69,6 +73,7 @@ private:
     PipelineData pipeline_param_;
     std::unordered_map<Recognition::Type, Recognition::Param> recognition_param_;
     std::unordered_map<Action::Type, Action::Param> action_param_;
+    bool loaded_ = false;
 };
 
 MAA_RES_NS_END
@@ -0,0 +1,134 @@
+#include "FileDigest.h"
+
+#include <format>
+#include <fstream>
+#include <vector>
+
+#include "MaaUtils/Logger.h"
+#include "MaaUtils/Platform.h"
+
+MAA_RES_NS_BEGIN
+
+namespace
+{
+
+constexpr uint64_t xxh64_of(std::string_view str, size_t chunk = 0)
+{
+    XXH64 hasher;
+    if (chunk == 0) {
+        hasher.update(str);
+    }
+    for (size_t pos = 0; chunk > 0 && pos < str.size(); pos += chunk) {
+        hasher.update(str.substr(pos, chunk));
+    }
+    return hasher.digest();
+}
+
+// 参考实现（xxHash）的已知结果：空输入、不足一个 stripe、超过 32 字节，以及分块输入
+constexpr std::string_view kLongInput = "Nobody inspects the spammish repetition";
+static_assert(xxh64_of("") == 0xEF46DB3751D8E999ULL);
+static_assert(xxh64_of("a") == 0xD24EC4F1A98C6E5BULL);
+static_assert(xxh64_of("abc") == 0x44BC2CF5AD770999ULL);
+static_assert(xxh64_of(kLongInput) == 0xFBCEA83C8A378BF1ULL);
+static_assert(xxh64_of(kLongInput, 5) == 0xFBCEA83C8A378BF1ULL);
+static_assert(xxh64_of(kLongInput, 33) == 0xFBCEA83C8A378BF1ULL);
+
+} // namespace
+
+std::optional<uint64_t> FileDigestCache::digest(const std::filesystem::path& path)
+{
+    auto stat = stat_of(std::filesystem::directory_entry(path));
+    if (!stat) {
+        LogError << "failed to stat" << VAR(path);
+        return std::nullopt;
+    }
+    return digest(path, *stat);
+}
+
+std::optional<uint64_t> FileDigestCache::digest(const std::filesystem::path& path, const FileStat& stat)
+{
+    const auto key = path_to_utf8_string(std::filesystem::absolute(path));
+    {
+        std::unique_lock lock(mutex_);
+        if (auto it = entries_.find(key); it != entries_.end() && it->second.stat == stat) {
+            lru_.splice(lru_.begin(), lru_, it->second.lru_iter);
+            return it->second.digest;
+        }
+    }
+
+    auto digest_opt = read_and_digest(path);
+    if (!digest_opt) {
+        return std::nullopt;
+    }
+
+    std::unique_lock lock(mutex_);
+    put(key, stat, *digest_opt);
+    return digest_opt;
+}
+
+void FileDigestCache::seed(const std::filesystem::path& path, const FileStat& stat, uint64_t digest)
+{
+    const auto key = path_to_utf8_string(std::filesystem::absolute(path));
+
+    std::unique_lock lock(mutex_);
+    put(key, stat, digest);
+}
+
+void FileDigestCache::put(const std::string& key, const FileStat& stat, uint64_t digest)
+{
+    auto [it, inserted] = entries_.try_emplace(key);
+    if (inserted) {
+        it->second.lru_iter = lru_.emplace(lru_.begin(), key);
+    }
+    else {
+        lru_.splice(lru_.begin(), lru_, it->second.lru_iter);
+    }
+    it->second.stat = stat;
+    it->second.digest = digest;
+
+    while (entries_.size() > kMaxEntries) {
+        entries_.erase(lru_.back());
+        lru_.pop_back();
+    }
+}
+
+std::optional<FileDigestCache::FileStat> FileDigestCache::stat_of(const std::filesystem::directory_entry& entry)
+{
+    std::error_code ec;
+    if (!entry.is_regular_file(ec) || ec) {
+        return std::nullopt;
+    }
+
+    auto size = entry.file_size(ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    auto mtime = entry.last_write_time(ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    return FileStat { .size = size, .mtime = static_cast<int64_t>(mtime.time_since_epoch().count()) };
+}
+
+std::string FileDigestCache::to_string(uint64_t digest)
+{
+    return std::format("{}:{:016x}", kAlgorithm, digest);
+}
+
+std::optional<uint64_t> FileDigestCache::read_and_digest(const std::filesystem::path& path)
+{
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs.is_open()) {
+        LogError << "failed to open" << VAR(path);
+        return std::nullopt;
+    }
+
+    XXH64 hasher;
+    std::vector<char> buffer(256 * 1024);
+    while (ifs.read(buffer.data(), buffer.size()) || ifs.gcount() > 0) {
+        hasher.update(buffer.data(), static_cast<size_t>(ifs.gcount()));
+    }
+    return hasher.digest();
+}
+
+MAA_RES_NS_END
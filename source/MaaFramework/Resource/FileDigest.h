@@ -0,0 +1,215 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "Common/Conf.h"
+#include "MaaUtils/SingletonHolder.hpp"
+
+MAA_RES_NS_BEGIN
+
+// 流式 XXH64。全部为 constexpr，FileDigest.cpp 中用参考向量做编译期校验
+class XXH64
+{
+public:
+    constexpr explicit XXH64(uint64_t seed = 0)
+        : acc_ { seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1 }
+        , seed_(seed)
+    {
+    }
+
+    void update(const void* data, size_t size);
+    constexpr void update(std::string_view str);
+    constexpr uint64_t digest() const;
+
+private:
+    inline static constexpr uint64_t kPrime1 = 11400714785074694791ULL;
+    inline static constexpr uint64_t kPrime2 = 14029467366897019727ULL;
+    inline static constexpr uint64_t kPrime3 = 1609587929392839161ULL;
+    inline static constexpr uint64_t kPrime4 = 9650029242287828579ULL;
+    inline static constexpr uint64_t kPrime5 = 2870177450012600261ULL;
+
+    // 按小端读取，与平台字节序无关；编译器会合并成一次读取
+    template <typename Byte>
+    static constexpr uint64_t read_le(const Byte* p, int bytes)
+    {
+        uint64_t v = 0;
+        for (int i = bytes - 1; i >= 0; --i) {
+            v = (v << 8) | static_cast<uint8_t>(p[i]);
+        }
+        return v;
+    }
+
+    static constexpr uint64_t round(uint64_t acc, uint64_t input)
+    {
+        acc += input * kPrime2;
+        acc = std::rotl(acc, 31);
+        return acc * kPrime1;
+    }
+
+    static constexpr uint64_t merge_round(uint64_t acc, uint64_t val)
+    {
+        acc ^= round(0, val);
+        return acc * kPrime1 + kPrime4;
+    }
+
+    template <typename Byte>
+    constexpr void update_bytes(const Byte* p, size_t size);
+
+    template <typename Byte>
+    constexpr void consume_stripe(const Byte* stripe)
+    {
+        for (size_t i = 0; i < acc_.size(); ++i) {
+            acc_[i] = round(acc_[i], read_le(stripe + i * 8, 8));
+        }
+    }
+
+private:
+    std::array<uint64_t, 4> acc_ { };
+    std::array<uint8_t, 32> buffer_ { };
+    size_t buffer_size_ = 0;
+    uint64_t total_size_ = 0;
+    uint64_t seed_ = 0;
+};
+
+inline void XXH64::update(const void* data, size_t size)
+{
+    update_bytes(static_cast<const uint8_t*>(data), size);
+}
+
+constexpr void XXH64::update(std::string_view str)
+{
+    update_bytes(str.data(), str.size());
+}
+
+template <typename Byte>
+constexpr void XXH64::update_bytes(const Byte* p, size_t size)
+{
+    const auto end = p + size;
+    total_size_ += size;
+
+    auto fill_buffer = [&](size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            buffer_[buffer_size_ + i] = static_cast<uint8_t>(p[i]);
+        }
+        buffer_size_ += count;
+        p += count;
+    };
+
+    if (buffer_size_ + size < buffer_.size()) {
+        fill_buffer(size);
+        return;
+    }
+
+    if (buffer_size_ > 0) {
+        fill_buffer(buffer_.size() - buffer_size_);
+        consume_stripe(buffer_.data());
+        buffer_size_ = 0;
+    }
+
+    for (; end - p >= static_cast<ptrdiff_t>(buffer_.size()); p += buffer_.size()) {
+        consume_stripe(p);
+    }
+
+    fill_buffer(static_cast<size_t>(end - p));
+}
+
+constexpr uint64_t XXH64::digest() const
+{
+    uint64_t h = 0;
+    if (total_size_ >= buffer_.size()) {
+        h = std::rotl(acc_[0], 1) + std::rotl(acc_[1], 7) + std::rotl(acc_[2], 12) + std::rotl(acc_[3], 18);
+        for (auto acc : acc_) {
+            h = merge_round(h, acc);
+        }
+    }
+    else {
+        h = seed_ + kPrime5;
+    }
+    h += total_size_;
+
+    const uint8_t* p = buffer_.data();
+    const uint8_t* end = p + buffer_size_;
+    for (; end - p >= 8; p += 8) {
+        h ^= round(0, read_le(p, 8));
+        h = std::rotl(h, 27) * kPrime1 + kPrime4;
+    }
+    if (end - p >= 4) {
+        h ^= read_le(p, 4) * kPrime1;
+        h = std::rotl(h, 23) * kPrime2 + kPrime3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        h ^= *p * kPrime5;
+        h = std::rotl(h, 11) * kPrime1;
+    }
+
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime3;
+    h ^= h >> 32;
+    return h;
+}
+
+// 进程内的文件内容摘要缓存，以 (路径, 大小, 修改时间) 为键，未变化的文件不会重新读取。
+// 最多保留 kMaxEntries 条，超出时淘汰最久未用的
+class FileDigestCache : public SingletonHolder<FileDigestCache>
+{
+public:
+    friend class SingletonHolder<FileDigestCache>;
+
+    inline static constexpr std::string_view kAlgorithm = "xxh64";
+    inline static constexpr size_t kMaxEntries = 16384;
+
+    struct FileStat
+    {
+        uintmax_t size = 0;
+        int64_t mtime = 0;
+
+        bool operator==(const FileStat&) const = default;
+    };
+
+public:
+    virtual ~FileDigestCache() = default;
+
+    std::optional<uint64_t> digest(const std::filesystem::path& path);
+    // 已经拿到文件状态（如遍历目录时）可直接传入，省去一次 stat
+    std::optional<uint64_t> digest(const std::filesystem::path& path, const FileStat& stat);
+    // 记录已知的摘要，如预编译资源包中保存的摘要
+    void seed(const std::filesystem::path& path, const FileStat& stat, uint64_t digest);
+
+    static std::optional<FileStat> stat_of(const std::filesystem::directory_entry& entry);
+    static std::string to_string(uint64_t digest);
+
+private:
+    FileDigestCache() = default;
+
+    static std::optional<uint64_t> read_and_digest(const std::filesystem::path& path);
+
+private:
+    struct Entry
+    {
+        FileStat stat;
+        uint64_t digest = 0;
+        std::list<std::string>::iterator lru_iter;
+    };
+
+    // 调用方需持有 mutex_
+    void put(const std::string& key, const FileStat& stat, uint64_t digest);
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::list<std::string> lru_; // 越靠前越新
+};
+
+MAA_RES_NS_END
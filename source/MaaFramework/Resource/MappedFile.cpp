@@ -0,0 +1,126 @@
+#include "MappedFile.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#include "MaaUtils/SafeWindows.hpp"
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "MaaUtils/Logger.h"
+
+MAA_RES_NS_BEGIN
+
+std::optional<MappedFile> MappedFile::open(const std::filesystem::path& path)
+{
+    MappedFile file;
+
+#ifdef _WIN32
+    HANDLE handle =
+        CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        LogError << "failed to open file" << VAR(path) << VAR(GetLastError());
+        return std::nullopt;
+    }
+
+    LARGE_INTEGER size { };
+    if (!GetFileSizeEx(handle, &size)) {
+        LogError << "failed to get file size" << VAR(path) << VAR(GetLastError());
+        CloseHandle(handle);
+        return std::nullopt;
+    }
+    if (size.QuadPart == 0) {
+        CloseHandle(handle);
+        return file;
+    }
+
+    // 映射视图会持有 mapping 对象，两个句柄都可以立即关闭
+    HANDLE mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(handle);
+    if (mapping == nullptr) {
+        LogError << "failed to create file mapping" << VAR(path) << VAR(GetLastError());
+        return std::nullopt;
+    }
+
+    file.data_ = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (file.data_ == nullptr) {
+        LogError << "failed to map view of file" << VAR(path) << VAR(GetLastError());
+        return std::nullopt;
+    }
+    file.size_ = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        LogError << "failed to open file" << VAR(path) << VAR(errno);
+        return std::nullopt;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        LogError << "failed to stat file" << VAR(path) << VAR(errno);
+        ::close(fd);
+        return std::nullopt;
+    }
+    if (st.st_size == 0) {
+        ::close(fd);
+        return file;
+    }
+
+    // 映射建立后不再需要 fd
+    void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        LogError << "failed to mmap file" << VAR(path) << VAR(errno);
+        return std::nullopt;
+    }
+    file.data_ = data;
+    file.size_ = static_cast<size_t>(st.st_size);
+#endif
+
+    return file;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr))
+    , size_(std::exchange(other.size_, 0))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        reset();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    reset();
+}
+
+void MappedFile::reset()
+{
+    if (!data_) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+#else
+    munmap(data_, size_);
+#endif
+
+    data_ = nullptr;
+    size_ = 0;
+}
+
+MAA_RES_NS_END
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+#include "Common/Conf.h"
+
+MAA_RES_NS_BEGIN
+
+// 只读映射整个文件，析构时解除映射；空文件得到空视图
+class MappedFile
+{
+public:
+    static std::optional<MappedFile> open(const std::filesystem::path& path);
+
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+public:
+    std::string_view view() const { return { static_cast<const char*>(data_), size_ }; }
+
+private:
+    void reset();
+
+private:
+    void* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+MAA_RES_NS_END
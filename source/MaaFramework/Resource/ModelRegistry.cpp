@@ -0,0 +1,69 @@
+#include "ModelRegistry.h"
+
+#include <format>
+
+#include "FileDigest.h"
+#include "MaaUtils/Logger.h"
+#include "MaaUtils/Platform.h"
+
+MAA_RES_NS_BEGIN
+
+std::string ModelRegistry::file_key(const std::filesystem::path& path)
+{
+    std::error_code ec;
+    auto canonical = std::filesystem::canonical(path, ec);
+    if (ec) {
+        LogError << "failed to canonicalize" << VAR(path) << VAR(ec.message());
+        return { };
+    }
+
+    auto digest = FileDigestCache::get_instance().digest(canonical);
+    if (!digest) {
+        LogError << "failed to digest" << VAR(canonical);
+        return { };
+    }
+
+    return std::format("{}#{}", path_to_utf8_string(canonical), FileDigestCache::to_string(*digest));
+}
+
+std::shared_ptr<void> ModelRegistry::acquire_impl(const std::string& key, const std::function<std::shared_ptr<void>()>& loader)
+{
+    std::shared_ptr<std::mutex> loading;
+    {
+        std::unique_lock lock(mutex_);
+
+        auto& entry = entries_[key];
+        if (auto model = entry.model.lock()) {
+            LogDebug << "shared" << VAR(key);
+            return model;
+        }
+        loading = entry.loading;
+    }
+
+    std::unique_lock loading_lock(*loading);
+
+    {
+        // 等待期间可能已被其他 Resource 加载完成
+        std::unique_lock lock(mutex_);
+        if (auto model = entries_[key].model.lock()) {
+            LogDebug << "shared" << VAR(key);
+            return model;
+        }
+    }
+
+    auto model = loader();
+    if (!model) {
+        return nullptr;
+    }
+
+    std::unique_lock lock(mutex_);
+    entries_[key].model = model;
+
+    // 顺带清理已卸载的条目，正在加载的条目仍被其他线程持有 loading，保留
+    std::erase_if(entries_, [](const auto& pair) { return pair.second.model.expired() && pair.second.loading.use_count() == 1; });
+
+    LogInfo << "loaded" << VAR(key) << VAR(entries_.size());
+    return model;
+}
+
+MAA_RES_NS_END
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Common/Conf.h"
+#include "MaaUtils/SingletonHolder.hpp"
+
+MAA_RES_NS_BEGIN
+
+// 进程内共享的模型表。多个 Resource 加载同一份模型（同路径、同内容、同推理后端）时复用同一个实例，
+// 表中只保存 weak_ptr，最后一个持有者释放后模型随之卸载
+class ModelRegistry : public SingletonHolder<ModelRegistry>
+{
+public:
+    friend class SingletonHolder<ModelRegistry>;
+
+public:
+    virtual ~ModelRegistry() = default;
+
+    template <typename T>
+    std::shared_ptr<T> acquire(const std::string& key, const std::function<std::shared_ptr<T>()>& loader)
+    {
+        return std::static_pointer_cast<T>(acquire_impl(key, [&]() -> std::shared_ptr<void> { return loader(); }));
+    }
+
+    // canonical path + 内容摘要，文件不存在时返回空
+    static std::string file_key(const std::filesystem::path& path);
+
+private:
+    ModelRegistry() = default;
+
+    std::shared_ptr<void> acquire_impl(const std::string& key, const std::function<std::shared_ptr<void>()>& loader);
+
+private:
+    struct Entry
+    {
+        std::weak_ptr<void> model;
+        // 同一个 key 只加载一次，其余请求等待
+        std::shared_ptr<std::mutex> loading = std::make_shared<std::mutex>();
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+};
+
+MAA_RES_NS_END
@@ -1,15 +1,37 @@
 #include "OCRResMgr.h"
 
 #include <filesystem>
+#include <format>
 #include <ranges>
 
 #include "MaaUtils/File.hpp"
 #include "MaaUtils/Logger.h"
 #include "MaaUtils/Platform.h"
 #include "MaaUtils/StringMisc.hpp"
+#include "ModelRegistry.h"
 
 MAA_RES_NS_BEGIN
 
+namespace
+{
+
+// PPOCRv4 只保存 det / rec 的裸指针，这里把它们绑在一起，保证共享期间不会先于 pipeline 释放
+struct SharedPPOCR
+{
+    SharedPPOCR(std::shared_ptr<fastdeploy::vision::ocr::DBDetector> d, std::shared_ptr<fastdeploy::vision::ocr::Recognizer> r)
+        : det(std::move(d))
+        , rec(std::move(r))
+        , ocr(det.get(), rec.get())
+    {
+    }
+
+    std::shared_ptr<fastdeploy::vision::ocr::DBDetector> det;
+    std::shared_ptr<fastdeploy::vision::ocr::Recognizer> rec;
+    fastdeploy::pipeline::PPOCRv4 ocr;
+};
+
+} // namespace
+
 OCRResMgr::OCRResMgr()
 {
     LogFunc;
@@ -27,6 +49,8 @@ void OCRResMgr::use_cpu()
 
     det_option_.SetCpuThreadNum(4);
     rec_option_.SetCpuThreadNum(4);
+
+    provider_ = "cpu";
 }
 
 void OCRResMgr::use_cuda(int device_id)
@@ -35,6 +59,8 @@ void OCRResMgr::use_cuda(int device_id)
 
     det_option_.UseCuda(device_id);
     rec_option_.UseCuda(device_id);
+
+    provider_ = std::format("cuda:{}", device_id);
 }
 
 void OCRResMgr::use_directml(int device_id)
@@ -43,6 +69,8 @@ void OCRResMgr::use_directml(int device_id)
 
     det_option_.UseDirectML(device_id);
     rec_option_.UseDirectML(device_id);
+
+    provider_ = std::format("directml:{}", device_id);
 }
 
 void OCRResMgr::use_coreml(uint32_t coreml_flag)
@@ -156,16 +184,21 @@ std::shared_ptr<fastdeploy::vision::ocr::DBDetector> OCRResMgr::load_deter(const
         }
         LogDebug << VAR(model_path);
 
-        auto det = std::make_shared<fastdeploy::vision::ocr::DBDetector>(
-            path_to_utf8_string(model_path),
-            std::string(),
-            det_option_,
-            fastdeploy::ModelFormat::ONNX);
-        if (!det || !det->Initialized()) {
-            LogError << "Failed to load DBDetector:" << VAR(name) << VAR(det) << VAR(det->Initialized());
-            return nullptr;
-        }
-        return det;
+        const std::string key = std::format("ocr.det|{}|{}", ModelRegistry::file_key(model_path), provider_);
+        return ModelRegistry::get_instance().acquire<fastdeploy::vision::ocr::DBDetector>(
+            key,
+            [&]() -> std::shared_ptr<fastdeploy::vision::ocr::DBDetector> {
+                auto det = std::make_shared<fastdeploy::vision::ocr::DBDetector>(
+                    path_to_utf8_string(model_path),
+                    std::string(),
+                    det_option_,
+                    fastdeploy::ModelFormat::ONNX);
+                if (!det || !det->Initialized()) {
+                    LogError << "Failed to load DBDetector:" << VAR(name) << VAR(det) << VAR(det->Initialized());
+                    return nullptr;
+                }
+                return det;
+            });
     }
 
     return nullptr;
@@ -186,17 +219,23 @@ std::shared_ptr<fastdeploy::vision::ocr::Recognizer> OCRResMgr::load_recer(const
         }
         LogDebug << VAR(model_path);
 
-        auto rec = std::make_shared<fastdeploy::vision::ocr::Recognizer>(
-            path_to_utf8_string(model_path),
-            std::string(),
-            path_to_utf8_string(label_path),
-            rec_option_,
-            fastdeploy::ModelFormat::ONNX);
-        if (!rec || !rec->Initialized()) {
-            LogError << "Failed to load Recognizer:" << VAR(name) << VAR(rec) << VAR(rec->Initialized());
-            return nullptr;
-        }
-        return rec;
+        const std::string key =
+            std::format("ocr.rec|{}|{}|{}", ModelRegistry::file_key(model_path), ModelRegistry::file_key(label_path), provider_);
+        return ModelRegistry::get_instance().acquire<fastdeploy::vision::ocr::Recognizer>(
+            key,
+            [&]() -> std::shared_ptr<fastdeploy::vision::ocr::Recognizer> {
+                auto rec = std::make_shared<fastdeploy::vision::ocr::Recognizer>(
+                    path_to_utf8_string(model_path),
+                    std::string(),
+                    path_to_utf8_string(label_path),
+                    rec_option_,
+                    fastdeploy::ModelFormat::ONNX);
+                if (!rec || !rec->Initialized()) {
+                    LogError << "Failed to load Recognizer:" << VAR(name) << VAR(rec) << VAR(rec->Initialized());
+                    return nullptr;
+                }
+                return rec;
+            });
     }
 
     return nullptr;
@@ -215,13 +254,20 @@ std::shared_ptr<fastdeploy::pipeline::PPOCRv4> OCRResMgr::load_ocrer(const std::
         return nullptr;
     }
 
-    auto ocr = std::make_shared<fastdeploy::pipeline::PPOCRv4>(det.get(), rec.get());
-
-    if (!ocr || !ocr->Initialized()) {
-        LogError << "Failed to load PPOCRv4:" << VAR(name) << VAR(ocr) << VAR(ocr->Initialized());
+    // det / rec 已经去重，用它们的地址即可标识 pipeline；holder 存活期间地址不会被复用
+    const std::string key = std::format("ocr.pipeline|{}|{}", static_cast<void*>(det.get()), static_cast<void*>(rec.get()));
+    auto holder = ModelRegistry::get_instance().acquire<SharedPPOCR>(key, [&]() -> std::shared_ptr<SharedPPOCR> {
+        auto shared = std::make_shared<SharedPPOCR>(det, rec);
+        if (!shared->ocr.Initialized()) {
+            LogError << "Failed to load PPOCRv4:" << VAR(name);
+            return nullptr;
+        }
+        return shared;
+    });
+    if (!holder) {
         return nullptr;
     }
-    return ocr;
+    return std::shared_ptr<fastdeploy::pipeline::PPOCRv4>(holder, &holder->ocr);
 }
 
 MAA_RES_NS_END
@@ -50,6 +50,8 @@ private:
 
     fastdeploy::RuntimeOption det_option_;
     fastdeploy::RuntimeOption rec_option_;
+    // 参与 ModelRegistry 的 key，推理后端不同的模型不能共享
+    std::string provider_ = "default";
 
     std::unordered_map<std::string, std::shared_ptr<fastdeploy::vision::ocr::DBDetector>> deters_;
     std::unordered_map<std::string, std::shared_ptr<fastdeploy::vision::ocr::Recognizer>> recers_;
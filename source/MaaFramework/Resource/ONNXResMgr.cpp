@@ -1,6 +1,7 @@
 #include "ONNXResMgr.h"
 
 #include <filesystem>
+#include <format>
 #include <ranges>
 #include <unordered_set>
 
@@ -11,9 +12,28 @@
 #include "MLProvider.h"
 #include "MaaUtils/Logger.h"
 #include "MaaUtils/Platform.h"
+#include "ModelRegistry.h"
 
 MAA_RES_NS_BEGIN
 
+namespace
+{
+
+// session 会被多个 Resource 共享，Env 必须比所有 session 活得久
+struct SharedSession
+{
+    std::shared_ptr<Ort::Env> env;
+    Ort::Session session;
+};
+
+std::shared_ptr<Ort::Env> shared_env()
+{
+    static auto env = std::make_shared<Ort::Env>(ORT_LOGGING_LEVEL_FATAL, "MaaFW");
+    return env;
+}
+
+} // namespace
+
 ONNXResMgr::ONNXResMgr()
     : memory_info_(Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault))
 {
@@ -46,6 +66,7 @@ void ONNXResMgr::use_cpu()
 
     options_ = { };
     memory_info_ = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+    provider_ = "cpu";
 }
 
 void ONNXResMgr::use_cuda(int device_id)
@@ -60,6 +81,7 @@ void ONNXResMgr::use_cuda(int device_id)
     // Input tensors are created from std::vector<float> (host memory).
     // Keep CPU memory info here and let ORT move data to CUDA EP internally.
     memory_info_ = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+    provider_ = std::format("cuda:{}", device_id);
 
     LogInfo << "Using CUDA execution provider with device_id" << device_id;
 }
@@ -78,6 +100,7 @@ void ONNXResMgr::use_directml(int device_id)
     }
 
     memory_info_ = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+    provider_ = std::format("directml:{}", device_id);
 
     LogInfo << "Using DML execution provider with device_id" << device_id;
 
@@ -101,6 +124,7 @@ void ONNXResMgr::use_coreml(uint32_t coreml_flag)
     }
 
     memory_info_ = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+    provider_ = std::format("coreml:{}", coreml_flag);
 
     LogInfo << "Using CoreML execution provider";
 
@@ -183,8 +207,17 @@ std::shared_ptr<Ort::Session> ONNXResMgr::load(const std::string& name, const st
         }
 
         LogDebug << VAR(path);
-        Ort::Session session(env_, path.c_str(), options_);
-        return std::make_shared<Ort::Session>(std::move(session));
+
+        const std::string key = std::format("onnx|{}|{}", ModelRegistry::file_key(path), provider_);
+        auto holder = ModelRegistry::get_instance().acquire<SharedSession>(key, [&]() {
+            auto env = shared_env();
+            Ort::Session session(*env, path.c_str(), options_);
+            return std::make_shared<SharedSession>(SharedSession { .env = std::move(env), .session = std::move(session) });
+        });
+        if (!holder) {
+            return nullptr;
+        }
+        return std::shared_ptr<Ort::Session>(holder, &holder->session);
     }
 
     return nullptr;
@@ -37,9 +37,10 @@ private:
     std::vector<std::filesystem::path> classifier_roots_;
     std::vector<std::filesystem::path> detector_roots_;
 
-    Ort::Env env_ = Ort::Env(ORT_LOGGING_LEVEL_FATAL, "MaaFW");
     Ort::SessionOptions options_;
     Ort::MemoryInfo memory_info_;
+    // 参与 ModelRegistry 的 key，推理后端不同的 session 不能共享
+    std::string provider_ = "default";
 
     std::unordered_map<std::string, std::shared_ptr<Ort::Session>> classifiers_;
     std::unordered_map<std::string, std::shared_ptr<Ort::Session>> detectors_;
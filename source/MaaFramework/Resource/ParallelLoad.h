@@ -0,0 +1,40 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "Common/Conf.h"
+
+MAA_RES_NS_BEGIN
+
+// 加载期的简单并行：按下标把 [0, count) 分给若干工作线程，全部完成后返回。
+// func 需自行保证对不同下标的调用互不干扰
+template <typename Func>
+inline void parallel_load(size_t count, Func&& func)
+{
+    const size_t worker_count = std::min<size_t>(count, std::max(1u, std::thread::hardware_concurrency()));
+    if (worker_count <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    std::atomic_size_t next = 0;
+    auto work = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            func(i);
+        }
+    };
+
+    std::vector<std::jthread> workers;
+    workers.reserve(worker_count - 1);
+    for (size_t i = 1; i < worker_count; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+}
+
+MAA_RES_NS_END
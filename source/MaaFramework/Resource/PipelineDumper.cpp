@@ -75,6 +75,7 @@ PipelineV2::JWaitFreezes dump_wait_freezes(const WaitFreezesParam& param)
         .target_offset = dump_rect(param.target.offset),
         .threshold = param.threshold,
         .method = param.method,
+        .block_size = param.block_size,
         .rate_limit = param.rate_limit.count(),
         .timeout = param.timeout.count(),
     };
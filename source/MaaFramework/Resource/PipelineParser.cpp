@@ -1564,6 +1564,15 @@ bool PipelineParser::parse_wait_freezes_value(const json::value& input, WaitFree
         return false;
     }
 
+    if (!get_and_check_value(input, "block_size", output.block_size, default_value.block_size)) {
+        LogError << "failed to parse_wait_freezes_value block_size" << VAR(input);
+        return false;
+    }
+    if (output.block_size < 0) {
+        LogError << "block_size must be non-negative" << VAR(output.block_size);
+        return false;
+    }
+
     auto rate_limit = default_value.rate_limit.count();
     if (!get_and_check_value(input, "rate_limit", rate_limit, rate_limit)) {
         LogError << "failed to parse_wait_freezes_value rate_limit" << VAR(input);
@@ -2,11 +2,15 @@
 
 #include <ranges>
 
+#include "FileDigest.h"
 #include "MaaUtils/Logger.h"
 #include "MaaUtils/Platform.h"
 #include "MaaUtils/StringMisc.hpp"
+#include "MaaUtils/Time.hpp"
+#include "ParallelLoad.h"
 #include "PipelineChecker.h"
 #include "PipelineParser.h"
+#include "PipelineSerializer.h"
 
 MAA_RES_NS_BEGIN
 
@@ -14,12 +18,18 @@ bool PipelineResMgr::load(const std::filesystem::path& path, const DefaultPipeli
 {
     LogFunc << VAR(path);
 
+    last_load_cost_ = { };
+
     if (!load_all_json(path, default_mgr)) {
         LogError << "load_all_json failed" << VAR(path);
         return false;
     }
 
-    if (!PipelineChecker::check_all_validity(pipeline_data_map_)) {
+    auto start_time = std::chrono::steady_clock::now();
+    bool valid = PipelineChecker::check_all_validity(pipeline_data_map_);
+    last_load_cost_.check = duration_since(start_time);
+
+    if (!valid) {
         LogError << "check_all_validity failed" << VAR(path);
         return false;
     }
@@ -33,13 +43,23 @@ bool PipelineResMgr::load_file(const std::filesystem::path& path, const DefaultP
 {
     LogFunc << VAR(path);
 
+    last_load_cost_ = { };
+
+    auto start_time = std::chrono::steady_clock::now();
     std::set<std::string> existing_keys;
-    if (!open_and_parse_file(path, existing_keys, default_mgr)) {
+    bool parsed = open_and_parse_file(path, existing_keys, default_mgr);
+    last_load_cost_.parse = duration_since(start_time);
+
+    if (!parsed) {
         LogError << "open_and_parse_file failed" << VAR(path);
         return false;
     }
 
-    if (!PipelineChecker::check_all_validity(pipeline_data_map_)) {
+    start_time = std::chrono::steady_clock::now();
+    bool valid = PipelineChecker::check_all_validity(pipeline_data_map_);
+    last_load_cost_.check = duration_since(start_time);
+
+    if (!valid) {
         LogError << "check_all_validity failed" << VAR(path);
         return false;
     }
@@ -49,6 +69,62 @@ bool PipelineResMgr::load_file(const std::filesystem::path& path, const DefaultP
     return true;
 }
 
+bool PipelineResMgr::load_compiled(const std::filesystem::path& path, const json::value& nodes, const DefaultPipelineMgr& default_mgr)
+{
+    LogFunc << VAR(path);
+
+    last_load_cost_ = { };
+
+    auto start_time = std::chrono::steady_clock::now();
+    std::set<std::string> existing_keys;
+    bool parsed = parse_and_override(nodes, existing_keys, default_mgr);
+    last_load_cost_.parse = duration_since(start_time);
+
+    if (!parsed) {
+        LogError << "parse_and_override failed" << VAR(path);
+        return false;
+    }
+
+    start_time = std::chrono::steady_clock::now();
+    bool valid = PipelineChecker::check_all_validity(pipeline_data_map_);
+    last_load_cost_.check = duration_since(start_time);
+
+    if (!valid) {
+        LogError << "check_all_validity failed" << VAR(path);
+        return false;
+    }
+
+    paths_.emplace_back(path);
+
+    return true;
+}
+
+bool PipelineResMgr::load_compiled(const std::filesystem::path& path, std::string_view serialized)
+{
+    LogFunc << VAR(path) << VAR(serialized.size());
+
+    if (!pipeline_data_map_.empty()) {
+        LogError << "pipeline already loaded, serialized nodes do not carry the current defaults" << VAR(path);
+        return false;
+    }
+
+    last_load_cost_ = { };
+
+    auto start_time = std::chrono::steady_clock::now();
+    auto data_opt = PipelineSerializer::read(serialized);
+    last_load_cost_.read = duration_since(start_time);
+
+    if (!data_opt) {
+        LogError << "failed to read serialized pipeline" << VAR(path);
+        return false;
+    }
+
+    pipeline_data_map_ = *std::move(data_opt);
+    paths_.emplace_back(path);
+
+    return true;
+}
+
 void PipelineResMgr::clear()
 {
     LogFunc;
@@ -64,9 +140,57 @@ bool PipelineResMgr::load_all_json(const std::filesystem::path& path, const Defa
         return false;
     }
 
-    bool valid = false;
+    auto files = list_json_files(path);
+    if (files.empty()) {
+        return false;
+    }
 
+    // 读取和解析 json 互不依赖，并行进行。顺带在同一工作线程上算文件摘要，此时文件内容还在页缓存中，
+    // 加载结束后计算资源 hash 只需 stat
+    auto start_time = std::chrono::steady_clock::now();
+    std::vector<std::optional<json::value>> jsons(files.size());
+    parallel_load(files.size(), [&](size_t i) {
+        jsons[i] = json::open(files[i], true, true);
+        FileDigestCache::get_instance().digest(files[i]);
+    });
+    last_load_cost_.read = duration_since(start_time);
+
+    start_time = std::chrono::steady_clock::now();
+    std::vector<NodeRef> nodes;
     std::set<std::string> existing_keys;
+    for (size_t i = 0; i < files.size(); ++i) {
+        const auto& file = files[i];
+        const auto& json_opt = jsons[i];
+        if (!json_opt) {
+            LogError << "json::open failed" << VAR(file);
+            return false;
+        }
+        if (!json_opt->is_object()) {
+            LogError << "json is not object" << VAR(file);
+            return false;
+        }
+        if (!collect_nodes(json_opt->as_object(), existing_keys, nodes)) {
+            LogError << "collect_nodes failed" << VAR(file);
+            return false;
+        }
+    }
+
+    bool parsed = parse_nodes(nodes, default_mgr);
+    last_load_cost_.parse = duration_since(start_time);
+    if (!parsed) {
+        return false;
+    }
+
+    LogInfo << VAR(path) << VAR(files.size()) << VAR(nodes.size()) << VAR(last_load_cost_.read.count())
+            << VAR(last_load_cost_.parse.count());
+
+    return true;
+}
+
+std::vector<std::filesystem::path> PipelineResMgr::list_json_files(const std::filesystem::path& path)
+{
+    std::vector<std::filesystem::path> files;
+
     for (auto& entry : std::filesystem::recursive_directory_iterator(path)) {
         auto& entry_path = entry.path();
         if (entry.is_directory()) {
@@ -90,16 +214,10 @@ bool PipelineResMgr::load_all_json(const std::filesystem::path& path, const Defa
             continue;
         }
 
-        bool parsed = open_and_parse_file(entry_path, existing_keys, default_mgr);
-        if (!parsed) {
-            LogError << "open_and_parse_file failed" << VAR(entry_path);
-            return false;
-        }
-
-        valid = true;
+        files.emplace_back(entry_path);
     }
 
-    return valid;
+    return files;
 }
 
 bool PipelineResMgr::open_and_parse_file(
@@ -135,6 +253,58 @@ std::vector<std::string> PipelineResMgr::get_node_list() const
     return std::vector(k.begin(), k.end());
 }
 
+namespace
+{
+
+void collect_template_names(const Recognition::Param& param, std::set<std::string>& names)
+{
+    auto collect_sub = [&](const std::vector<Recognition::SubRecognition>& subs) {
+        for (const auto& sub : subs) {
+            // 按节点名引用的子识别会在遍历该节点时收集
+            if (const auto* inline_sub = std::get_if<Recognition::InlineSubRecognition>(&sub)) {
+                collect_template_names(inline_sub->param, names);
+            }
+        }
+    };
+
+    if (const auto* p = std::get_if<MAA_VISION_NS::TemplateMatcherParam>(&param)) {
+        names.insert(p->template_.begin(), p->template_.end());
+    }
+    else if (const auto* p = std::get_if<MAA_VISION_NS::FeatureMatcherParam>(&param)) {
+        names.insert(p->template_.begin(), p->template_.end());
+    }
+    else if (const auto* p = std::get_if<std::shared_ptr<Recognition::AndParam>>(&param); p && *p) {
+        collect_sub((*p)->all_of);
+    }
+    else if (const auto* p = std::get_if<std::shared_ptr<Recognition::OrParam>>(&param); p && *p) {
+        collect_sub((*p)->any_of);
+    }
+}
+
+} // namespace
+
+std::set<std::string> PipelineResMgr::get_template_names() const
+{
+    std::set<std::string> names;
+    for (const auto& data : pipeline_data_map_ | std::views::values) {
+        collect_template_names(data.reco_param, names);
+    }
+    return names;
+}
+
+std::set<std::string> PipelineResMgr::get_template_names(const std::vector<std::string>& node_names) const
+{
+    std::set<std::string> names;
+    for (const auto& node_name : node_names) {
+        auto it = pipeline_data_map_.find(node_name);
+        if (it == pipeline_data_map_.end()) {
+            continue;
+        }
+        collect_template_names(it->second.reco_param, names);
+    }
+    return names;
+}
+
 bool PipelineResMgr::parse_and_override(
     const json::value& input,
     std::set<std::string>& existing_keys,
@@ -166,6 +336,15 @@ bool PipelineResMgr::parse_and_override_once(
     const json::object& input,
     std::set<std::string>& existing_keys,
     const DefaultPipelineMgr& default_mgr)
+{
+    std::vector<NodeRef> nodes;
+    if (!collect_nodes(input, existing_keys, nodes)) {
+        return false;
+    }
+    return parse_nodes(nodes, default_mgr);
+}
+
+bool PipelineResMgr::collect_nodes(const json::object& input, std::set<std::string>& existing_keys, std::vector<NodeRef>& nodes)
 {
     for (const auto& [key, value] : input) {
         if (key.empty()) {
@@ -176,7 +355,7 @@ bool PipelineResMgr::parse_and_override_once(
             LogInfo << "key starts with '$', skip" << VAR(key);
             continue;
         }
-        if (existing_keys.contains(key)) {
+        if (!existing_keys.emplace(key).second) {
             LogError << "key already exists" << VAR(key);
             return false;
         }
@@ -184,17 +363,40 @@ bool PipelineResMgr::parse_and_override_once(
             LogError << "value is not object" << VAR(key) << VAR(value);
             return false;
         }
+        nodes.emplace_back(key, &value);
+    }
 
-        PipelineData result;
-        const auto& default_result = pipeline_data_map_.contains(key) ? pipeline_data_map_.at(key) : default_mgr.get_pipeline();
-        bool ret = PipelineParser::parse_node(key, value, result, default_result, default_mgr);
-        if (!ret) {
-            LogError << "parse_task failed" << VAR(key) << VAR(value);
-            return false;
+    return true;
+}
+
+bool PipelineResMgr::parse_nodes(const std::vector<NodeRef>& nodes, const DefaultPipelineMgr& default_mgr)
+{
+    std::vector<PipelineData> results(nodes.size());
+    std::vector<char> parsed(nodes.size(), false);
+    auto parse = [&](size_t i) {
+        const auto& [key, value] = nodes[i];
+        auto it = pipeline_data_map_.find(key);
+        const auto& default_result = it != pipeline_data_map_.end() ? it->second : default_mgr.get_pipeline();
+        parsed[i] = PipelineParser::parse_node(key, *value, results[i], default_result, default_mgr);
+    };
+
+    // 运行期 override 通常只有几个节点，不值得起线程
+    constexpr size_t kParallelThreshold = 32;
+    if (nodes.size() < kParallelThreshold) {
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            parse(i);
         }
+    }
+    else {
+        parallel_load(nodes.size(), parse);
+    }
 
-        existing_keys.emplace(key);
-        pipeline_data_map_.insert_or_assign(key, std::move(result));
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (!parsed[i]) {
+            LogError << "parse_task failed" << VAR(nodes[i].first) << VAR(*nodes[i].second);
+            return false;
+        }
+        pipeline_data_map_.insert_or_assign(nodes[i].first, std::move(results[i]));
     }
 
     return true;
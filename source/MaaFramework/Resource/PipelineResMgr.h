@@ -1,8 +1,12 @@
 #pragma once
 
+#include <chrono>
 #include <filesystem>
 #include <set>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <meojson/json.hpp>
 
@@ -18,9 +22,21 @@ class PipelineResMgr : public NonCopyable
 public:
     inline static constexpr std::string_view kFilePrefix_Ignore = ".";
 
+    // 最近一次 load / load_compiled 各阶段耗时
+    struct LoadCost
+    {
+        std::chrono::milliseconds read { };
+        std::chrono::milliseconds parse { };
+        std::chrono::milliseconds check { };
+    };
+
 public:
     bool load(const std::filesystem::path& path, const DefaultPipelineMgr& default_mgr);
     bool load_file(const std::filesystem::path& path, const DefaultPipelineMgr& default_mgr);
+    // nodes 为预编译资源包中合并后的节点 JSON，叠加在已有资源之上时使用，需重新解析和校验
+    bool load_compiled(const std::filesystem::path& path, const json::value& nodes, const DefaultPipelineMgr& default_mgr);
+    // serialized 为预编译资源包中 PipelineSerializer 写出的节点，直接还原，不再解析和校验；只能用于尚未加载任何节点时
+    bool load_compiled(const std::filesystem::path& path, std::string_view serialized);
     void clear();
 
     const std::vector<std::filesystem::path>& get_paths() const { return paths_; }
@@ -31,18 +47,34 @@ public:
 
     std::vector<std::string> get_node_list() const;
 
+    // 所有节点（含 And / Or 内联的子识别）引用的模板图片名
+    std::set<std::string> get_template_names() const;
+    std::set<std::string> get_template_names(const std::vector<std::string>& node_names) const;
+
+    const LoadCost& last_load_cost() const { return last_load_cost_; }
+
 public:
     bool parse_and_override(const json::value& input, std::set<std::string>& existing_keys, const DefaultPipelineMgr& default_mgr);
 
+    // 目录下需要加载的 pipeline 文件，按加载顺序
+    static std::vector<std::filesystem::path> list_json_files(const std::filesystem::path& path);
+
 private:
     bool load_all_json(const std::filesystem::path& path, const DefaultPipelineMgr& default_mgr);
     bool
         open_and_parse_file(const std::filesystem::path& path, std::set<std::string>& existing_keys, const DefaultPipelineMgr& default_mgr);
     bool parse_and_override_once(const json::object& input, std::set<std::string>& existing_keys, const DefaultPipelineMgr& default_mgr);
 
+    using NodeRef = std::pair<std::string, const json::value*>;
+    // 校验节点名与节点值并登记到 existing_keys，跳过以 '$' 开头的节点，待解析的节点追加到 nodes
+    static bool collect_nodes(const json::object& input, std::set<std::string>& existing_keys, std::vector<NodeRef>& nodes);
+    // 同一次加载中不允许重名节点，每个节点的默认值只取决于本次加载之前的数据，因此可以并行解析；合并仍按顺序进行
+    bool parse_nodes(const std::vector<NodeRef>& nodes, const DefaultPipelineMgr& default_mgr);
+
 private:
     std::vector<std::filesystem::path> paths_;
     PipelineDataMap pipeline_data_map_;
+    LoadCost last_load_cost_;
 };
 
 MAA_RES_NS_END
@@ -0,0 +1,370 @@
+#include "PipelineSerializer.h"
+
+#include "BinaryArchive.h"
+#include "MaaUtils/Logger.h"
+
+MAA_RES_NS_BEGIN
+
+// 字段列表须与 PipelineTypes.h / VisionTypes.h 保持一致，增删字段后提升 CompiledBundle::kVersion
+
+template <>
+struct BinaryFields<MAA_VISION_NS::TargetObj>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, MAA_VISION_NS::TargetObj& v)
+    {
+        return ar(v.type, v.param);
+    }
+};
+
+template <>
+struct BinaryFields<MAA_VISION_NS::Target>
+{
+    // Target 与基类各有一份 type / param，两份都保留
+    template <typename Ar>
+    static auto apply(Ar& ar, MAA_VISION_NS::Target& v)
+    {
+        return ar(static_cast<MAA_VISION_NS::TargetObj&>(v), v.type, v.param, v.offset);
+    }
+};
+
+template <>
+struct BinaryFields<MAA_VISION_NS::DirectHitParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, MAA_VISION_NS::DirectHitParam& v)
+    {
+        return ar(v.roi_target);
+    }
+};
+
+template <>
+struct BinaryFields<MAA_VISION_NS::TemplateMatcherParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, MAA_VISION_NS::TemplateMatcherParam& v)
+    {
+        return ar(v.roi_target, v.template_, v.thresholds, v.method, v.green_mask, v.order_by, v.result_index);
+    }
+};
+
+template <>
+struct BinaryFields<MAA_VISION_NS::FeatureMatcherParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, MAA_VISION_NS::FeatureMatcherParam& v)
+    {
+        return ar(v.roi_target, v.template_, v.green_mask, v.detector, v.ratio, v.count, v.order_by, v.result_index);
+    }
+};
+
+template <>
+struct BinaryFields<MAA_VISION_NS::OCRerParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, MAA_VISION_NS::OCRerParam& v)
+    {
+        return ar(v.roi_target, v.model, v.only_rec, v.expected, v.threshold, v.replace, v.color_filter, v.order_by, v.result_index);
+    }
+};
+
+template <>
+struct BinaryFields<MAA_VISION_NS::NeuralNetworkClassifierParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, MAA_VISION_NS::NeuralNetworkClassifierParam& v)
+    {
+        return ar(v.roi_target, v.model, v.labels, v.expected, v.order_by, v.result_index);
+    }
+};
+
+template <>
+struct BinaryFields<MAA_VISION_NS::NeuralNetworkDetectorParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, MAA_VISION_NS::NeuralNetworkDetectorParam& v)
+    {
+        return ar(v.roi_target, v.model, v.net, v.labels, v.expected, v.thresholds, v.order_by, v.result_index);
+    }
+};
+
+template <>
+struct BinaryFields<MAA_VISION_NS::ColorMatcherParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, MAA_VISION_NS::ColorMatcherParam& v)
+    {
+        return ar(v.roi_target, v.range, v.count, v.method, v.connected, v.order_by, v.result_index);
+    }
+};
+
+template <>
+struct BinaryFields<MAA_VISION_NS::CustomRecognitionParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, MAA_VISION_NS::CustomRecognitionParam& v)
+    {
+        return ar(v.roi_target, v.name, v.custom_param);
+    }
+};
+
+template <>
+struct BinaryFields<Recognition::InlineSubRecognition>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Recognition::InlineSubRecognition& v)
+    {
+        return ar(v.sub_name, v.type, v.param);
+    }
+};
+
+template <>
+struct BinaryFields<Recognition::AndParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Recognition::AndParam& v)
+    {
+        return ar(v.all_of, v.box_index);
+    }
+};
+
+template <>
+struct BinaryFields<Recognition::OrParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Recognition::OrParam& v)
+    {
+        return ar(v.any_of);
+    }
+};
+
+template <>
+struct BinaryFields<Action::ClickParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Action::ClickParam& v)
+    {
+        return ar(v.target, v.contact, v.pressure);
+    }
+};
+
+template <>
+struct BinaryFields<Action::LongPressParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Action::LongPressParam& v)
+    {
+        return ar(v.target, v.duration, v.contact, v.pressure);
+    }
+};
+
+template <>
+struct BinaryFields<Action::SwipeParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Action::SwipeParam& v)
+    {
+        return ar(v.begin, v.end, v.end_offset, v.end_hold, v.duration, v.only_hover, v.starting, v.contact, v.pressure);
+    }
+};
+
+template <>
+struct BinaryFields<Action::MultiSwipeParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Action::MultiSwipeParam& v)
+    {
+        return ar(v.swipes);
+    }
+};
+
+template <>
+struct BinaryFields<Action::TouchParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Action::TouchParam& v)
+    {
+        return ar(v.contact, v.target, v.pressure);
+    }
+};
+
+template <>
+struct BinaryFields<Action::TouchUpParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Action::TouchUpParam& v)
+    {
+        return ar(v.contact);
+    }
+};
+
+template <>
+struct BinaryFields<Action::KeyParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Action::KeyParam& v)
+    {
+        return ar(v.key);
+    }
+};
+
+template <>
+struct BinaryFields<Action::ClickKeyParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Action::ClickKeyParam& v)
+    {
+        return ar(v.keys);
+    }
+};
+
+template <>
+struct BinaryFields<Action::LongPressKeyParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Action::LongPressKeyParam& v)
+    {
+        return ar(v.keys, v.duration);
+    }
+};
+
+template <>
+struct BinaryFields<Action::InputTextParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Action::InputTextParam& v)
+    {
+        return ar(v.text);
+    }
+};
+
+template <>
+struct BinaryFields<Action::AppParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Action::AppParam& v)
+    {
+        return ar(v.package);
+    }
+};
+
+template <>
+struct BinaryFields<Action::ScrollParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Action::ScrollParam& v)
+    {
+        return ar(v.target, v.dx, v.dy);
+    }
+};
+
+template <>
+struct BinaryFields<Action::ShellParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Action::ShellParam& v)
+    {
+        return ar(v.cmd, v.shell_timeout);
+    }
+};
+
+template <>
+struct BinaryFields<Action::CommandParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Action::CommandParam& v)
+    {
+        return ar(v.exec, v.args, v.detach);
+    }
+};
+
+template <>
+struct BinaryFields<Action::ScreencapParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Action::ScreencapParam& v)
+    {
+        return ar(v.filename, v.format, v.quality);
+    }
+};
+
+template <>
+struct BinaryFields<Action::CustomParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, Action::CustomParam& v)
+    {
+        return ar(v.name, v.custom_param, v.target);
+    }
+};
+
+template <>
+struct BinaryFields<WaitFreezesParam>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, WaitFreezesParam& v)
+    {
+        return ar(v.time, v.target, v.threshold, v.method, v.block_size, v.rate_limit, v.timeout);
+    }
+};
+
+template <>
+struct BinaryFields<NodeAttr>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, NodeAttr& v)
+    {
+        return ar(v.name, v.jump_back, v.anchor);
+    }
+};
+
+template <>
+struct BinaryFields<PipelineData>
+{
+    template <typename Ar>
+    static auto apply(Ar& ar, PipelineData& v)
+    {
+        return ar(
+            v.name,
+            v.enabled,
+            v.reco_type,
+            v.reco_param,
+            v.inverse,
+            v.action_type,
+            v.action_param,
+            v.next,
+            v.on_error,
+            v.anchor,
+            v.rate_limit,
+            v.reco_timeout,
+            v.pre_delay,
+            v.post_delay,
+            v.pre_wait_freezes,
+            v.post_wait_freezes,
+            v.repeat,
+            v.repeat_delay,
+            v.repeat_wait_freezes,
+            v.max_hit,
+            v.focus,
+            v.attach);
+    }
+};
+
+void PipelineSerializer::write(std::string& out, const PipelineDataMap& data)
+{
+    BinaryWriter writer(out);
+    writer(data);
+}
+
+std::optional<PipelineDataMap> PipelineSerializer::read(std::string_view data)
+{
+    PipelineDataMap result;
+    BinaryReader reader(data);
+    if (!reader(result) || reader.remaining() != 0) {
+        LogError << "failed to read pipeline data" << VAR(data.size()) << VAR(reader.remaining());
+        return std::nullopt;
+    }
+    return result;
+}
+
+MAA_RES_NS_END
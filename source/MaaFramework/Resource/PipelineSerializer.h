@@ -0,0 +1,22 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "Common/Conf.h"
+#include "PipelineTypes.h"
+
+MAA_RES_NS_BEGIN
+
+// 解析后节点的二进制形式，预编译资源包据此直接还原 PipelineDataMap，不再经过 JSON 和 PipelineParser
+class PipelineSerializer
+{
+public:
+    PipelineSerializer() = delete;
+
+    static void write(std::string& out, const PipelineDataMap& data);
+    static std::optional<PipelineDataMap> read(std::string_view data);
+};
+
+MAA_RES_NS_END
@@ -344,6 +344,8 @@ struct WaitFreezesParam
 
     double threshold = 0.95;
     int method = MAA_VISION_NS::TemplateMatcherParam::kDefaultMethod;
+    // 大于 0 时把 roi 切成该边长的方块逐块比较，不再整体做模板比较
+    int block_size = 0;
     std::chrono::milliseconds rate_limit = std::chrono::milliseconds(1000);
     std::chrono::milliseconds timeout = std::chrono::milliseconds(20 * 1000);
 };
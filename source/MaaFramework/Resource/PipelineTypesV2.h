@@ -355,10 +355,11 @@ struct JWaitFreezes
     JRect target_offset { };
     double threshold = 0;
     int method = 0;
+    int block_size = 0;
     int64_t rate_limit = 0;
     int64_t timeout = 0;
 
-    MEO_TOJSON(time, target, target_offset, threshold, method, rate_limit, timeout);
+    MEO_TOJSON(time, target, target_offset, threshold, method, block_size, rate_limit, timeout);
 };
 
 struct JPipelineData
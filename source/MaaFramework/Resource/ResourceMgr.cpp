@@ -1,13 +1,17 @@
 #include "ResourceMgr.h"
 
+#include <algorithm>
 #include <tuple>
 
+#include "CompiledBundle.h"
+#include "FileDigest.h"
 #include "Global/PluginMgr.h"
 #include "MLProvider.h"
 #include "MaaFramework/MaaMsg.h"
 #include "MaaUtils/GpuOption.h"
 #include "MaaUtils/Logger.h"
 #include "MaaUtils/Platform.h"
+#include "MaaUtils/Time.hpp"
 #include "PipelineDumper.h"
 #include "PipelineParser.h"
 
@@ -44,6 +48,18 @@ bool ResourceMgr::set_option(MaaResOption key, MaaOptionValue value, MaaOptionVa
     case MaaResOption_InferenceExecutionProvider:
         return set_inference_execution_provider(value, val_size);
 
+    case MaaResOption_TemplateWarmUp:
+        return set_template_warm_up(value, val_size);
+
+    case MaaResOption_TemplateCacheBudget:
+        return set_template_cache_budget(value, val_size);
+
+    case MaaResOption_TemplatePinnedNodes:
+        return set_template_pinned_nodes(value, val_size);
+
+    case MaaResOption_CompiledBundleVerifySources:
+        return set_compiled_bundle_verify_sources(value, val_size);
+
     default:
         LogError << "Unknown key" << VAR(key) << VAR(value);
         return false;
@@ -113,19 +129,6 @@ bool ResourceMgr::valid() const
     return valid_;
 }
 
-// https://stackoverflow.com/questions/20511347/a-good-hash-function-for-a-vector
-size_t vec_hash(const std::vector<size_t>& vec)
-{
-    size_t seed = vec.size();
-    for (auto x : vec) {
-        x = ((x >> 16) ^ x) * 0x45d9f3b;
-        x = ((x >> 16) ^ x) * 0x45d9f3b;
-        x = (x >> 16) ^ x;
-        seed ^= x + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-    }
-    return seed;
-}
-
 std::string ResourceMgr::get_hash() const
 {
     return hash_cache_;
@@ -184,7 +187,22 @@ void ResourceMgr::post_stop()
 
 std::string ResourceMgr::calc_hash()
 {
-    std::vector<size_t> filesizes;
+    // 按相对路径排序后依次混入 (相对路径, 文件内容摘要)。文件摘要按 (路径, 大小, 修改时间) 缓存，
+    // 重复加载未改动的资源只需 stat，不会重新读取文件内容
+    auto& digest_cache = FileDigestCache::get_instance();
+
+    XXH64 hasher;
+    auto add_file = [&](const std::string& name, const std::filesystem::directory_entry& entry) {
+        auto stat = FileDigestCache::stat_of(entry);
+        auto digest = stat ? digest_cache.digest(entry.path(), *stat) : std::nullopt;
+        if (!digest) {
+            LogError << "failed to digest" << VAR(entry.path());
+            return;
+        }
+        hasher.update(name.data(), name.size() + 1); // 带上结尾的 '\0' 作为分隔
+        hasher.update(&*digest, sizeof(*digest));
+    };
+
     for (const auto& p : paths_) {
         if (!std::filesystem::exists(p)) {
             LogError << "path not exists" << VAR(p);
@@ -192,7 +210,7 @@ std::string ResourceMgr::calc_hash()
         }
 
         if (std::filesystem::is_regular_file(p)) {
-            filesizes.emplace_back(std::filesystem::file_size(p));
+            add_file(path_to_utf8_string(p.filename()), std::filesystem::directory_entry(p));
             continue;
         }
 
@@ -201,18 +219,21 @@ std::string ResourceMgr::calc_hash()
             continue;
         }
 
+        std::vector<std::pair<std::string, std::filesystem::directory_entry>> entries;
         for (const auto& entry : std::filesystem::recursive_directory_iterator(p)) {
             if (!entry.is_regular_file()) {
                 continue;
             }
-            filesizes.emplace_back(entry.file_size());
+            entries.emplace_back(path_to_utf8_string(std::filesystem::relative(entry.path(), p)), entry);
+        }
+        std::ranges::sort(entries, { }, &decltype(entries)::value_type::first);
+
+        for (const auto& [name, entry] : entries) {
+            add_file(name, entry);
         }
     }
-    size_t hash = vec_hash(filesizes);
 
-    std::stringstream ss;
-    ss << std::hex << hash;
-    hash_cache_ = std::move(ss).str();
+    hash_cache_ = FileDigestCache::to_string(hasher.digest());
 
     LogInfo << VAR(hash_cache_);
     return hash_cache_;
@@ -291,7 +312,21 @@ void ResourceMgr::register_custom_recognition(const std::string& name, MaaCustom
         LogError << "empty name or handle";
         return;
     }
-    custom_recognition_sessions_.insert_or_assign(name, CustomRecognitionSession { .recognition = recognition, .trans_arg = trans_arg });
+    // 批量形式须在单个形式之后注册，重新注册单个形式会清掉旧的批量形式
+    custom_recognition_sessions_[name] = CustomRecognitionSession { .recognition = recognition, .trans_arg = trans_arg };
+}
+
+void ResourceMgr::register_custom_recognition_batch(const std::string& name, MaaCustomRecognitionBatchCallback recognition, void* trans_arg)
+{
+    LogDebug << VAR(name) << VAR_VOIDP(recognition) << VAR_VOIDP(trans_arg);
+
+    if (name.empty() || !recognition) {
+        LogError << "empty name or handle";
+        return;
+    }
+    auto& session = custom_recognition_sessions_[name];
+    session.batch = recognition;
+    session.batch_trans_arg = trans_arg;
 }
 
 void ResourceMgr::unregister_custom_recognition(const std::string& name)
@@ -401,6 +436,91 @@ const std::unordered_set<MaaInferenceExecutionProvider>& ResourceMgr::available_
     return s_provider_cache;
 }
 
+bool ResourceMgr::set_template_warm_up(MaaOptionValue value, MaaOptionValueSize val_size)
+{
+    LogFunc << VAR_VOIDP(value) << VAR(val_size);
+
+    if (val_size != sizeof(bool)) {
+        LogError << "invalid size" << VAR(val_size);
+        return false;
+    }
+
+    template_warm_up_ = *reinterpret_cast<const bool*>(value);
+    LogInfo << VAR(template_warm_up_);
+
+    return true;
+}
+
+bool ResourceMgr::set_template_cache_budget(MaaOptionValue value, MaaOptionValueSize val_size)
+{
+    LogFunc << VAR_VOIDP(value) << VAR(val_size);
+
+    if (val_size != sizeof(int64_t)) {
+        LogError << "invalid size" << VAR(val_size);
+        return false;
+    }
+
+    auto budget = *reinterpret_cast<const int64_t*>(value);
+    if (budget < 0) {
+        LogError << "invalid budget" << VAR(budget);
+        return false;
+    }
+
+    template_res_.set_budget(static_cast<size_t>(budget));
+    return true;
+}
+
+bool ResourceMgr::set_template_pinned_nodes(MaaOptionValue value, MaaOptionValueSize val_size)
+{
+    LogFunc << VAR_VOIDP(value) << VAR(val_size);
+
+    if (!value) {
+        LogError << "value is null";
+        return false;
+    }
+
+    std::string str(reinterpret_cast<const char*>(value), val_size);
+    auto json_opt = json::parse(str);
+    if (!json_opt || !json_opt->is<std::vector<std::string>>()) {
+        LogError << "value is not json array of string" << VAR(str);
+        return false;
+    }
+
+    // 正在加载时会等本次加载结束
+    std::unique_lock load_lock(load_mutex_);
+
+    template_pinned_nodes_ = json_opt->as<std::vector<std::string>>();
+    LogInfo << VAR(template_pinned_nodes_);
+
+    update_template_pinned();
+    return true;
+}
+
+void ResourceMgr::update_template_pinned()
+{
+    template_res_.set_pinned(pipeline_res_.get_template_names(template_pinned_nodes_));
+}
+
+bool ResourceMgr::set_compiled_bundle_verify_sources(MaaOptionValue value, MaaOptionValueSize val_size)
+{
+    LogFunc << VAR_VOIDP(value) << VAR(val_size);
+
+    if (val_size != sizeof(bool)) {
+        LogError << "invalid size" << VAR(val_size);
+        return false;
+    }
+
+    compiled_bundle_verify_sources_ = *reinterpret_cast<const bool*>(value);
+    LogInfo << VAR(compiled_bundle_verify_sources_);
+
+    return true;
+}
+
+std::string ResourceMgr::get_template_cache_stats() const
+{
+    return json::value(template_res_.stats()).to_string();
+}
+
 bool ResourceMgr::set_inference_device(MaaOptionValue value, MaaOptionValueSize val_size)
 {
     LogFunc << VAR_VOIDP(value) << VAR(val_size);
@@ -603,6 +723,11 @@ bool ResourceMgr::run_load(typename AsyncRunner<PostPathItem>::Id id, PostPathIt
 
     notifier_.notify(this, MaaMsg_Resource_Loading_Starting, cb_detail);
 
+    std::unique_lock load_lock(load_mutex_);
+
+    load_timings_.clear();
+    auto start_time = std::chrono::steady_clock::now();
+
     check_and_set_inference_device();
 
     switch (item.type) {
@@ -624,7 +749,18 @@ bool ResourceMgr::run_load(typename AsyncRunner<PostPathItem>::Id id, PostPathIt
         break;
     }
 
+    if (!template_pinned_nodes_.empty()) {
+        update_template_pinned();
+    }
+    if (valid_ && template_warm_up_ && item.type != PostPathType::OcrModel) {
+        warm_up_templates();
+    }
+    load_timings_["total"] = duration_since(start_time).count();
+
+    load_lock.unlock();
+
     cb_detail["hash"] = calc_hash();
+    cb_detail["timings"] = load_timings_;
 
     notifier_.notify(this, valid_ ? MaaMsg_Resource_Loading_Succeeded : MaaMsg_Resource_Loading_Failed, cb_detail);
 
@@ -635,6 +771,10 @@ bool ResourceMgr::load_bundle(const std::filesystem::path& path)
 {
     LogFunc << VAR(path);
 
+    if (std::filesystem::is_regular_file(path)) {
+        return load_compiled_bundle(path);
+    }
+
     if (!std::filesystem::exists(path) || !std::filesystem::is_directory(path)) {
         LogError << "path not exists or not a directory" << VAR(path);
         return false;
@@ -648,6 +788,7 @@ bool ResourceMgr::load_bundle(const std::filesystem::path& path)
 
     bool to_load = false;
     bool ret = true;
+    auto start_time = std::chrono::steady_clock::now();
     if (auto jc_path = path / "default_pipeline.jsonc"_path; std::filesystem::exists(jc_path)) {
         to_load = true;
         ret &= default_pipeline_.load(jc_path);
@@ -656,11 +797,97 @@ bool ResourceMgr::load_bundle(const std::filesystem::path& path)
         to_load = true;
         ret &= default_pipeline_.load(j_path);
     }
+    load_timings_["default_pipeline"] = duration_since(start_time).count();
 
     if (auto p = path / "pipeline"_path; std::filesystem::exists(p)) {
         to_load = true;
         ret &= pipeline_res_.load(p, default_pipeline_);
+        record_pipeline_timings();
     }
+
+    start_time = std::chrono::steady_clock::now();
+    ret &= lazy_load_models_and_images(path, to_load);
+    load_timings_["models"] = duration_since(start_time).count();
+
+    LogInfo << VAR(path) << VAR(ret) << VAR(to_load);
+
+    return to_load && ret;
+}
+
+bool ResourceMgr::load_compiled_bundle(const std::filesystem::path& path)
+{
+    LogFunc << VAR(path);
+
+    auto bundle_opt = CompiledBundle::open(path);
+    if (!bundle_opt) {
+        LogError << "failed to open compiled bundle" << VAR(path);
+        return false;
+    }
+    const auto& bundle = *bundle_opt;
+    const auto& source = bundle.source();
+
+    if (!std::filesystem::is_directory(source)) {
+        LogError << "source of compiled bundle not exists" << VAR(path) << VAR(source);
+        return false;
+    }
+
+    // 默认只 stat 清单中的路径；开启 MaaResOption_CompiledBundleVerifySources 时才遍历整个源目录逐文件比较
+    const bool fresh =
+        compiled_bundle_verify_sources_ ? bundle.is_fresh(CompiledBundle::make_stamp(source, path, false)) : bundle.is_fresh();
+    if (!fresh) {
+        LogWarn << "compiled bundle is stale, fallback to source" << VAR(path) << VAR(source);
+        return load_bundle(source);
+    }
+
+    check_and_set_inference_device();
+
+    // 解析好的节点依赖加载时的默认参数，只有此前没有加载过任何默认参数和节点时才能直接使用
+    const bool pristine = !default_pipeline_.loaded() && pipeline_res_.get_pipeline_data_map().empty();
+
+    paths_.emplace_back(source);
+
+    // 编译时已算好各文件摘要，calc_hash 不必再读取源文件；文件有变化时摘要缓存按状态比对，不会误用
+    auto& digest_cache = FileDigestCache::get_instance();
+    for (const auto& file : bundle.stamp()) {
+        digest_cache.seed(source / MAA_NS::path(file.path), { .size = file.size, .mtime = file.mtime }, file.digest);
+    }
+
+    bool to_load = false;
+    bool ret = true;
+    auto start_time = std::chrono::steady_clock::now();
+    if (!bundle.default_pipeline().empty()) {
+        to_load = true;
+        auto json_opt = json::parse(std::string(bundle.default_pipeline()));
+        ret &= json_opt && default_pipeline_.load(*json_opt);
+    }
+    load_timings_["default_pipeline"] = duration_since(start_time).count();
+
+    if (!bundle.pipeline_json().empty()) {
+        to_load = true;
+        if (pristine) {
+            ret &= pipeline_res_.load_compiled(path, bundle.pipeline_data());
+        }
+        else {
+            auto json_opt = json::parse(std::string(bundle.pipeline_json()));
+            ret &= json_opt && pipeline_res_.load_compiled(path, *json_opt, default_pipeline_);
+        }
+        record_pipeline_timings();
+    }
+
+    start_time = std::chrono::steady_clock::now();
+    ret &= lazy_load_models_and_images(source, to_load);
+    load_timings_["models"] = duration_since(start_time).count();
+
+    LogInfo << VAR(path) << VAR(source) << VAR(ret) << VAR(to_load) << VAR(pristine);
+
+    return to_load && ret;
+}
+
+bool ResourceMgr::lazy_load_models_and_images(const std::filesystem::path& path, bool& to_load)
+{
+    using namespace path_literals;
+
+    bool ret = true;
     if (auto p = path / "model"_path / "ocr"_path; std::filesystem::exists(p)) {
         to_load = true;
         ret &= ocr_res_.lazy_load(p);
@@ -677,10 +904,7 @@ bool ResourceMgr::load_bundle(const std::filesystem::path& path)
         to_load = true;
         ret &= template_res_.lazy_load(p);
     }
-
-    LogInfo << VAR(path) << VAR(ret) << VAR(to_load);
-
-    return to_load && ret;
+    return ret;
 }
 
 bool ResourceMgr::load_ocr_model(const std::filesystem::path& path)
@@ -708,11 +932,32 @@ bool ResourceMgr::load_pipeline(const std::filesystem::path& path)
 
     paths_.emplace_back(path);
 
-    if (std::filesystem::is_directory(path)) {
-        return pipeline_res_.load(path, default_pipeline_);
-    }
+    bool ret = std::filesystem::is_directory(path) ? pipeline_res_.load(path, default_pipeline_)
+                                                   : pipeline_res_.load_file(path, default_pipeline_);
+    record_pipeline_timings();
+    return ret;
+}
+
+void ResourceMgr::record_pipeline_timings()
+{
+    const auto& cost = pipeline_res_.last_load_cost();
+    load_timings_["pipeline_read"] = cost.read.count();
+    load_timings_["pipeline_parse"] = cost.parse.count();
+    load_timings_["pipeline_check"] = cost.check.count();
+}
+
+void ResourceMgr::warm_up_templates()
+{
+    LogFunc;
+
+    auto start_time = std::chrono::steady_clock::now();
+
+    auto names = pipeline_res_.get_template_names();
+    size_t loaded = template_res_.warm_up(names);
 
-    return pipeline_res_.load_file(path, default_pipeline_);
+    auto cost = duration_since(start_time);
+    load_timings_["template_warm_up"] = cost.count();
+    LogInfo << VAR(names.size()) << VAR(loaded) << VAR(cost.count());
 }
 
 bool ResourceMgr::load_image(const std::filesystem::path& path)
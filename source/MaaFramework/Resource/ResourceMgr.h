@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <mutex>
 
 #include "Base/AsyncRunner.hpp"
 #include "Common/MaaTypes.h"
@@ -34,6 +35,10 @@ struct CustomRecognitionSession
 {
     MaaCustomRecognitionCallback recognition = nullptr;
     void* trans_arg = nullptr;
+
+    // 可选的批量形式
+    MaaCustomRecognitionBatchCallback batch = nullptr;
+    void* batch_trans_arg = nullptr;
 };
 
 struct CustomActionSession
@@ -68,6 +73,8 @@ public: // MaaResource
     virtual std::optional<json::object> get_node_data(const std::string& node_name) const override;
 
     virtual void register_custom_recognition(const std::string& name, MaaCustomRecognitionCallback recognition, void* trans_arg) override;
+    virtual void
+        register_custom_recognition_batch(const std::string& name, MaaCustomRecognitionBatchCallback recognition, void* trans_arg) override;
     virtual void unregister_custom_recognition(const std::string& name) override;
     virtual void clear_custom_recognition() override;
     virtual void register_custom_action(const std::string& name, MaaCustomActionCallback action, void* trans_arg) override;
@@ -78,6 +85,7 @@ public: // MaaResource
     virtual std::vector<std::string> get_node_list() const override;
     virtual std::vector<std::string> get_custom_recognition_list() const override;
     virtual std::vector<std::string> get_custom_action_list() const override;
+    virtual std::string get_template_cache_stats() const override;
 
     virtual std::optional<json::object> get_default_recognition_param(const std::string& reco_type) const override;
     virtual std::optional<json::object> get_default_action_param(const std::string& action_type) const override;
@@ -118,6 +126,11 @@ private:
 
     bool set_inference_device(MaaOptionValue value, MaaOptionValueSize val_size);
     bool set_inference_execution_provider(MaaOptionValue value, MaaOptionValueSize val_size);
+    bool set_template_warm_up(MaaOptionValue value, MaaOptionValueSize val_size);
+    bool set_template_cache_budget(MaaOptionValue value, MaaOptionValueSize val_size);
+    bool set_template_pinned_nodes(MaaOptionValue value, MaaOptionValueSize val_size);
+    void update_template_pinned();
+    bool set_compiled_bundle_verify_sources(MaaOptionValue value, MaaOptionValueSize val_size);
 
     bool check_and_set_inference_device();
     bool use_auto_ep();
@@ -130,9 +143,13 @@ private:
 
     bool run_load(typename AsyncRunner<PostPathItem>::Id id, PostPathItem item);
     bool load_bundle(const std::filesystem::path& path);
+    bool load_compiled_bundle(const std::filesystem::path& path);
+    bool lazy_load_models_and_images(const std::filesystem::path& path, bool& to_load);
     bool load_ocr_model(const std::filesystem::path& path);
     bool load_pipeline(const std::filesystem::path& path);
     bool load_image(const std::filesystem::path& path);
+    void record_pipeline_timings();
+    void warm_up_templates();
     bool check_stop();
 
 private:
@@ -152,6 +169,13 @@ private:
     std::vector<std::filesystem::path> paths_;
     mutable std::string hash_cache_;
     std::atomic_bool valid_ = true;
+    // 最近一次加载各阶段耗时（毫秒），随 Resource.Loading 回调发出
+    json::object load_timings_;
+    bool template_warm_up_ = false;
+    // 加载线程改写 pipeline 期间持有 load_mutex_；在其他线程读取 pipeline 计算固定模板时也需持有
+    std::mutex load_mutex_;
+    std::vector<std::string> template_pinned_nodes_;
+    bool compiled_bundle_verify_sources_ = false;
 
     std::unique_ptr<AsyncRunner<PostPathItem>> res_loader_ = nullptr;
     EventDispatcher notifier_;
@@ -2,6 +2,7 @@
 
 #include "MaaUtils/ImageIo.h"
 #include "MaaUtils/Logger.h"
+#include "ParallelLoad.h"
 
 MAA_RES_NS_BEGIN
 
@@ -9,6 +10,7 @@ bool TemplateResMgr::lazy_load(const std::filesystem::path& path)
 {
     LogFunc << VAR(path);
 
+    std::unique_lock lock(roots_mutex_);
     roots_.emplace_back(path);
     return true;
 }
@@ -29,39 +31,143 @@ bool TemplateResMgr::load_file(const std::filesystem::path& path)
     }
 
     auto name = path_to_utf8_string(path.filename());
-    image_cache_[name] = { std::move(image) };
+    insert(name, { std::move(image) }, false);
     return true;
 }
 
+size_t TemplateResMgr::warm_up(const std::set<std::string>& names)
+{
+    LogFunc << VAR(names.size());
+
+    std::vector<std::string> to_load;
+    for (const auto& name : names) {
+        auto& shard = shard_of(name);
+        std::unique_lock lock(shard.mutex);
+        if (!shard.entries.contains(name)) {
+            to_load.emplace_back(name);
+        }
+    }
+
+    std::vector<std::vector<cv::Mat>> images(to_load.size());
+    parallel_load(to_load.size(), [&](size_t i) { images[i] = load(to_load[i]); });
+
+    size_t loaded = 0;
+    for (size_t i = 0; i < to_load.size(); ++i) {
+        if (images[i].empty()) {
+            LogWarn << "template not found" << VAR(to_load[i]);
+            continue;
+        }
+        insert(to_load[i], std::move(images[i]), true);
+        ++loaded;
+    }
+
+    LogInfo << VAR(names.size()) << VAR(to_load.size()) << VAR(loaded);
+    return loaded;
+}
+
 void TemplateResMgr::clear()
 {
     LogFunc;
 
-    roots_.clear();
-    image_cache_.clear();
+    {
+        std::unique_lock lock(roots_mutex_);
+        roots_.clear();
+    }
+    for (auto& shard : shards_) {
+        std::unique_lock lock(shard.mutex);
+        shard.entries.clear();
+        shard.lru.clear();
+        bytes_ -= shard.bytes;
+        shard.bytes = 0;
+    }
 }
 
 std::vector<cv::Mat> TemplateResMgr::get_image(const std::string& name)
 {
-    if (auto iter = image_cache_.find(name); iter != image_cache_.end()) {
-        return iter->second;
+    auto& shard = shard_of(name);
+    {
+        std::unique_lock lock(shard.mutex);
+        if (auto iter = shard.entries.find(name); iter != shard.entries.end()) {
+            auto& entry = iter->second;
+            touch(shard, entry);
+            ++hits_;
+            return entry.images;
+        }
     }
 
+    ++misses_;
+
+    // 在锁外读取，多个线程同时未命中同一模板时由 insert 保留先写入的一份
     auto imgs = load(name);
     if (imgs.empty()) {
         return { };
     }
-    image_cache_.emplace(name, imgs);
-    return imgs;
+    return insert(name, std::move(imgs), true);
 }
 
 void TemplateResMgr::set_image(const std::string& name, const cv::Mat& image)
 {
-    image_cache_[name] = { image };
+    auto& shard = shard_of(name);
+    {
+        std::unique_lock lock(shard.mutex);
+        if (auto iter = shard.entries.find(name); iter != shard.entries.end()) {
+            if (!iter->second.pinned) {
+                shard.lru.erase(iter->second.lru_iter);
+            }
+            shard.bytes -= iter->second.bytes;
+            bytes_ -= iter->second.bytes;
+            shard.entries.erase(iter);
+        }
+    }
+    insert(name, { image }, false);
+}
+
+void TemplateResMgr::set_budget(size_t bytes)
+{
+    LogInfo << VAR(bytes);
+
+    budget_ = bytes;
+    trim({ });
 }
 
-std::vector<cv::Mat> TemplateResMgr::load(const std::string& name)
+void TemplateResMgr::set_pinned(std::set<std::string> names)
 {
+    LogInfo << VAR(names);
+
+    std::unique_lock pin_lock(pin_mutex_);
+    pinned_names_ = std::move(names);
+
+    for (auto& shard : shards_) {
+        std::unique_lock lock(shard.mutex);
+        for (auto& [name, entry] : shard.entries) {
+            set_entry_pinned(shard, name, entry, !entry.reloadable || pinned_names_.contains(name));
+        }
+    }
+    trim({ });
+}
+
+TemplateResMgr::CacheStats TemplateResMgr::stats() const
+{
+    CacheStats result {
+        .budget = budget_,
+        .hits = hits_,
+        .misses = misses_,
+        .evictions = evictions_,
+    };
+
+    for (const auto& shard : shards_) {
+        std::unique_lock lock(shard.mutex);
+        result.bytes += shard.bytes;
+        result.entries += shard.entries.size();
+        result.pinned += shard.entries.size() - shard.lru.size();
+    }
+    return result;
+}
+
+std::vector<cv::Mat> TemplateResMgr::load(const std::string& name) const
+{
+    std::shared_lock roots_lock(roots_mutex_);
+
     LogFunc << VAR(name) << VAR(roots_);
 
     auto load_regular_image = [&](const std::filesystem::path& path) -> cv::Mat {
@@ -117,4 +223,130 @@ std::vector<cv::Mat> TemplateResMgr::load(const std::string& name)
     return results;
 }
 
+TemplateResMgr::Shard& TemplateResMgr::shard_of(const std::string& name)
+{
+    return shards_[std::hash<std::string> {}(name) % kShardCount];
+}
+
+std::vector<cv::Mat> TemplateResMgr::insert(const std::string& name, std::vector<cv::Mat> images, bool reloadable)
+{
+    size_t bytes = 0;
+    for (const auto& image : images) {
+        bytes += image.total() * image.elemSize();
+    }
+
+    std::vector<cv::Mat> result;
+    {
+        std::shared_lock pin_lock(pin_mutex_);
+
+        auto& shard = shard_of(name);
+        std::unique_lock lock(shard.mutex);
+
+        auto [iter, inserted] = shard.entries.try_emplace(name);
+        auto& entry = iter->second;
+        if (!inserted) {
+            return entry.images;
+        }
+
+        entry.images = std::move(images);
+        entry.bytes = bytes;
+        entry.reloadable = reloadable;
+        entry.pinned = true; // 尚未进入 lru
+        shard.bytes += bytes;
+        bytes_ += bytes;
+
+        set_entry_pinned(shard, name, entry, !reloadable || pinned_names_.contains(name));
+        result = entry.images;
+    }
+
+    trim(name);
+    return result;
+}
+
+void TemplateResMgr::set_entry_pinned(Shard& shard, const std::string& name, Entry& entry, bool pinned)
+{
+    if (entry.pinned == pinned) {
+        return;
+    }
+
+    if (pinned) {
+        shard.lru.erase(entry.lru_iter);
+    }
+    else {
+        entry.lru_iter = shard.lru.emplace(shard.lru.begin(), name);
+        entry.last_used = ++clock_;
+    }
+    entry.pinned = pinned;
+}
+
+void TemplateResMgr::touch(Shard& shard, Entry& entry)
+{
+    if (entry.pinned) {
+        return;
+    }
+    // 序号在分片锁内取得，同一分片内 lru 的顺序与 last_used 一致
+    shard.lru.splice(shard.lru.begin(), shard.lru, entry.lru_iter);
+    entry.last_used = ++clock_;
+}
+
+void TemplateResMgr::trim(const std::string& keep)
+{
+    if (budget_ == 0 || bytes_ <= budget_) {
+        return;
+    }
+
+    std::unique_lock trim_lock(trim_mutex_);
+
+    // 各分片的队尾是该分片最久未用的条目，比较所有队尾即可找到全局最久未用的条目。
+    // 每次只锁一个分片；比较后队尾可能被访问而移走，此时重新比较
+    while (budget_ != 0 && bytes_ > budget_) {
+        Shard* oldest = nullptr;
+        uint64_t oldest_used = UINT64_MAX;
+        for (auto& shard : shards_) {
+            std::unique_lock lock(shard.mutex);
+            if (shard.lru.empty()) {
+                continue;
+            }
+            const auto& name = shard.lru.back();
+            // 刚放入的模板即使单独超出预算也保留，否则马上又会被重新读取；它在分片中最新，只有分片中仅剩它时才会位于队尾
+            if (name == keep) {
+                continue;
+            }
+            const uint64_t used = shard.entries.at(name).last_used;
+            if (used < oldest_used) {
+                oldest = &shard;
+                oldest_used = used;
+            }
+        }
+        if (!oldest) {
+            break;
+        }
+
+        std::unique_lock lock(oldest->mutex);
+        evict(*oldest, oldest_used);
+    }
+}
+
+bool TemplateResMgr::evict(Shard& shard, uint64_t last_used)
+{
+    if (shard.lru.empty()) {
+        return false;
+    }
+
+    auto iter = shard.entries.find(shard.lru.back());
+    if (iter->second.last_used != last_used) {
+        return false;
+    }
+
+    LogDebug << "evict" << VAR(iter->first) << VAR(iter->second.bytes) << VAR(iter->second.last_used) << VAR(shard.bytes)
+             << VAR(bytes_.load()) << VAR(budget_.load());
+
+    shard.bytes -= iter->second.bytes;
+    bytes_ -= iter->second.bytes;
+    shard.lru.pop_back();
+    shard.entries.erase(iter);
+    ++evictions_;
+    return true;
+}
+
 MAA_RES_NS_END
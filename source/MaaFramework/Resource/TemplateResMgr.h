@@ -1,19 +1,46 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <filesystem>
+#include <list>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
 #include <unordered_map>
 
+#include <meojson/json.hpp>
+
 #include "Common/Conf.h"
 #include "MaaUtils/NoWarningCVMat.hpp"
 #include "MaaUtils/NonCopyable.hpp"
 
 MAA_RES_NS_BEGIN
 
+// 模板图片缓存。按名称分片加锁，可并发读取；超出字节预算时按全局 LRU 淘汰未固定的模板，
+// 被淘汰的模板下次使用时重新从磁盘读取。override / load_file 设置的图片无法重新读取，始终固定
 class TemplateResMgr : public NonCopyable
 {
+public:
+    struct CacheStats
+    {
+        size_t budget = 0; // 0 表示不限
+        size_t bytes = 0;
+        size_t entries = 0;
+        size_t pinned = 0;
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+
+        MEO_JSONIZATION(budget, bytes, entries, pinned, hits, misses, evictions);
+    };
+
 public:
     bool lazy_load(const std::filesystem::path& path);
     bool load_file(const std::filesystem::path& path);
+    // 并行读取并解码尚未缓存的模板，返回本次新缓存的数量
+    size_t warm_up(const std::set<std::string>& names);
 
     void clear();
 
@@ -21,12 +48,60 @@ public:
     std::vector<cv::Mat> get_image(const std::string& name);
     void set_image(const std::string& name, const cv::Mat& image);
 
+    void set_budget(size_t bytes);
+    // 替换固定的模板名集合，固定的模板不会被淘汰
+    void set_pinned(std::set<std::string> names);
+    CacheStats stats() const;
+
 private:
-    std::vector<cv::Mat> load(const std::string& name);
+    struct Entry
+    {
+        std::vector<cv::Mat> images;
+        size_t bytes = 0;
+        bool reloadable = true;
+        bool pinned = false;
+        uint64_t last_used = 0; // 全局递增的访问序号
+        std::list<std::string>::iterator lru_iter; // 仅未固定的条目在 lru 中
+    };
+
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, Entry> entries;
+        std::list<std::string> lru; // 越靠前越新，与 last_used 的顺序一致
+        size_t bytes = 0;
+    };
 
+    inline static constexpr size_t kShardCount = 16;
+
+    std::vector<cv::Mat> load(const std::string& name) const;
+
+    Shard& shard_of(const std::string& name);
+    std::vector<cv::Mat> insert(const std::string& name, std::vector<cv::Mat> images, bool reloadable);
+    void set_entry_pinned(Shard& shard, const std::string& name, Entry& entry, bool pinned);
+    void touch(Shard& shard, Entry& entry);
+    // 总量超出预算时淘汰全局最久未用的条目，调用方不得持有任何分片锁
+    void trim(const std::string& keep);
+    // 调用方需持有 shard.mutex；队尾仍是 last_used 时淘汰它
+    bool evict(Shard& shard, uint64_t last_used);
+
+    mutable std::shared_mutex roots_mutex_;
     std::vector<std::filesystem::path> roots_ = { "" }; // for filepath without prefix
 
-    std::unordered_map<std::string, std::vector<cv::Mat>> image_cache_;
+    // 加锁顺序：pin_mutex_ -> trim_mutex_ -> Shard::mutex
+    mutable std::shared_mutex pin_mutex_;
+    std::set<std::string> pinned_names_;
+
+    // 同一时间只有一个线程在淘汰，避免并发淘汰时超量
+    std::mutex trim_mutex_;
+    std::atomic_uint64_t clock_ = 0;
+
+    std::array<Shard, kShardCount> shards_;
+    std::atomic_size_t budget_ = 0;
+    std::atomic_size_t bytes_ = 0; // 所有分片之和，预算按它判断
+    std::atomic_size_t hits_ = 0;
+    std::atomic_size_t misses_ = 0;
+    std::atomic_size_t evictions_ = 0;
 };
 
 MAA_RES_NS_END
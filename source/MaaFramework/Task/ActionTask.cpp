@@ -46,11 +46,13 @@ MaaActId ActionTask::run_impl()
 
     auto node_id = generate_node_id();
 
-    json::value node_cb_detail {
-        { "task_id", task_id() },
-        { "node_id", node_id },
-        { "name", entry_ },
-        { "focus", cur_node.focus },
+    auto node_cb_detail = [&]() {
+        return json::value {
+            { "task_id", task_id() },
+            { "node_id", node_id },
+            { "name", entry_ },
+            { "focus", cur_node.focus },
+        };
     };
 
     notify(MaaMsg_Node_ActionNode_Starting, node_cb_detail);
@@ -73,10 +75,13 @@ MaaActId ActionTask::run_impl()
     LogInfo << "ActionTask node done" << VAR(result) << VAR(task_id_);
     set_node_detail(result.node_id, result);
 
-    node_cb_detail["node_details"] = result;
-    node_cb_detail["reco_details"] = fake_reco;
-    node_cb_detail["action_details"] = act;
-    notify(act.success ? MaaMsg_Node_ActionNode_Succeeded : MaaMsg_Node_ActionNode_Failed, node_cb_detail);
+    notify(act.success ? MaaMsg_Node_ActionNode_Succeeded : MaaMsg_Node_ActionNode_Failed, [&]() {
+        json::value detail = node_cb_detail();
+        detail["node_details"] = result;
+        detail["reco_details"] = fake_reco;
+        detail["action_details"] = act;
+        return detail;
+    });
 
     return act.action_id;
 }
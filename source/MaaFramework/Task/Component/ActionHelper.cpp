@@ -6,6 +6,7 @@
 #include "Recognizer.h"
 #include "Task/Context.h"
 #include "Tasker/Tasker.h"
+#include "Vision/BlockComparator.h"
 #include "Vision/TemplateComparator.h"
 #include "Vision/VisionUtils.hpp"
 
@@ -39,25 +40,28 @@ bool ActionHelper::wait_freezes(
     using namespace MAA_VISION_NS;
 
     LogTrace << "Wait freezes:" << VAR(param.time) << VAR(param.rate_limit) << VAR(param.timeout) << VAR(param.threshold)
-             << VAR(param.method);
+             << VAR(param.method) << VAR(param.block_size);
 
     const MaaWfId wf_id = generate_wf_id();
 
-    json::value cb_detail {
-        { "task_id", context_ ? context_->task_id() : MaaInvalidId },
-        { "wf_id", wf_id },
-        { "name", noti_ctx.name },
-        { "phase", noti_ctx.phase },
-        { "roi", roi },
-        { "param",
-          {
-              { "time", param.time.count() },
-              { "threshold", param.threshold },
-              { "method", param.method },
-              { "rate_limit", param.rate_limit.count() },
-              { "timeout", param.timeout.count() },
-          } },
-        { "focus", noti_ctx.focus },
+    auto cb_detail = [&]() {
+        return json::value {
+            { "task_id", context_ ? context_->task_id() : MaaInvalidId },
+            { "wf_id", wf_id },
+            { "name", noti_ctx.name },
+            { "phase", noti_ctx.phase },
+            { "roi", roi },
+            { "param",
+              {
+                  { "time", param.time.count() },
+                  { "threshold", param.threshold },
+                  { "method", param.method },
+                  { "block_size", param.block_size },
+                  { "rate_limit", param.rate_limit.count() },
+                  { "timeout", param.timeout.count() },
+              } },
+            { "focus", noti_ctx.focus },
+        };
     };
     notify(MaaMsg_Node_WaitFreezes_Starting, cb_detail);
 
@@ -67,11 +71,15 @@ bool ActionHelper::wait_freezes(
     auto finish = [&](bool success) {
         auto elapsed_ms = duration_since(start_clock).count();
 
-        cb_detail["reco_ids"] = json::array(reco_ids);
-        cb_detail["elapsed"] = elapsed_ms;
-        notify(success ? MaaMsg_Node_WaitFreezes_Succeeded : MaaMsg_Node_WaitFreezes_Failed, cb_detail);
+        notify(success ? MaaMsg_Node_WaitFreezes_Succeeded : MaaMsg_Node_WaitFreezes_Failed, [&]() {
+            json::value detail = cb_detail();
+            detail["reco_ids"] = json::array(reco_ids);
+            detail["elapsed"] = elapsed_ms;
+            return detail;
+        });
 
         if (auto* t = tasker()) {
+            t->latency_stats().record_since("wait_freezes", noti_ctx.phase.empty() ? "context" : noti_ctx.phase, start_clock);
             t->runtime_cache().set_wf_detail(
                 wf_id,
                 WaitFreezesDetail {
@@ -104,6 +112,11 @@ bool ActionHelper::wait_freezes(
         .method = param.method,
     };
 
+    // 分块模式下块内平均逐像素差的容差，threshold 越高越严格
+    const double block_tolerance = (1.0 - param.threshold) * 255.0;
+    std::optional<bool> pre_changed;
+    size_t polls = 0;
+
     auto pre_image_clock = start_clock;
 
     while (true) {
@@ -124,30 +137,62 @@ bool ActionHelper::wait_freezes(
         }
 
         std::string draw_name = noti_ctx.name.empty() ? "wait_freezes" : std::format("{}_wait_freezes", noti_ctx.name);
-        TemplateComparator comparator(pre_image, cur_image, { *corrected_roi }, comp_param, draw_name);
-
-        const MaaRecoId reco_id = Recognizer::generate_reco_id();
-        RecoResult reco_result {
-            .reco_id = reco_id,
-            .name = draw_name,
-            .algorithm = "WaitFreezes",
-            .box = comparator.best_result() ? std::make_optional(comparator.best_result()->box) : std::nullopt,
-            .detail =
-                json::value {
-                    { "all", json::array(comparator.all_results()) },
-                    { "filtered", json::array(comparator.filtered_results()) },
-                    { "best", comparator.best_result() ? json::value(*comparator.best_result()) : json::value(nullptr) },
-                },
-            .draws = comparator.draws(),
-        };
-        if (auto* t = tasker()) {
-            t->runtime_cache().set_reco_detail(reco_id, std::move(reco_result));
-        }
-        reco_ids.emplace_back(reco_id);
 
-        VisionBase::save_draws(draw_name, comparator.draws());
+        bool changed = false;
+        if (param.block_size > 0) {
+            auto changed_block = find_changed_block(pre_image, cur_image, *corrected_roi, param.block_size, block_tolerance);
+            changed = changed_block.has_value();
+
+            // 高频轮询时每帧都记录会塞满缓存，只在变化/静止状态切换时记录一次
+            if (!pre_changed || *pre_changed != changed) {
+                const MaaRecoId reco_id = Recognizer::generate_reco_id();
+                RecoResult reco_result {
+                    .reco_id = reco_id,
+                    .name = draw_name,
+                    .algorithm = "WaitFreezes",
+                    .box = changed ? std::nullopt : std::make_optional(*corrected_roi),
+                    .detail =
+                        json::value {
+                            { "changed", changed },
+                            { "block", changed_block ? json::value(*changed_block) : json::value(nullptr) },
+                            { "polls", polls },
+                        },
+                };
+                if (auto* t = tasker()) {
+                    t->runtime_cache().set_reco_detail(reco_id, std::move(reco_result));
+                }
+                reco_ids.emplace_back(reco_id);
+            }
+            pre_changed = changed;
+            ++polls;
+        }
+        else {
+            TemplateComparator comparator(pre_image, cur_image, { *corrected_roi }, comp_param, draw_name);
+            changed = !comparator.best_result();
+
+            const MaaRecoId reco_id = Recognizer::generate_reco_id();
+            RecoResult reco_result {
+                .reco_id = reco_id,
+                .name = draw_name,
+                .algorithm = "WaitFreezes",
+                .box = comparator.best_result() ? std::make_optional(comparator.best_result()->box) : std::nullopt,
+                .detail =
+                    json::value {
+                        { "all", json::array(comparator.all_results()) },
+                        { "filtered", json::array(comparator.filtered_results()) },
+                        { "best", comparator.best_result() ? json::value(*comparator.best_result()) : json::value(nullptr) },
+                    },
+                .draws = comparator.draws(),
+            };
+            if (auto* t = tasker()) {
+                t->runtime_cache().set_reco_detail(reco_id, std::move(reco_result));
+            }
+            reco_ids.emplace_back(reco_id);
+
+            VisionBase::save_draws(draw_name, comparator.draws());
+        }
 
-        if (!comparator.best_result()) {
+        if (changed) {
             pre_image = cur_image;
             pre_image_clock = std::chrono::steady_clock::now();
             continue;
@@ -267,6 +312,12 @@ void ActionHelper::notify(std::string_view msg, const json::value& detail)
     t->context_notify(context_, msg, detail);
 }
 
+bool ActionHelper::subscribed(std::string_view msg) const
+{
+    auto* t = tasker();
+    return t && context_ && t->context_subscribed(msg);
+}
+
 MAA_CTRL_NS::ControllerAgent* ActionHelper::controller()
 {
     auto* t = tasker();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <concepts>
 #include <string_view>
 
 #include <meojson/json.hpp>
@@ -36,6 +37,17 @@ public:
 private:
     cv::Rect get_rect_from_node(const std::string& node_name) const;
     void notify(std::string_view msg, const json::value& detail);
+
+    template <std::invocable DetailBuilder>
+    void notify(std::string_view msg, DetailBuilder&& make_detail)
+    {
+        if (!subscribed(msg)) {
+            return;
+        }
+        notify(msg, json::value(std::forward<DetailBuilder>(make_detail)()));
+    }
+
+    bool subscribed(std::string_view msg) const;
     Tasker* tasker() const;
     MAA_CTRL_NS::ControllerAgent* controller();
 
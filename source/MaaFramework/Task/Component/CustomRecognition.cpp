@@ -24,6 +24,23 @@ CustomRecognition::CustomRecognition(
     analyze();
 }
 
+CustomRecognition::CustomRecognition(
+    const cv::Mat& image,
+    const cv::Rect& roi,
+    const MAA_VISION_NS::CustomRecognitionParam& param,
+    const CustomRecognitionBatchCache::Entry& cached,
+    Context& context,
+    std::string name)
+    : VisionBase(image, { roi }, name)
+    , param_(param)
+    , context_(context)
+{
+    LogDebug << "use batch result" << VAR(name_) << VAR(param_.name) << VAR(cached.hit) << VAR(cached.result);
+
+    next_roi();
+    set_result(cached.hit, cached.result);
+}
+
 void CustomRecognition::analyze()
 {
     LogFunc << VAR(context_.task_id()) << VAR(name_) << VAR_VOIDP(session_.recognition) << VAR_VOIDP(session_.trans_arg) << VAR(param_.name)
@@ -63,16 +80,90 @@ void CustomRecognition::analyze()
     const std::string& detail = detail_buffer.get();
 
     auto jdetail = json::parse(detail).value_or(detail);
-    Result res { .box = box, .detail = std::move(jdetail) };
+    set_result(ret, Result { .box = box, .detail = std::move(jdetail) });
+
+    auto cost = duration_since(start_time);
+    LogDebug << VAR(name_) << VAR(param_.name) << VAR(all_results_) << VAR(filtered_results_) << VAR(best_result_) << VAR(cost) << VAR(ret);
+}
 
+void CustomRecognition::set_result(bool hit, Result res)
+{
     all_results_ = { res };
-    if (ret) {
+    if (hit) {
         filtered_results_ = { res };
-        best_result_ = res;
+        best_result_ = std::move(res);
+    }
+}
+
+bool CustomRecognition::analyze_batch(
+    const cv::Mat& image,
+    const std::string& recognition_name,
+    const std::vector<BatchEntry>& entries,
+    const MAA_RES_NS::CustomRecognitionSession& session,
+    Context& context,
+    CustomRecognitionBatchCache& cache)
+{
+    LogFunc << VAR(context.task_id()) << VAR(recognition_name) << VAR(entries.size()) << VAR_VOIDP(session.batch)
+            << VAR_VOIDP(session.batch_trans_arg);
+
+    if (!session.batch || entries.empty()) {
+        return false;
+    }
+
+    auto start_time = std::chrono::steady_clock::now();
+
+    /*in*/
+    json::array jentries;
+    for (const auto& entry : entries) {
+        jentries.emplace_back(
+            json::object {
+                { "node_name", entry.node_name },
+                { "roi", json::array { entry.roi.x, entry.roi.y, entry.roi.width, entry.roi.height } },
+                { "param", entry.param ? entry.param->custom_param : json::value { } },
+            });
+    }
+    const std::string entries_str = json::value(std::move(jentries)).to_string();
+    ImageBuffer image_buffer(image);
+
+    /*out*/
+    StringBuffer results_buffer;
+
+    bool ret = session.batch(
+        &context,
+        context.task_id(),
+        recognition_name.c_str(),
+        entries_str.c_str(),
+        &image_buffer,
+        session.batch_trans_arg,
+        &results_buffer);
+    if (!ret) {
+        LogWarn << "batch recognition failed, fall back to single" << VAR(recognition_name);
+        return false;
+    }
+
+    auto results_opt = json::parse(results_buffer.get());
+    if (!results_opt || !results_opt->is_array() || results_opt->as_array().size() != entries.size()) {
+        LogError << "invalid batch results" << VAR(recognition_name) << VAR(entries.size()) << VAR(results_buffer.get());
+        return false;
+    }
+
+    const auto& results = results_opt->as_array();
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const json::value& jresult = results.at(i);
+
+        CustomRecognitionBatchCache::Entry entry { .hit = jresult.get("hit", false) };
+        if (auto box = jresult.find<std::vector<int>>("box"); box && box->size() == 4) {
+            entry.result.box = cv::Rect(box->at(0), box->at(1), box->at(2), box->at(3));
+        }
+        if (auto detail = jresult.find("detail")) {
+            entry.result.detail = *std::move(detail);
+        }
+        cache.results.insert_or_assign(entries[i].node_name, std::move(entry));
     }
 
     auto cost = duration_since(start_time);
-    LogDebug << VAR(name_) << VAR(param_.name) << VAR(all_results_) << VAR(filtered_results_) << VAR(best_result_) << VAR(cost) << VAR(ret);
+    LogDebug << VAR(recognition_name) << VAR(entries.size()) << VAR(cost);
+    return true;
 }
 
 MAA_TASK_NS_END
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <unordered_map>
 #include <vector>
 
 #include "Common/MaaTypes.h"
@@ -20,6 +21,18 @@ struct CustomRecognitionResult
     MEO_JSONIZATION(box, detail);
 };
 
+// 批量回调给出的各节点结果，随后逐个识别这些节点时直接取用
+struct CustomRecognitionBatchCache
+{
+    struct Entry
+    {
+        bool hit = false;
+        CustomRecognitionResult result;
+    };
+
+    std::unordered_map<std::string /* node name */, Entry> results;
+};
+
 class CustomRecognition
     : public MAA_VISION_NS::VisionBase
     , public MAA_VISION_NS::RecoResultAPI<CustomRecognitionResult>
@@ -33,8 +46,35 @@ public:
         Context& context,
         std::string name);
 
+    // 该节点已由批量回调识别过，直接采用其结果
+    CustomRecognition(
+        const cv::Mat& image,
+        const cv::Rect& roi,
+        const MAA_VISION_NS::CustomRecognitionParam& param,
+        const CustomRecognitionBatchCache::Entry& cached,
+        Context& context,
+        std::string name);
+
+public:
+    struct BatchEntry
+    {
+        std::string node_name;
+        cv::Rect roi;
+        const MAA_VISION_NS::CustomRecognitionParam* param = nullptr;
+    };
+
+    // 同一帧上一次回调识别多个节点，结果写入 cache；回调失败或结果不合法时返回 false，由调用方逐个识别
+    static bool analyze_batch(
+        const cv::Mat& image,
+        const std::string& recognition_name,
+        const std::vector<BatchEntry>& entries,
+        const MAA_RES_NS::CustomRecognitionSession& session,
+        Context& context,
+        CustomRecognitionBatchCache& cache);
+
 private:
     void analyze();
+    void set_result(bool hit, Result res);
 
 private:
     const MAA_VISION_NS::CustomRecognitionParam& param_;
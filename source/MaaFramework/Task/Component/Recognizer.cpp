@@ -7,6 +7,7 @@
 #include "Resource/ResourceMgr.h"
 #include "Vision/ColorMatcher.h"
 #include "Vision/FeatureMatcher.h"
+#include "Vision/ImageEncoder.h"
 #include "Vision/NeuralNetworkClassifier.h"
 #include "Vision/NeuralNetworkDetector.h"
 #include "Vision/OCRer.h"
@@ -15,13 +16,21 @@
 
 MAA_TASK_NS_BEGIN
 
-Recognizer::Recognizer(Tasker* tasker, Context& context, const cv::Mat& image_, std::shared_ptr<MAA_VISION_NS::OCRCache> ocr_batch_cache)
+Recognizer::Recognizer(
+    Tasker* tasker,
+    Context& context,
+    const cv::Mat& image_,
+    std::shared_ptr<MAA_VISION_NS::OCRCache> ocr_batch_cache,
+    std::shared_ptr<CustomRecognitionBatchCache> custom_batch_cache,
+    std::shared_ptr<MAA_VISION_NS::FrameCache> frame_cache)
     : tasker_(tasker)
     , context_(context)
     , image_(image_)
     , sub_filtered_boxes_(std::make_shared<typename decltype(sub_filtered_boxes_)::element_type>())
     , sub_best_box_(std::make_shared<typename decltype(sub_best_box_)::element_type>())
     , ocr_batch_cache_(std::move(ocr_batch_cache))
+    , custom_batch_cache_(std::move(custom_batch_cache))
+    , frame_cache_(std::move(frame_cache))
 {
 }
 
@@ -33,6 +42,8 @@ Recognizer::Recognizer(const Recognizer& recognizer)
     , sub_filtered_boxes_(recognizer.sub_filtered_boxes_)
     , sub_best_box_(recognizer.sub_best_box_)
     , ocr_batch_cache_(recognizer.ocr_batch_cache_)
+    , custom_batch_cache_(recognizer.custom_batch_cache_)
+    , frame_cache_(recognizer.frame_cache_)
 {
 }
 
@@ -47,6 +58,7 @@ RecoResult Recognizer::recognize(MAA_RES_NS::Recognition::Type type, const MAA_R
     }
 
     RecoResult result;
+    const auto start_clock = std::chrono::steady_clock::now();
 
     switch (type) {
     case Type::DirectHit:
@@ -94,10 +106,10 @@ RecoResult Recognizer::recognize(MAA_RES_NS::Recognition::Type type, const MAA_R
         break;
     }
 
+    tasker_->latency_stats().record_since("recognition", result.algorithm, start_clock);
+
     if (debug_mode() && !image_.empty()) {
-        ImageEncodedBuffer png;
-        cv::imencode(".png", image_, png);
-        result.raw = std::move(png);
+        result.raw = MAA_VISION_NS::ImageEncoder::get_instance().encode_frame(image_);
     }
 
     LogInfo << "reco" << VAR(result);
@@ -206,7 +218,7 @@ RecoResult Recognizer::feature_match(const MAA_VISION_NS::FeatureMatcherParam& p
     }
     auto templs = context_.get_images(param.template_);
 
-    return build_result(name, "FeatureMatch", FeatureMatcher(image_, rois, param, templs, name));
+    return build_result(name, "FeatureMatch", FeatureMatcher(image_, rois, param, templs, name, frame_cache_));
 }
 
 RecoResult Recognizer::color_match(const MAA_VISION_NS::ColorMatcherParam& param, const std::string& name)
@@ -224,7 +236,7 @@ RecoResult Recognizer::color_match(const MAA_VISION_NS::ColorMatcherParam& param
         return { };
     }
 
-    return build_result(name, "ColorMatch", ColorMatcher(image_, rois, param, name));
+    return build_result(name, "ColorMatch", ColorMatcher(image_, rois, param, name, frame_cache_));
 }
 
 RecoResult Recognizer::ocr(const MAA_VISION_NS::OCRerParam& param, const std::string& name)
@@ -271,18 +283,31 @@ RecoResult Recognizer::ocr(const MAA_VISION_NS::OCRerParam& param, const std::st
         return build_result(name, "OCR", OCRer(image_, rois, param, cached, resource()->ocr_res().recer(param.model), name));
     }
 
-    return build_result(
+    // 同一帧上 roi 和模型相同的 OCR 只跑一次 det + rec，之后按各自参数过滤
+    const bool can_use_frame_cache = frame_cache_ && !param.only_rec && !color_filter;
+    if (can_use_frame_cache) {
+        if (auto cached = frame_cache_->get_ocr(param.model, rois)) {
+            LogDebug << "OCR using frame cache" << VAR(name) << VAR(cached->size());
+            return build_result(name, "OCR", OCRer(image_, rois, param, *cached, resource()->ocr_res().recer(param.model), name));
+        }
+    }
+
+    OCRer ocrer(
+        image_,
+        rois,
+        param,
+        resource()->ocr_res().deter(param.model),
+        resource()->ocr_res().recer(param.model),
+        resource()->ocr_res().ocrer(param.model),
         name,
-        "OCR",
-        OCRer(
-            image_,
-            rois,
-            param,
-            resource()->ocr_res().deter(param.model),
-            resource()->ocr_res().recer(param.model),
-            resource()->ocr_res().ocrer(param.model),
-            name,
-            std::move(color_filter)));
+        std::move(color_filter),
+        frame_cache_);
+
+    if (can_use_frame_cache && !ocrer.all_results().empty()) {
+        frame_cache_->set_ocr(param.model, rois, ocrer.all_results());
+    }
+
+    return build_result(name, "OCR", std::move(ocrer));
 }
 
 RecoResult Recognizer::nn_classify(const MAA_VISION_NS::NeuralNetworkClassifierParam& param, const std::string& name)
@@ -356,6 +381,12 @@ RecoResult Recognizer::custom_recognize(const MAA_VISION_NS::CustomRecognitionPa
         return { };
     }
 
+    if (custom_batch_cache_) {
+        if (auto it = custom_batch_cache_->results.find(name); it != custom_batch_cache_->results.end()) {
+            return build_result(name, "Custom", CustomRecognition(image_, rois.front(), param, it->second, context_, name));
+        }
+    }
+
     return build_result(
         name,
         "Custom",
@@ -408,7 +439,7 @@ RecoResult Recognizer::and_(const std::shared_ptr<MAA_RES_NS::Recognition::AndPa
         }
     }
 
-    std::vector<ImageEncodedBuffer> all_draws;
+    std::vector<EncodedImage> all_draws;
     for (auto& sub : sub_results) {
         all_draws.insert(all_draws.end(), std::make_move_iterator(sub.draws.begin()), std::make_move_iterator(sub.draws.end()));
     }
@@ -490,7 +521,7 @@ RecoResult Recognizer::or_(const std::shared_ptr<MAA_RES_NS::Recognition::OrPara
             break;
         }
     }
-    std::vector<ImageEncodedBuffer> all_draws;
+    std::vector<EncodedImage> all_draws;
     for (auto& sub : sub_results) {
         all_draws.insert(all_draws.end(), std::make_move_iterator(sub.draws.begin()), std::make_move_iterator(sub.draws.end()));
     }
@@ -713,4 +744,33 @@ void Recognizer::prefetch_batch_ocr(const std::vector<BatchOCREntry>& entries)
     LogInfo << "prefetch_batch_ocr completed" << VAR(entries) << VAR(ocr_batch_cache_->results);
 }
 
+void Recognizer::prefetch_batch_custom(const std::string& recognition, const std::vector<BatchCustomEntry>& entries)
+{
+    if (!custom_batch_cache_ || entries.empty() || !resource() || image_.empty()) {
+        LogDebug << "prefetch_batch_custom skipped" << VAR(recognition) << VAR(entries.size()) << VAR(image_.empty());
+        return;
+    }
+
+    std::vector<CustomRecognition::BatchEntry> batch_entries;
+    for (const auto& entry : entries) {
+        auto rois = get_rois(entry.param.roi_target, true);
+        if (rois.empty()) {
+            LogWarn << "failed to get rois for batch custom entry" << VAR(entry.name);
+            continue;
+        }
+        batch_entries.emplace_back(
+            CustomRecognition::BatchEntry { .node_name = entry.name, .roi = rois.front(), .param = &entry.param });
+    }
+
+    CustomRecognition::analyze_batch(
+        image_,
+        recognition,
+        batch_entries,
+        resource()->custom_recognition(recognition),
+        context_,
+        *custom_batch_cache_);
+
+    LogInfo << "prefetch_batch_custom completed" << VAR(recognition) << VAR(entries) << VAR(custom_batch_cache_->results.size());
+}
+
 MAA_TASK_NS_END
@@ -5,10 +5,12 @@
 
 #include "Common/Conf.h"
 #include "Common/MaaTypes.h"
+#include "CustomRecognition.h"
 #include "Resource/PipelineTypes.h"
 #include "Task/Context.h"
 #include "Task/PipelineTask.h"
 #include "Tasker/Tasker.h"
+#include "Vision/FrameCache.h"
 #include "Vision/OCRer.h"
 
 MAA_TASK_NS_BEGIN
@@ -17,7 +19,13 @@ class Recognizer
 {
 public:
 public:
-    Recognizer(Tasker* tasker, Context& context, const cv::Mat& image, std::shared_ptr<MAA_VISION_NS::OCRCache> ocr_batch_cache = nullptr);
+    Recognizer(
+        Tasker* tasker,
+        Context& context,
+        const cv::Mat& image,
+        std::shared_ptr<MAA_VISION_NS::OCRCache> ocr_batch_cache = nullptr,
+        std::shared_ptr<CustomRecognitionBatchCache> custom_batch_cache = nullptr,
+        std::shared_ptr<MAA_VISION_NS::FrameCache> frame_cache = nullptr);
     Recognizer(const Recognizer& recognizer);
 
 public:
@@ -26,6 +34,7 @@ public:
     RecoResult recognize(MAA_RES_NS::Recognition::Type type, const MAA_RES_NS::Recognition::Param& param, const std::string& name);
 
     void prefetch_batch_ocr(const std::vector<BatchOCREntry>& entries);
+    void prefetch_batch_custom(const std::string& recognition, const std::vector<BatchCustomEntry>& entries);
 
     MaaRecoId get_id() const { return reco_id_; }
 
@@ -65,6 +74,8 @@ private:
     std::shared_ptr<std::unordered_map<std::string, cv::Rect>> sub_best_box_;
 
     std::shared_ptr<MAA_VISION_NS::OCRCache> ocr_batch_cache_;
+    std::shared_ptr<CustomRecognitionBatchCache> custom_batch_cache_;
+    std::shared_ptr<MAA_VISION_NS::FrameCache> frame_cache_;
 };
 
 MAA_TASK_NS_END
@@ -133,6 +133,30 @@ MaaRecoId Context::run_recognition_direct(const std::string& reco_type, const js
     return run_recognition(entry, pipeline_override, image);
 }
 
+MaaRecoId Context::run_recognition_on_frame(MaaFrameId frame_id, const std::string& reco_type, const json::value& reco_param)
+{
+    LogTrace << VAR(getptr()) << VAR(frame_id) << VAR(reco_type) << VAR(reco_param);
+
+    auto frame = tasker_ ? tasker_->get_frame(frame_id) : nullptr;
+    if (!frame) {
+        LogError << "frame not found" << VAR(frame_id);
+        return MaaInvalidId;
+    }
+
+    std::string entry = std::format("recognition/{}/{}", reco_type, make_uuid());
+
+    json::value pipeline_override;
+    pipeline_override[entry]["recognition"] = { { "type", reco_type }, { "param", reco_param } };
+
+    RecognitionTask subtask(std::move(frame), entry, tasker_, make_clone());
+    bool ov = subtask.override_pipeline(pipeline_override);
+    if (!ov) {
+        LogError << "failed to override_pipeline" << VAR(entry) << VAR(pipeline_override);
+        return MaaInvalidId;
+    }
+    return subtask.run_impl();
+}
+
 MaaActId Context::run_action_direct(
     const std::string& action_type,
     const json::value& action_param,
@@ -141,11 +141,13 @@ NodeDetail PipelineTask::run_next(const std::vector<MAA_RES_NS::NodeAttr>& next,
 
     const auto& cur_node = *cur_opt;
 
-    json::value node_cb_detail {
-        { "task_id", task_id() },
-        { "node_id", node_id },
-        { "name", cur_node_ },
-        { "focus", cur_node.focus },
+    auto node_cb_detail = [&]() {
+        return json::value {
+            { "task_id", task_id() },
+            { "node_id", node_id },
+            { "name", cur_node_ },
+            { "focus", cur_node.focus },
+        };
     };
 
     notify(MaaMsg_Node_PipelineNode_Starting, node_cb_detail);
@@ -223,12 +225,17 @@ NodeDetail PipelineTask::run_next(const std::vector<MAA_RES_NS::NodeAttr>& next,
 
         LogInfo << "PipelineTask node done" << VAR(result) << VAR(task_id_);
         set_node_detail(result.node_id, result);
+        if (tasker_) {
+            tasker_->latency_stats().record_since("node", hit_name, start_clock);
+        }
 
-        node_cb_detail["node_details"] = result;
-        node_cb_detail["reco_details"] = reco;
-        node_cb_detail["action_details"] = act;
-
-        notify(act.success ? MaaMsg_Node_PipelineNode_Succeeded : MaaMsg_Node_PipelineNode_Failed, node_cb_detail);
+        notify(act.success ? MaaMsg_Node_PipelineNode_Succeeded : MaaMsg_Node_PipelineNode_Failed, [&]() {
+            json::value detail = node_cb_detail();
+            detail["node_details"] = result;
+            detail["reco_details"] = reco;
+            detail["action_details"] = act;
+            return detail;
+        });
 
         return result;
     }
@@ -262,11 +269,13 @@ RecoResult PipelineTask::recognize_list(const cv::Mat& image, const std::vector<
 
     const auto& cur_node = *cur_opt;
 
-    const json::value reco_list_cb_detail {
-        { "task_id", task_id() },
-        { "name", cur_node_ },
-        { "list", list },
-        { "focus", cur_node.focus },
+    auto reco_list_cb_detail = [&]() {
+        return json::value {
+            { "task_id", task_id() },
+            { "name", cur_node_ },
+            { "list", list },
+            { "focus", cur_node.focus },
+        };
     };
 
     notify(MaaMsg_Node_NextList_Starting, reco_list_cb_detail);
@@ -276,6 +285,12 @@ RecoResult PipelineTask::recognize_list(const cv::Mat& image, const std::vector<
         batch_plan ? std::make_shared<MAA_VISION_NS::OCRCache>(MAA_VISION_NS::OCRCache { .model = batch_plan->model }) : nullptr;
     bool batch_triggered = false;
 
+    auto custom_plans = prepare_batch_custom(list);
+    auto custom_cache = custom_plans.empty() ? nullptr : std::make_shared<CustomRecognitionBatchCache>();
+
+    // 本轮各节点识别的是同一帧，颜色转换、特征点等派生数据共享
+    auto frame_cache = std::make_shared<MAA_VISION_NS::FrameCache>(image);
+
     for (const auto& node : list) {
         if (context_->need_to_stop()) {
             LogWarn << "need_to_stop";
@@ -296,6 +311,17 @@ RecoResult PipelineTask::recognize_list(const cv::Mat& image, const std::vector<
             recognizer.prefetch_batch_ocr(batch_plan->entries);
         }
 
+        // 轮到某组的第一个节点时才批量识别整组，前面的节点命中就不必调用
+        for (auto it = custom_plans.begin(); it != custom_plans.end(); ++it) {
+            if (std::ranges::none_of(it->entries, [&](const BatchCustomEntry& entry) { return entry.name == pipeline_data.name; })) {
+                continue;
+            }
+            Recognizer recognizer(tasker_, *context_, image, nullptr, custom_cache);
+            recognizer.prefetch_batch_custom(it->recognition, it->entries);
+            custom_plans.erase(it);
+            break;
+        }
+
         if (!pipeline_data.enabled) {
             LogDebug << "node disabled" << pipeline_data.name << VAR(pipeline_data.enabled);
             continue;
@@ -306,7 +332,7 @@ RecoResult PipelineTask::recognize_list(const cv::Mat& image, const std::vector<
         }
 
         auto anchor_name = node.anchor ? std::optional { node.name } : std::nullopt;
-        RecoResult result = run_recognition(image, pipeline_data, std::move(anchor_name), ocr_cache);
+        RecoResult result = run_recognition(image, pipeline_data, std::move(anchor_name), ocr_cache, custom_cache, frame_cache);
 
         if (result.box) {
             LogInfo << "reco hit" << VAR(result.name) << VAR(result.box);
@@ -368,6 +394,50 @@ std::optional<PipelineTask::BatchOCRPlan> PipelineTask::prepare_batch_ocr(const
     return ctx.plan;
 }
 
+std::vector<PipelineTask::BatchCustomPlan> PipelineTask::prepare_batch_custom(const std::vector<MAA_RES_NS::NodeAttr>& list)
+{
+    using namespace MAA_RES_NS::Recognition;
+
+    std::vector<BatchCustomPlan> plans;
+    if (!context_ || !resource()) {
+        return plans;
+    }
+
+    for (const auto& node : list) {
+        auto data_opt = context_->get_pipeline_data(node);
+        if (!data_opt) {
+            continue;
+        }
+        const auto& data = *data_opt;
+
+        if (!data.enabled || data.reco_type != Type::Custom || !context_->check_hit_count(data)) {
+            continue;
+        }
+
+        const auto& param = std::get<MAA_VISION_NS::CustomRecognitionParam>(data.reco_param);
+        if (param.roi_target.type == MAA_VISION_NS::TargetType::PreTask) {
+            // roi 依赖前面节点本轮的识别结果，批量时还拿不到
+            continue;
+        }
+        if (!resource()->custom_recognition(param.name).batch) {
+            continue;
+        }
+
+        auto it = std::ranges::find(plans, param.name, &BatchCustomPlan::recognition);
+        if (it == plans.end()) {
+            it = plans.insert(plans.end(), BatchCustomPlan { .recognition = param.name });
+        }
+        it->entries.emplace_back(BatchCustomEntry { .name = data.name, .param = param });
+    }
+
+    std::erase_if(plans, [](const BatchCustomPlan& plan) { return plan.entries.size() < 2; });
+
+    if (!plans.empty()) {
+        LogInfo << "prepared batch custom plans" << VAR(plans.size());
+    }
+    return plans;
+}
+
 void PipelineTask::try_add_ocr_node(OCRCollectContext& ctx, const std::string& name, const MAA_VISION_NS::OCRerParam& param)
 {
     if (param.roi_target.type == MAA_VISION_NS::TargetType::PreTask) {
@@ -22,6 +22,14 @@ struct BatchOCREntry
     MEO_TOJSON(name);
 };
 
+struct BatchCustomEntry
+{
+    std::string name;
+    MAA_VISION_NS::CustomRecognitionParam param;
+
+    MEO_TOJSON(name);
+};
+
 class PipelineTask : public TaskBase
 {
 public:
@@ -40,6 +48,13 @@ private:
         std::vector<BatchOCREntry> entries;
     };
 
+    // next 列表中使用同一个已注册批量回调的自定义识别器的节点
+    struct BatchCustomPlan
+    {
+        std::string recognition;
+        std::vector<BatchCustomEntry> entries;
+    };
+
     struct OCRCollectContext
     {
         BatchOCRPlan plan;
@@ -50,6 +65,7 @@ private:
     NodeDetail run_next(const std::vector<MAA_RES_NS::NodeAttr>& next, const PipelineData& pretask);
     RecoResult recognize_list(const cv::Mat& image, const std::vector<MAA_RES_NS::NodeAttr>& list);
     std::optional<BatchOCRPlan> prepare_batch_ocr(const std::vector<MAA_RES_NS::NodeAttr>& list);
+    std::vector<BatchCustomPlan> prepare_batch_custom(const std::vector<MAA_RES_NS::NodeAttr>& list);
 
     void try_add_ocr_node(OCRCollectContext& ctx, const std::string& name, const MAA_VISION_NS::OCRerParam& param);
     void collect_ocr_from_reco(
@@ -15,6 +15,17 @@ RecognitionTask::RecognitionTask(const cv::Mat& image, std::string entry, Tasker
 {
 }
 
+RecognitionTask::RecognitionTask(
+    std::shared_ptr<MAA_VISION_NS::FrameCache> frame,
+    std::string entry,
+    Tasker* tasker,
+    std::shared_ptr<Context> context)
+    : TaskBase(std::move(entry), tasker, std::move(context))
+    , image_(frame ? frame->image() : cv::Mat())
+    , frame_(std::move(frame))
+{
+}
+
 bool RecognitionTask::run()
 {
     return run_impl() != MaaInvalidId;
@@ -39,16 +50,18 @@ MaaRecoId RecognitionTask::run_impl()
 
     auto node_id = generate_node_id();
 
-    json::value node_cb_detail {
-        { "task_id", task_id() },
-        { "node_id", node_id },
-        { "name", entry_ },
-        { "focus", cur_node.focus },
+    auto node_cb_detail = [&]() {
+        return json::value {
+            { "task_id", task_id() },
+            { "node_id", node_id },
+            { "name", entry_ },
+            { "focus", cur_node.focus },
+        };
     };
 
     notify(MaaMsg_Node_RecognitionNode_Starting, node_cb_detail);
 
-    auto reco = run_recognition(image_, cur_node);
+    auto reco = run_recognition(image_, cur_node, std::nullopt, nullptr, nullptr, frame_);
 
     bool hit = reco.box.has_value();
     NodeDetail result {
@@ -61,10 +74,13 @@ MaaRecoId RecognitionTask::run_impl()
     LogInfo << "RecognitionTask node done" << VAR(result) << VAR(task_id_);
     set_node_detail(result.node_id, result);
 
-    node_cb_detail["node_details"] = result;
-    node_cb_detail["reco_details"] = reco;
-    node_cb_detail["action_details"] = nullptr;
-    notify(hit ? MaaMsg_Node_RecognitionNode_Succeeded : MaaMsg_Node_RecognitionNode_Failed, node_cb_detail);
+    notify(hit ? MaaMsg_Node_RecognitionNode_Succeeded : MaaMsg_Node_RecognitionNode_Failed, [&]() {
+        json::value detail = node_cb_detail();
+        detail["node_details"] = result;
+        detail["reco_details"] = reco;
+        detail["action_details"] = nullptr;
+        return detail;
+    });
 
     return reco.reco_id;
 }
@@ -10,6 +10,12 @@ class RecognitionTask : public TaskBase
 {
 public:
     RecognitionTask(const cv::Mat& image, std::string entry, Tasker* tasker, std::shared_ptr<Context> context = nullptr);
+    // 在已注册的帧上识别，复用帧上缓存的派生数据
+    RecognitionTask(
+        std::shared_ptr<MAA_VISION_NS::FrameCache> frame,
+        std::string entry,
+        Tasker* tasker,
+        std::shared_ptr<Context> context = nullptr);
 
     virtual ~RecognitionTask() override = default;
 
@@ -21,6 +27,7 @@ public:
 
 private:
     cv::Mat image_;
+    std::shared_ptr<MAA_VISION_NS::FrameCache> frame_;
 };
 
 MAA_TASK_NS_END
@@ -56,7 +56,9 @@ RecoResult TaskBase::run_recognition(
     const cv::Mat& image,
     const PipelineData& data,
     std::optional<std::string> anchor_name,
-    std::shared_ptr<MAA_VISION_NS::OCRCache> ocr_cache)
+    std::shared_ptr<MAA_VISION_NS::OCRCache> ocr_cache,
+    std::shared_ptr<CustomRecognitionBatchCache> custom_cache,
+    std::shared_ptr<MAA_VISION_NS::FrameCache> frame_cache)
 {
     LogFunc << VAR(cur_node_) << VAR(data.name);
 
@@ -65,17 +67,20 @@ RecoResult TaskBase::run_recognition(
         return { };
     }
 
-    Recognizer recognizer(tasker_, *context_, image, std::move(ocr_cache));
-
-    json::value cb_detail {
-        { "task_id", task_id() },
-        { "reco_id", recognizer.get_id() },
-        { "name", data.name },
-        { "focus", data.focus },
+    Recognizer recognizer(tasker_, *context_, image, std::move(ocr_cache), std::move(custom_cache), std::move(frame_cache));
+
+    auto cb_detail = [&]() {
+        json::value detail {
+            { "task_id", task_id() },
+            { "reco_id", recognizer.get_id() },
+            { "name", data.name },
+            { "focus", data.focus },
+        };
+        if (anchor_name) {
+            detail["anchor"] = *anchor_name;
+        }
+        return detail;
     };
-    if (anchor_name) {
-        cb_detail["anchor"] = *anchor_name;
-    }
 
     notify(MaaMsg_Node_Recognition_Starting, cb_detail);
 
@@ -86,8 +91,11 @@ RecoResult TaskBase::run_recognition(
         result.box = result.box ? std::nullopt : std::make_optional<cv::Rect>();
     }
 
-    cb_detail["reco_details"] = result;
-    notify(result.box ? MaaMsg_Node_Recognition_Succeeded : MaaMsg_Node_Recognition_Failed, cb_detail);
+    notify(result.box ? MaaMsg_Node_Recognition_Succeeded : MaaMsg_Node_Recognition_Failed, [&]() {
+        json::value detail = cb_detail();
+        detail["reco_details"] = result;
+        return detail;
+    });
 
     return result;
 }
@@ -113,11 +121,13 @@ ActionResult TaskBase::run_action(const RecoResult& reco, const PipelineData& da
     sleep(data.pre_delay);
 
     Actuator actuator(tasker_, *context_);
-    json::value cb_detail {
-        { "task_id", task_id() },
-        { "action_id", actuator.get_id() },
-        { "name", reco.name },
-        { "focus", data.focus },
+    auto cb_detail = [&]() {
+        return json::value {
+            { "task_id", task_id() },
+            { "action_id", actuator.get_id() },
+            { "name", reco.name },
+            { "focus", data.focus },
+        };
     };
     notify(MaaMsg_Node_Action_Starting, cb_detail);
 
@@ -133,7 +143,11 @@ ActionResult TaskBase::run_action(const RecoResult& reco, const PipelineData& da
             return { };
         }
 
+        const auto action_clock = std::chrono::steady_clock::now();
         result = actuator.run(*reco.box, reco.reco_id, data, entry_);
+        if (tasker_) {
+            tasker_->latency_stats().record_since("action", result.action, action_clock);
+        }
         LogInfo << "action" << VAR(i) << VAR(data.repeat) << VAR(result);
 
         if (context_->need_to_stop()) {
@@ -141,8 +155,11 @@ ActionResult TaskBase::run_action(const RecoResult& reco, const PipelineData& da
         }
     }
 
-    cb_detail["action_details"] = result;
-    notify(result.success ? MaaMsg_Node_Action_Succeeded : MaaMsg_Node_Action_Failed, cb_detail);
+    notify(result.success ? MaaMsg_Node_Action_Succeeded : MaaMsg_Node_Action_Failed, [&]() {
+        json::value detail = cb_detail();
+        detail["action_details"] = result;
+        return detail;
+    });
 
     if (!context_->need_to_stop()) {
         wait_freezes(data.post_wait_freezes, *reco.box, data.name, "post", data.focus);
@@ -231,4 +248,9 @@ void TaskBase::notify(std::string_view msg, const json::value detail)
     tasker_->context_notify(context_.get(), msg, detail);
 }
 
+bool TaskBase::subscribed(std::string_view msg) const
+{
+    return tasker_ && context_ && tasker_->context_subscribed(msg);
+}
+
 MAA_TASK_NS_END
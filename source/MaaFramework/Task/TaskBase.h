@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <concepts>
 #include <string_view>
 
 #include <meojson/json.hpp>
@@ -11,8 +12,10 @@
 #include "Controller/ControllerAgent.h"
 #include "Resource/PipelineTypes.h"
 #include "Resource/ResourceMgr.h"
+#include "Task/Component/CustomRecognition.h"
 #include "Tasker/RuntimeCache.h"
 #include "Tasker/Tasker.h"
+#include "Vision/FrameCache.h"
 #include "Vision/OCRer.h"
 
 MAA_TASK_NS_BEGIN
@@ -44,7 +47,9 @@ protected:
         const cv::Mat& image,
         const PipelineData& data,
         std::optional<std::string> anchor_name = std::nullopt,
-        std::shared_ptr<MAA_VISION_NS::OCRCache> ocr_cache = nullptr);
+        std::shared_ptr<MAA_VISION_NS::OCRCache> ocr_cache = nullptr,
+        std::shared_ptr<CustomRecognitionBatchCache> custom_cache = nullptr,
+        std::shared_ptr<MAA_VISION_NS::FrameCache> frame_cache = nullptr);
     ActionResult run_action(const RecoResult& reco, const PipelineData& data);
     cv::Mat screencap();
     void set_node_detail(MaaNodeId node_id, NodeDetail detail);
@@ -61,6 +66,18 @@ protected:
     bool debug_mode() const;
     void notify(std::string_view msg, const json::value detail);
 
+    // 没有 sink 订阅该消息时不构造 details
+    template <std::invocable DetailBuilder>
+    void notify(std::string_view msg, DetailBuilder&& make_detail)
+    {
+        if (!subscribed(msg)) {
+            return;
+        }
+        notify(msg, json::value(std::forward<DetailBuilder>(make_detail)()));
+    }
+
+    bool subscribed(std::string_view msg) const;
+
 protected:
     const MaaTaskId task_id_ = ++s_global_task_id;
     Tasker* tasker_ = nullptr;
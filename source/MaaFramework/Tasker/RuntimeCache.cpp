@@ -79,7 +79,7 @@ void RuntimeCache::set_reco_detail(MaaRecoId uid, MAA_TASK_NS::RecoResult detail
         reco_image_order_.push_back(uid);
     }
 
-    detail.raw.clear();
+    detail.raw = { };
     detail.draws.clear();
 
     reco_details_.insert_or_assign(uid, std::move(detail));
@@ -40,8 +40,8 @@ public:
 private:
     struct RecoImageCache
     {
-        MAA_TASK_NS::ImageEncodedBuffer raw;
-        std::vector<MAA_TASK_NS::ImageEncodedBuffer> draws;
+        MAA_TASK_NS::EncodedImage raw;
+        std::vector<MAA_TASK_NS::EncodedImage> draws;
     };
 
     void evict_reco_image_cache_if_needed(size_t limit);
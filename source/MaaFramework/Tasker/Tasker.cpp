@@ -3,6 +3,7 @@
 #include <ranges>
 
 #include "Controller/ControllerAgent.h"
+#include "Global/OptionMgr.h"
 #include "Global/PluginMgr.h"
 #include "MaaFramework/MaaMsg.h"
 #include "MaaUtils/Logger.h"
@@ -12,6 +13,7 @@
 #include "Task/EmptyTask.h"
 #include "Task/PipelineTask.h"
 #include "Task/RecognitionTask.h"
+#include "Vision/FrameCache.h"
 
 MAA_NS_BEGIN
 
@@ -111,6 +113,66 @@ MaaTaskId Tasker::post_recognition(const std::string& reco_type, const json::val
     return post_task(std::move(task_ptr), pipeline_override);
 }
 
+MaaFrameId Tasker::register_frame(const cv::Mat& image)
+{
+    LogInfo << VAR(image);
+
+    if (image.empty()) {
+        LogError << "image is empty";
+        return MaaInvalidId;
+    }
+
+    // 调用方之后可能复用自己的图像缓冲，这里拷贝一次，之后的识别都不再拷贝
+    auto frame = std::make_shared<MAA_VISION_NS::FrameCache>(image.clone());
+    MaaFrameId frame_id = ++s_global_frame_id;
+
+    std::unique_lock lock(frames_mutex_);
+    frames_.emplace(frame_id, std::move(frame));
+    return frame_id;
+}
+
+bool Tasker::unregister_frame(MaaFrameId frame_id)
+{
+    LogInfo << VAR(frame_id);
+
+    std::unique_lock lock(frames_mutex_);
+    if (frames_.erase(frame_id) == 0) {
+        LogError << "frame not found" << VAR(frame_id);
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<MAA_VISION_NS::FrameCache> Tasker::get_frame(MaaFrameId frame_id) const
+{
+    std::shared_lock lock(frames_mutex_);
+    auto it = frames_.find(frame_id);
+    return it == frames_.end() ? nullptr : it->second;
+}
+
+MaaTaskId Tasker::post_recognition_on_frame(MaaFrameId frame_id, const std::string& reco_type, const json::value& reco_param)
+{
+    LogInfo << VAR(frame_id) << VAR(reco_type) << VAR(reco_param);
+
+    if (!check_stop()) {
+        return MaaInvalidId;
+    }
+
+    auto frame = get_frame(frame_id);
+    if (!frame) {
+        LogError << "frame not found" << VAR(frame_id);
+        return MaaInvalidId;
+    }
+
+    std::string entry = std::format("recognition/{}/{}", reco_type, make_uuid());
+
+    json::value pipeline_override;
+    pipeline_override[entry]["recognition"] = { { "type", reco_type }, { "param", reco_param } };
+
+    auto task_ptr = std::make_shared<MAA_TASK_NS::RecognitionTask>(std::move(frame), entry, this);
+    return post_task(std::move(task_ptr), pipeline_override);
+}
+
 MaaTaskId Tasker::post_action(
     const std::string& action_type,
     const json::value& action_param,
@@ -241,6 +303,30 @@ std::optional<MaaNodeId> Tasker::get_latest_node(const std::string& node_name) c
     return runtime_cache().get_latest_node(node_name);
 }
 
+json::object Tasker::get_latency_stats() const
+{
+    json::object stats = latency_stats_.to_json();
+
+    if (controller_) {
+        for (auto& [category, histograms] : controller_->latency_stats().to_json()) {
+            stats[category] = std::move(histograms);
+        }
+    }
+
+    return stats;
+}
+
+void Tasker::clear_latency_stats()
+{
+    LogTrace;
+
+    latency_stats_.clear();
+
+    if (controller_) {
+        controller_->latency_stats().clear();
+    }
+}
+
 RuntimeCache& Tasker::runtime_cache()
 {
     return runtime_cache_;
@@ -251,6 +337,11 @@ const RuntimeCache& Tasker::runtime_cache() const
     return runtime_cache_;
 }
 
+LatencyStats& Tasker::latency_stats()
+{
+    return latency_stats_;
+}
+
 MaaSinkId Tasker::add_sink(MaaEventCallback callback, void* trans_arg)
 {
     return notifier_.add_sink(callback, trans_arg);
@@ -281,11 +372,27 @@ void Tasker::clear_context_sinks()
     context_notifier_.clear_sinks();
 }
 
+bool Tasker::set_sink_subscription(MaaSinkId sink_id, std::vector<std::string> msg_filter)
+{
+    return notifier_.set_subscription(sink_id, std::move(msg_filter));
+}
+
+bool Tasker::set_context_sink_subscription(MaaSinkId sink_id, std::vector<std::string> msg_filter)
+{
+    return context_notifier_.set_subscription(sink_id, std::move(msg_filter));
+}
+
 void Tasker::context_notify(MaaContext* context, std::string_view msg, const json::value& details)
 {
     context_notifier_.notify(context, msg, details);
 }
 
+bool Tasker::context_subscribed(std::string_view msg) const
+{
+    // debug 模式下保留完整的事件日志
+    return context_notifier_.subscribed(msg) || MAA_GLOBAL_NS::OptionMgr::get_instance().debug_mode();
+}
+
 MaaTaskId Tasker::post_task(TaskPtr task_ptr, const json::value& pipeline_override)
 {
 #ifndef MAA_DEBUG
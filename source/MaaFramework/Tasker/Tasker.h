@@ -1,11 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <shared_mutex>
 #include <vector>
 
 #include "Base/AsyncRunner.hpp"
+#include "Base/LatencyStats.hpp"
 #include "Common/MaaTypes.h"
 #include "Controller/ControllerAgent.h"
 #include "Resource/ResourceMgr.h"
@@ -16,6 +18,10 @@ MAA_TASK_NS_BEGIN
 class TaskBase;
 MAA_TASK_NS_END
 
+MAA_VISION_NS_BEGIN
+class FrameCache;
+MAA_VISION_NS_END
+
 MAA_NS_BEGIN
 
 class Tasker : public MaaTasker
@@ -36,6 +42,11 @@ public:
         post_action(const std::string& action_type, const json::value& action_param, const cv::Rect& box, const std::string& reco_detail)
             override;
 
+    virtual MaaFrameId register_frame(const cv::Mat& image) override;
+    virtual bool unregister_frame(MaaFrameId frame_id) override;
+    virtual MaaTaskId
+        post_recognition_on_frame(MaaFrameId frame_id, const std::string& reco_type, const json::value& reco_param) override;
+
     virtual bool override_pipeline(MaaTaskId task_id, const json::value& pipeline_override) override;
 
     virtual MaaStatus status(MaaTaskId task_id) const override;
@@ -56,6 +67,9 @@ public:
     virtual std::optional<MAA_TASK_NS::WaitFreezesDetail> get_wf_detail(MaaWfId wf_id) const override;
     virtual std::optional<MaaNodeId> get_latest_node(const std::string& node_name) const override;
 
+    virtual json::object get_latency_stats() const override;
+    virtual void clear_latency_stats() override;
+
     virtual MaaSinkId add_sink(MaaEventCallback callback, void* trans_arg) override;
     virtual void remove_sink(MaaSinkId sink_id) override;
     virtual void clear_sinks() override;
@@ -64,11 +78,17 @@ public:
     virtual void remove_context_sink(MaaSinkId sink_id) override;
     virtual void clear_context_sinks() override;
 
+    virtual bool set_sink_subscription(MaaSinkId sink_id, std::vector<std::string> msg_filter) override;
+    virtual bool set_context_sink_subscription(MaaSinkId sink_id, std::vector<std::string> msg_filter) override;
+
 public:
     RuntimeCache& runtime_cache();
     const RuntimeCache& runtime_cache() const;
+    LatencyStats& latency_stats();
+    std::shared_ptr<MAA_VISION_NS::FrameCache> get_frame(MaaFrameId frame_id) const;
 
     void context_notify(MaaContext* context, std::string_view msg, const json::value& details);
+    bool context_subscribed(std::string_view msg) const;
 
 private:
     using TaskPtr = std::shared_ptr<MAA_TASK_NS::TaskBase>;
@@ -94,6 +114,12 @@ private:
     mutable std::shared_mutex task_id_mapping_mutex_;
 
     RuntimeCache runtime_cache_;
+    LatencyStats latency_stats_;
+
+    // 已注册的帧；进行中的任务也持有帧，注销后等任务结束才释放
+    std::map<MaaFrameId, std::shared_ptr<MAA_VISION_NS::FrameCache>> frames_;
+    mutable std::shared_mutex frames_mutex_;
+    inline static std::atomic<MaaFrameId> s_global_frame_id = kFrameIdBase;
 };
 
 MAA_NS_END
@@ -0,0 +1,36 @@
+#include "BlockComparator.h"
+
+#include "MaaUtils/Logger.h"
+#include "MaaUtils/NoWarningCV.hpp"
+
+MAA_VISION_NS_BEGIN
+
+std::optional<BlockComparatorResult>
+    find_changed_block(const cv::Mat& lhs, const cv::Mat& rhs, const cv::Rect& roi, int block_size, double tolerance)
+{
+    if (lhs.size() != rhs.size() || lhs.type() != rhs.type()) {
+        LogError << "lhs and rhs mismatch" << VAR(lhs) << VAR(rhs);
+        return BlockComparatorResult { .box = roi, .diff = 255.0 };
+    }
+    if (block_size <= 0) {
+        LogError << "invalid block_size" << VAR(block_size);
+        return BlockComparatorResult { .box = roi, .diff = 255.0 };
+    }
+
+    for (int y = roi.y; y < roi.y + roi.height; y += block_size) {
+        for (int x = roi.x; x < roi.x + roi.width; x += block_size) {
+            cv::Rect block(x, y, block_size, block_size);
+            block &= roi;
+
+            const double area = static_cast<double>(block.area()) * lhs.channels();
+            const double diff = cv::norm(lhs(block), rhs(block), cv::NORM_L1) / area;
+            if (diff > tolerance) {
+                return BlockComparatorResult { .box = block, .diff = diff };
+            }
+        }
+    }
+
+    return std::nullopt;
+}
+
+MAA_VISION_NS_END
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <optional>
+
+#include "MaaUtils/JsonExt.hpp"
+#include "MaaUtils/NoWarningCVMat.hpp"
+
+#include "Common/Conf.h"
+
+MAA_VISION_NS_BEGIN
+
+struct BlockComparatorResult
+{
+    cv::Rect box { };
+    double diff = 0.0;
+
+    MEO_JSONIZATION(box, diff);
+};
+
+// 把 roi 切成 block_size 见方的块逐块比较两帧，块内平均逐像素绝对差超过 tolerance 即视为变化。
+// 遇到第一个变化的块就返回该块，全部未变化返回 nullopt；不分配中间图像，适合高频轮询
+std::optional<BlockComparatorResult>
+    find_changed_block(const cv::Mat& lhs, const cv::Mat& rhs, const cv::Rect& roi, int block_size, double tolerance);
+
+MAA_VISION_NS_END
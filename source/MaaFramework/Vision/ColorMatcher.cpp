@@ -8,8 +8,13 @@
 
 MAA_VISION_NS_BEGIN
 
-ColorMatcher::ColorMatcher(cv::Mat image, std::vector<cv::Rect> rois, ColorMatcherParam param, std::string name)
-    : VisionBase(std::move(image), std::move(rois), std::move(name))
+ColorMatcher::ColorMatcher(
+    cv::Mat image,
+    std::vector<cv::Rect> rois,
+    ColorMatcherParam param,
+    std::string name,
+    std::shared_ptr<FrameCache> frame)
+    : VisionBase(std::move(image), std::move(rois), std::move(name), std::move(frame))
     , param_(std::move(param))
 {
     analyze();
@@ -36,9 +41,7 @@ void ColorMatcher::analyze()
 
 ColorMatcher::ResultsVec ColorMatcher::color_match(const ColorMatcherParam::Range& range) const
 {
-    cv::Mat image = image_with_roi();
-    cv::Mat color;
-    cv::cvtColor(image, color, param_.method);
+    cv::Mat color = image_with_roi(param_.method);
     cv::Mat bin;
     cv::inRange(color, range.first, range.second, bin);
 
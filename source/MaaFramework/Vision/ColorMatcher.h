@@ -21,7 +21,12 @@ class ColorMatcher
     , public RecoResultAPI<ColorMatcherResult>
 {
 public:
-    ColorMatcher(cv::Mat image, std::vector<cv::Rect> rois, ColorMatcherParam param, std::string name = "");
+    ColorMatcher(
+        cv::Mat image,
+        std::vector<cv::Rect> rois,
+        ColorMatcherParam param,
+        std::string name = "",
+        std::shared_ptr<FrameCache> frame = nullptr);
 
 private:
     void analyze();
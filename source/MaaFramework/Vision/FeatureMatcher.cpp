@@ -10,6 +10,7 @@ MAA_SUPPRESS_CV_WARNINGS_BEGIN
 #endif
 MAA_SUPPRESS_CV_WARNINGS_END
 
+#include "FrameCache.h"
 #include "MaaUtils/Logger.h"
 #include "VisionUtils.hpp"
 
@@ -20,8 +21,9 @@ FeatureMatcher::FeatureMatcher(
     std::vector<cv::Rect> rois,
     FeatureMatcherParam param,
     std::vector<cv::Mat> templates,
-    std::string name)
-    : VisionBase(std::move(image), std::move(rois), std::move(name))
+    std::string name,
+    std::shared_ptr<FrameCache> frame)
+    : VisionBase(std::move(image), std::move(rois), std::move(name), std::move(frame))
     , param_(std::move(param))
     , templates_(std::move(templates))
 {
@@ -57,7 +59,7 @@ void FeatureMatcher::analyze()
 FeatureMatcher::ResultsVec
     FeatureMatcher::feature_match(const cv::Mat& templ, const std::vector<cv::KeyPoint>& keypoints_1, const cv::Mat& descriptors_1) const
 {
-    auto [keypoints_2, descriptors_2] = detect(image_, create_mask(image_, roi_));
+    auto [keypoints_2, descriptors_2] = detect_roi();
 
     auto match_points = match(descriptors_1, descriptors_2);
 
@@ -113,6 +115,18 @@ std::pair<std::vector<cv::KeyPoint>, cv::Mat> FeatureMatcher::detect(const cv::M
     return std::make_pair(std::move(keypoints), std::move(descriptors));
 }
 
+std::pair<std::vector<cv::KeyPoint>, cv::Mat> FeatureMatcher::detect_roi() const
+{
+    auto detect_image = [&]() {
+        return detect(image_, create_mask(image_, roi_));
+    };
+
+    if (!frame_) {
+        return detect_image();
+    }
+    return frame_->features(static_cast<int>(param_.detector), roi_, detect_image);
+}
+
 cv::Ptr<cv::DescriptorMatcher> FeatureMatcher::create_matcher() const
 {
     switch (param_.detector) {
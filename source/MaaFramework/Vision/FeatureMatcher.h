@@ -33,7 +33,8 @@ public:
         std::vector<cv::Rect> rois,
         FeatureMatcherParam param,
         std::vector<cv::Mat> templates,
-        std::string name = "");
+        std::string name = "",
+        std::shared_ptr<FrameCache> frame = nullptr);
 
 private:
     void analyze();
@@ -45,6 +46,8 @@ private:
 private:
     cv::Ptr<cv::Feature2D> create_detector() const;
     std::pair<std::vector<cv::KeyPoint>, cv::Mat> detect(const cv::Mat& image, const cv::Mat& mask) const;
+    // 当前 roi 内的特征，有帧缓存时同一检测器和 roi 只检测一次
+    std::pair<std::vector<cv::KeyPoint>, cv::Mat> detect_roi() const;
 
     cv::Ptr<cv::DescriptorMatcher> create_matcher() const;
     std::vector<std::vector<cv::DMatch>> match(const cv::Mat& descriptors_1, const cv::Mat& descriptors_2) const;
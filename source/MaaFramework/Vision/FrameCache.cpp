@@ -0,0 +1,88 @@
+#include "FrameCache.h"
+
+#include <format>
+
+#include "MaaUtils/Logger.h"
+#include "MaaUtils/NoWarningCV.hpp"
+
+MAA_VISION_NS_BEGIN
+
+FrameCache::FrameCache(cv::Mat image)
+    : image_(std::move(image))
+{
+}
+
+cv::Mat FrameCache::color(int method, const cv::Rect& roi)
+{
+    std::unique_lock lock(mutex_);
+
+    if (auto it = colors_.find(method); it != colors_.end()) {
+        return it->second(roi);
+    }
+    // 只有一个小 roi 用到时不值得转换整帧
+    const bool whole = roi.size() == image_.size() || !color_requested_.emplace(method).second;
+
+    lock.unlock();
+
+    cv::Mat converted;
+    if (!whole) {
+        cv::cvtColor(image_(roi), converted, method);
+        return converted;
+    }
+    cv::cvtColor(image_, converted, method);
+
+    lock.lock();
+    return colors_.try_emplace(method, std::move(converted)).first->second(roi);
+}
+
+FrameCache::Features FrameCache::features(int detector, const cv::Rect& roi, const std::function<Features()>& detect)
+{
+    auto key = features_key(detector, roi);
+    {
+        std::unique_lock lock(mutex_);
+        auto it = features_.find(key);
+        if (it != features_.end()) {
+            return it->second;
+        }
+    }
+
+    // 检测耗时，不占着锁，免得阻塞同一帧上的其他识别
+    Features detected = detect();
+
+    std::unique_lock lock(mutex_);
+    return features_.try_emplace(std::move(key), std::move(detected)).first->second;
+}
+
+std::optional<OCRer::ResultsVec> FrameCache::get_ocr(const std::string& model, const std::vector<cv::Rect>& rois) const
+{
+    std::unique_lock lock(mutex_);
+
+    auto it = ocr_results_.find(ocr_key(model, rois));
+    if (it == ocr_results_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void FrameCache::set_ocr(const std::string& model, const std::vector<cv::Rect>& rois, OCRer::ResultsVec results)
+{
+    std::unique_lock lock(mutex_);
+
+    ocr_results_.insert_or_assign(ocr_key(model, rois), std::move(results));
+}
+
+std::string FrameCache::ocr_key(const std::string& model, const std::vector<cv::Rect>& rois)
+{
+    std::string key = model;
+    for (const cv::Rect& r : rois) {
+        key += std::format("|{},{},{},{}", r.x, r.y, r.width, r.height);
+    }
+    return key;
+}
+
+std::string FrameCache::features_key(int detector, const cv::Rect& roi)
+{
+    return std::format("{}|{},{},{},{}", detector, roi.x, roi.y, roi.width, roi.height);
+}
+
+MAA_VISION_NS_END
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Common/Conf.h"
+#include "MaaUtils/NoWarningCVMat.hpp"
+#include "MaaUtils/NonCopyable.hpp"
+#include "OCRer.h"
+
+MAA_VISION_NS_BEGIN
+
+// 一帧图像及其派生数据。同一帧上的多次识别共享这些数据，随帧一起释放
+class FrameCache : public NonCopyable
+{
+public:
+    explicit FrameCache(cv::Mat image);
+
+    const cv::Mat& image() const { return image_; }
+
+    // roi 转换到 method（cv::ColorConversionCodes）颜色空间。同一 method 第一次只转换 roi，
+    // 再次请求时才整帧转换并缓存，之后直接截取
+    cv::Mat color(int method, const cv::Rect& roi);
+
+    using Features = std::pair<std::vector<cv::KeyPoint>, cv::Mat>;
+    // roi 内的特征点和描述子，同一检测器和 roi 只检测一次（并发首次请求时可能各自检测，取先存入的）
+    Features features(int detector, const cv::Rect& roi, const std::function<Features()>& detect);
+
+    // OCR 的全部原始结果（未经 threshold / replace / expected 过滤），按模型和 roi 区分
+    std::optional<OCRer::ResultsVec> get_ocr(const std::string& model, const std::vector<cv::Rect>& rois) const;
+    void set_ocr(const std::string& model, const std::vector<cv::Rect>& rois, OCRer::ResultsVec results);
+
+private:
+    static std::string ocr_key(const std::string& model, const std::vector<cv::Rect>& rois);
+    static std::string features_key(int detector, const cv::Rect& roi);
+
+private:
+    const cv::Mat image_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<int, cv::Mat> colors_;
+    // 已请求过、但还没有整帧转换的 method
+    std::unordered_set<int> color_requested_;
+    std::unordered_map<std::string, Features> features_;
+    std::unordered_map<std::string, OCRer::ResultsVec> ocr_results_;
+};
+
+MAA_VISION_NS_END
@@ -0,0 +1,135 @@
+#include "ImageEncoder.h"
+
+#include <algorithm>
+#include <future>
+
+#include "MaaUtils/NoWarningCV.hpp"
+
+#include "MaaUtils/Logger.h"
+
+MAA_VISION_NS_BEGIN
+
+ImageEncoder::ImageEncoder()
+{
+    const size_t worker_count = std::clamp<size_t>(std::thread::hardware_concurrency() / 4, 1, 4);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back(&ImageEncoder::working, this);
+    }
+}
+
+ImageEncoder::~ImageEncoder()
+{
+    {
+        std::unique_lock lock(queue_mutex_);
+        exit_ = true;
+    }
+    queue_cond_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+ImageEncoder::EncodedImage ImageEncoder::encode_frame(const cv::Mat& image)
+{
+    if (image.empty()) {
+        return { };
+    }
+
+    auto find = [&]() {
+        return std::ranges::find_if(frame_cache_, [&](const FrameEntry& entry) {
+            return entry.image.data == image.data && entry.image.size == image.size && entry.image.type() == image.type();
+        });
+    };
+
+    {
+        std::unique_lock lock(frame_mutex_);
+        if (auto it = find(); it != frame_cache_.end()) {
+            return it->encoded;
+        }
+    }
+
+    // 队列满时 encode_png 会在本线程同步编码，不能占着锁，否则其他识别都要等它
+    auto encoded = encode_png(image);
+
+    std::unique_lock lock(frame_mutex_);
+    // 期间其他线程可能已编码同一帧，用先存入的，保证结果共享
+    if (auto it = find(); it != frame_cache_.end()) {
+        return it->encoded;
+    }
+    if (frame_cache_.size() >= kFrameCacheSize) {
+        frame_cache_.pop_front();
+    }
+    frame_cache_.emplace_back(FrameEntry { .image = image, .encoded = encoded });
+
+    return encoded;
+}
+
+ImageEncoder::EncodedImage ImageEncoder::encode_png(cv::Mat image)
+{
+    return submit([image = std::move(image)]() {
+        MAA_TASK_NS::ImageEncodedBuffer png;
+        if (!cv::imencode(".png", image, png)) {
+            LogError << "Failed to encode png";
+        }
+        return png;
+    });
+}
+
+ImageEncoder::EncodedImage ImageEncoder::encode_jpg(cv::Mat image, int quality)
+{
+    return submit([image = std::move(image), quality]() {
+        MAA_TASK_NS::ImageEncodedBuffer jpg;
+        if (!cv::imencode(".jpg", image, jpg, { cv::IMWRITE_JPEG_QUALITY, quality })) {
+            LogError << "Failed to encode jpg";
+        }
+        return jpg;
+    });
+}
+
+void ImageEncoder::post(std::function<void()> job)
+{
+    {
+        std::unique_lock lock(queue_mutex_);
+        if (!exit_ && queue_.size() < kMaxQueueSize) {
+            queue_.emplace_back(std::move(job));
+            queue_cond_.notify_one();
+            return;
+        }
+    }
+
+    job();
+}
+
+ImageEncoder::EncodedImage ImageEncoder::submit(std::function<MAA_TASK_NS::ImageEncodedBuffer()> encode)
+{
+    auto task = std::make_shared<std::packaged_task<MAA_TASK_NS::ImageEncodedBuffer()>>(std::move(encode));
+    EncodedImage encoded(task->get_future().share());
+
+    post([task]() { (*task)(); });
+
+    return encoded;
+}
+
+void ImageEncoder::working()
+{
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock lock(queue_mutex_);
+            queue_cond_.wait(lock, [&]() { return exit_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                // exit_ 且队列已清空
+                return;
+            }
+            job = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        job();
+    }
+}
+
+MAA_VISION_NS_END
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/Conf.h"
+#include "Common/TaskResultTypes.h"
+#include "MaaUtils/NoWarningCVMat.hpp"
+#include "MaaUtils/SingletonHolder.hpp"
+
+MAA_VISION_NS_BEGIN
+
+// 调试图像的后台编码池，避免在识别线程上同步编码
+// 队列有上限，满了就在调用线程上直接编码，防止内存无限增长
+class ImageEncoder : public SingletonHolder<ImageEncoder>
+{
+public:
+    using EncodedImage = MAA_TASK_NS::EncodedImage;
+
+    friend class SingletonHolder<ImageEncoder>;
+
+public:
+    virtual ~ImageEncoder() override;
+
+    // 同一帧（同一块图像内存）只编码一次，结果共享
+    EncodedImage encode_frame(const cv::Mat& image);
+
+    EncodedImage encode_png(cv::Mat image);
+    EncodedImage encode_jpg(cv::Mat image, int quality);
+
+    // 在编码线程上执行，用于依赖编码结果的后续工作（如落盘）
+    void post(std::function<void()> job);
+
+private:
+    ImageEncoder();
+
+    EncodedImage submit(std::function<MAA_TASK_NS::ImageEncodedBuffer()> encode);
+    void working();
+
+private:
+    static constexpr size_t kMaxQueueSize = 64;
+    static constexpr size_t kFrameCacheSize = 4;
+
+    struct FrameEntry
+    {
+        cv::Mat image; // 持有引用，保证 data 指针在缓存期间不会被复用
+        EncodedImage encoded;
+    };
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> queue_;
+    std::mutex queue_mutex_;
+    std::condition_variable queue_cond_;
+    bool exit_ = false;
+
+    std::deque<FrameEntry> frame_cache_;
+    std::mutex frame_mutex_;
+};
+
+MAA_VISION_NS_END
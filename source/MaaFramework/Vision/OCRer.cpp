@@ -43,8 +43,9 @@ OCRer::OCRer(
     std::shared_ptr<fastdeploy::vision::ocr::Recognizer> recer,
     std::shared_ptr<fastdeploy::pipeline::PPOCRv4> ocrer,
     std::string name,
-    std::optional<ColorFilterConfig> color_filter)
-    : VisionBase(std::move(image), std::move(rois), std::move(name))
+    std::optional<ColorFilterConfig> color_filter,
+    std::shared_ptr<FrameCache> frame)
+    : VisionBase(std::move(image), std::move(rois), std::move(name), std::move(frame))
     , param_(std::move(param))
     , color_filter_(std::move(color_filter))
     , deter_(std::move(deter))
@@ -91,14 +92,11 @@ void OCRer::analyze()
              << VAR(param_.only_rec) << VAR(param_.expected);
 }
 
-cv::Mat OCRer::apply_color_filter(const cv::Mat& image_roi) const
+cv::Mat OCRer::apply_color_filter(const cv::Mat& color) const
 {
     const auto& cfg = *color_filter_;
 
-    cv::Mat color;
-    cv::cvtColor(image_roi, color, cfg.method);
-
-    cv::Mat bin = cv::Mat::zeros(image_roi.size(), CV_8UC1);
+    cv::Mat bin = cv::Mat::zeros(color.size(), CV_8UC1);
     for (const auto& [lower, upper] : cfg.range) {
         cv::Mat single;
         cv::inRange(color, lower, upper, single);
@@ -114,10 +112,7 @@ OCRer::ResultsVec OCRer::predict() const
 {
     ResultsVec results;
 
-    auto image_roi = image_with_roi();
-    if (color_filter_) {
-        image_roi = apply_color_filter(image_roi);
-    }
+    auto image_roi = color_filter_ ? apply_color_filter(image_with_roi(color_filter_->method)) : image_with_roi();
     results = param_.only_rec ? ResultsVec { predict_only_rec(image_roi) } : predict_det_and_rec(image_roi);
 
     std::ranges::for_each(results, [&](auto& res) {
@@ -310,7 +305,9 @@ cv::Mat OCRer::draw_result(const ResultsVec& results) const
     }
 
     if (color_filter_) {
-        auto bin = apply_color_filter(image_);
+        cv::Mat color;
+        cv::cvtColor(image_, color, color_filter_->method);
+        auto bin = apply_color_filter(color);
 
         int raw_width = image_draw.cols;
         cv::copyMakeBorder(image_draw, image_draw, 0, 0, 0, bin.cols, cv::BORDER_CONSTANT, cv::Scalar(0, 0, 0));
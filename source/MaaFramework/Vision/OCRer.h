@@ -59,7 +59,8 @@ public:
         std::shared_ptr<fastdeploy::vision::ocr::Recognizer> recer,
         std::shared_ptr<fastdeploy::pipeline::PPOCRv4> ocrer,
         std::string name = "",
-        std::optional<ColorFilterConfig> color_filter = std::nullopt);
+        std::optional<ColorFilterConfig> color_filter = std::nullopt,
+        std::shared_ptr<FrameCache> frame = nullptr);
 
     OCRer(
         cv::Mat image,
@@ -79,7 +80,8 @@ private:
     void cherry_pick();
 
 private:
-    cv::Mat apply_color_filter(const cv::Mat& image_roi) const;
+    // color 为已转换到 color_filter 颜色空间的图像
+    cv::Mat apply_color_filter(const cv::Mat& color) const;
     ResultsVec predict_det_and_rec(const cv::Mat& image_roi) const;
     Result predict_only_rec(const cv::Mat& image_roi) const;
     ResultsVec predict_batch_rec(const std::vector<cv::Rect>& rois) const;
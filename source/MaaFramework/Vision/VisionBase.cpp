@@ -4,18 +4,27 @@
 
 #include "MaaUtils/NoWarningCV.hpp"
 
+#include "FrameCache.h"
 #include "Global/OptionMgr.h"
+#include "ImageEncoder.h"
 #include "MaaUtils/Logger.h"
 #include "MaaUtils/Time.hpp"
 #include "VisionUtils.hpp"
 
 MAA_VISION_NS_BEGIN
 
-VisionBase::VisionBase(cv::Mat image, std::vector<cv::Rect> rois, std::string name)
+VisionBase::VisionBase(cv::Mat image, std::vector<cv::Rect> rois, std::string name, std::shared_ptr<FrameCache> frame)
     : image_(std::move(image))
     , name_(std::move(name))
+    , frame_(std::move(frame))
     , rois_(std::move(rois))
 {
+    // 缓存只对同一张图有效（如 batch OCR 的 mask 图就不是）
+    if (frame_ && (frame_->image().data != image_.data || frame_->image().size() != image_.size())) {
+        LogWarn << name_ << "frame cache does not match image, ignored";
+        frame_ = nullptr;
+    }
+
     init_draw();
 }
 
@@ -24,6 +33,17 @@ cv::Mat VisionBase::image_with_roi() const
     return image_(roi_);
 }
 
+cv::Mat VisionBase::image_with_roi(int color_method) const
+{
+    if (frame_) {
+        return frame_->color(color_method, roi_);
+    }
+
+    cv::Mat color;
+    cv::cvtColor(image_with_roi(), color, color_method);
+    return color;
+}
+
 bool VisionBase::next_roi()
 {
     if (roi_index_ >= rois_.size()) {
@@ -57,13 +77,7 @@ void VisionBase::handle_draw(const cv::Mat& draw) const
     const auto& option = MAA_GLOBAL_NS::OptionMgr::get_instance();
     int quality = option.draw_quality();
 
-    ImageEncodedBuffer jpg;
-    if (!cv::imencode(".jpg", draw, jpg, { cv::IMWRITE_JPEG_QUALITY, quality })) {
-        LogError << "Failed to encode draw image" << VAR(name_);
-        return;
-    }
-
-    draws_.emplace_back(std::move(jpg));
+    draws_.emplace_back(ImageEncoder::get_instance().encode_jpg(draw, quality));
 }
 
 void VisionBase::init_draw()
@@ -76,25 +90,34 @@ void VisionBase::init_draw()
 #endif
 }
 
-void VisionBase::save_draws(const std::string& name, const std::vector<ImageEncodedBuffer>& draws)
+void VisionBase::save_draws(const std::string& name, const std::vector<EncodedImage>& draws)
 {
     const auto& option = MAA_GLOBAL_NS::OptionMgr::get_instance();
 
-    if (!option.save_draw()) {
+    if (!option.save_draw() || draws.empty()) {
         return;
     }
 
     auto dir = option.log_dir() / "vision";
-    std::filesystem::create_directories(dir);
 
-    for (const auto& draw : draws) {
-        std::string filename = std::format("{}_{}.jpg", format_now_for_filename(), name);
-        auto filepath = dir / path(filename);
+    // 等待编码完成再落盘，放到编码线程上做
+    ImageEncoder::get_instance().post([dir = std::move(dir), name, draws]() {
+        std::filesystem::create_directories(dir);
 
-        std::ofstream of(filepath, std::ios::out | std::ios::binary);
-        of.write(reinterpret_cast<const char*>(draw.data()), draw.size());
-        LogDebug << "save draw to" << filepath;
-    }
+        for (const auto& draw : draws) {
+            const auto& data = draw.get();
+            if (data.empty()) {
+                continue;
+            }
+
+            std::string filename = std::format("{}_{}.jpg", format_now_for_filename(), name);
+            auto filepath = dir / path(filename);
+
+            std::ofstream of(filepath, std::ios::out | std::ios::binary);
+            of.write(reinterpret_cast<const char*>(data.data()), data.size());
+            LogDebug << "save draw to" << filepath;
+        }
+    });
 }
 
 MAA_VISION_NS_END
@@ -2,14 +2,18 @@
 
 #include <atomic>
 #include <filesystem>
+#include <memory>
 
 #include "Common/Conf.h"
+#include "Common/TaskResultTypes.h"
 #include "MaaFramework/MaaDef.h"
 #include "MaaUtils/JsonExt.hpp"
 #include "MaaUtils/NoWarningCVMat.hpp"
 
 MAA_VISION_NS_BEGIN
 
+class FrameCache;
+
 template <typename ResultType>
 class RecoResultAPI
 {
@@ -39,19 +43,22 @@ protected:
 class VisionBase
 {
 public:
-    using ImageEncodedBuffer = std::vector<uint8_t>;
+    using EncodedImage = MAA_TASK_NS::EncodedImage;
 
 public:
-    VisionBase(cv::Mat image, std::vector<cv::Rect> rois, std::string name);
+    // frame 为 image 所在帧的派生数据缓存，可为空
+    VisionBase(cv::Mat image, std::vector<cv::Rect> rois, std::string name, std::shared_ptr<FrameCache> frame = nullptr);
 
-    const std::vector<ImageEncodedBuffer>& draws() const& { return draws_; }
+    const std::vector<EncodedImage>& draws() const& { return draws_; }
 
-    std::vector<ImageEncodedBuffer> draws() && { return std::move(draws_); }
+    std::vector<EncodedImage> draws() && { return std::move(draws_); }
 
-    static void save_draws(const std::string& name, const std::vector<ImageEncodedBuffer>& draws);
+    static void save_draws(const std::string& name, const std::vector<EncodedImage>& draws);
 
 protected:
     cv::Mat image_with_roi() const;
+    // roi 部分转换颜色空间；有帧缓存时整帧只转换一次，返回的是缓存的视图，不要写入
+    cv::Mat image_with_roi(int color_method) const;
 
     bool next_roi();
     void reset_roi();
@@ -63,6 +70,7 @@ protected:
 protected:
     const cv::Mat image_;
     const std::string name_;
+    std::shared_ptr<FrameCache> frame_;
 
     cv::Rect roi_ { };
 
@@ -74,7 +82,7 @@ private:
     std::vector<cv::Rect> rois_;
     size_t roi_index_ = 0;
 
-    mutable std::vector<ImageEncodedBuffer> draws_;
+    mutable std::vector<EncodedImage> draws_;
 };
 
 MAA_VISION_NS_END
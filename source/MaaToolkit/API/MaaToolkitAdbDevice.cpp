@@ -66,6 +66,24 @@ MaaBool MaaToolkitAdbDeviceFindSpecified(const char* adb_path, MaaToolkitAdbDevi
     return true;
 }
 
+MaaBool MaaToolkitAdbDeviceWatch(MaaToolkitAdbDeviceList* added, MaaToolkitAdbDeviceList* removed)
+{
+    if (!added || !removed) {
+        LogError << "buffer is null" << VAR_VOIDP(added) << VAR_VOIDP(removed);
+        return false;
+    }
+
+    auto changes = finder().watch();
+    for (const auto& d : changes.added) {
+        added->append(MAA_TOOLKIT_NS::AdbDeviceBuffer(d));
+    }
+    for (const auto& d : changes.removed) {
+        removed->append(MAA_TOOLKIT_NS::AdbDeviceBuffer(d));
+    }
+
+    return true;
+}
+
 MaaSize MaaToolkitAdbDeviceListSize(const MaaToolkitAdbDeviceList* list)
 {
     if (!list) {
@@ -0,0 +1,134 @@
+#include "AdbDeviceCache.h"
+
+#include <fstream>
+
+#include "MaaUtils/Logger.h"
+#include "MaaUtils/Platform.h"
+
+MAA_TOOLKIT_NS_BEGIN
+
+bool AdbDeviceCache::init(const std::filesystem::path& user_path)
+{
+    LogFunc << VAR(user_path);
+
+    std::unique_lock lock(mutex_);
+
+    cache_path_ = user_path / kCachePath;
+    entries_.clear();
+    dirty_ = false;
+
+    if (!std::filesystem::exists(cache_path_)) {
+        return true;
+    }
+
+    auto json_opt = json::open(cache_path_, true, true);
+    if (!json_opt || !json_opt->is<std::vector<Entry>>()) {
+        LogWarn << "invalid adb device cache, ignored" << VAR(cache_path_);
+        return false;
+    }
+
+    for (auto& entry : json_opt->as<std::vector<Entry>>()) {
+        if (expired(entry)) {
+            dirty_ = true;
+            continue;
+        }
+        auto key = key_of(entry.adb_path, entry.serial);
+        entries_.insert_or_assign(std::move(key), std::move(entry));
+    }
+
+    LogInfo << VAR(entries_.size());
+    return true;
+}
+
+void AdbDeviceCache::set_ttl(std::chrono::seconds ttl)
+{
+    LogInfo << VAR(ttl.count());
+
+    std::unique_lock lock(mutex_);
+    ttl_ = ttl;
+}
+
+std::optional<AdbDeviceCache::Entry>
+    AdbDeviceCache::get(const std::filesystem::path& adb_path, const std::string& serial, const std::string& emulator) const
+{
+    std::unique_lock lock(mutex_);
+
+    auto it = entries_.find(key_of(path_to_utf8_string(adb_path), serial));
+    if (it == entries_.end() || it->second.emulator != emulator || expired(it->second)) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void AdbDeviceCache::put(const AdbDevice& device, const std::string& emulator)
+{
+    std::unique_lock lock(mutex_);
+
+    if (ttl_.count() <= 0) {
+        return;
+    }
+
+    Entry entry {
+        .adb_path = path_to_utf8_string(device.adb_path),
+        .serial = device.serial,
+        .emulator = emulator,
+        .screencap_methods = device.screencap_methods,
+        .input_methods = device.input_methods,
+        .config = device.config,
+        .updated_at = now(),
+    };
+    auto key = key_of(entry.adb_path, entry.serial);
+    entries_.insert_or_assign(std::move(key), std::move(entry));
+    dirty_ = true;
+}
+
+void AdbDeviceCache::flush()
+{
+    std::unique_lock lock(mutex_);
+
+    if (!dirty_ || cache_path_.empty()) {
+        return;
+    }
+
+    std::vector<Entry> entries;
+    for (const auto& [key, entry] : entries_) {
+        if (!expired(entry)) {
+            entries.emplace_back(entry);
+        }
+    }
+
+    if (cache_path_.has_parent_path()) {
+        std::error_code ec;
+        std::filesystem::create_directories(cache_path_.parent_path(), ec);
+        if (ec) {
+            // 保持 dirty_，下次 flush 再试
+            LogError << "Failed to create cache directory" << cache_path_.parent_path() << VAR(ec.message());
+            return;
+        }
+    }
+
+    std::ofstream ofs(cache_path_, std::ios::out | std::ios::trunc);
+    if (!ofs.is_open()) {
+        LogError << "Failed to open cache file" << cache_path_;
+        return;
+    }
+    ofs << json::value(entries);
+    dirty_ = false;
+}
+
+std::string AdbDeviceCache::key_of(const std::string& adb_path, const std::string& serial)
+{
+    return adb_path + '\n' + serial;
+}
+
+int64_t AdbDeviceCache::now()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+bool AdbDeviceCache::expired(const Entry& entry) const
+{
+    return ttl_.count() <= 0 || now() - entry.updated_at >= ttl_.count();
+}
+
+MAA_TOOLKIT_NS_END
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include <meojson/json.hpp>
+
+#include "AdbDeviceBuffer.hpp"
+#include "Common/Conf.h"
+#include "MaaUtils/SingletonHolder.hpp"
+
+MAA_TOOLKIT_NS_BEGIN
+
+// 设备探测结果缓存，以 (adb 路径, serial, 模拟器类型) 为键，记录探测得到的截图/输入方式与额外配置，
+// 在有效期内再次发现同一设备时跳过逐项 shell 探测。调用 init 后持久化到 user_path 下
+class AdbDeviceCache : public SingletonHolder<AdbDeviceCache>
+{
+    friend class SingletonHolder<AdbDeviceCache>;
+
+public:
+    inline static const std::filesystem::path kCachePath = "cache/adb_device.json";
+    inline static constexpr std::chrono::seconds kDefaultTTL = std::chrono::hours(1);
+
+    struct Entry
+    {
+        std::string adb_path;
+        std::string serial;
+        std::string emulator;
+        MaaAdbScreencapMethod screencap_methods = MaaAdbScreencapMethod_None;
+        MaaAdbInputMethod input_methods = MaaAdbInputMethod_None;
+        json::object config;
+        int64_t updated_at = 0; // unix 秒
+
+        MEO_JSONIZATION(adb_path, serial, emulator, screencap_methods, input_methods, config, updated_at);
+    };
+
+public:
+    virtual ~AdbDeviceCache() = default;
+
+    bool init(const std::filesystem::path& user_path);
+    // 0 表示关闭缓存
+    void set_ttl(std::chrono::seconds ttl);
+
+    // 仅返回有效期内的结果
+    std::optional<Entry> get(const std::filesystem::path& adb_path, const std::string& serial, const std::string& emulator) const;
+    void put(const AdbDevice& device, const std::string& emulator);
+
+    // 有改动时写回磁盘
+    void flush();
+
+private:
+    AdbDeviceCache() = default;
+
+    static std::string key_of(const std::string& adb_path, const std::string& serial);
+    static int64_t now();
+
+    bool expired(const Entry& entry) const;
+
+private:
+    mutable std::mutex mutex_;
+    std::filesystem::path cache_path_;
+    std::chrono::seconds ttl_ = kDefaultTTL;
+    std::map<std::string, Entry> entries_;
+    bool dirty_ = false;
+};
+
+MAA_TOOLKIT_NS_END
@@ -1,61 +1,141 @@
 #include "AdbDeviceFinder.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
+#include <iterator>
+#include <mutex>
 #include <ranges>
+#include <thread>
 #include <unordered_set>
 
+#include "AdbDeviceCache.h"
 #include "LibraryHolder/ControlUnit.h"
 #include "MaaControlUnit/ControlUnitAPI.h"
 #include "MaaUtils/IOStream/BoostIO.hpp"
 #include "MaaUtils/Logger.h"
 #include "MaaUtils/StringMisc.hpp"
+#include "MaaUtils/Time.hpp"
 
 MAA_TOOLKIT_NS_BEGIN
 
+namespace
+{
+
+// 每个探测都会启动 adb 进程，限制并发数以免同时拉起过多进程
+constexpr size_t kMaxProbeWorkers = 8;
+
+// 单条 shell 探测的超时，设备无响应时不至于卡住整个搜索
+constexpr std::chrono::milliseconds kShellProbeTimeout(5000);
+
+template <typename Func>
+void parallel_probe(size_t count, Func&& func)
+{
+    const size_t worker_count = std::min(count, kMaxProbeWorkers);
+    if (worker_count <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    std::atomic_size_t next = 0;
+    auto work = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            func(i);
+        }
+    };
+
+    std::vector<std::jthread> workers;
+    workers.reserve(worker_count - 1);
+    for (size_t i = 1; i < worker_count; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+}
+
+std::shared_ptr<MAA_CTRL_UNIT_NS::AdbControlUnitAPI> create_probe_unit(const std::filesystem::path& adb_path, const std::string& serial)
+{
+    // 首次创建时会加载控制单元动态库，并行探测时串行化这一步
+    static std::mutex mutex;
+    std::unique_lock lock(mutex);
+
+    std::string str_adb = path_to_utf8_string(adb_path);
+    return AdbControlUnitLibraryHolder::create_control_unit(
+        str_adb.c_str(),
+        serial.c_str(),
+        MaaAdbScreencapMethod_None,
+        MaaAdbInputMethod_None,
+        "{}",
+        "");
+}
+
+} // namespace
+
 std::vector<AdbDevice> AdbDeviceFinder::find() const
 {
     LogFunc;
 
-    std::vector<AdbDevice> result;
-    std::unordered_set<std::string> accurate_serials;
+    auto start_time = std::chrono::steady_clock::now();
 
     auto all_emulators = find_emulators();
-    for (const Emulator& e : all_emulators) {
-        auto res = find_by_emulator_tool(e);
-        bool found = !res.empty();
-        for (auto& dev : res) {
+
+    // 模拟器自带的工具能直接给出准确的 serial
+    std::vector<std::vector<AdbDevice>> tool_devices(all_emulators.size());
+    parallel_probe(all_emulators.size(), [&](size_t i) { tool_devices[i] = find_by_emulator_tool(all_emulators[i]); });
+
+    std::unordered_set<std::string> accurate_serials;
+    for (const auto& devices : tool_devices) {
+        for (const auto& dev : devices) {
             accurate_serials.emplace(dev.serial);
-            result.emplace_back(std::move(dev));
         }
-        if (found) {
+    }
+
+    constexpr size_t kNoSource = static_cast<size_t>(-1);
+    std::vector<AdbSource> sources;
+    std::vector<size_t> source_index(all_emulators.size(), kNoSource);
+
+    for (size_t i = 0; i < all_emulators.size(); ++i) {
+        const Emulator& e = all_emulators[i];
+        if (!tool_devices[i].empty()) {
             continue;
         }
-
         if (e.adb_path.empty() || !std::filesystem::exists(e.adb_path)) {
             LogWarn << "adb_path is empty or does not exist" << VAR(e.adb_path);
             continue;
         }
-
-        res = find_specified(e.adb_path, accurate_serials, e);
-        for (auto& dev : res) {
-            if (accurate_serials.count(dev.serial)) {
-                continue;
-            }
-            result.emplace_back(std::move(dev));
-        }
+        source_index[i] = sources.size();
+        sources.emplace_back(AdbSource { .adb_path = e.adb_path, .emulator = e });
     }
 
+    bool has_env_adb = false;
     if (auto env_adb = boost::process::search_path("adb"); std::filesystem::exists(env_adb)) {
-        auto res = find_specified(env_adb, accurate_serials);
-        for (auto& dev : res) {
-            if (accurate_serials.count(dev.serial)) {
-                continue;
-            }
-            result.emplace_back(std::move(dev));
+        has_env_adb = true;
+        sources.emplace_back(AdbSource { .adb_path = env_adb });
+    }
+
+    auto adb_devices = find_by_adb_sources(sources, accurate_serials);
+
+    std::vector<AdbDevice> result;
+    auto append = [&](std::vector<AdbDevice>& devices) {
+        std::ranges::move(devices, std::back_inserter(result));
+    };
+    for (size_t i = 0; i < all_emulators.size(); ++i) {
+        if (!tool_devices[i].empty()) {
+            append(tool_devices[i]);
         }
+        else if (source_index[i] != kNoSource) {
+            append(adb_devices[source_index[i]]);
+        }
+    }
+    if (has_env_adb) {
+        append(adb_devices.back());
     }
 
-    LogInfo << VAR(result);
+    AdbDeviceCache::get_instance().flush();
+
+    LogInfo << VAR(result) << VAR(duration_since(start_time));
     return result;
 }
 
@@ -66,23 +146,99 @@ std::vector<AdbDevice> AdbDeviceFinder::find_specified(
 {
     LogFunc << VAR(adb_path);
 
-    std::vector<AdbDevice> result;
+    auto devices = find_by_adb_sources({ AdbSource { .adb_path = adb_path, .emulator = emulator } }, exclude_serials);
+    auto result = std::move(devices.front());
+
+    AdbDeviceCache::get_instance().flush();
 
-    auto serials = find_serials_by_adb_command(adb_path);
+    LogInfo << VAR(result);
+    return result;
+}
+
+AdbDeviceFinder::DeviceChanges AdbDeviceFinder::watch()
+{
+    LogFunc;
+
+    auto current = find();
+
+    auto key_of = [](const AdbDevice& dev) {
+        return path_to_utf8_string(dev.adb_path) + '\n' + dev.serial;
+    };
+    auto same = [](const AdbDevice& lhs, const AdbDevice& rhs) {
+        return lhs.name == rhs.name && lhs.screencap_methods == rhs.screencap_methods && lhs.input_methods == rhs.input_methods
+               && lhs.config == rhs.config;
+    };
+
+    std::unique_lock lock(watch_mutex_);
+
+    std::unordered_map<std::string, const AdbDevice*> previous;
+    for (const auto& dev : watched_devices_) {
+        previous.emplace(key_of(dev), &dev);
+    }
 
-    for (const std::string& ser : serials) {
-        if (exclude_serials.count(ser)) {
-            LogInfo << "skip excluded serial" << VAR(ser);
+    DeviceChanges changes;
+    for (const auto& dev : current) {
+        auto it = previous.find(key_of(dev));
+        if (it == previous.end()) {
+            changes.added.emplace_back(dev);
             continue;
         }
-        auto res_opt = try_device(adb_path, ser, emulator);
-        if (!res_opt) {
-            continue;
+        if (!same(*it->second, dev)) {
+            changes.removed.emplace_back(*it->second);
+            changes.added.emplace_back(dev);
+        }
+        previous.erase(it);
+    }
+    for (const auto& dev : watched_devices_) {
+        if (previous.contains(key_of(dev))) {
+            changes.removed.emplace_back(dev);
         }
-        result.emplace_back(std::move(*res_opt));
     }
 
-    LogInfo << VAR(result);
+    watched_devices_ = std::move(current);
+
+    LogInfo << VAR(changes);
+    return changes;
+}
+
+std::vector<std::vector<AdbDevice>>
+    AdbDeviceFinder::find_by_adb_sources(const std::vector<AdbSource>& sources, const std::unordered_set<std::string>& exclude_serials) const
+{
+    LogFunc << VAR(sources.size()) << VAR(exclude_serials);
+
+    std::vector<std::vector<std::string>> serials(sources.size());
+    parallel_probe(sources.size(), [&](size_t i) { serials[i] = find_serials_by_adb_command(sources[i].adb_path); });
+
+    struct Target
+    {
+        size_t source = 0;
+        std::string serial;
+    };
+
+    std::vector<Target> targets;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        for (auto& ser : serials[i]) {
+            if (exclude_serials.contains(ser)) {
+                LogInfo << "skip excluded serial" << VAR(ser);
+                continue;
+            }
+            targets.emplace_back(Target { .source = i, .serial = std::move(ser) });
+        }
+    }
+
+    std::vector<std::optional<AdbDevice>> devices(targets.size());
+    parallel_probe(targets.size(), [&](size_t i) {
+        const auto& source = sources[targets[i].source];
+        devices[i] = try_device(source.adb_path, targets[i].serial, source.emulator);
+    });
+
+    std::vector<std::vector<AdbDevice>> result(sources.size());
+    for (size_t i = 0; i < targets.size(); ++i) {
+        if (!devices[i]) {
+            continue;
+        }
+        result[targets[i].source].emplace_back(std::move(*devices[i]));
+    }
     return result;
 }
 
@@ -90,10 +246,7 @@ std::vector<std::string> AdbDeviceFinder::find_serials_by_adb_command(const std:
 {
     LogFunc << VAR(adb_path);
 
-    std::string str_adb = path_to_utf8_string(adb_path);
-
-    auto control_unit =
-        AdbControlUnitLibraryHolder::create_control_unit(str_adb.c_str(), "", MaaAdbScreencapMethod_None, MaaAdbInputMethod_None, "{}", "");
+    auto control_unit = create_probe_unit(adb_path, "");
 
     if (!control_unit) {
         LogError << "Failed to create control unit";
@@ -120,7 +273,7 @@ bool request_waydroid_config(std::shared_ptr<MAA_CTRL_UNIT_NS::AdbControlUnitAPI
     }
 
     std::string output;
-    bool ret = control_unit->shell("getprop | grep ro.product.brand", output);
+    bool ret = control_unit->shell("getprop | grep ro.product.brand", output, kShellProbeTimeout);
     if (!ret) {
         return false;
     }
@@ -153,7 +306,7 @@ bool request_androws_config(std::shared_ptr<MAA_CTRL_UNIT_NS::AdbControlUnitAPI>
 
     // Detect via Tencent-specific property; non-empty means this is an Androws device
     std::string output;
-    bool ret = control_unit->shell("getprop sys.tencent.imei", output);
+    bool ret = control_unit->shell("getprop sys.tencent.imei", output, kShellProbeTimeout);
     if (!ret) {
         return false;
     }
@@ -183,7 +336,7 @@ bool request_avd_config(std::shared_ptr<MAA_CTRL_UNIT_NS::AdbControlUnitAPI> con
     }
 
     std::string output;
-    if (!control_unit->shell("getprop ro.product.model", output)) {
+    if (!control_unit->shell("getprop ro.product.model", output, kShellProbeTimeout)) {
         return false;
     }
 
@@ -207,7 +360,7 @@ bool request_vivo_orientation_config(std::shared_ptr<MAA_CTRL_UNIT_NS::AdbContro
     }
 
     std::string brand;
-    if (!control_unit->shell("getprop ro.product.brand", brand)) {
+    if (!control_unit->shell("getprop ro.product.brand", brand, kShellProbeTimeout)) {
         return false;
     }
 
@@ -215,13 +368,13 @@ bool request_vivo_orientation_config(std::shared_ptr<MAA_CTRL_UNIT_NS::AdbContro
     tolowers_(brand);
 
     std::string manufacturer;
-    if (control_unit->shell("getprop ro.product.manufacturer", manufacturer)) {
+    if (control_unit->shell("getprop ro.product.manufacturer", manufacturer, kShellProbeTimeout)) {
         string_trim_(manufacturer);
         tolowers_(manufacturer);
     }
 
     std::string model;
-    if (control_unit->shell("getprop ro.product.model", model)) {
+    if (control_unit->shell("getprop ro.product.model", model, kShellProbeTimeout)) {
         string_trim_(model);
         tolowers_(model);
     }
@@ -236,7 +389,7 @@ bool request_vivo_orientation_config(std::shared_ptr<MAA_CTRL_UNIT_NS::AdbContro
     // If SurfaceOrientation exists, the default Orientation command should still work.
     // In this case, do not override the default command to minimize the impact scope.
     std::string surface_orientation;
-    if (control_unit->shell("dumpsys input | grep -m 1 SurfaceOrientation", surface_orientation)) {
+    if (control_unit->shell("dumpsys input | grep -m 1 SurfaceOrientation", surface_orientation, kShellProbeTimeout)) {
         string_trim_(surface_orientation);
         if (!surface_orientation.empty()) {
             return false;
@@ -246,7 +399,7 @@ bool request_vivo_orientation_config(std::shared_ptr<MAA_CTRL_UNIT_NS::AdbContro
     // Some vivo / iQOO devices do not have SurfaceOrientation in dumpsys input,
     // but Viewport INTERNAL contains orientation=0/1/2/3.
     std::string viewport;
-    if (!control_unit->shell("dumpsys input | grep -m 1 'Viewport INTERNAL'", viewport)) {
+    if (!control_unit->shell("dumpsys input | grep -m 1 'Viewport INTERNAL'", viewport, kShellProbeTimeout)) {
         return false;
     }
 
@@ -273,15 +426,7 @@ std::optional<AdbDevice>
 {
     LogFunc << VAR(adb_path) << VAR(serial);
 
-    std::string str_adb = path_to_utf8_string(adb_path);
-
-    auto control_unit = AdbControlUnitLibraryHolder::create_control_unit(
-        str_adb.c_str(),
-        serial.c_str(),
-        MaaAdbScreencapMethod_None,
-        MaaAdbInputMethod_None,
-        "{}",
-        "");
+    auto control_unit = create_probe_unit(adb_path, serial);
 
     if (!control_unit) {
         LogError << "Failed to create control unit";
@@ -300,6 +445,17 @@ std::optional<AdbDevice>
     device.input_methods = MaaAdbInputMethod_Default;
     device.config = { };
 
+    auto& cache = AdbDeviceCache::get_instance();
+    if (auto cached = cache.get(adb_path, serial, emulator.name)) {
+        device.screencap_methods = cached->screencap_methods;
+        device.input_methods = cached->input_methods;
+        device.config = std::move(cached->config);
+        LogInfo << "use cached config" << VAR(device);
+        return device;
+    }
+
+    auto probe_start = std::chrono::steady_clock::now();
+
     if (request_waydroid_config(control_unit, device)) {
     }
     else if (request_androws_config(control_unit, device)) {
@@ -313,6 +469,21 @@ std::optional<AdbDevice>
     else {
     }
 
+    // 各探测在 shell 失败时也返回 false，与“不是该类设备”无法区分，会得到默认配置。
+    // 只有确认设备 shell 可用时才写入缓存，否则一次快速失败的探测会让默认配置缓存整个有效期
+    auto cost = duration_since(probe_start);
+    std::string echo;
+    if (cost >= kShellProbeTimeout) {
+        // 耗时达到超时时间说明有探测没有正常返回
+        LogWarn << "probe too slow, not cached" << VAR(serial) << VAR(cost);
+    }
+    else if (!control_unit->shell("echo maa", echo, kShellProbeTimeout) || echo.find("maa") == std::string::npos) {
+        LogWarn << "device shell unavailable, probe not cached" << VAR(serial) << VAR(echo);
+    }
+    else {
+        cache.put(device, emulator.name);
+    }
+
     return device;
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -39,6 +40,14 @@ public:
         MEO_TOJSON(name, process_path, adb_path);
     };
 
+    struct DeviceChanges
+    {
+        std::vector<AdbDevice> added;
+        std::vector<AdbDevice> removed; // 配置发生变化的设备同时出现在 removed 与 added 中
+
+        MEO_TOJSON(added, removed);
+    };
+
 public:
     virtual ~AdbDeviceFinder() = default;
 
@@ -49,6 +58,9 @@ public:
         const std::unordered_set<std::string>& exclude_serials = { },
         const Emulator& emulator = { }) const;
 
+    // 重新搜索一遍，只返回与上一次 watch 相比的变化，首次调用时所有设备都视为新增
+    DeviceChanges watch();
+
 protected:
     virtual const EmulatorConstDataMap& get_emulator_const_data() const { return kEmptyEmulatorConstDataMap; }
 
@@ -61,6 +73,16 @@ protected:
     virtual std::vector<Emulator> find_extra_emulators() const { return { }; }
 
 protected:
+    struct AdbSource
+    {
+        std::filesystem::path adb_path;
+        Emulator emulator;
+    };
+
+    // 并行枚举各 adb 的 serial 并探测，结果与 sources 一一对应
+    std::vector<std::vector<AdbDevice>>
+        find_by_adb_sources(const std::vector<AdbSource>& sources, const std::unordered_set<std::string>& exclude_serials) const;
+
     std::vector<std::string> find_serials_by_adb_command(const std::filesystem::path& adb_path) const;
     std::optional<AdbDevice> try_device(const std::filesystem::path& adb_path, const std::string& serial, const Emulator& emulator) const;
 
@@ -69,6 +91,9 @@ protected:
 
 private:
     inline static const EmulatorConstDataMap kEmptyEmulatorConstDataMap;
+
+    std::mutex watch_mutex_;
+    std::vector<AdbDevice> watched_devices_;
 };
 
 MAA_TOOLKIT_NS_END
@@ -5,6 +5,7 @@
 
 #include <meojson/json.hpp>
 
+#include "AdbDevice/AdbDeviceCache.h"
 #include "MaaFramework/MaaAPI.h"
 #include "MaaUtils/Logger.h"
 #include "MaaUtils/Platform.h"
@@ -16,6 +17,7 @@ bool GlobalOptionConfig::init(const std::filesystem::path& user_path, const json
 {
     LogFunc << VAR(user_path);
 
+    user_path_ = user_path;
     config_path_ = user_path / kConfigPath;
     debug_dir_ = user_path / kDebugDir;
 
@@ -79,6 +81,10 @@ bool GlobalOptionConfig::apply_option()
 
     ret &= MaaGlobalSetOption(MaaGlobalOption_DrawQuality, &option_.draw_quality, sizeof(option_.draw_quality));
 
+    auto& adb_device_cache = AdbDeviceCache::get_instance();
+    adb_device_cache.set_ttl(std::chrono::seconds(option_.adb_device_cache_ttl));
+    adb_device_cache.init(user_path_);
+
     bool bret = ret;
     LogDebug << VAR(bret);
     return bret;
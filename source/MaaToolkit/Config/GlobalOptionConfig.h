@@ -30,8 +30,15 @@ public:
         bool save_on_error = true;
         int32_t stdout_level = MaaLoggingLevel_Error;
         int draw_quality = 85;
+        int64_t adb_device_cache_ttl = 3600; // 秒，0 表示不缓存设备探测结果
 
-        MEO_JSONIZATION(MEO_OPT logging, MEO_OPT save_draw, MEO_OPT save_on_error, MEO_OPT stdout_level, MEO_OPT draw_quality);
+        MEO_JSONIZATION(
+            MEO_OPT logging,
+            MEO_OPT save_draw,
+            MEO_OPT save_on_error,
+            MEO_OPT stdout_level,
+            MEO_OPT draw_quality,
+            MEO_OPT adb_device_cache_ttl);
     };
 
 public:
@@ -46,6 +53,7 @@ private:
     bool save() const;
 
 private:
+    std::filesystem::path user_path_;
     std::filesystem::path config_path_;
     std::filesystem::path debug_dir_;
 
@@ -73,7 +73,7 @@ std::optional<cv::Mat> FramePoolScreencap::screencap()
             LogError << "Failed to get frame and no cached image available";
             return std::nullopt;
         }
-        return cached_image_.clone();
+        return cached_image_;
     }
 
     auto surface = frame.Surface();
@@ -164,7 +164,8 @@ std::optional<cv::Mat> FramePoolScreencap::screencap()
     cv::Mat image = raw(client_roi);
 
     cv::Mat result = bgra_to_bgr(image);
-    cached_image_ = result.clone();
+    // result 是新分配的缓冲区，之后不会被修改，缓存共享即可
+    cached_image_ = result;
     return result;
 }
 
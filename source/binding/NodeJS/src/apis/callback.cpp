@@ -1,5 +1,14 @@
 #include "callback.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "../foundation/spec.h"
 
 #include "buffer.h"
@@ -80,6 +89,170 @@ void ContextSink(void* context, const char* message, const char* details_json, v
     });
 }
 
+struct BatchedSinkContext::State
+{
+    struct Event
+    {
+        void* source { }; // 有 snapshot 时为空
+        uint64_t source_id = 0;
+        std::string message;
+        std::string details;
+    };
+
+    maajs::CallbackContext* callback { };
+    std::string prefix;
+    Locator locator { };
+    Snapshot snapshot { };
+    size_t max_count = kDefaultMaxCount;
+    std::chrono::milliseconds max_delay { kDefaultMaxDelay };
+    size_t capacity = kDefaultCapacity;
+
+    std::atomic_bool stop = false;
+    mutable std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<Event> queue;
+    SinkBatchStats stats;
+};
+
+BatchedSinkContext::BatchedSinkContext(
+    maajs::FunctionType fn,
+    const char* name,
+    std::string prefix,
+    Locator locator,
+    maajs::OptionalParam<uint32_t> max_count,
+    maajs::OptionalParam<uint32_t> max_delay,
+    maajs::OptionalParam<uint32_t> capacity,
+    Snapshot snapshot)
+    : state_(std::make_shared<State>())
+{
+    state_->callback = new maajs::CallbackContext(fn, name);
+    state_->prefix = std::move(prefix);
+    state_->locator = locator;
+    state_->snapshot = snapshot;
+    state_->max_count = std::max<size_t>(max_count.value_or(kDefaultMaxCount), 1);
+    state_->max_delay = std::chrono::milliseconds(max_delay.value_or(kDefaultMaxDelay));
+    state_->capacity = std::max<size_t>(capacity.value_or(kDefaultCapacity), state_->max_count);
+
+    // 后台线程可能正阻塞在 JS 线程上的调用中, 析构时无法 join, 由线程自己持有状态
+    std::thread(run, state_).detach();
+}
+
+BatchedSinkContext::~BatchedSinkContext()
+{
+    {
+        std::unique_lock lock(state_->mutex);
+        state_->stop = true;
+        state_->queue.clear();
+    }
+    state_->cond.notify_all();
+}
+
+void BatchedSinkContext::push(void* source, const char* message, const char* details_json)
+{
+    // 仍在框架回调内, source 有效, 在这里取出需要的数据
+    State::Event event { .message = message, .details = details_json };
+    if (state_->snapshot) {
+        event.source_id = state_->snapshot(source);
+    }
+    else {
+        event.source = source;
+    }
+
+    {
+        std::unique_lock lock(state_->mutex);
+        if (state_->queue.size() >= state_->capacity) {
+            ++state_->stats.dropped;
+            return;
+        }
+        state_->queue.emplace_back(std::move(event));
+        state_->stats.max_pending = std::max<uint64_t>(state_->stats.max_pending, state_->queue.size());
+        if (state_->queue.size() < state_->max_count) {
+            return;
+        }
+    }
+    state_->cond.notify_all();
+}
+
+SinkBatchStats BatchedSinkContext::stats() const
+{
+    std::unique_lock lock(state_->mutex);
+    return state_->stats;
+}
+
+maajs::ValueType BatchedSinkContext::stats_value(maajs::EnvType env) const
+{
+    auto stat = stats();
+    auto result = maajs::ObjectType::New(env);
+    result["events"] = maajs::NumberType::New(env, static_cast<double>(stat.events));
+    result["batches"] = maajs::NumberType::New(env, static_cast<double>(stat.batches));
+    result["dropped"] = maajs::NumberType::New(env, static_cast<double>(stat.dropped));
+    result["max_pending"] = maajs::NumberType::New(env, static_cast<double>(stat.max_pending));
+    return result;
+}
+
+void BatchedSinkContext::run(std::shared_ptr<State> state)
+{
+    while (true) {
+        std::vector<State::Event> batch;
+        {
+            std::unique_lock lock(state->mutex);
+            state->cond.wait(lock, [&] { return state->stop || !state->queue.empty(); });
+            if (state->stop) {
+                break;
+            }
+            // 第一个事件到达后最多再等一个时间窗口, 攒够数量提前投递
+            state->cond.wait_for(lock, state->max_delay, [&] { return state->stop || state->queue.size() >= state->max_count; });
+            if (state->stop) {
+                break;
+            }
+
+            auto count = std::min(state->queue.size(), state->max_count);
+            batch.assign(
+                std::make_move_iterator(state->queue.begin()),
+                std::make_move_iterator(state->queue.begin() + static_cast<ptrdiff_t>(count)));
+            state->queue.erase(state->queue.begin(), state->queue.begin() + static_cast<ptrdiff_t>(count));
+            state->stats.events += count;
+            ++state->stats.batches;
+        }
+
+        state->callback->Call<void>([&](maajs::FunctionType fn) -> maajs::ValueType {
+            auto env = fn.Env();
+            // 排队期间 sink 已被移除, source 可能也已销毁
+            if (state->stop) {
+                return env.Undefined();
+            }
+
+            std::vector<maajs::ValueType> events;
+            events.reserve(batch.size());
+            for (const auto& event : batch) {
+                auto detail = maajs::JsonParse(env, event.details).As<maajs::ObjectType>();
+                std::string_view msg = event.message;
+                if (msg.starts_with(state->prefix)) {
+                    msg.remove_prefix(state->prefix.size());
+                }
+                detail["msg"] = maajs::StringType::New(env, std::string(msg));
+                auto source = state->snapshot ? maajs::NumberType::New(env, static_cast<double>(event.source_id))
+                                              : state->locator(env, event.source);
+                events.push_back(maajs::MakeArray(env, { source, detail }));
+            }
+            return fn.Call({ maajs::MakeArray(env, events) });
+        });
+    }
+
+    // CallbackContext 持有 JS 引用, 需在 JS 线程上释放; Call 在调用 caller 之后不再访问自身成员
+    auto callback = state->callback;
+    callback->Call<void>([callback](maajs::FunctionType fn) -> maajs::ValueType {
+        auto env = fn.Env();
+        delete callback;
+        return env.Undefined();
+    });
+}
+
+void BatchedSink(void* source, const char* message, const char* details_json, void* callback_arg)
+{
+    reinterpret_cast<BatchedSinkContext*>(callback_arg)->push(source, message, details_json);
+}
+
 MaaBool CustomReco(
     MaaContext* context,
     MaaTaskId task_id,
@@ -1,12 +1,64 @@
 #pragma once
 
+#include <chrono>
+#include <memory>
+#include <string>
+
 #include <MaaFramework/MaaAPI.h>
 
+#include "../foundation/spec.h"
+
 void ResourceSink(void* resource, const char* message, const char* details_json, void* callback_arg);
 void ControllerSink(void* controller, const char* message, const char* details_json, void* callback_arg);
 void TaskerSink(void* tasker, const char* message, const char* details_json, void* callback_arg);
 void ContextSink(void* context, const char* message, const char* details_json, void* callback_arg);
 
+struct SinkBatchStats
+{
+    uint64_t events = 0;
+    uint64_t batches = 0;
+    uint64_t dropped = 0; // 队列已满时丢弃的事件
+    uint64_t max_pending = 0;
+};
+
+// 批量投递的 sink: 框架线程只负责入队, 由后台线程按数量/时间窗口合并后一次调用 JS, 参数为 [source, detail][].
+// 同一 sink 内保持事件顺序; 队列有上限, 满时丢弃新事件并计数. 移除 sink 时尚未投递的事件会被丢弃.
+// 投递时框架回调早已返回, 生命周期只在回调内有效的 source (如 Context) 须传 snapshot, 入队时取出其 id 代替 source
+class BatchedSinkContext
+{
+public:
+    using Locator = maajs::ValueType (*)(maajs::EnvType env, void* source);
+    using Snapshot = uint64_t (*)(void* source);
+
+    constexpr static size_t kDefaultMaxCount = 64;
+    constexpr static uint32_t kDefaultMaxDelay = 16; // ms
+    constexpr static size_t kDefaultCapacity = 4096;
+
+    BatchedSinkContext(
+        maajs::FunctionType fn,
+        const char* name,
+        std::string prefix,
+        Locator locator,
+        maajs::OptionalParam<uint32_t> max_count,
+        maajs::OptionalParam<uint32_t> max_delay,
+        maajs::OptionalParam<uint32_t> capacity,
+        Snapshot snapshot = nullptr);
+    ~BatchedSinkContext();
+
+    void push(void* source, const char* message, const char* details_json);
+    SinkBatchStats stats() const;
+    maajs::ValueType stats_value(maajs::EnvType env) const;
+
+private:
+    struct State;
+
+    static void run(std::shared_ptr<State> state);
+
+    std::shared_ptr<State> state_;
+};
+
+void BatchedSink(void* source, const char* message, const char* details_json, void* callback_arg);
+
 MaaBool CustomReco(
     MaaContext* context,
     MaaTaskId task_id,
@@ -91,6 +91,20 @@ void ClientImpl::set_timeout(uint64_t ms)
     }
 }
 
+maajs::PromiseType ClientImpl::probe_latency(maajs::OptionalParam<uint32_t> count)
+{
+    using Result = std::optional<std::string>;
+    auto work = new maajs::AsyncWork<Result>(env, [client = client, count = count.value_or(20)]() -> Result {
+        StringBuffer buf;
+        if (!MaaAgentClientProbeLatency(client, count, buf)) {
+            return std::nullopt;
+        }
+        return buf.str();
+    });
+    work->Queue();
+    return work->Promise();
+}
+
 std::optional<std::vector<std::string>> ClientImpl::get_custom_recognition_list()
 {
     StringListBuffer buffer;
@@ -140,6 +154,7 @@ void ClientImpl::init_proto(maajs::ObjectType proto, maajs::FunctionType)
     MAA_BIND_GETTER(proto, "connected", ClientImpl::get_connected);
     MAA_BIND_GETTER(proto, "alive", ClientImpl::get_alive);
     MAA_BIND_SETTER(proto, "timeout", ClientImpl::set_timeout);
+    MAA_BIND_FUNC(proto, "probe_latency", ClientImpl::probe_latency);
     MAA_BIND_GETTER(proto, "custom_recognition_list", ClientImpl::get_custom_recognition_list);
     MAA_BIND_GETTER(proto, "custom_action_list", ClientImpl::get_custom_action_list);
 }
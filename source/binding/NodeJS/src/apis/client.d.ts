@@ -14,6 +14,8 @@ declare global {
             get connected(): boolean
             get alive(): boolean
             set timeout(ms: Uint64)
+            // json: { count, failed, min_us, p50_us, p90_us, p99_us, max_us, mean_us }
+            probe_latency(count?: number): Promise<string | null>
             get custom_recognition_list(): string[] | null
             get custom_action_list(): string[] | null
         }
@@ -32,6 +32,7 @@ struct ClientImpl : public maajs::NativeClassBase
     bool get_connected();
     bool get_alive();
     void set_timeout(uint64_t ms);
+    maajs::PromiseType probe_latency(maajs::OptionalParam<uint32_t> count);
     std::optional<std::vector<std::string>> get_custom_recognition_list();
     std::optional<std::vector<std::string>> get_custom_action_list();
 
@@ -73,6 +73,12 @@ void ControllerImpl::destroy()
     }
     sinks.clear();
 
+    for (const auto& [id, ctx] : batched_sinks) {
+        MaaControllerRemoveSink(controller, id);
+        delete ctx;
+    }
+    batched_sinks.clear();
+
     if (own) {
         MaaControllerDestroy(controller);
     }
@@ -101,6 +107,11 @@ void ControllerImpl::remove_sink(MaaSinkId id)
         delete it->second;
         sinks.erase(it);
     }
+    else if (auto it = batched_sinks.find(id); it != batched_sinks.end()) {
+        MaaControllerRemoveSink(controller, id);
+        delete it->second;
+        batched_sinks.erase(it);
+    }
 }
 
 void ControllerImpl::clear_sinks()
@@ -110,6 +121,38 @@ void ControllerImpl::clear_sinks()
         delete ctx;
     }
     sinks.clear();
+    for (const auto& [_, ctx] : batched_sinks) {
+        delete ctx;
+    }
+    batched_sinks.clear();
+}
+
+MaaSinkId ControllerImpl::add_batched_sink(
+    maajs::FunctionType sink,
+    maajs::OptionalParam<uint32_t> max_count,
+    maajs::OptionalParam<uint32_t> max_delay,
+    maajs::OptionalParam<uint32_t> capacity)
+{
+    auto locator = [](maajs::EnvType env, void* source) {
+        return ControllerImpl::locate_object(env, reinterpret_cast<MaaController*>(source));
+    };
+    auto ctx = new BatchedSinkContext(sink, "ControllerSink", "Controller.", locator, max_count, max_delay, capacity);
+    auto id = MaaControllerAddSink(controller, BatchedSink, ctx);
+    if (id != MaaInvalidId) {
+        batched_sinks[id] = ctx;
+    }
+    else {
+        delete ctx;
+    }
+    return id;
+}
+
+maajs::ValueType ControllerImpl::get_sink_stats(maajs::EnvType env, MaaSinkId id)
+{
+    if (auto it = batched_sinks.find(id); it != batched_sinks.end()) {
+        return it->second->stats_value(env);
+    }
+    return env.Null();
 }
 
 void ControllerImpl::set_screenshot_target_long_side(int32_t value)
@@ -376,6 +419,8 @@ void ControllerImpl::init_proto(maajs::ObjectType proto, maajs::FunctionType)
     MAA_BIND_SETTER(proto, "screenshot_use_raw_size", ControllerImpl::set_screenshot_use_raw_size);
     MAA_BIND_SETTER(proto, "screenshot_resize_method", ControllerImpl::set_screenshot_resize_method);
     MAA_BIND_FUNC(proto, "clear_sinks", ControllerImpl::clear_sinks);
+    MAA_BIND_FUNC(proto, "add_batched_sink", ControllerImpl::add_batched_sink);
+    MAA_BIND_FUNC(proto, "get_sink_stats", ControllerImpl::get_sink_stats);
     MAA_BIND_FUNC(proto, "post_connection", ControllerImpl::post_connection);
     MAA_BIND_FUNC(proto, "post_click", ControllerImpl::post_click);
     MAA_BIND_FUNC(proto, "post_swipe", ControllerImpl::post_swipe);
@@ -419,6 +464,27 @@ std::string AdbControllerImpl::agent_path()
     return folder.parent_path().append("maa-node").append("agent").string();
 }
 
+#ifdef MAA_JS_WITH_TOOLKIT
+static std::vector<AdbDevice> get_adb_devices(const MaaToolkitAdbDeviceList* lst)
+{
+    std::vector<AdbDevice> result;
+    auto size = MaaToolkitAdbDeviceListSize(lst);
+    result.reserve(size);
+    for (size_t i = 0; i < size; i++) {
+        auto dev = MaaToolkitAdbDeviceListAt(lst, i);
+        result.push_back(
+            std::make_tuple(
+                std::string(MaaToolkitAdbDeviceGetName(dev)),
+                std::string(MaaToolkitAdbDeviceGetAdbPath(dev)),
+                std::string(MaaToolkitAdbDeviceGetAddress(dev)),
+                MaaToolkitAdbDeviceGetScreencapMethods(dev),
+                MaaToolkitAdbDeviceGetInputMethods(dev),
+                std::string(MaaToolkitAdbDeviceGetConfig(dev))));
+    }
+    return result;
+}
+#endif
+
 maajs::PromiseType AdbControllerImpl::find(maajs::EnvType env, maajs::OptionalParam<std::string> adb)
 {
 #ifdef MAA_JS_WITH_TOOLKIT
@@ -437,20 +503,7 @@ maajs::PromiseType AdbControllerImpl::find(maajs::EnvType env, maajs::OptionalPa
             return std::nullopt;
         }
 
-        std::vector<AdbDevice> result;
-        auto size = MaaToolkitAdbDeviceListSize(lst);
-        result.reserve(size);
-        for (size_t i = 0; i < size; i++) {
-            auto dev = MaaToolkitAdbDeviceListAt(lst, i);
-            result.push_back(
-                std::make_tuple(
-                    std::string(MaaToolkitAdbDeviceGetName(dev)),
-                    std::string(MaaToolkitAdbDeviceGetAdbPath(dev)),
-                    std::string(MaaToolkitAdbDeviceGetAddress(dev)),
-                    MaaToolkitAdbDeviceGetScreencapMethods(dev),
-                    MaaToolkitAdbDeviceGetInputMethods(dev),
-                    std::string(MaaToolkitAdbDeviceGetConfig(dev))));
-        }
+        auto result = get_adb_devices(lst);
         MaaToolkitAdbDeviceListDestroy(lst);
 
         return result;
@@ -464,6 +517,31 @@ maajs::PromiseType AdbControllerImpl::find(maajs::EnvType env, maajs::OptionalPa
 #endif
 }
 
+maajs::PromiseType AdbControllerImpl::watch(maajs::EnvType env)
+{
+#ifdef MAA_JS_WITH_TOOLKIT
+    using Result = std::optional<std::tuple<std::vector<AdbDevice>, std::vector<AdbDevice>>>;
+    auto worker = new maajs::AsyncWork<Result>(env, []() -> Result {
+        auto added = MaaToolkitAdbDeviceListCreate();
+        auto removed = MaaToolkitAdbDeviceListCreate();
+
+        Result result;
+        if (MaaToolkitAdbDeviceWatch(added, removed)) {
+            result = std::make_tuple(get_adb_devices(added), get_adb_devices(removed));
+        }
+
+        MaaToolkitAdbDeviceListDestroy(added);
+        MaaToolkitAdbDeviceListDestroy(removed);
+        return result;
+    });
+    worker->Queue();
+    return worker->Promise();
+#else
+    std::ignore = env;
+    throw_toolkit_unavailable("AdbController.watch");
+#endif
+}
+
 AdbControllerImpl* AdbControllerImpl::ctor(const maajs::CallbackInfo& info)
 {
     auto [adb_path, address, screencap_methods, input_methods, config, agent] = maajs::UnWrapArgs<AdbControllerCtorParam, void>(info);
@@ -484,6 +562,7 @@ void AdbControllerImpl::init_proto(maajs::ObjectType, maajs::FunctionType ctor)
 {
     MAA_BIND_FUNC(ctor, "agent_path", agent_path);
     MAA_BIND_FUNC(ctor, "find", find);
+    MAA_BIND_FUNC(ctor, "watch", watch);
 }
 
 maajs::ValueType load_adb_controller(maajs::EnvType env)
@@ -147,6 +147,13 @@ declare global {
             add_sink(cb: (ctrl: Controller, msg: ControllerNotify) => MaybePromise<void>): SinkId
             remove_sink(id: SinkId): void
             clear_sinks(): void
+            add_batched_sink(
+                cb: (events: [Controller, ControllerNotify][]) => MaybePromise<void>,
+                max_count?: number,
+                max_delay?: number,
+                capacity?: number,
+            ): SinkId
+            get_sink_stats(id: SinkId): { events: number; batches: number; dropped: number; max_pending: number } | null
 
             set screenshot_target_long_side(value: number)
             set screenshot_target_short_side(value: number)
@@ -241,6 +248,7 @@ declare global {
 
             static agent_path(): string
             static find(adb?: string): Promise<AdbDevice[] | null>
+            static watch(): Promise<[added: AdbDevice[], removed: AdbDevice[]] | null>
         }
 
         type DesktopDevice = [handle: DesktopHandle, class_name: string, window_name: string]
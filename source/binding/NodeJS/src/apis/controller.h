@@ -8,6 +8,8 @@
 #include <MaaFramework/MaaAPI.h>
 
 #include "../foundation/spec.h"
+
+class BatchedSinkContext;
 #include "job.h"
 
 struct ImageJobImpl : public JobImpl
@@ -25,6 +27,7 @@ struct ControllerImpl : public maajs::NativeClassBase
     MaaController* controller { };
     bool own = false;
     std::map<MaaSinkId, maajs::CallbackContext*> sinks { };
+    std::map<MaaSinkId, BatchedSinkContext*> batched_sinks { };
 
     ControllerImpl() = default;
     ControllerImpl(MaaController* ctrl, bool own);
@@ -33,6 +36,12 @@ struct ControllerImpl : public maajs::NativeClassBase
     MaaSinkId add_sink(maajs::FunctionType sink);
     void remove_sink(MaaSinkId id);
     void clear_sinks();
+    MaaSinkId add_batched_sink(
+        maajs::FunctionType sink,
+        maajs::OptionalParam<uint32_t> max_count,
+        maajs::OptionalParam<uint32_t> max_delay,
+        maajs::OptionalParam<uint32_t> capacity);
+    maajs::ValueType get_sink_stats(maajs::EnvType env, MaaSinkId id);
     void set_screenshot_target_long_side(int32_t value);
     void set_screenshot_target_short_side(int32_t value);
     void set_screenshot_use_raw_size(bool value);
@@ -100,6 +109,7 @@ struct AdbControllerImpl : public ControllerImpl
 
     static std::string agent_path();
     static maajs::PromiseType find(maajs::EnvType env, maajs::OptionalParam<std::string> adb);
+    static maajs::PromiseType watch(maajs::EnvType env);
 
     constexpr static char name[] = "AdbController";
 
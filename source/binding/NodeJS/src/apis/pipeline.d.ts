@@ -454,6 +454,7 @@ declare global {
             target_offset?: Rect
             threshold?: number
             method?: 1 | 3 | 5
+            block_size?: number
             rate_limit?: number
             timeout?: number
         }
@@ -33,6 +33,12 @@ void ResourceImpl::destroy()
     }
     sinks.clear();
 
+    for (const auto& [id, ctx] : batched_sinks) {
+        MaaResourceRemoveSink(resource, id);
+        delete ctx;
+    }
+    batched_sinks.clear();
+
     for (const auto& [key, ctx] : recos) {
         MaaResourceUnregisterCustomRecognition(resource, key.c_str());
         delete ctx;
@@ -73,6 +79,11 @@ void ResourceImpl::remove_sink(MaaSinkId id)
         delete it->second;
         sinks.erase(it);
     }
+    else if (auto it = batched_sinks.find(id); it != batched_sinks.end()) {
+        MaaResourceRemoveSink(resource, id);
+        delete it->second;
+        batched_sinks.erase(it);
+    }
 }
 
 void ResourceImpl::clear_sinks()
@@ -82,6 +93,38 @@ void ResourceImpl::clear_sinks()
         delete ctx;
     }
     sinks.clear();
+    for (const auto& [_, ctx] : batched_sinks) {
+        delete ctx;
+    }
+    batched_sinks.clear();
+}
+
+MaaSinkId ResourceImpl::add_batched_sink(
+    maajs::FunctionType sink,
+    maajs::OptionalParam<uint32_t> max_count,
+    maajs::OptionalParam<uint32_t> max_delay,
+    maajs::OptionalParam<uint32_t> capacity)
+{
+    auto locator = [](maajs::EnvType env, void* source) {
+        return ResourceImpl::locate_object(env, reinterpret_cast<MaaResource*>(source));
+    };
+    auto ctx = new BatchedSinkContext(sink, "ResourceSink", "Resource.", locator, max_count, max_delay, capacity);
+    auto id = MaaResourceAddSink(resource, BatchedSink, ctx);
+    if (id != MaaInvalidId) {
+        batched_sinks[id] = ctx;
+    }
+    else {
+        delete ctx;
+    }
+    return id;
+}
+
+maajs::ValueType ResourceImpl::get_sink_stats(maajs::EnvType env, MaaSinkId id)
+{
+    if (auto it = batched_sinks.find(id); it != batched_sinks.end()) {
+        return it->second->stats_value(env);
+    }
+    return env.Null();
 }
 
 void ResourceImpl::set_inference_device(std::variant<std::string, int32_t> id)
@@ -132,6 +175,36 @@ void ResourceImpl::set_inference_execution_provider(std::string provider)
     }
 }
 
+void ResourceImpl::set_template_warm_up(bool value)
+{
+    if (!MaaResourceSetOption(resource, MaaResOption_TemplateWarmUp, &value, sizeof(value))) {
+        throw maajs::MaaError { "Resource set template_warm_up failed" };
+    }
+}
+
+void ResourceImpl::set_template_cache_budget(std::variant<int32_t, int64_t> bytes)
+{
+    int64_t value = std::visit([](auto v) { return static_cast<int64_t>(v); }, bytes);
+    if (!MaaResourceSetOption(resource, MaaResOption_TemplateCacheBudget, &value, sizeof(value))) {
+        throw maajs::MaaError { "Resource set template_cache_budget failed" };
+    }
+}
+
+void ResourceImpl::set_template_pinned_nodes(maajs::ValueType nodes)
+{
+    auto value = maajs::JsonStringify(env, nodes);
+    if (!MaaResourceSetOption(resource, MaaResOption_TemplatePinnedNodes, value.data(), value.size())) {
+        throw maajs::MaaError { "Resource set template_pinned_nodes failed" };
+    }
+}
+
+void ResourceImpl::set_compiled_bundle_verify_sources(bool value)
+{
+    if (!MaaResourceSetOption(resource, MaaResOption_CompiledBundleVerifySources, &value, sizeof(value))) {
+        throw maajs::MaaError { "Resource set compiled_bundle_verify_sources failed" };
+    }
+}
+
 void ResourceImpl::register_custom_recognition(std::string key, maajs::FunctionType func)
 {
     auto ctx = new maajs::CallbackContext(func, "CustomReco");
@@ -354,6 +427,15 @@ std::optional<std::vector<std::string>> ResourceImpl::get_custom_action_list()
     return buffer.as_vector([](StringBufferRefer buf) { return buf.str(); });
 }
 
+std::optional<maajs::ValueType> ResourceImpl::get_template_cache_stats()
+{
+    StringBuffer buffer;
+    if (!MaaResourceGetTemplateCacheStats(resource, buffer)) {
+        return std::nullopt;
+    }
+    return maajs::JsonParse(env, buffer.str());
+}
+
 std::string ResourceImpl::to_string()
 {
     return std::format(" handle = {:#018x}, {} ", reinterpret_cast<uintptr_t>(resource), own ? "owned" : "rented");
@@ -401,12 +483,19 @@ ResourceImpl* ResourceImpl::ctor(const maajs::CallbackInfo& info)
     }
 }
 
-void ResourceImpl::init_proto(maajs::ObjectType proto, maajs::FunctionType)
+bool ResourceImpl::compile_bundle(std::string bundle_path, std::string output_path)
+{
+    return MaaResourceCompileBundle(bundle_path.c_str(), output_path.c_str());
+}
+
+void ResourceImpl::init_proto(maajs::ObjectType proto, maajs::FunctionType ctor)
 {
     MAA_BIND_FUNC(proto, "destroy", ResourceImpl::destroy);
     MAA_BIND_FUNC(proto, "add_sink", ResourceImpl::add_sink);
     MAA_BIND_FUNC(proto, "remove_sink", ResourceImpl::remove_sink);
     MAA_BIND_FUNC(proto, "clear_sinks", ResourceImpl::clear_sinks);
+    MAA_BIND_FUNC(proto, "add_batched_sink", ResourceImpl::add_batched_sink);
+    MAA_BIND_FUNC(proto, "get_sink_stats", ResourceImpl::get_sink_stats);
     MAA_BIND_FUNC(proto, "register_custom_recognition", ResourceImpl::register_custom_recognition);
     MAA_BIND_FUNC(proto, "unregister_custom_recognition", ResourceImpl::unregister_custom_recognition);
     MAA_BIND_FUNC(proto, "clear_custom_recognition", ResourceImpl::clear_custom_recognition);
@@ -419,6 +508,10 @@ void ResourceImpl::init_proto(maajs::ObjectType proto, maajs::FunctionType)
     MAA_BIND_FUNC(proto, "post_image", ResourceImpl::post_image);
     MAA_BIND_SETTER(proto, "inference_device", ResourceImpl::set_inference_device);
     MAA_BIND_SETTER(proto, "inference_execution_provider", ResourceImpl::set_inference_execution_provider);
+    MAA_BIND_SETTER(proto, "template_warm_up", ResourceImpl::set_template_warm_up);
+    MAA_BIND_SETTER(proto, "template_cache_budget", ResourceImpl::set_template_cache_budget);
+    MAA_BIND_SETTER(proto, "template_pinned_nodes", ResourceImpl::set_template_pinned_nodes);
+    MAA_BIND_SETTER(proto, "compiled_bundle_verify_sources", ResourceImpl::set_compiled_bundle_verify_sources);
     MAA_BIND_FUNC(proto, "override_pipeline", ResourceImpl::override_pipeline);
     MAA_BIND_FUNC(proto, "override_next", ResourceImpl::override_next);
     MAA_BIND_FUNC(proto, "override_image", ResourceImpl::override_image);
@@ -434,6 +527,9 @@ void ResourceImpl::init_proto(maajs::ObjectType proto, maajs::FunctionType)
     MAA_BIND_GETTER(proto, "node_list", ResourceImpl::get_node_list);
     MAA_BIND_GETTER(proto, "custom_recognition_list", ResourceImpl::get_custom_recognition_list);
     MAA_BIND_GETTER(proto, "custom_action_list", ResourceImpl::get_custom_action_list);
+    MAA_BIND_GETTER(proto, "template_cache_stats", ResourceImpl::get_template_cache_stats);
+
+    MAA_BIND_FUNC(ctor, "compile_bundle", ResourceImpl::compile_bundle);
 }
 
 maajs::ValueType load_resource(maajs::EnvType env)
@@ -5,6 +5,8 @@ declare global {
             res_id: number // ResId
             path: string
             hash: string
+            /** 各阶段耗时（毫秒），仅在 Succeeded / Failed 中存在 */
+            timings?: Record<string, number>
         }
 
         class Resource {
@@ -13,11 +15,23 @@ declare global {
             add_sink(cb: (res: Resource, msg: ResourceNotify) => MaybePromise<void>): SinkId
             remove_sink(id: SinkId): void
             clear_sinks(): void
+            add_batched_sink(
+                cb: (events: [Resource, ResourceNotify][]) => MaybePromise<void>,
+                max_count?: number,
+                max_delay?: number,
+                capacity?: number,
+            ): SinkId
+            get_sink_stats(id: SinkId): { events: number; batches: number; dropped: number; max_pending: number } | null
 
             set inference_device(id: 'CPU' | 'Auto' | number)
             set inference_execution_provider(
                 provider: 'Auto' | 'CPU' | 'DirectML' | 'CoreML' | 'CUDA',
             )
+            set template_warm_up(value: boolean)
+            /** 字节数，0 表示不限 */
+            set template_cache_budget(bytes: number | string)
+            set template_pinned_nodes(nodes: string[])
+            set compiled_bundle_verify_sources(value: boolean)
 
             register_custom_recognition(name: string, func: CustomRecognitionCallback): void
             unregister_custom_recognition(name: string): void
@@ -50,6 +64,17 @@ declare global {
             get node_list(): string[] | null
             get custom_recognition_list(): string[] | null
             get custom_action_list(): string[] | null
+            get template_cache_stats(): {
+                budget: number
+                bytes: number
+                entries: number
+                pinned: number
+                hits: number
+                misses: number
+                evictions: number
+            } | null
+
+            static compile_bundle(bundle_path: string, output_path: string): boolean
         }
     }
 }
@@ -9,11 +9,14 @@
 
 #include "../foundation/spec.h"
 
+class BatchedSinkContext;
+
 struct ResourceImpl : public maajs::NativeClassBase
 {
     MaaResource* resource { };
     bool own = false;
     std::map<MaaSinkId, maajs::CallbackContext*> sinks { };
+    std::map<MaaSinkId, BatchedSinkContext*> batched_sinks { };
     std::map<std::string, maajs::CallbackContext*> recos { };
     std::map<std::string, maajs::CallbackContext*> acts { };
 
@@ -24,8 +27,18 @@ struct ResourceImpl : public maajs::NativeClassBase
     MaaSinkId add_sink(maajs::FunctionType sink);
     void remove_sink(MaaSinkId id);
     void clear_sinks();
+    MaaSinkId add_batched_sink(
+        maajs::FunctionType sink,
+        maajs::OptionalParam<uint32_t> max_count,
+        maajs::OptionalParam<uint32_t> max_delay,
+        maajs::OptionalParam<uint32_t> capacity);
+    maajs::ValueType get_sink_stats(maajs::EnvType env, MaaSinkId id);
     void set_inference_device(std::variant<std::string, int32_t> id);
     void set_inference_execution_provider(std::string provider);
+    void set_template_warm_up(bool value);
+    void set_template_cache_budget(std::variant<int32_t, int64_t> bytes);
+    void set_template_pinned_nodes(maajs::ValueType nodes);
+    void set_compiled_bundle_verify_sources(bool value);
     void register_custom_recognition(std::string name, maajs::FunctionType func);
     void unregister_custom_recognition(std::string name);
     void clear_custom_recognition();
@@ -51,16 +64,18 @@ struct ResourceImpl : public maajs::NativeClassBase
     std::optional<std::vector<std::string>> get_node_list();
     std::optional<std::vector<std::string>> get_custom_recognition_list();
     std::optional<std::vector<std::string>> get_custom_action_list();
+    std::optional<maajs::ValueType> get_template_cache_stats();
 
     std::string to_string() override;
 
     static maajs::ValueType locate_object(maajs::EnvType env, MaaResource* res);
+    static bool compile_bundle(std::string bundle_path, std::string output_path);
 
     constexpr static char name[] = "Resource";
 
     virtual void init_bind(maajs::ObjectType self) override;
     virtual void gc_mark(maajs::NativeMarkerFunc marker) override;
     static ResourceImpl* ctor(const maajs::CallbackInfo&);
-    static void init_proto(maajs::ObjectType proto, maajs::FunctionType);
+    static void init_proto(maajs::ObjectType proto, maajs::FunctionType ctor);
 };
 
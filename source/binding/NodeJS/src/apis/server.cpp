@@ -1,3 +1,4 @@
+#include "buffer.h"
 #include "loader.h"
 
 #include <MaaAgentServer/MaaAgentServerAPI.h>
@@ -52,6 +53,26 @@ static void add_context_sink(maajs::FunctionType func)
     ExtContext::get(func.Env())->globalCallbacks.push_back(std::move(ctx));
 }
 
+static void set_event_subscription(std::vector<std::string> msg_filter)
+{
+    StringListBuffer buffer;
+    buffer.set_vector(msg_filter, [](auto str) {
+        StringBuffer buf;
+        buf.set(str);
+        return buf;
+    });
+    if (!MaaAgentServerSetEventSubscription(buffer)) {
+        throw maajs::MaaError { "Server set_event_subscription failed" };
+    }
+}
+
+static void set_concurrency(uint32_t concurrency)
+{
+    if (!MaaAgentServerSetConcurrency(static_cast<MaaSize>(concurrency))) {
+        throw maajs::MaaError { "Server set_concurrency failed" };
+    }
+}
+
 static maajs::PromiseType start_up(maajs::EnvType env, std::string identifier)
 {
     auto work = new maajs::AsyncWork<bool>(env, [identifier]() { return MaaAgentServerStartUp(identifier.c_str()); });
@@ -94,6 +115,8 @@ maajs::ValueType load_server(maajs::EnvType env)
     MAA_BIND_FUNC(obj, "add_controller_sink", add_controller_sink);
     MAA_BIND_FUNC(obj, "add_tasker_sink", add_tasker_sink);
     MAA_BIND_FUNC(obj, "add_context_sink", add_context_sink);
+    MAA_BIND_FUNC(obj, "set_event_subscription", set_event_subscription);
+    MAA_BIND_FUNC(obj, "set_concurrency", set_concurrency);
     MAA_BIND_FUNC(obj, "start_up", start_up);
     MAA_BIND_FUNC(obj, "shut_down", shut_down);
     MAA_BIND_FUNC(obj, "join", join);
@@ -12,6 +12,8 @@ declare global {
             add_context_sink(
                 cb: (ctx: Context, msg: TaskerContextNotify) => MaybePromise<void>,
             ): void
+            set_event_subscription(msg_filter: string[]): void
+            set_concurrency(concurrency: number): void
 
             start_up(identifier: string): Promise<boolean>
             shut_down(): Promise<void>
@@ -6,6 +6,7 @@
 
 #include "../foundation/spec.h"
 #include "callback.h"
+#include "context.h"
 #include "convert.h"
 #include "ext.h"
 
@@ -66,6 +67,18 @@ void TaskerImpl::destroy()
     }
     ctxSinks.clear();
 
+    for (const auto& [id, ctx] : batchedSinks) {
+        MaaTaskerRemoveSink(tasker, id);
+        delete ctx;
+    }
+    batchedSinks.clear();
+
+    for (const auto& [id, ctx] : batchedCtxSinks) {
+        MaaTaskerRemoveContextSink(tasker, id);
+        delete ctx;
+    }
+    batchedCtxSinks.clear();
+
     if (own) {
         MaaTaskerDestroy(tasker);
     }
@@ -94,6 +107,11 @@ void TaskerImpl::remove_sink(MaaSinkId id)
         delete it->second;
         sinks.erase(it);
     }
+    else if (auto it = batchedSinks.find(id); it != batchedSinks.end()) {
+        MaaTaskerRemoveSink(tasker, id);
+        delete it->second;
+        batchedSinks.erase(it);
+    }
 }
 
 void TaskerImpl::clear_sinks()
@@ -103,6 +121,10 @@ void TaskerImpl::clear_sinks()
         delete ctx;
     }
     sinks.clear();
+    for (const auto& [_, ctx] : batchedSinks) {
+        delete ctx;
+    }
+    batchedSinks.clear();
 }
 
 MaaSinkId TaskerImpl::add_context_sink(maajs::FunctionType sink)
@@ -125,6 +147,11 @@ void TaskerImpl::remove_context_sink(MaaSinkId id)
         delete it->second;
         ctxSinks.erase(it);
     }
+    else if (auto it = batchedCtxSinks.find(id); it != batchedCtxSinks.end()) {
+        MaaTaskerRemoveContextSink(tasker, id);
+        delete it->second;
+        batchedCtxSinks.erase(it);
+    }
 }
 
 void TaskerImpl::clear_context_sinks()
@@ -134,6 +161,93 @@ void TaskerImpl::clear_context_sinks()
         delete ctx;
     }
     ctxSinks.clear();
+    for (const auto& [_, ctx] : batchedCtxSinks) {
+        delete ctx;
+    }
+    batchedCtxSinks.clear();
+}
+
+MaaSinkId TaskerImpl::add_batched_sink(
+    maajs::FunctionType sink,
+    maajs::OptionalParam<uint32_t> max_count,
+    maajs::OptionalParam<uint32_t> max_delay,
+    maajs::OptionalParam<uint32_t> capacity)
+{
+    auto locator = [](maajs::EnvType env, void* source) {
+        return TaskerImpl::locate_object(env, reinterpret_cast<MaaTasker*>(source));
+    };
+    auto ctx = new BatchedSinkContext(sink, "TaskerSink", "Tasker.", locator, max_count, max_delay, capacity);
+    auto id = MaaTaskerAddSink(tasker, BatchedSink, ctx);
+    if (id != MaaInvalidId) {
+        batchedSinks[id] = ctx;
+    }
+    else {
+        delete ctx;
+    }
+    return id;
+}
+
+maajs::ValueType TaskerImpl::get_sink_stats(maajs::EnvType env, MaaSinkId id)
+{
+    if (auto it = batchedSinks.find(id); it != batchedSinks.end()) {
+        return it->second->stats_value(env);
+    }
+    return env.Null();
+}
+
+MaaSinkId TaskerImpl::add_batched_context_sink(
+    maajs::FunctionType sink,
+    maajs::OptionalParam<uint32_t> max_count,
+    maajs::OptionalParam<uint32_t> max_delay,
+    maajs::OptionalParam<uint32_t> capacity)
+{
+    // 批量投递时 Context 多半已销毁, 只交出 task id
+    auto snapshot = [](void* source) -> uint64_t {
+        return static_cast<uint64_t>(MaaContextGetTaskId(reinterpret_cast<MaaContext*>(source)));
+    };
+    auto ctx = new BatchedSinkContext(sink, "ContextSink", "Node.", nullptr, max_count, max_delay, capacity, snapshot);
+    auto id = MaaTaskerAddContextSink(tasker, BatchedSink, ctx);
+    if (id != MaaInvalidId) {
+        batchedCtxSinks[id] = ctx;
+    }
+    else {
+        delete ctx;
+    }
+    return id;
+}
+
+maajs::ValueType TaskerImpl::get_context_sink_stats(maajs::EnvType env, MaaSinkId id)
+{
+    if (auto it = batchedCtxSinks.find(id); it != batchedCtxSinks.end()) {
+        return it->second->stats_value(env);
+    }
+    return env.Null();
+}
+
+void TaskerImpl::set_sink_subscription(MaaSinkId id, std::vector<std::string> msg_filter)
+{
+    StringListBuffer buffer;
+    buffer.set_vector(msg_filter, [](auto str) {
+        StringBuffer buf;
+        buf.set(str);
+        return buf;
+    });
+    if (!MaaTaskerSetSinkSubscription(tasker, id, buffer)) {
+        throw maajs::MaaError { "Tasker set_sink_subscription failed" };
+    }
+}
+
+void TaskerImpl::set_context_sink_subscription(MaaSinkId id, std::vector<std::string> msg_filter)
+{
+    StringListBuffer buffer;
+    buffer.set_vector(msg_filter, [](auto str) {
+        StringBuffer buf;
+        buf.set(str);
+        return buf;
+    });
+    if (!MaaTaskerSetContextSinkSubscription(tasker, id, buffer)) {
+        throw maajs::MaaError { "Tasker set_context_sink_subscription failed" };
+    }
 }
 
 maajs::ValueType
@@ -383,6 +497,20 @@ std::optional<MaaNodeId> TaskerImpl::latest_node(std::string node_name)
     }
 }
 
+maajs::ValueType TaskerImpl::latency_stats()
+{
+    StringBuffer buffer;
+    if (!MaaTaskerGetLatencyStats(tasker, buffer)) {
+        throw maajs::MaaError { "Tasker latency_stats failed" };
+    }
+    return maajs::JsonParse(env, buffer.str());
+}
+
+void TaskerImpl::clear_latency_stats()
+{
+    MaaTaskerClearLatencyStats(tasker);
+}
+
 std::string TaskerImpl::to_string()
 {
     return std::format(" handle = {:#018x}, {} ", reinterpret_cast<uintptr_t>(tasker), own ? "owned" : "rented");
@@ -442,6 +570,12 @@ void TaskerImpl::init_proto(maajs::ObjectType proto, maajs::FunctionType)
     MAA_BIND_FUNC(proto, "add_context_sink", TaskerImpl::add_context_sink);
     MAA_BIND_FUNC(proto, "remove_context_sink", TaskerImpl::remove_context_sink);
     MAA_BIND_FUNC(proto, "clear_context_sinks", TaskerImpl::clear_context_sinks);
+    MAA_BIND_FUNC(proto, "add_batched_sink", TaskerImpl::add_batched_sink);
+    MAA_BIND_FUNC(proto, "add_batched_context_sink", TaskerImpl::add_batched_context_sink);
+    MAA_BIND_FUNC(proto, "get_sink_stats", TaskerImpl::get_sink_stats);
+    MAA_BIND_FUNC(proto, "get_context_sink_stats", TaskerImpl::get_context_sink_stats);
+    MAA_BIND_FUNC(proto, "set_sink_subscription", TaskerImpl::set_sink_subscription);
+    MAA_BIND_FUNC(proto, "set_context_sink_subscription", TaskerImpl::set_context_sink_subscription);
     MAA_BIND_FUNC(proto, "post_task", TaskerImpl::post_task);
     MAA_BIND_FUNC(proto, "post_recognition", TaskerImpl::post_recognition);
     MAA_BIND_FUNC(proto, "post_action", TaskerImpl::post_action);
@@ -460,6 +594,8 @@ void TaskerImpl::init_proto(maajs::ObjectType proto, maajs::FunctionType)
     MAA_BIND_FUNC(proto, "node_detail", TaskerImpl::node_detail);
     MAA_BIND_FUNC(proto, "task_detail", TaskerImpl::task_detail);
     MAA_BIND_FUNC(proto, "latest_node", TaskerImpl::latest_node);
+    MAA_BIND_FUNC(proto, "latency_stats", TaskerImpl::latency_stats);
+    MAA_BIND_FUNC(proto, "clear_latency_stats", TaskerImpl::clear_latency_stats);
 }
 
 maajs::ValueType load_tasker(maajs::EnvType env)
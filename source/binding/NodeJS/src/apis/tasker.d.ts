@@ -52,6 +52,16 @@ declare global {
             detail: ActionDetailObject
         }
 
+        type LatencyHistogram = {
+            count: number
+            avg?: number // ms
+            min?: number // ms
+            max?: number // ms
+            p50?: number // ms
+            p90?: number // ms
+            p99?: number // ms
+        }
+
         type TaskerNotify = {
             msg: NotifyMessage<'Task'>
             task_id: number // TaskId
@@ -134,6 +144,22 @@ declare global {
             ): SinkId
             remove_context_sink(id: SinkId): void
             clear_context_sinks(): void
+            add_batched_sink(
+                cb: (events: [Tasker, TaskerNotify][]) => MaybePromise<void>,
+                max_count?: number,
+                max_delay?: number,
+                capacity?: number,
+            ): SinkId
+            add_batched_context_sink(
+                cb: (events: [TaskId, TaskerContextNotify][]) => MaybePromise<void>, // context may be gone by delivery, only its task id is given
+                max_count?: number,
+                max_delay?: number,
+                capacity?: number,
+            ): SinkId
+            get_sink_stats(id: SinkId): { events: number; batches: number; dropped: number; max_pending: number } | null
+            get_context_sink_stats(id: SinkId): { events: number; batches: number; dropped: number; max_pending: number } | null
+            set_sink_subscription(id: SinkId, msg_filter: string[]): void
+            set_context_sink_subscription(id: SinkId, msg_filter: string[]): void
             post_task(
                 entry: string,
                 pipeline_override?: Record<string, unknown> | Record<string, unknown>[],
@@ -169,6 +195,8 @@ declare global {
             node_detail(id: NodeId): NodeDetail | null
             task_detail(id: TaskId): TaskDetail | null
             latest_node(node_name: string): NodeId | null
+            latency_stats(): Record<string, Record<string, LatencyHistogram>>
+            clear_latency_stats(): void
         }
     }
 }
@@ -25,6 +25,8 @@ struct TaskerImpl : public maajs::NativeClassBase
     bool own = false;
     std::map<MaaSinkId, maajs::CallbackContext*> sinks { };
     std::map<MaaSinkId, maajs::CallbackContext*> ctxSinks { };
+    std::map<MaaSinkId, BatchedSinkContext*> batchedSinks { };
+    std::map<MaaSinkId, BatchedSinkContext*> batchedCtxSinks { };
 
     TaskerImpl() = default;
     TaskerImpl(MaaTasker* res, bool own);
@@ -36,6 +38,20 @@ struct TaskerImpl : public maajs::NativeClassBase
     MaaSinkId add_context_sink(maajs::FunctionType sink);
     void remove_context_sink(MaaSinkId id);
     void clear_context_sinks();
+    MaaSinkId add_batched_sink(
+        maajs::FunctionType sink,
+        maajs::OptionalParam<uint32_t> max_count,
+        maajs::OptionalParam<uint32_t> max_delay,
+        maajs::OptionalParam<uint32_t> capacity);
+    MaaSinkId add_batched_context_sink(
+        maajs::FunctionType sink,
+        maajs::OptionalParam<uint32_t> max_count,
+        maajs::OptionalParam<uint32_t> max_delay,
+        maajs::OptionalParam<uint32_t> capacity);
+    maajs::ValueType get_sink_stats(maajs::EnvType env, MaaSinkId id);
+    maajs::ValueType get_context_sink_stats(maajs::EnvType env, MaaSinkId id);
+    void set_sink_subscription(MaaSinkId id, std::vector<std::string> msg_filter);
+    void set_context_sink_subscription(MaaSinkId id, std::vector<std::string> msg_filter);
     maajs::ValueType post_task(maajs::ValueType self, maajs::EnvType env, std::string entry, maajs::OptionalParam<maajs::ValueType> param);
     maajs::ValueType post_recognition(
         maajs::ValueType self,
@@ -67,6 +83,8 @@ struct TaskerImpl : public maajs::NativeClassBase
     std::optional<maajs::ValueType> node_detail(MaaNodeId id);
     std::optional<maajs::ValueType> task_detail(MaaTaskId id);
     std::optional<MaaNodeId> latest_node(std::string node_name);
+    maajs::ValueType latency_stats();
+    void clear_latency_stats();
 
     std::string to_string() override;
 
@@ -1,6 +1,8 @@
 import ctypes
-from typing import TYPE_CHECKING, Callable
+import json
+from typing import TYPE_CHECKING, Callable, Optional
 
+from ..buffer import StringListBuffer
 from ..define import *
 from ..event_sink import EventSink
 from ..library import Library
@@ -76,13 +78,22 @@ class AgentServer:
         # avoid gc
         AgentServer._custom_recognition_holder[name] = recognition
 
-        return bool(
+        ret = bool(
             Library.agent_server().MaaAgentServerRegisterCustomRecognition(
                 name.encode(),
                 recognition.c_handle,
                 recognition.c_arg,
             )
         )
+        if ret and recognition.has_batch:
+            ret = bool(
+                Library.agent_server().MaaAgentServerRegisterCustomRecognitionBatch(
+                    name.encode(),
+                    recognition.c_batch_handle,
+                    recognition.c_arg,
+                )
+            )
+        return ret
 
     @staticmethod
     def custom_action(
@@ -293,6 +304,63 @@ class AgentServer:
 
         AgentServer._sink_holder[sink_id] = sink
 
+    @staticmethod
+    def set_event_subscription(msg_filter: Optional[list[str]] = None) -> bool:
+        """设置 agent 订阅的事件 / Set events subscribed by the agent
+
+        需在 start_up 前调用。连接时告知客户端，未订阅的事件不会转发过来
+        Must be called before start_up. The client is told on connection and stops forwarding unsubscribed events
+
+        Args:
+            msg_filter: 完整消息名或以 '.' 分隔的前缀，为空则订阅全部 / Full message names or dot-separated prefixes, empty to subscribe all
+
+        Returns:
+            bool: 是否成功 / Whether successful
+        """
+
+        AgentServer._set_api_properties()
+
+        list_buffer = StringListBuffer()
+        list_buffer.set(msg_filter or [])
+
+        return bool(Library.agent_server().MaaAgentServerSetEventSubscription(list_buffer._handle))
+
+    @staticmethod
+    def set_concurrency(concurrency: int) -> bool:
+        """设置同时执行的自定义识别/动作数量，默认为 1 / Set how many custom recognitions/actions may run at the same time, default is 1
+
+        需在 start_up 前调用。同一 context 的请求总是按顺序执行；大于 1 时回调可能在不同线程上被调用
+        Must be called before start_up. Requests from the same context always run in order; callbacks may be called from different threads when greater than 1
+
+        Args:
+            concurrency: 工作线程数，需大于 0 / Number of worker threads, must be greater than 0
+
+        Returns:
+            bool: 是否成功 / Whether successful
+        """
+
+        AgentServer._set_api_properties()
+
+        return bool(Library.agent_server().MaaAgentServerSetConcurrency(concurrency))
+
+    @staticmethod
+    def set_transport_options(options: Optional[dict[str, int]] = None) -> bool:
+        """设置 socket 调优参数 / Set socket tuning options
+
+        需在 start_up 前调用，如 {"reconnect_interval": 100, "reconnect_interval_max": 5000, "heartbeat_interval": 1000}，未给出的保持默认
+        Must be called before start_up, e.g. {"reconnect_interval": 100, "reconnect_interval_max": 5000, "heartbeat_interval": 1000}, missing fields keep the defaults
+
+        Args:
+            options: 调优参数，为空则全部恢复默认 / Tuning options, empty to reset all
+
+        Returns:
+            bool: 是否成功 / Whether successful
+        """
+
+        AgentServer._set_api_properties()
+
+        return bool(Library.agent_server().MaaAgentServerSetTransportOptions(json.dumps(options or {}).encode()))
+
     _api_properties_initialized: bool = False
 
     @staticmethod
@@ -309,6 +377,13 @@ class AgentServer:
             ctypes.c_void_p,
         ]
 
+        Library.agent_server().MaaAgentServerRegisterCustomRecognitionBatch.restype = MaaBool
+        Library.agent_server().MaaAgentServerRegisterCustomRecognitionBatch.argtypes = [
+            ctypes.c_char_p,
+            MaaCustomRecognitionBatchCallback,
+            ctypes.c_void_p,
+        ]
+
         Library.agent_server().MaaAgentServerRegisterCustomAction.restype = MaaBool
         Library.agent_server().MaaAgentServerRegisterCustomAction.argtypes = [
             ctypes.c_char_p,
@@ -316,6 +391,16 @@ class AgentServer:
             ctypes.c_void_p,
         ]
 
+        Library.agent_server().MaaAgentServerSetConcurrency.restype = MaaBool
+        Library.agent_server().MaaAgentServerSetConcurrency.argtypes = [
+            MaaSize,
+        ]
+
+        Library.agent_server().MaaAgentServerSetTransportOptions.restype = MaaBool
+        Library.agent_server().MaaAgentServerSetTransportOptions.argtypes = [
+            ctypes.c_char_p,
+        ]
+
         Library.agent_server().MaaAgentServerStartUp.restype = MaaBool
         Library.agent_server().MaaAgentServerStartUp.argtypes = [
             ctypes.c_char_p,
@@ -353,3 +438,8 @@ class AgentServer:
             MaaEventCallback,
             ctypes.c_void_p,
         ]
+
+        Library.agent_server().MaaAgentServerSetEventSubscription.restype = MaaBool
+        Library.agent_server().MaaAgentServerSetEventSubscription.argtypes = [
+            MaaStringListBufferHandle,
+        ]
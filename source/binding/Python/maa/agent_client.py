@@ -1,5 +1,6 @@
 import ctypes
-from typing import Optional
+import json
+from typing import Any, Optional
 
 from .buffer import StringBuffer, StringListBuffer
 from .controller import Controller
@@ -61,7 +62,7 @@ class AgentClient:
             raise RuntimeError("Failed to create agent client.")
 
     @classmethod
-    def create_tcp(cls, port: int = 0) -> "AgentClient":
+    def create_tcp(cls, port: int = 0, transport_options: Optional[dict[str, int]] = None) -> "AgentClient":
         """创建使用 TCP 连接的 Agent 客户端 / Create Agent client with TCP connection
 
         客户端会监听 127.0.0.1 上的指定端口。如果传入 0 则自动选择可用端口。
@@ -72,6 +73,8 @@ class AgentClient:
 
         Args:
             port: TCP 端口号 (0-65535)，0 表示自动选择 / TCP port number (0-65535), 0 means auto-select
+            transport_options: socket 调优参数，如 {"send_hwm": 1000, "tcp_keepalive": 1, "heartbeat_interval": 1000}，未给出的保持默认 /
+                Socket tuning, e.g. {"send_hwm": 1000, "tcp_keepalive": 1, "heartbeat_interval": 1000}, missing fields keep the defaults
 
         Returns:
             AgentClient: TCP 模式的客户端实例 / Client instance in TCP mode
@@ -85,7 +88,12 @@ class AgentClient:
 
         cls._set_api_properties()
 
-        handle = Library.agent_client().MaaAgentClientCreateTcp(ctypes.c_uint16(port))
+        if transport_options:
+            handle = Library.agent_client().MaaAgentClientCreateTcpV2(
+                ctypes.c_uint16(port), json.dumps(transport_options).encode()
+            )
+        else:
+            handle = Library.agent_client().MaaAgentClientCreateTcp(ctypes.c_uint16(port))
         if not handle:
             raise RuntimeError("Failed to create TCP agent client.")
 
@@ -193,6 +201,23 @@ class AgentClient:
         """
         return bool(Library.agent_client().MaaAgentClientSetTimeout(self._handle, ctypes.c_int64(milliseconds)))
 
+    def probe_latency(self, count: int = 20) -> Optional[dict[str, Any]]:
+        """测量通道往返延迟 / Measure the round trip of the channel
+
+        依次发送 count 个 ping，需已连接 / Sends count pings one after another, must be connected
+
+        Args:
+            count: ping 次数 / Number of pings
+
+        Returns:
+            Optional[dict[str, Any]]: {"count", "failed", "min_us", "p50_us", "p90_us", "p99_us", "max_us", "mean_us"}，单位微秒；失败返回 None /
+                in microseconds; None on failure
+        """
+        buffer = StringBuffer()
+        if not Library.agent_client().MaaAgentClientProbeLatency(self._handle, count, buffer._handle):
+            return None
+        return json.loads(buffer.get())
+
     @property
     def custom_recognition_list(self) -> list[str]:
         """获取已注册的自定义识别器列表 / Get registered custom recognizer list
@@ -245,6 +270,12 @@ class AgentClient:
             ctypes.c_uint16,
         ]
 
+        Library.agent_client().MaaAgentClientCreateTcpV2.restype = MaaAgentClientHandle
+        Library.agent_client().MaaAgentClientCreateTcpV2.argtypes = [
+            ctypes.c_uint16,
+            ctypes.c_char_p,
+        ]
+
         Library.agent_client().MaaAgentClientIdentifier.restype = MaaBool
         Library.agent_client().MaaAgentClientIdentifier.argtypes = [
             MaaAgentClientHandle,
@@ -304,6 +335,13 @@ class AgentClient:
             ctypes.c_int64,
         ]
 
+        Library.agent_client().MaaAgentClientProbeLatency.restype = MaaBool
+        Library.agent_client().MaaAgentClientProbeLatency.argtypes = [
+            MaaAgentClientHandle,
+            MaaSize,
+            MaaStringBufferHandle,
+        ]
+
         Library.agent_client().MaaAgentClientGetCustomRecognitionList.restype = MaaBool
         Library.agent_client().MaaAgentClientGetCustomRecognitionList.argtypes = [
             MaaAgentClientHandle,
@@ -245,6 +245,16 @@ class StringListBuffer:
         ]
 
 
+class _ImageView:
+    """numpy 通过 __array_interface__ 引用缓冲区内存，数组的 base 即本对象，借此让缓冲区活得比数组久"""
+
+    __slots__ = ("__array_interface__", "_owner")
+
+    def __init__(self, owner: "ImageBuffer", interface: dict):
+        self.__array_interface__ = interface
+        self._owner = owner
+
+
 class ImageBuffer:
     """图像缓冲区 / Image buffer
 
@@ -290,6 +300,49 @@ class ImageBuffer:
             numpy.ctypeslib.as_array(ctypes.cast(buff, ctypes.POINTER(ctypes.c_uint8)), shape=(h, w, c))
         )
 
+    def view(self, roi: Optional[RectType] = None) -> numpy.ndarray:
+        """获取只读的图像视图，不拷贝 / Get a read-only view of the image without copying
+
+        视图直接引用缓冲区内存并持有本对象，缓冲区被 set / resize / clear 后视图失效；
+        借用的缓冲区（如自定义识别的入参）在回调返回后失效，需要保留请用 get 或自行 copy
+        The view references the buffer memory and keeps this object alive. It becomes invalid once the buffer is set / resized / cleared;
+        borrowed buffers (e.g. custom recognition arguments) become invalid when the callback returns, use get or copy it to keep the data
+
+        Args:
+            roi: 只取该矩形区域，超出图像的部分会被裁掉 / Only expose this rectangle, clipped to the image
+
+        Returns:
+            numpy.ndarray: 只读的 BGR 图像视图，形状为 (height, width, channels)
+            Read-only BGR image view with shape (height, width, channels)
+        """
+        buff = Library.framework().MaaImageBufferGetRawData(self._handle)
+        if not buff:
+            return numpy.ndarray((0, 0, 3), dtype=numpy.uint8)
+
+        w = Library.framework().MaaImageBufferWidth(self._handle)
+        h = Library.framework().MaaImageBufferHeight(self._handle)
+        c = Library.framework().MaaImageBufferChannels(self._handle)
+
+        x, y, vw, vh = 0, 0, w, h
+        if roi is not None:
+            x = min(max(int(roi[0]), 0), w)
+            y = min(max(int(roi[1]), 0), h)
+            vw = max(min(int(roi[0]) + int(roi[2]), w) - x, 0)
+            vh = max(min(int(roi[1]) + int(roi[3]), h) - y, 0)
+
+        return numpy.asarray(
+            _ImageView(
+                self,
+                {
+                    "shape": (vh, vw, c),
+                    "typestr": "|u1",
+                    "data": (buff + (y * w + x) * c, True),
+                    "strides": (w * c, c, 1),
+                    "version": 3,
+                },
+            )
+        )
+
     def set(self, value: numpy.ndarray) -> bool:
         """设置图像数据 / Set image data
 
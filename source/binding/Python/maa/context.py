@@ -189,6 +189,41 @@ class Context:
 
         return self.tasker.get_recognition_detail(reco_id)
 
+    def run_recognition_on_frame(
+        self,
+        frame_id: int,
+        reco_type: JRecognitionType,
+        reco_param: JRecognitionParam,
+    ) -> Optional[RecognitionDetail]:
+        """在已注册的帧上同步执行识别 / Synchronously execute recognition on a registered frame
+
+        帧通过 Tasker.register_frame 注册，同一帧上的识别复用派生数据，不再重复传图。
+        The frame is registered by Tasker.register_frame. Recognitions on the same frame reuse derived data
+        and do not transfer the image again.
+
+        Args:
+            frame_id: 帧 id / Frame id
+            reco_type: 识别类型 / Recognition type
+            reco_param: 识别参数 / Recognition parameters
+
+        Returns:
+            Optional[RecognitionDetail]: 识别结果，帧不存在或未能启动识别时返回 None
+            Recognition detail, None if the frame does not exist or recognition fails to start
+        """
+        reco_param_json = json.dumps(dataclasses.asdict(reco_param), ensure_ascii=False)
+        reco_id = int(
+            Library.framework().MaaContextRunRecognitionOnFrame(
+                self._handle,
+                frame_id,
+                reco_type.encode(),
+                reco_param_json.encode(),
+            )
+        )
+        if not reco_id:
+            return None
+
+        return self.tasker.get_recognition_detail(reco_id)
+
     def run_action_direct(
         self,
         action_type: JActionType,
@@ -427,10 +462,10 @@ class Context:
             box: 识别命中的区域 (x, y, w, h)，用于 target 为 Self 时计算 ROI
             Recognition hit box, used when target is Self to calculate ROI
             wait_freezes_param: 等待参数，使用 JWaitFreezes。支持 time, target, target_offset, threshold,
-            method, rate_limit, timeout
+            method, block_size, rate_limit, timeout
 
                               Wait parameters, use JWaitFreezes. Supports time, target,
-                              target_offset, threshold, method, rate_limit, timeout
+                              target_offset, threshold, method, block_size, rate_limit, timeout
 
         Returns:
             bool: 是否成功 / Whether successful
@@ -517,6 +552,14 @@ class Context:
             MaaImageBufferHandle,
         ]
 
+        Library.framework().MaaContextRunRecognitionOnFrame.restype = MaaRecoId
+        Library.framework().MaaContextRunRecognitionOnFrame.argtypes = [
+            MaaContextHandle,
+            MaaFrameId,
+            ctypes.c_char_p,
+            ctypes.c_char_p,
+        ]
+
         Library.framework().MaaContextRunActionDirect.restype = MaaActId
         Library.framework().MaaContextRunActionDirect.argtypes = [
             MaaContextHandle,
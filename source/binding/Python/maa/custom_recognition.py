@@ -30,8 +30,13 @@ class CustomRecognition(ABC):
 
     _handle: Any
 
+    # 为 True 时 argv.image 是缓冲区的只读视图，不再拷贝整帧；视图仅在 analyze 期间有效，需要保留请自行 copy
+    # When True, argv.image is a read-only view of the buffer instead of a full-frame copy; it is only valid during analyze, copy it to keep the data
+    image_view: bool = False
+
     def __init__(self):
         self._handle = self._c_analyze_agent
+        self._batch_handle = self._c_analyze_batch_agent
 
     @dataclass
     class AnalyzeArg:
@@ -43,7 +48,8 @@ class CustomRecognition(ABC):
             custom_recognition_name: 自定义识别器名 / Custom recognition name
             custom_recognition_param: 自定义识别器参数 (JSON 字符串)
             Custom recognition parameter (JSON string)
-            image: 待识别的图像 (BGR 格式) / Image to recognize (BGR format)
+            image: 待识别的图像 (BGR 格式)，image_view 为 True 时是只读视图，切片取 roi 也不拷贝
+            Image to recognize (BGR format), a read-only view when image_view is True, slicing the roi does not copy either
             roi: 识别区域 / Recognition region of interest
         """
 
@@ -66,6 +72,21 @@ class CustomRecognition(ABC):
         box: Optional[RectType]
         detail: dict[str, Any]
 
+    @dataclass
+    class BatchEntry:
+        """analyze_batch 中的一个节点 / One node in analyze_batch
+
+        Attributes:
+            node_name: 节点名 / Node name
+            custom_recognition_param: 自定义识别器参数 (JSON 字符串)
+            Custom recognition parameter (JSON string)
+            roi: 识别区域 / Recognition region of interest
+        """
+
+        node_name: str
+        custom_recognition_param: str
+        roi: Rect
+
     @abstractmethod
     def analyze(
         self,
@@ -86,10 +107,47 @@ class CustomRecognition(ABC):
         """
         raise NotImplementedError
 
+    def analyze_batch(
+        self,
+        context: Context,
+        task_detail: TaskDetail,
+        custom_recognition_name: str,
+        image: numpy.ndarray,
+        entries: list[BatchEntry],
+    ) -> Optional[list[Union[AnalyzeResult, Optional[RectType]]]]:
+        """在同一帧上一次识别 next 列表中使用本识别器的多个节点（可选） / Recognize several nodes of a next list that use this recognizer on the same frame at once (optional)
+
+        重写后注册时会一并注册批量形式，共享的前处理（如一次推理）只需做一次。
+        image 的处理方式同 analyze，受 image_view 控制。
+        Once overridden, the batch form is registered as well, so shared work (e.g. one inference pass) only runs once.
+        image is handled the same way as in analyze and follows image_view.
+
+        Args:
+            context: 任务上下文 / Task context
+            task_detail: 当前任务详情 / Current task detail
+            custom_recognition_name: 自定义识别器名 / Custom recognition name
+            image: 待识别的图像 (BGR 格式) / Image to recognize (BGR format)
+            entries: 各节点的参数与 roi / Param and roi of each node
+
+        Returns:
+            与 entries 一一对应的结果，每项含义同 analyze 的返回值；返回 None 则逐个调用 analyze。
+            Results in the same order as entries, each item means the same as the return value of analyze;
+            return None to call analyze for each node instead.
+        """
+        return None
+
+    @property
+    def has_batch(self) -> bool:
+        return type(self).analyze_batch is not CustomRecognition.analyze_batch
+
     @property
     def c_handle(self) -> Any:
         return self._handle
 
+    @property
+    def c_batch_handle(self) -> Any:
+        return self._batch_handle
+
     @property
     def c_arg(self) -> ctypes.c_void_p:
         return ctypes.c_void_p.from_buffer(ctypes.py_object(self))
@@ -118,7 +176,8 @@ class CustomRecognition(ABC):
         if not task_detail:
             return int(False)
 
-        image = ImageBuffer(c_image).get()
+        image_buffer = ImageBuffer(c_image)
+        image = image_buffer.view() if self.image_view else image_buffer.get()
 
         result: Union[CustomRecognition.AnalyzeResult, Optional[RectType]] = self.analyze(
             context,
@@ -132,14 +191,77 @@ class CustomRecognition(ABC):
             ),
         )
 
-        rect_buffer = RectBuffer(c_out_box)
-        detail_buffer = StringBuffer(c_out_detail)
+        box, detail = CustomRecognition._unpack_result(result)
+
+        if box:
+            RectBuffer(c_out_box).set(box)
+        if detail is not None:
+            StringBuffer(c_out_detail).set(json.dumps(detail, ensure_ascii=False))
+        return int(box is not None)
 
+    @staticmethod
+    @MaaCustomRecognitionBatchCallback
+    def _c_analyze_batch_agent(
+        c_context: MaaContextHandle,
+        c_task_id: MaaTaskId,
+        c_custom_reco_name: bytes,
+        c_entries: bytes,
+        c_image: MaaImageBufferHandle,
+        c_transparent_arg: ctypes.c_void_p,
+        c_out_results: MaaStringBufferHandle,
+    ) -> int:
+        if not c_transparent_arg:
+            return int(False)
+
+        self: CustomRecognition = ctypes.cast(c_transparent_arg, ctypes.py_object).value
+
+        context = Context(c_context)
+        task_detail = context.tasker.get_task_detail(int(c_task_id))
+        if not task_detail:
+            return int(False)
+
+        image_buffer = ImageBuffer(c_image)
+        image = image_buffer.view() if self.image_view else image_buffer.get()
+
+        entries = [
+            CustomRecognition.BatchEntry(
+                node_name=entry["node_name"],
+                custom_recognition_param=json.dumps(entry["param"], ensure_ascii=False),
+                roi=Rect(*entry["roi"]),
+            )
+            for entry in json.loads(c_entries.decode())
+        ]
+
+        results = self.analyze_batch(
+            context,
+            task_detail,
+            c_custom_reco_name.decode(),
+            image,
+            entries,
+        )
+        if results is None:
+            return int(False)
+
+        out_results = []
+        for result in results:
+            box, detail = CustomRecognition._unpack_result(result)
+            out_results.append(
+                {
+                    "hit": box is not None,
+                    "box": [int(v) for v in numpy.ravel(list(box))] if box else [0, 0, 0, 0],
+                    "detail": detail,
+                }
+            )
+
+        StringBuffer(c_out_results).set(json.dumps(out_results, ensure_ascii=False))
+        return int(True)
+
+    @staticmethod
+    def _unpack_result(
+        result: Union[AnalyzeResult, Optional[RectType]],
+    ) -> tuple[Optional[RectType], Optional[dict[str, Any]]]:
         if isinstance(result, CustomRecognition.AnalyzeResult):
-            if result.box:
-                rect_buffer.set(result.box)
-            detail_buffer.set(json.dumps(result.detail, ensure_ascii=False))
-            return int(result.box is not None)
+            return result.box, result.detail
 
         # RectType
         elif (
@@ -148,11 +270,10 @@ class CustomRecognition(ABC):
             or (isinstance(result, numpy.ndarray) and result.size == 4)
             or (isinstance(result, tuple) and len(result) == 4)
         ):
-            rect_buffer.set(result)
-            return int(True)
+            return result, None
 
         elif result is None:
-            return int(False)
+            return None, None
 
         else:
             raise TypeError(f"Invalid return type: {result!r}")
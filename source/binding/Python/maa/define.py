@@ -22,6 +22,7 @@ __all__ = [
     "MaaNodeId",
     "MaaWfId",
     "MaaSinkId",
+    "MaaFrameId",
     "MaaInvalidId",
     "MaaStatus",
     "MaaLoggingLevel",
@@ -65,6 +66,7 @@ __all__ = [
     "FUNCTYPE",
     "MaaEventCallback",
     "MaaCustomRecognitionCallback",
+    "MaaCustomRecognitionBatchCallback",
     "MaaCustomActionCallback",
     "MaaCustomControllerCallbacks",
     # Enums
@@ -145,6 +147,7 @@ MaaActId = MaaId
 MaaNodeId = MaaId
 MaaWfId = MaaId
 MaaSinkId = MaaId
+MaaFrameId = MaaId
 MaaInvalidId = MaaId(0)
 
 MaaStringBufferHandle = ctypes.c_void_p
@@ -330,6 +333,35 @@ class MaaResOptionEnum(IntEnum):
     # default value is MaaInferenceExecutionProvider_Auto
     InferenceExecutionProvider = 2
 
+    # Decode all templates referenced by the loaded pipeline on a worker pool at load time,
+    # instead of on their first use during a task.
+    #
+    # value: bool, eg: true; val_size: sizeof(bool)
+    # default value is false
+    TemplateWarmUp = 3
+
+    # Memory budget of the decoded template cache, in bytes.
+    # When exceeded, the least recently used templates that are not pinned are evicted and
+    # read from disk again on their next use.
+    #
+    # value: int64_t, eg: 268435456; val_size: sizeof(int64_t)
+    # default value is 0, which means unlimited
+    TemplateCacheBudget = 4
+
+    # Nodes whose templates are pinned in the template cache and never evicted.
+    # Applies to nodes loaded later as well. Each set replaces the previous list.
+    #
+    # value: string, JSON array of node names, eg: "[\"StartUp\", \"Battle\"]"; val_size: string length
+    # default value is []
+    TemplatePinnedNodes = 5
+
+    # Check a compiled bundle against every file in its source directory before using it.
+    # By default only the default pipeline, the pipeline files and their directories are checked.
+    #
+    # value: bool, eg: true; val_size: sizeof(bool)
+    # default value is false
+    CompiledBundleVerifySources = 6
+
 
 MaaAdbScreencapMethod = ctypes.c_uint64
 
@@ -687,6 +719,7 @@ class MaaControllerFeatureEnum(IntEnum):
 
     UseMouseDownAndUpInsteadOfClick = 1
     UseKeyboardDownAndUpInsteadOfClick = 1 << 1
+    ConcurrentScreencapAndInput = 1 << 3
 
 
 FUNCTYPE = ctypes.WINFUNCTYPE if (platform.system() == "Windows") else ctypes.CFUNCTYPE
@@ -707,6 +740,17 @@ MaaCustomRecognitionCallback = FUNCTYPE(
     MaaStringBufferHandle,  # [out] out_detail
 )
 
+MaaCustomRecognitionBatchCallback = FUNCTYPE(
+    MaaBool,  # return value
+    MaaContextHandle,  # context
+    MaaTaskId,  # task_id
+    ctypes.c_char_p,  # custom_recognition_name
+    ctypes.c_char_p,  # entries_json
+    MaaImageBufferHandle,  # image
+    ctypes.c_void_p,  # trans_arg
+    MaaStringBufferHandle,  # [out] out_results
+)
+
 MaaCustomActionCallback = FUNCTYPE(
     MaaBool,  # return value
     MaaContextHandle,  # context
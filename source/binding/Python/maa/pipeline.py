@@ -347,6 +347,7 @@ class JWaitFreezes:
     target_offset: JRect = (0, 0, 0, 0)
     threshold: float = 0.95
     method: int = 5
+    block_size: int = 0
     rate_limit: int = 1000
     timeout: int = 20000
 
@@ -384,6 +385,7 @@ class JPipelineParser:
             target_offset=cast(JRect, data.get("target_offset")),
             threshold=cast(float, data.get("threshold")),
             method=cast(int, data.get("method")),
+            block_size=cast(int, data.get("block_size", 0)),
             rate_limit=cast(int, data.get("rate_limit")),
             timeout=cast(int, data.get("timeout")),
         )
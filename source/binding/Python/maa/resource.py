@@ -1,7 +1,7 @@
 import ctypes
 import json
 import pathlib
-from dataclasses import dataclass
+from dataclasses import dataclass, field
 from typing import TYPE_CHECKING, Any, Callable, Optional, Union
 
 import numpy
@@ -78,6 +78,29 @@ class Resource:
         res_id = Library.framework().MaaResourcePostBundle(self._handle, str(path).encode())
         return Job(res_id, self._status, self._wait)
 
+    @staticmethod
+    def compile_bundle(bundle_path: Union[pathlib.Path, str], output_path: Union[pathlib.Path, str]) -> bool:
+        """预编译资源包 / Precompile a resource bundle
+
+        解析、校验资源包并写入单个文件，可直接传给 post_bundle；源目录有改动时加载会回退为源目录
+        Parse and validate the bundle into a single file that can be passed to post_bundle;
+        loading falls back to the source directory if it has changed since compiling
+
+        Args:
+            bundle_path: 资源包目录 / Resource bundle directory
+            output_path: 输出文件路径 / Output file path
+
+        Returns:
+            bool: 是否成功 / Whether successful
+        """
+        Resource._set_api_properties()
+
+        return bool(
+            Library.framework().MaaResourceCompileBundle(
+                str(bundle_path).encode(), str(output_path).encode()
+            )
+        )
+
     def post_ocr_model(self, path: Union[pathlib.Path, str]) -> Job:
         """异步加载 OCR 模型 / Asynchronously load OCR model from path
 
@@ -330,6 +353,27 @@ class Resource:
         """
         return self.set_inference(MaaInferenceExecutionProviderEnum.Auto, MaaInferenceDeviceEnum.Auto)
 
+    def set_template_warm_up(self, enabled: bool) -> bool:
+        """加载时并行预解码 pipeline 引用的所有模板图片 / Pre-decode all templates referenced by the pipeline at load time
+
+        默认在任务中首次使用时才读取 / By default templates are read on first use during a task
+
+        Args:
+            enabled: 是否开启 / Whether to enable
+
+        Returns:
+            bool: 是否设置成功 / Whether the setting was successful
+        """
+        c_enabled = ctypes.c_bool(enabled)
+        return bool(
+            Library.framework().MaaResourceSetOption(
+                self._handle,
+                MaaResOptionEnum.TemplateWarmUp,
+                ctypes.byref(c_enabled),
+                ctypes.sizeof(c_enabled),
+            )
+        )
+
     # not implemented
     # def use_cuda(self, nvidia_gpu_id: int) -> bool:
     #     return self.set_inference(MaaInferenceExecutionProviderEnum.CUDA, nvidia_gpu_id)
@@ -390,7 +434,7 @@ class Resource:
         # avoid gc
         self._custom_recognition_holder[name] = recognition
 
-        return bool(
+        ret = bool(
             Library.framework().MaaResourceRegisterCustomRecognition(
                 self._handle,
                 name.encode(),
@@ -398,6 +442,16 @@ class Resource:
                 recognition.c_arg,
             )
         )
+        if ret and recognition.has_batch:
+            ret = bool(
+                Library.framework().MaaResourceRegisterCustomRecognitionBatch(
+                    self._handle,
+                    name.encode(),
+                    recognition.c_batch_handle,
+                    recognition.c_arg,
+                )
+            )
+        return ret
 
     def unregister_custom_recognition(self, name: str) -> bool:
         """移除自定义识别器 / Remove the custom recognizer
@@ -547,6 +601,82 @@ class Resource:
             raise RuntimeError("Failed to get custom action list.")
         return buffer.get()
 
+    @property
+    def template_cache_stats(self) -> dict:
+        """获取模板图片缓存统计 / Get template image cache statistics
+
+        Returns:
+            dict: budget, bytes, entries, pinned, hits, misses, evictions
+
+        Raises:
+            RuntimeError: 如果获取失败
+        """
+        buffer = StringBuffer()
+        if not Library.framework().MaaResourceGetTemplateCacheStats(self._handle, buffer._handle):
+            raise RuntimeError("Failed to get template cache stats.")
+        return json.loads(buffer.get())
+
+    def set_template_cache_budget(self, budget: int) -> bool:
+        """设置模板图片缓存的内存预算 / Set memory budget of the template image cache
+
+        超出预算时按最近最少使用淘汰未固定的模板 / Evicts least recently used templates that are not pinned when exceeded
+
+        Args:
+            budget: 字节数，0 表示不限 / Bytes, 0 means unlimited
+
+        Returns:
+            bool: 是否设置成功 / Whether the setting was successful
+        """
+        c_budget = ctypes.c_int64(budget)
+        return bool(
+            Library.framework().MaaResourceSetOption(
+                self._handle,
+                MaaResOptionEnum.TemplateCacheBudget,
+                ctypes.byref(c_budget),
+                ctypes.sizeof(c_budget),
+            )
+        )
+
+    def set_template_pinned_nodes(self, nodes: list[str]) -> bool:
+        """固定这些节点引用的模板，不会被淘汰 / Pin templates referenced by these nodes so they are never evicted
+
+        Args:
+            nodes: 节点名列表 / Node names
+
+        Returns:
+            bool: 是否设置成功 / Whether the setting was successful
+        """
+        value = json.dumps(nodes, ensure_ascii=False).encode()
+        return bool(
+            Library.framework().MaaResourceSetOption(
+                self._handle,
+                MaaResOptionEnum.TemplatePinnedNodes,
+                value,
+                len(value),
+            )
+        )
+
+    def set_compiled_bundle_verify_sources(self, enabled: bool) -> bool:
+        """加载预编译资源包前逐个比较源目录下的所有文件 / Check every source file before using a compiled bundle
+
+        默认只检查默认参数、pipeline 文件及其目录 / By default only the default pipeline, pipeline files and their directories are checked
+
+        Args:
+            enabled: 是否开启 / Whether to enable
+
+        Returns:
+            bool: 是否设置成功 / Whether the setting was successful
+        """
+        c_enabled = ctypes.c_bool(enabled)
+        return bool(
+            Library.framework().MaaResourceSetOption(
+                self._handle,
+                MaaResOptionEnum.CompiledBundleVerifySources,
+                ctypes.byref(c_enabled),
+                ctypes.sizeof(c_enabled),
+            )
+        )
+
     @property
     def hash(self) -> str:
         """获取资源 hash / Get resource hash
@@ -634,6 +764,12 @@ class Resource:
         Library.framework().MaaResourceDestroy.restype = None
         Library.framework().MaaResourceDestroy.argtypes = [MaaResourceHandle]
 
+        Library.framework().MaaResourceCompileBundle.restype = MaaBool
+        Library.framework().MaaResourceCompileBundle.argtypes = [
+            ctypes.c_char_p,
+            ctypes.c_char_p,
+        ]
+
         Library.framework().MaaResourcePostBundle.restype = MaaResId
         Library.framework().MaaResourcePostBundle.argtypes = [
             MaaResourceHandle,
@@ -725,6 +861,14 @@ class Resource:
             ctypes.c_void_p,
         ]
 
+        Library.framework().MaaResourceRegisterCustomRecognitionBatch.restype = MaaBool
+        Library.framework().MaaResourceRegisterCustomRecognitionBatch.argtypes = [
+            MaaResourceHandle,
+            ctypes.c_char_p,
+            MaaCustomRecognitionBatchCallback,
+            ctypes.c_void_p,
+        ]
+
         Library.framework().MaaResourceUnregisterCustomRecognition.restype = MaaBool
         Library.framework().MaaResourceUnregisterCustomRecognition.argtypes = [
             MaaResourceHandle,
@@ -773,6 +917,12 @@ class Resource:
             MaaStringListBufferHandle,
         ]
 
+        Library.framework().MaaResourceGetTemplateCacheStats.restype = MaaBool
+        Library.framework().MaaResourceGetTemplateCacheStats.argtypes = [
+            MaaResourceHandle,
+            MaaStringBufferHandle,
+        ]
+
         Library.framework().MaaResourceGetDefaultRecognitionParam.restype = MaaBool
         Library.framework().MaaResourceGetDefaultRecognitionParam.argtypes = [
             MaaResourceHandle,
@@ -811,6 +961,8 @@ class ResourceEventSink(EventSink):
         path: str
         type: str
         hash: str
+        # 各阶段耗时（毫秒），仅在 Succeeded / Failed 中存在 / Per-phase timings in ms, only in Succeeded / Failed
+        timings: dict[str, int] = field(default_factory=dict)
 
     def on_resource_loading(
         self,
@@ -834,6 +986,7 @@ class ResourceEventSink(EventSink):
                 path=details["path"],
                 type=details.get("type", "Bundle"),
                 hash=details["hash"],
+                timings=details.get("timings", {}),
             )
             self.on_resource_loading(resource, noti_type, detail)
 
@@ -7,7 +7,7 @@ from typing import TYPE_CHECKING, Any, Optional, Union
 
 import numpy
 
-from .buffer import ImageBuffer, ImageListBuffer, RectBuffer, StringBuffer
+from .buffer import ImageBuffer, ImageListBuffer, RectBuffer, StringBuffer, StringListBuffer
 from .controller import Controller
 from .define import *
 from .event_sink import EventSink, NotificationType
@@ -166,6 +166,63 @@ class Tasker:
         )
         return self._gen_task_job(taskid)
 
+    def register_frame(self, image: numpy.ndarray) -> Optional[int]:
+        """注册一帧图像，供多次识别复用 / Register a frame for repeated recognitions
+
+        图像只拷贝一次。在该帧上的识别共享 OCR 结果等派生数据，直到注销。
+        The image is copied once. Recognitions on the frame share derived data such as OCR results,
+        until it is unregistered.
+
+        Args:
+            image: 图像 / Image
+
+        Returns:
+            Optional[int]: 帧 id，失败返回 None / Frame id, None on failure
+        """
+        img_buffer = ImageBuffer()
+        img_buffer.set(image)
+        frame_id = int(Library.framework().MaaTaskerRegisterFrame(self._handle, img_buffer._handle))
+        return frame_id or None
+
+    def unregister_frame(self, frame_id: int) -> bool:
+        """注销帧 / Unregister a frame
+
+        已提交的识别仍会完成。
+        Recognitions already posted on it still complete.
+
+        Args:
+            frame_id: 帧 id / Frame id
+
+        Returns:
+            bool: 是否成功 / Whether successful
+        """
+        return bool(Library.framework().MaaTaskerUnregisterFrame(self._handle, frame_id))
+
+    def post_recognition_on_frame(
+        self,
+        frame_id: int,
+        reco_type: JRecognitionType,
+        reco_param: JRecognitionParam,
+    ) -> TaskJob:
+        """在已注册的帧上异步执行识别 / Asynchronously execute recognition on a registered frame
+
+        Args:
+            frame_id: register_frame 返回的帧 id / Frame id returned by register_frame
+            reco_type: 识别类型 / Recognition type
+            reco_param: 识别参数 / Recognition parameters
+
+        Returns:
+            TaskJob: 任务作业对象 / Task job object
+        """
+        reco_param_json = json.dumps(dataclasses.asdict(reco_param), ensure_ascii=False)
+        taskid = Library.framework().MaaTaskerPostRecognitionOnFrame(
+            self._handle,
+            frame_id,
+            reco_type.encode(),
+            reco_param_json.encode(),
+        )
+        return self._gen_task_job(taskid)
+
     def post_action(
         self,
         action_type: JActionType,
@@ -259,6 +316,32 @@ class Tasker:
         """
         return bool(Library.framework().MaaTaskerClearCache(self._handle))
 
+    def get_latency_stats(self) -> dict:
+        """获取耗时统计 / Get latency statistics
+
+        包含截图、缩放、各识别算法、各节点、动作与 wait_freezes 各阶段的耗时直方图，单位毫秒
+        Contains latency histograms of screencap, resize, each recognition algorithm, each node, action and
+        each wait_freezes phase, in milliseconds
+
+        Returns:
+            dict: {category: {name: {count, avg, min, max, p50, p90, p99}}}
+
+        Raises:
+            RuntimeError: 如果获取失败
+        """
+        buffer = StringBuffer()
+        if not Library.framework().MaaTaskerGetLatencyStats(self._handle, buffer._handle):
+            raise RuntimeError("Failed to get latency stats.")
+        return json.loads(buffer.get())
+
+    def clear_latency_stats(self) -> bool:
+        """清空耗时统计 / Clear latency statistics
+
+        Returns:
+            bool: 是否成功 / Whether successful
+        """
+        return bool(Library.framework().MaaTaskerClearLatencyStats(self._handle))
+
     def override_pipeline(self, task_id: int, pipeline_override: dict[str, Any]) -> bool:
         """覆盖指定任务的 pipeline / Override pipeline for specified task
 
@@ -337,6 +420,39 @@ class Tasker:
         """清除所有上下文事件监听器 / Clear all context event listeners"""
         Library.framework().MaaTaskerClearContextSinks(self._handle)
 
+    def set_sink_subscription(self, sink_id: int, msg_filter: Optional[list[str]] = None) -> bool:
+        """设置实例事件监听器订阅的消息 / Set messages subscribed by instance event listener
+
+        Args:
+            sink_id: 监听器 id / Listener id
+            msg_filter: 完整消息名或以 '.' 分隔的前缀，为空则订阅全部 / Full message names or dot-separated prefixes, empty to subscribe all
+
+        Returns:
+            bool: 是否成功 / Whether successful
+        """
+        list_buffer = StringListBuffer()
+        list_buffer.set(msg_filter or [])
+
+        return bool(Library.framework().MaaTaskerSetSinkSubscription(self._handle, sink_id, list_buffer._handle))
+
+    def set_context_sink_subscription(self, sink_id: int, msg_filter: Optional[list[str]] = None) -> bool:
+        """设置上下文事件监听器订阅的消息 / Set messages subscribed by context event listener
+
+        未被任何监听器订阅的上下文消息不会构造 details
+        Details of context messages that no listener subscribes to are not built
+
+        Args:
+            sink_id: 监听器 id / Listener id
+            msg_filter: 完整消息名或以 '.' 分隔的前缀，为空则订阅全部 / Full message names or dot-separated prefixes, empty to subscribe all
+
+        Returns:
+            bool: 是否成功 / Whether successful
+        """
+        list_buffer = StringListBuffer()
+        list_buffer.set(msg_filter or [])
+
+        return bool(Library.framework().MaaTaskerSetContextSinkSubscription(self._handle, sink_id, list_buffer._handle))
+
     ### private ###
 
     @staticmethod
@@ -926,6 +1042,26 @@ class Tasker:
             ctypes.c_char_p,
         ]
 
+        Library.framework().MaaTaskerRegisterFrame.restype = MaaFrameId
+        Library.framework().MaaTaskerRegisterFrame.argtypes = [
+            MaaTaskerHandle,
+            MaaImageBufferHandle,
+        ]
+
+        Library.framework().MaaTaskerUnregisterFrame.restype = MaaBool
+        Library.framework().MaaTaskerUnregisterFrame.argtypes = [
+            MaaTaskerHandle,
+            MaaFrameId,
+        ]
+
+        Library.framework().MaaTaskerPostRecognitionOnFrame.restype = MaaId
+        Library.framework().MaaTaskerPostRecognitionOnFrame.argtypes = [
+            MaaTaskerHandle,
+            MaaFrameId,
+            ctypes.c_char_p,
+            ctypes.c_char_p,
+        ]
+
         Library.framework().MaaTaskerStatus.restype = MaaStatus
         Library.framework().MaaTaskerStatus.argtypes = [
             MaaTaskerHandle,
@@ -1022,6 +1158,17 @@ class Tasker:
             MaaTaskerHandle,
         ]
 
+        Library.framework().MaaTaskerGetLatencyStats.restype = MaaBool
+        Library.framework().MaaTaskerGetLatencyStats.argtypes = [
+            MaaTaskerHandle,
+            MaaStringBufferHandle,
+        ]
+
+        Library.framework().MaaTaskerClearLatencyStats.restype = MaaBool
+        Library.framework().MaaTaskerClearLatencyStats.argtypes = [
+            MaaTaskerHandle,
+        ]
+
         Library.framework().MaaTaskerOverridePipeline.restype = MaaBool
         Library.framework().MaaTaskerOverridePipeline.argtypes = [
             MaaTaskerHandle,
@@ -1061,6 +1208,20 @@ class Tasker:
         Library.framework().MaaTaskerClearContextSinks.restype = None
         Library.framework().MaaTaskerClearContextSinks.argtypes = [MaaTaskerHandle]
 
+        Library.framework().MaaTaskerSetSinkSubscription.restype = MaaBool
+        Library.framework().MaaTaskerSetSinkSubscription.argtypes = [
+            MaaTaskerHandle,
+            MaaSinkId,
+            MaaStringListBufferHandle,
+        ]
+
+        Library.framework().MaaTaskerSetContextSinkSubscription.restype = MaaBool
+        Library.framework().MaaTaskerSetContextSinkSubscription.argtypes = [
+            MaaTaskerHandle,
+            MaaSinkId,
+            MaaStringListBufferHandle,
+        ]
+
 
 class TaskerEventSink(EventSink):
     @dataclass
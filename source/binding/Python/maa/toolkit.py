@@ -159,24 +159,36 @@ class Toolkit:
         else:
             Library.toolkit().MaaToolkitAdbDeviceFind(list_handle)
 
-        count = Library.toolkit().MaaToolkitAdbDeviceListSize(list_handle)
+        devices = Toolkit._get_adb_device_list(list_handle)
 
-        devices: list[AdbDevice] = []
-        for i in range(count):
-            device_handle = Library.toolkit().MaaToolkitAdbDeviceListAt(list_handle, i)
+        Library.toolkit().MaaToolkitAdbDeviceListDestroy(list_handle)
 
-            name = Library.toolkit().MaaToolkitAdbDeviceGetName(device_handle).decode()
-            adb_path = Path(Library.toolkit().MaaToolkitAdbDeviceGetAdbPath(device_handle).decode())
-            address = Library.toolkit().MaaToolkitAdbDeviceGetAddress(device_handle).decode()
-            screencap_methods = int(Library.toolkit().MaaToolkitAdbDeviceGetScreencapMethods(device_handle))
-            input_methods = int(Library.toolkit().MaaToolkitAdbDeviceGetInputMethods(device_handle))
-            config = json.loads(Library.toolkit().MaaToolkitAdbDeviceGetConfig(device_handle).decode())
+        return devices
 
-            devices.append(AdbDevice(name, adb_path, address, screencap_methods, input_methods, config))
+    @staticmethod
+    def watch_adb_devices() -> tuple[list[AdbDevice], list[AdbDevice]]:
+        """重新搜索安卓模拟器，只返回与上一次调用相比的变化 / Search Android emulators again and only return changes since the last call
 
-        Library.toolkit().MaaToolkitAdbDeviceListDestroy(list_handle)
+        首次调用时所有设备都视为新增；配置变化的设备同时出现在两个列表中。
+        On the first call every device is reported as added; a device whose config changed appears in both lists.
 
-        return devices
+        Returns:
+            tuple[list[AdbDevice], list[AdbDevice]]: (新增设备, 移除设备) / (added devices, removed devices)
+        """
+        Toolkit._set_api_properties()
+
+        added_handle = Library.toolkit().MaaToolkitAdbDeviceListCreate()
+        removed_handle = Library.toolkit().MaaToolkitAdbDeviceListCreate()
+
+        Library.toolkit().MaaToolkitAdbDeviceWatch(added_handle, removed_handle)
+
+        added = Toolkit._get_adb_device_list(added_handle)
+        removed = Toolkit._get_adb_device_list(removed_handle)
+
+        Library.toolkit().MaaToolkitAdbDeviceListDestroy(added_handle)
+        Library.toolkit().MaaToolkitAdbDeviceListDestroy(removed_handle)
+
+        return added, removed
 
     @staticmethod
     def find_desktop_windows() -> list[DesktopWindow]:
@@ -297,6 +309,25 @@ class Toolkit:
 
     _api_properties_initialized: bool = False
 
+    @staticmethod
+    def _get_adb_device_list(list_handle: MaaToolkitAdbDeviceListHandle) -> list[AdbDevice]:
+        count = Library.toolkit().MaaToolkitAdbDeviceListSize(list_handle)
+
+        devices: list[AdbDevice] = []
+        for i in range(count):
+            device_handle = Library.toolkit().MaaToolkitAdbDeviceListAt(list_handle, i)
+
+            name = Library.toolkit().MaaToolkitAdbDeviceGetName(device_handle).decode()
+            adb_path = Path(Library.toolkit().MaaToolkitAdbDeviceGetAdbPath(device_handle).decode())
+            address = Library.toolkit().MaaToolkitAdbDeviceGetAddress(device_handle).decode()
+            screencap_methods = int(Library.toolkit().MaaToolkitAdbDeviceGetScreencapMethods(device_handle))
+            input_methods = int(Library.toolkit().MaaToolkitAdbDeviceGetInputMethods(device_handle))
+            config = json.loads(Library.toolkit().MaaToolkitAdbDeviceGetConfig(device_handle).decode())
+
+            devices.append(AdbDevice(name, adb_path, address, screencap_methods, input_methods, config))
+
+        return devices
+
     @staticmethod
     def _set_api_properties():
         if Toolkit._api_properties_initialized:
@@ -324,6 +355,12 @@ class Toolkit:
             MaaToolkitAdbDeviceListHandle,
         ]
 
+        Library.toolkit().MaaToolkitAdbDeviceWatch.restype = MaaBool
+        Library.toolkit().MaaToolkitAdbDeviceWatch.argtypes = [
+            MaaToolkitAdbDeviceListHandle,
+            MaaToolkitAdbDeviceListHandle,
+        ]
+
         Library.toolkit().MaaToolkitAdbDeviceListSize.restype = MaaSize
         Library.toolkit().MaaToolkitAdbDeviceListSize.argtypes = [MaaToolkitAdbDeviceListHandle]
 
@@ -54,6 +54,8 @@ public:
     virtual bool clear() = 0;
 
     virtual void register_custom_recognition(const std::string& name, MaaCustomRecognitionCallback recognition, void* trans_arg) = 0;
+    virtual void
+        register_custom_recognition_batch(const std::string& name, MaaCustomRecognitionBatchCallback recognition, void* trans_arg) = 0;
     virtual void unregister_custom_recognition(const std::string& name) = 0;
     virtual void clear_custom_recognition() = 0;
     virtual void register_custom_action(const std::string& name, MaaCustomActionCallback action, void* trans_arg) = 0;
@@ -64,6 +66,7 @@ public:
     virtual std::vector<std::string> get_node_list() const = 0;
     virtual std::vector<std::string> get_custom_recognition_list() const = 0;
     virtual std::vector<std::string> get_custom_action_list() const = 0;
+    virtual std::string get_template_cache_stats() const = 0;
 
     virtual std::optional<json::object> get_default_recognition_param(const std::string& reco_type) const = 0;
     virtual std::optional<json::object> get_default_action_param(const std::string& action_type) const = 0;
@@ -133,6 +136,10 @@ public:
         const cv::Rect& box,
         const std::string& reco_detail) = 0;
 
+    virtual MaaFrameId register_frame(const cv::Mat& image) = 0;
+    virtual bool unregister_frame(MaaFrameId frame_id) = 0;
+    virtual MaaTaskId post_recognition_on_frame(MaaFrameId frame_id, const std::string& reco_type, const json::value& reco_param) = 0;
+
     virtual bool override_pipeline(MaaTaskId task_id, const json::value& pipeline_override) = 0;
 
     virtual MaaStatus status(MaaTaskId task_id) const = 0;
@@ -153,9 +160,15 @@ public:
     virtual std::optional<MAA_TASK_NS::WaitFreezesDetail> get_wf_detail(MaaWfId wf_id) const = 0;
     virtual std::optional<MaaNodeId> get_latest_node(const std::string& node_name) const = 0;
 
+    virtual json::object get_latency_stats() const = 0;
+    virtual void clear_latency_stats() = 0;
+
     virtual MaaSinkId add_context_sink(MaaEventCallback callback, void* trans_arg) = 0;
     virtual void remove_context_sink(MaaSinkId sink_id) = 0;
     virtual void clear_context_sinks() = 0;
+
+    virtual bool set_sink_subscription(MaaSinkId sink_id, std::vector<std::string> msg_filter) = 0;
+    virtual bool set_context_sink_subscription(MaaSinkId sink_id, std::vector<std::string> msg_filter) = 0;
 };
 
 struct MaaContext : public IMaaPipeline
@@ -174,6 +187,7 @@ public:
         const json::value& action_param,
         const cv::Rect& box,
         const std::string& reco_detail) = 0;
+    virtual MaaRecoId run_recognition_on_frame(MaaFrameId frame_id, const std::string& reco_type, const json::value& reco_param) = 0;
 
     virtual MaaContext* clone() const = 0;
 
@@ -199,6 +213,7 @@ public:
     virtual void register_controller_sink(MaaController* ctrl) = 0;
     virtual void register_tasker_sink(MaaTasker* tasker) = 0;
     virtual std::string create_socket(const std::string& identifier) = 0;
+    virtual bool set_transport_options(const std::string& options_json) = 0;
     virtual std::string create_tcp_socket(uint16_t port) = 0;
     virtual bool connect() = 0;
     virtual bool disconnect() = 0;
@@ -207,4 +222,5 @@ public:
     virtual void set_timeout(const std::chrono::milliseconds& timeout) = 0;
     virtual std::vector<std::string> get_custom_recognition_list() const = 0;
     virtual std::vector<std::string> get_custom_action_list() const = 0;
+    virtual std::optional<json::object> probe_latency(size_t count) = 0;
 };
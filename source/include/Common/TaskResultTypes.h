@@ -1,5 +1,6 @@
 #pragma once
 
+#include <future>
 #include <optional>
 
 #include "MaaFramework/MaaDef.h"
@@ -12,6 +13,37 @@ MAA_TASK_NS_BEGIN
 
 using ImageEncodedBuffer = std::vector<uint8_t>;
 
+// 编码后的图像，可能仍在后台编码中。拷贝只增加引用，同一帧的多个结果共享同一份数据
+class EncodedImage
+{
+public:
+    EncodedImage() = default;
+
+    EncodedImage(ImageEncodedBuffer buffer)
+    {
+        std::promise<ImageEncodedBuffer> promise;
+        promise.set_value(std::move(buffer));
+        future_ = promise.get_future().share();
+    }
+
+    explicit EncodedImage(std::shared_future<ImageEncodedBuffer> future)
+        : future_(std::move(future))
+    {
+    }
+
+    // 会等待编码完成
+    const ImageEncodedBuffer& get() const
+    {
+        static const ImageEncodedBuffer kEmpty;
+        return future_.valid() ? future_.get() : kEmpty;
+    }
+
+    bool empty() const { return get().empty(); }
+
+private:
+    std::shared_future<ImageEncodedBuffer> future_;
+};
+
 struct RecoResult
 {
     MaaRecoId reco_id = MaaInvalidId;
@@ -19,8 +51,8 @@ struct RecoResult
     std::string algorithm;
     std::optional<cv::Rect> box = std::nullopt;
     json::value detail;
-    ImageEncodedBuffer raw;
-    std::vector<ImageEncodedBuffer> draws;
+    EncodedImage raw;
+    std::vector<EncodedImage> draws;
 
     MEO_TOJSON(reco_id, name, algorithm, box, detail);
 };
@@ -14,15 +14,23 @@ MAA_AGENT_NS_BEGIN
 // ReverseRequest: server -> client
 
 using MessageTypePlaceholder = int;
-inline static constexpr int kProtocolVersion = 7;
+inline static constexpr int kProtocolVersion = 12;
+
+// 消息信封，由 Transceiver 统一附加：
+// 请求带 _id（发送方自增）；在处理对端请求期间发出的请求另带 _parent（该对端请求的 _id）；
+// 回复带 _reply_to（所回复请求的 _id）。_parent 与 _reply_to 均指向接收方自己分配的 id
+inline static constexpr const char* kMsgIdKey = "_id";
+inline static constexpr const char* kMsgParentKey = "_parent";
+inline static constexpr const char* kMsgReplyToKey = "_reply_to";
 
 struct StartUpRequest
 {
     std::string version = MAA_VERSION;
     int protocol = kProtocolVersion;
+    std::vector<std::string> wire_formats; // 客户端支持的二进制编码，如 kBinaryWireFormatName
 
     MessageTypePlaceholder _StartUpRequest = 1;
-    MEO_JSONIZATION(version, protocol, _StartUpRequest);
+    MEO_JSONIZATION(version, protocol, MEO_OPT wire_formats, _StartUpRequest);
 };
 
 struct StartUpResponse
@@ -31,9 +39,20 @@ struct StartUpResponse
     int protocol = kProtocolVersion;
     std::vector<std::string> actions;
     std::vector<std::string> recognitions;
+    std::vector<std::string> batch_recognitions; // 同时提供了批量回调的识别
+    std::string wire_format;                     // 服务端选定的编码，空表示继续使用 json
+    std::vector<std::string> event_filter;       // agent 订阅的事件，规则同 sink 订阅，空表示全部
 
     MessageTypePlaceholder _StartUpResponse = 1;
-    MEO_JSONIZATION(version, protocol, actions, recognitions, _StartUpResponse);
+    MEO_JSONIZATION(
+        version,
+        protocol,
+        actions,
+        recognitions,
+        MEO_OPT batch_recognitions,
+        MEO_OPT wire_format,
+        MEO_OPT event_filter,
+        _StartUpResponse);
 };
 
 struct ShutDownRequest
@@ -48,6 +67,19 @@ struct ShutDownResponse
     MEO_JSONIZATION(_ShutDownResponse);
 };
 
+// 测量通道往返延迟，对端在消息线程上立即回复
+struct PingRequest
+{
+    MessageTypePlaceholder _PingRequest = 1;
+    MEO_JSONIZATION(_PingRequest);
+};
+
+struct PingResponse
+{
+    MessageTypePlaceholder _PingResponse = 1;
+    MEO_JSONIZATION(_PingResponse);
+};
+
 struct CustomRecognitionRequest
 {
     std::string context_id;
@@ -80,6 +112,27 @@ struct CustomRecognitionResponse
     MEO_JSONIZATION(ret, out_box, out_detail, _CustomRecognitionResponse);
 };
 
+struct CustomRecognitionBatchRequest
+{
+    std::string context_id;
+    int64_t task_id = 0;
+    std::string custom_recognition_name;
+    std::string entries; // 格式同 MaaCustomRecognitionBatchCallback 的 entries_json
+    std::string image;
+
+    MessageTypePlaceholder _CustomRecognitionBatchRequest = 1;
+    MEO_JSONIZATION(context_id, task_id, custom_recognition_name, entries, image, _CustomRecognitionBatchRequest);
+};
+
+struct CustomRecognitionBatchResponse
+{
+    bool ret = false;
+    std::string results;
+
+    MessageTypePlaceholder _CustomRecognitionBatchResponse = 1;
+    MEO_JSONIZATION(ret, results, _CustomRecognitionBatchResponse);
+};
+
 struct CustomActionRequest
 {
     std::string context_id;
@@ -102,68 +155,38 @@ struct CustomActionResponse
     MEO_JSONIZATION(ret, _CustomActionResponse);
 };
 
-struct ResourceEventRequest
-{
-    std::string resource_id;
-    std::string message;
-    json::value details;
-
-    MessageTypePlaceholder _ResourceEventRequest = 1;
-    MEO_JSONIZATION(resource_id, message, details, _ResourceEventRequest);
-};
-
-struct ResourceEventResponse
+enum class EventCategory
 {
-    MessageTypePlaceholder _ResourceEventResponse = 1;
-    MEO_JSONIZATION(_ResourceEventResponse);
+    Resource,
+    Controller,
+    Tasker,
+    Context,
 };
 
-struct ControllerEventRequest
+struct ForwardedEvent
 {
-    std::string controller_id;
+    EventCategory category = EventCategory::Resource;
+    std::string handle_id;
     std::string message;
-    json::value details;
-
-    MessageTypePlaceholder _ControllerEventRequest = 1;
-    MEO_JSONIZATION(controller_id, message, details, _ControllerEventRequest);
-};
-
-struct ControllerEventResponse
-{
-    MessageTypePlaceholder _ControllerEventResponse = 1;
-    MEO_JSONIZATION(_ControllerEventResponse);
-};
-
-struct TaskerEventRequest
-{
-    std::string tasker_id;
-    std::string message;
-    json::value details;
-
-    MessageTypePlaceholder _TaskerEventRequest = 1;
-    MEO_JSONIZATION(tasker_id, message, details, _TaskerEventRequest);
-};
+    std::string details; // 框架给出的 json 文本，原样转交对端 sink，两端都不解析
 
-struct TaskerEventResponse
-{
-    MessageTypePlaceholder _TaskerEventResponse = 1;
-    MEO_JSONIZATION(_TaskerEventResponse);
+    MEO_JSONIZATION(category, handle_id, message, details);
 };
 
-struct ContextEventRequest
+// 客户端把积压的事件合并成一批发送，上一批确认前新事件只入队
+struct EventBatchRequest
 {
-    std::string context_id;
-    std::string message;
-    json::value details;
+    std::vector<ForwardedEvent> events;
+    uint64_t dropped = 0; // 自上一批以来因积压而丢弃的事件数
 
-    MessageTypePlaceholder _ContextEventRequest = 1;
-    MEO_JSONIZATION(context_id, message, details, _ContextEventRequest);
+    MessageTypePlaceholder _EventBatchRequest = 1;
+    MEO_JSONIZATION(events, dropped, _EventBatchRequest);
 };
 
-struct ContextEventResponse
+struct EventBatchResponse
 {
-    MessageTypePlaceholder _ContextEventResponse = 1;
-    MEO_JSONIZATION(_ContextEventResponse);
+    MessageTypePlaceholder _EventBatchResponse = 1;
+    MEO_JSONIZATION(_EventBatchResponse);
 };
 
 struct ContextRunTaskReverseRequest
@@ -262,6 +285,25 @@ struct ContextRunActionDirectReverseResponse
     MEO_JSONIZATION(action_id, _ContextRunActionDirectReverseResponse);
 };
 
+struct ContextRunRecognitionOnFrameReverseRequest
+{
+    std::string context_id;
+    int64_t frame_id = 0;
+    std::string reco_type;
+    json::value reco_param;
+
+    MessageTypePlaceholder _ContextRunRecognitionOnFrameReverseRequest = 1;
+    MEO_JSONIZATION(context_id, frame_id, reco_type, reco_param, _ContextRunRecognitionOnFrameReverseRequest);
+};
+
+struct ContextRunRecognitionOnFrameReverseResponse
+{
+    int64_t reco_id = 0;
+
+    MessageTypePlaceholder _ContextRunRecognitionOnFrameReverseResponse = 1;
+    MEO_JSONIZATION(reco_id, _ContextRunRecognitionOnFrameReverseResponse);
+};
+
 struct ContextOverridePipelineReverseRequest
 {
     std::string context_id;
@@ -539,6 +581,59 @@ struct TaskerPostActionReverseResponse
     MEO_JSONIZATION(task_id, _TaskerPostActionReverseResponse);
 };
 
+struct TaskerRegisterFrameReverseRequest
+{
+    std::string tasker_id;
+    std::string image;
+
+    MessageTypePlaceholder _TaskerRegisterFrameReverseRequest = 1;
+    MEO_JSONIZATION(tasker_id, image, _TaskerRegisterFrameReverseRequest);
+};
+
+struct TaskerRegisterFrameReverseResponse
+{
+    int64_t frame_id = 0;
+
+    MessageTypePlaceholder _TaskerRegisterFrameReverseResponse = 1;
+    MEO_JSONIZATION(frame_id, _TaskerRegisterFrameReverseResponse);
+};
+
+struct TaskerUnregisterFrameReverseRequest
+{
+    std::string tasker_id;
+    int64_t frame_id = 0;
+
+    MessageTypePlaceholder _TaskerUnregisterFrameReverseRequest = 1;
+    MEO_JSONIZATION(tasker_id, frame_id, _TaskerUnregisterFrameReverseRequest);
+};
+
+struct TaskerUnregisterFrameReverseResponse
+{
+    bool ret = false;
+
+    MessageTypePlaceholder _TaskerUnregisterFrameReverseResponse = 1;
+    MEO_JSONIZATION(ret, _TaskerUnregisterFrameReverseResponse);
+};
+
+struct TaskerPostRecognitionOnFrameReverseRequest
+{
+    std::string tasker_id;
+    int64_t frame_id = 0;
+    std::string reco_type;
+    json::value reco_param;
+
+    MessageTypePlaceholder _TaskerPostRecognitionOnFrameReverseRequest = 1;
+    MEO_JSONIZATION(tasker_id, frame_id, reco_type, reco_param, _TaskerPostRecognitionOnFrameReverseRequest);
+};
+
+struct TaskerPostRecognitionOnFrameReverseResponse
+{
+    int64_t task_id = 0;
+
+    MessageTypePlaceholder _TaskerPostRecognitionOnFrameReverseResponse = 1;
+    MEO_JSONIZATION(task_id, _TaskerPostRecognitionOnFrameReverseResponse);
+};
+
 struct TaskerStatusReverseRequest
 {
     std::string tasker_id;
@@ -818,6 +913,36 @@ struct TaskerGetLatestNodeReverseResponse
     MEO_JSONIZATION(has_value, latest_id, _TaskerGetLatestNodeReverseResponse);
 };
 
+struct TaskerGetLatencyStatsReverseRequest
+{
+    std::string tasker_id;
+
+    MessageTypePlaceholder _TaskerGetLatencyStatsReverseRequest = 1;
+    MEO_JSONIZATION(tasker_id, _TaskerGetLatencyStatsReverseRequest);
+};
+
+struct TaskerGetLatencyStatsReverseResponse
+{
+    json::value stats;
+
+    MessageTypePlaceholder _TaskerGetLatencyStatsReverseResponse = 1;
+    MEO_JSONIZATION(stats, _TaskerGetLatencyStatsReverseResponse);
+};
+
+struct TaskerClearLatencyStatsReverseRequest
+{
+    std::string tasker_id;
+
+    MessageTypePlaceholder _TaskerClearLatencyStatsReverseRequest = 1;
+    MEO_JSONIZATION(tasker_id, _TaskerClearLatencyStatsReverseRequest);
+};
+
+struct TaskerClearLatencyStatsReverseResponse
+{
+    MessageTypePlaceholder _TaskerClearLatencyStatsReverseResponse = 1;
+    MEO_JSONIZATION(_TaskerClearLatencyStatsReverseResponse);
+};
+
 struct ResourcePostBundleReverseRequest
 {
     std::string resource_id;
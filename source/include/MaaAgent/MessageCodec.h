@@ -0,0 +1,34 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <meojson/json.hpp>
+
+#include "Common/Conf.h"
+
+MAA_AGENT_NS_BEGIN
+
+// agent 消息的线上编码。默认 Json；Binary 需在 StartUp 时协商，帧格式为
+// kBinaryMagic | kBinaryVersion | 类型名长度(u8) | 类型名 | MessagePack 正文
+// 类型名取自消息结构体的占位字段（去掉前导下划线），从正文移到帧头。zmq 帧自带长度，不再另写
+enum class WireFormat
+{
+    Json,
+    Binary,
+};
+
+inline static constexpr const char* kBinaryWireFormatName = "msgpack/1";
+// MessagePack 中保留不用的字节，不会出现在 json 文本开头
+inline static constexpr uint8_t kBinaryMagic = 0xC1;
+inline static constexpr uint8_t kBinaryVersion = 1;
+
+std::string encode_message(const json::value& j, WireFormat format);
+// 按首字节自动识别两种编码
+std::optional<json::value> decode_message(std::string_view data);
+
+// 消息类型名，如 "StartUpRequest"；不是 agent 消息时返回空
+std::string_view message_type(const json::value& j);
+
+MAA_AGENT_NS_END
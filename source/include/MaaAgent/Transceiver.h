@@ -1,7 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <thread>
 
 #include <meojson/json.hpp>
 #include <zmq.hpp>
@@ -9,15 +15,23 @@
 #include "Common/MaaTypes.h"
 #include "MaaUtils/Logger.h"
 #include "Message.hpp"
+#include "MessageCodec.h"
+#include "TransportOptions.h"
 
 #include "Common/Conf.h"
 
 MAA_AGENT_NS_BEGIN
 
+// 每条请求带 id，由独立的 io 线程收发并按 id 分发回复，多个线程可以同时经由同一个 socket 请求对端。
+// 对端在处理某个请求期间发来的请求（_parent 指向该请求）交给正在等待这个请求的线程处理，保持原有的可重入语义
 class Transceiver
 {
     using ImageEncodedBuffer = std::vector<uint8_t>;
 
+public:
+    // 同时在途的顶层请求上限；处理对端请求期间发出的嵌套请求不占名额，避免互相等待
+    inline static constexpr size_t kMaxInFlight = 32;
+
 public:
     virtual ~Transceiver();
 
@@ -25,41 +39,15 @@ public:
     template <typename ResponseT, typename RequestT>
     std::optional<ResponseT> send_and_recv(const RequestT& req)
     {
-        auto req_id = ++s_req_id_;
-
-        // LogFunc << VAR(req_id);
-        bool sent = send(req);
-        if (!sent) {
-            LogError << "failed to send req" << VAR(req_id);
+        auto msg_opt = request(json::value(req));
+        if (!msg_opt) {
             return std::nullopt;
         }
-
-        for (int64_t loop_count = 0;; ++loop_count) {
-            // LogTrace << "enter loop" << VAR(req_id) << VAR(loop_count);
-
-            auto msg_opt = recv();
-            if (!msg_opt) {
-                LogError << "failed to recv resp" << VAR(req_id) << VAR(loop_count);
-                return std::nullopt;
-            }
-            const json::value& msg = *msg_opt;
-            if (msg.is<ResponseT>()) {
-                // LogTrace << "response" << VAR(req_id) << VAR(loop_count);
-                return msg.as<ResponseT>();
-            }
-            else if (msg.is<ImageHeader>()) {
-                handle_image(msg.as<ImageHeader>());
-            }
-            else if (msg.is<ImageEncodedHeader>()) {
-                handle_image_encoded(msg.as<ImageEncodedHeader>());
-            }
-            else {
-                // LogTrace << "inserted request" << VAR(req_id) << VAR(loop_count);
-                handle_inserted_request(msg);
-            }
+        if (!msg_opt->is<ResponseT>()) {
+            LogError << "unexpected response" << VAR(*msg_opt) << VAR(ipc_addr_);
+            return std::nullopt;
         }
-        // unreachable code
-        // return std::nullopt;
+        return msg_opt->as<ResponseT>();
     }
 
     std::string send_image(const cv::Mat& mat);
@@ -69,22 +57,54 @@ public:
 
 protected:
     virtual bool handle_inserted_request(const json::value& j) = 0;
-    bool handle_image_header(const json::value& j);
-    bool handle_image_encoded_header(const json::value& j);
 
     void init_socket(const std::string& identifier, bool bind);
     void uninit_socket();
 
+    // 回复当前线程正在处理的对端请求
     bool send(const json::value& j);
-    std::optional<json::value> recv();
+    // 回复指定的对端请求，用于没有经 dispatch_request 处理就放弃的请求
+    bool reply(const json::value& request, const json::value& j);
+    // 单向请求，不等待回复；对端处理它期间发来的请求没有线程在等，按顶层请求处理
+    bool post(const json::value& j);
+
+    // 等待对端的顶层请求，仅 connect 的一端（AgentServer）使用；io 线程停止后返回 nullopt
+    std::optional<json::value> recv_request();
+    // 处理对端请求，期间 send 的内容作为它的回复
+    bool dispatch_request(const json::value& j);
+    // 当前线程正在处理的对端请求 id，没有则为 0；此时发出的请求作为它的嵌套请求
+    int64_t current_inbound_id() const;
 
     bool alive();
     void set_timeout(const std::chrono::milliseconds& timeout);
+    // 之后发出的消息使用的编码，接收端总是按帧自动识别
+    void set_wire_format(WireFormat format);
+
+    void stop_io();
+
+    // 在创建 socket 前设置
+    void set_transport_options(TransportOptions options);
 
 private:
-    void handle_image(const ImageHeader& header);
-    void handle_image_encoded(const ImageEncodedHeader& header);
-    bool poll(zmq::pollitem_t& pollitem);
+    struct PendingRequest
+    {
+        std::condition_variable cv;
+        std::deque<json::value> inserted; // 对端在处理本请求期间发来的请求
+        std::optional<json::value> response;
+        bool failed = false;
+    };
+
+    std::optional<json::value> request(json::value j);
+    zmq::message_t make_message(const json::value& j) const;
+    bool enqueue(std::vector<zmq::message_t> frames);
+
+    void apply_transport_options();
+    void start_io();
+    void io_loop();
+    void flush_outgoing(std::deque<zmq::message_t>& outgoing);
+    void route(zmq::message_t& msg);
+    void store_image(const json::value& header_json, const zmq::message_t& msg);
+    void fail_all_pending();
 
 protected:
     // 返回实际绑定的端口号，如果传入 0 则自动选择可用端口
@@ -105,17 +125,34 @@ protected:
     bool is_tcp_ = false;
     uint16_t tcp_port_ = 0;
 
-    std::map<std::string /* uuid */, cv::Mat> recved_images_;
-    std::map<std::string /* uuid */, ImageEncodedBuffer> recved_images_encoded_;
-
 private:
-    inline static int64_t s_req_id_ = 0;
+    inline static std::atomic<int64_t> s_req_id_ = 0;
     bool is_bound_ = false;
 
-    std::mutex socket_mutex_;
-    zmq::pollitem_t zmq_pollitem_send_ { };
-    zmq::pollitem_t zmq_pollitem_recv_ { };
     std::chrono::milliseconds timeout_ = std::chrono::milliseconds::max();
+    TransportOptions transport_options_;
+    std::atomic<WireFormat> wire_format_ = WireFormat::Json;
+
+    // 仅 io 线程读写 zmq_sock_，其他线程经 outbox_ 投递，再通过 inproc socket 唤醒 io 线程
+    std::thread io_thread_;
+    std::atomic_bool io_running_ = false;
+    std::atomic_bool writable_ = false;
+    zmq::socket_t wake_recv_;
+    zmq::socket_t wake_send_;
+    std::mutex out_mutex_;
+    std::deque<zmq::message_t> outbox_;
+    std::optional<json::value> image_header_; // io 线程专用，等待中的图片数据帧所属的头
+
+    std::mutex pending_mutex_;
+    std::map<int64_t, std::shared_ptr<PendingRequest>> pending_;
+    std::condition_variable in_flight_cv_;
+    size_t in_flight_ = 0;
+    std::condition_variable requests_cv_;
+    std::deque<json::value> requests_;
+
+    std::mutex images_mutex_;
+    std::map<std::string /* uuid */, cv::Mat> recved_images_;
+    std::map<std::string /* uuid */, ImageEncodedBuffer> recved_images_encoded_;
 };
 
 MAA_AGENT_NS_END
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <optional>
+#include <string_view>
+
+#include <meojson/json.hpp>
+
+#include "Common/Conf.h"
+
+MAA_AGENT_NS_BEGIN
+
+// 底层 zmq socket 的调优参数，创建 socket 时于 bind/connect 前生效。-1 表示沿用 zmq 或系统的默认值
+// zmq 建立 tcp 连接时总会设置 TCP_NODELAY，不需要另外关闭 Nagle
+struct TransportOptions
+{
+    int send_hwm = -1; // 发送/接收队列上限（消息数），zmq 默认 1000
+    int recv_hwm = -1;
+
+    int tcp_keepalive = -1;          // 1 开启，0 关闭，仅 tcp
+    int tcp_keepalive_idle = -1;     // 秒
+    int tcp_keepalive_interval = -1; // 秒
+    int tcp_keepalive_count = -1;
+
+    int reconnect_interval = -1;     // 毫秒，仅 connect 的一端（AgentServer）
+    int reconnect_interval_max = -1; // 毫秒，大于 reconnect_interval 时重连间隔按指数退避增长到该值
+
+    int heartbeat_interval = -1; // 毫秒，ZMTP 心跳，超时未收到回应则断开重连
+    int heartbeat_timeout = -1;  // 毫秒
+    int heartbeat_ttl = -1;      // 毫秒，告知对端多久收不到任何数据即可断开
+
+    MEO_JSONIZATION(
+        MEO_OPT send_hwm,
+        MEO_OPT recv_hwm,
+        MEO_OPT tcp_keepalive,
+        MEO_OPT tcp_keepalive_idle,
+        MEO_OPT tcp_keepalive_interval,
+        MEO_OPT tcp_keepalive_count,
+        MEO_OPT reconnect_interval,
+        MEO_OPT reconnect_interval_max,
+        MEO_OPT heartbeat_interval,
+        MEO_OPT heartbeat_timeout,
+        MEO_OPT heartbeat_ttl);
+};
+
+// 空串视为全部默认值
+inline std::optional<TransportOptions> parse_transport_options(std::string_view str)
+{
+    if (str.empty()) {
+        return TransportOptions { };
+    }
+    auto json_opt = json::parse(str);
+    if (!json_opt || !json_opt->is<TransportOptions>()) {
+        return std::nullopt;
+    }
+    return json_opt->as<TransportOptions>();
+}
+
+MAA_AGENT_NS_END
@@ -1,5 +1,15 @@
 #pragma once
 
+#include <algorithm>
+#include <concepts>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "Common/MaaTypes.h"
 #include "MaaUtils/Dispatcher.hpp"
 #include "MaaUtils/Logger.h"
@@ -7,8 +17,25 @@
 
 MAA_NS_BEGIN
 
+// 空列表表示订阅全部消息；否则按完整消息名或以 '.' 分隔的前缀匹配，如 "Node.Recognition"
+inline bool match_msg_filter(const std::vector<std::string>& msg_filter, std::string_view msg)
+{
+    if (msg_filter.empty()) {
+        return true;
+    }
+    return std::ranges::any_of(msg_filter, [&](const std::string& f) {
+        return msg == f || (msg.size() > f.size() && msg.starts_with(f) && msg[f.size()] == '.');
+    });
+}
+
 struct EventSink
 {
+    EventSink(MaaEventCallback cb, void* arg)
+        : callback(cb)
+        , trans_arg(arg)
+    {
+    }
+
     void on_event(void* handle, std::string_view msg, std::string_view detail)
     {
         if (!callback) {
@@ -18,8 +45,23 @@ struct EventSink
         callback(handle, msg.data(), detail.data(), trans_arg);
     }
 
+    bool subscribed(std::string_view msg) const
+    {
+        std::shared_lock lock(filter_mutex);
+        return match_msg_filter(msg_filter, msg);
+    }
+
+    void set_subscription(std::vector<std::string> filter)
+    {
+        std::unique_lock lock(filter_mutex);
+        msg_filter = std::move(filter);
+    }
+
     MaaEventCallback callback = nullptr;
     void* trans_arg = nullptr;
+
+    mutable std::shared_mutex filter_mutex;
+    std::vector<std::string> msg_filter;
 };
 
 class EventDispatcher
@@ -40,7 +82,13 @@ public:
             LogWarn << "callback is null";
             return MaaInvalidId;
         }
-        return register_observer(std::make_shared<EventSink>(callback, trans_arg));
+
+        auto sink = std::make_shared<EventSink>(callback, trans_arg);
+        MaaSinkId sink_id = register_observer(sink);
+
+        std::unique_lock lock(sinks_mutex_);
+        sinks_.insert_or_assign(sink_id, std::move(sink));
+        return sink_id;
     }
 
     virtual void remove_sink(MaaSinkId sink_id) override
@@ -48,6 +96,9 @@ public:
         LogInfo << VAR(sink_id);
 
         unregister_observer(sink_id);
+
+        std::unique_lock lock(sinks_mutex_);
+        sinks_.erase(sink_id);
     }
 
     virtual void clear_sinks() override
@@ -55,9 +106,33 @@ public:
         LogInfo;
 
         clear_observer();
+
+        std::unique_lock lock(sinks_mutex_);
+        sinks_.clear();
     }
 
 public:
+    bool set_subscription(MaaSinkId sink_id, std::vector<std::string> msg_filter)
+    {
+        LogInfo << VAR(sink_id) << VAR(msg_filter);
+
+        std::shared_lock lock(sinks_mutex_);
+        auto it = sinks_.find(sink_id);
+        if (it == sinks_.end()) {
+            LogError << "sink not found" << VAR(sink_id);
+            return false;
+        }
+        it->second->set_subscription(std::move(msg_filter));
+        return true;
+    }
+
+    // 是否有任何 sink 关心该消息，调用方据此决定是否构造 details
+    bool subscribed(std::string_view msg) const
+    {
+        std::shared_lock lock(sinks_mutex_);
+        return std::ranges::any_of(sinks_, [&](const auto& pair) { return pair.second->subscribed(msg); });
+    }
+
     void notify(void* handle, std::string_view msg, const json::value& details)
     {
         if (log_) {
@@ -65,17 +140,55 @@ public:
             LogInfo << kLogFlag << VAR_VOIDP(handle) << VAR(msg) << VAR(details);
         }
 
+        if (!subscribed(msg)) {
+            return;
+        }
+
         const std::string str_detail = details.to_string();
         dispatch([&](const std::shared_ptr<EventSink>& sink) {
-            if (!sink) {
+            if (!sink || !sink->subscribed(msg)) {
                 return;
             }
             sink->on_event(handle, msg, str_detail);
         });
     }
 
+    // details 已经是 json 文本（如 agent 转发来的事件），直接交给 sink，不再解析
+    // msg 与 details_json 须以 '\0' 结尾
+    void notify_raw(void* handle, std::string_view msg, std::string_view details_json)
+    {
+        if (log_) {
+            static constexpr std::string_view kLogFlag = "!!!OnEventNotify!!!";
+            LogInfo << kLogFlag << VAR_VOIDP(handle) << VAR(msg) << VAR(details_json);
+        }
+
+        if (!subscribed(msg)) {
+            return;
+        }
+
+        dispatch([&](const std::shared_ptr<EventSink>& sink) {
+            if (!sink || !sink->subscribed(msg)) {
+                return;
+            }
+            sink->on_event(handle, msg, details_json);
+        });
+    }
+
+    // 仅在需要时才调用 make_details 构造 details
+    template <std::invocable DetailsBuilder>
+    void notify(void* handle, std::string_view msg, DetailsBuilder&& make_details, bool force = false)
+    {
+        if (!force && !subscribed(msg)) {
+            return;
+        }
+        notify(handle, msg, json::value(std::forward<DetailsBuilder>(make_details)()));
+    }
+
 private:
     bool log_ = false;
+
+    std::map<MaaSinkId, std::shared_ptr<EventSink>> sinks_;
+    mutable std::shared_mutex sinks_mutex_;
 };
 
 MAA_NS_END
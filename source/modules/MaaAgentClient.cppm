@@ -14,6 +14,7 @@ export using ::MaaAgentClient;
 
 export using ::MaaAgentClientCreateV2;
 export using ::MaaAgentClientCreateTcp;
+export using ::MaaAgentClientCreateTcpV2;
 export using ::MaaAgentClientDestroy;
 export using ::MaaAgentClientIdentifier;
 export using ::MaaAgentClientBindResource;
@@ -25,6 +26,7 @@ export using ::MaaAgentClientDisconnect;
 export using ::MaaAgentClientConnected;
 export using ::MaaAgentClientAlive;
 export using ::MaaAgentClientSetTimeout;
+export using ::MaaAgentClientProbeLatency;
 export using ::MaaAgentClientGetCustomRecognitionList;
 export using ::MaaAgentClientGetCustomActionList;
 
@@ -9,7 +9,11 @@ import maa.core;
 // MaaAgentServerAPI.h
 
 export using ::MaaAgentServerRegisterCustomRecognition;
+export using ::MaaAgentServerRegisterCustomRecognitionBatch;
 export using ::MaaAgentServerRegisterCustomAction;
+export using ::MaaAgentServerSetEventSubscription;
+export using ::MaaAgentServerSetConcurrency;
+export using ::MaaAgentServerSetTransportOptions;
 export using ::MaaAgentServerStartUp;
 export using ::MaaAgentServerShutDown;
 export using ::MaaAgentServerJoin;
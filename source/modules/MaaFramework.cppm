@@ -19,6 +19,7 @@ export using ::MaaActId;
 export using ::MaaNodeId;
 export using ::MaaWfId;
 export using ::MaaSinkId;
+export using ::MaaFrameId;
 export constexpr auto _MaaInvalidId = MaaInvalidId;
 
 export using ::MaaStringBuffer;
@@ -127,6 +128,7 @@ export using ::MaaRect;
 export using ::MaaNotificationCallback;
 export using ::MaaEventCallback;
 export using ::MaaCustomRecognitionCallback;
+export using ::MaaCustomRecognitionBatchCallback;
 export using ::MaaCustomActionCallback;
 
 // Instance/MaaContext.h
@@ -135,6 +137,7 @@ export using ::MaaContextRunTask;
 export using ::MaaContextRunRecognition;
 export using ::MaaContextRunAction;
 export using ::MaaContextRunRecognitionDirect;
+export using ::MaaContextRunRecognitionOnFrame;
 export using ::MaaContextRunActionDirect;
 export using ::MaaContextOverridePipeline;
 export using ::MaaContextOverrideNext;
@@ -204,10 +207,12 @@ export using ::MaaCustomControllerCallbacks;
 
 export using ::MaaResourceCreate;
 export using ::MaaResourceDestroy;
+export using ::MaaResourceCompileBundle;
 export using ::MaaResourceAddSink;
 export using ::MaaResourceRemoveSink;
 export using ::MaaResourceClearSinks;
 export using ::MaaResourceRegisterCustomRecognition;
+export using ::MaaResourceRegisterCustomRecognitionBatch;
 export using ::MaaResourceUnregisterCustomRecognition;
 export using ::MaaResourceClearCustomRecognition;
 export using ::MaaResourceRegisterCustomAction;
@@ -230,6 +235,7 @@ export using ::MaaResourceGetHash;
 export using ::MaaResourceGetNodeList;
 export using ::MaaResourceGetCustomRecognitionList;
 export using ::MaaResourceGetCustomActionList;
+export using ::MaaResourceGetTemplateCacheStats;
 export using ::MaaResourceGetDefaultRecognitionParam;
 export using ::MaaResourceGetDefaultActionParam;
 
@@ -243,6 +249,8 @@ export using ::MaaTaskerClearSinks;
 export using ::MaaTaskerAddContextSink;
 export using ::MaaTaskerRemoveContextSink;
 export using ::MaaTaskerClearContextSinks;
+export using ::MaaTaskerSetSinkSubscription;
+export using ::MaaTaskerSetContextSinkSubscription;
 export using ::MaaTaskerSetOption;
 export using ::MaaTaskerBindResource;
 export using ::MaaTaskerBindController;
@@ -250,6 +258,9 @@ export using ::MaaTaskerInited;
 export using ::MaaTaskerPostTask;
 export using ::MaaTaskerPostRecognition;
 export using ::MaaTaskerPostAction;
+export using ::MaaTaskerRegisterFrame;
+export using ::MaaTaskerUnregisterFrame;
+export using ::MaaTaskerPostRecognitionOnFrame;
 export using ::MaaTaskerStatus;
 export using ::MaaTaskerWait;
 export using ::MaaTaskerRunning;
@@ -265,6 +276,8 @@ export using ::MaaTaskerGetWaitFreezesDetail;
 export using ::MaaTaskerGetNodeDetail;
 export using ::MaaTaskerGetTaskDetail;
 export using ::MaaTaskerGetLatestNode;
+export using ::MaaTaskerGetLatencyStats;
+export using ::MaaTaskerClearLatencyStats;
 
 // Utility/MaaBuffer.h
 
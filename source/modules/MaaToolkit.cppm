@@ -22,6 +22,7 @@ export using ::MaaToolkitAdbDeviceListCreate;
 export using ::MaaToolkitAdbDeviceListDestroy;
 export using ::MaaToolkitAdbDeviceFind;
 export using ::MaaToolkitAdbDeviceFindSpecified;
+export using ::MaaToolkitAdbDeviceWatch;
 export using ::MaaToolkitAdbDeviceListSize;
 export using ::MaaToolkitAdbDeviceListAt;
 export using ::MaaToolkitAdbDeviceGetName;
@@ -58,6 +58,8 @@ def main():
         exit(1)
 
     socket_id = sys.argv[-1]
+    AgentServer.set_event_subscription(["Resource", "Controller", "Tasker", "Node"])
+    AgentServer.set_concurrency(2)
     AgentServer.start_up(socket_id)
     AgentServer.join()
     AgentServer.shut_down()
@@ -65,6 +67,7 @@ def main():
 
 @AgentServer.custom_recognition("MyRec")
 class MyRecognition(CustomRecognition):
+    image_view = True
 
     def analyze(
         self,
@@ -144,6 +144,13 @@ def run_tcp_flow(agent: AgentClient, socket_id: str, *, scenario: str):
         exit(1)
     print(f"agent.alive: {agent.alive}")
 
+    # 测试 probe_latency
+    latency = agent.probe_latency(10)
+    print(f"agent.probe_latency: {latency}")
+    if not latency or latency["count"] != 10 or latency["p50_us"] > latency["p99_us"]:
+        print("unexpected latency stats")
+        exit(1)
+
     # ============================================================
     # 测试 custom_recognition_list 和 custom_action_list
     # ============================================================
@@ -251,6 +258,15 @@ def api_test():
     agent = AgentClient.create_tcp(0)
     run_tcp_flow(agent, agent.identifier, scenario="create_tcp flow")
 
+    # ============================================================
+    # AgentClient TCP API 测试: 带 transport_options 的 create_tcp
+    # ============================================================
+    agent = AgentClient.create_tcp(
+        0,
+        transport_options={"tcp_keepalive": 1, "send_hwm": 100, "heartbeat_interval": 1000, "heartbeat_timeout": 3000},
+    )
+    run_tcp_flow(agent, agent.identifier, scenario="create_tcp with transport options flow")
+
     # ============================================================
     # AgentClient TCP API 测试: 纯数字 identifier 自动走 TCP
     # ============================================================
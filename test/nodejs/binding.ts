@@ -113,6 +113,9 @@ async function api_test() {
     tasker.add_sink(msg => {
         console.log(msg)
     })
+    const batched_sink = tasker.add_batched_sink(events => {
+        console.log('batched tasker events', events.length)
+    }, 16, 10)
     console.log('tasker', tasker)
     tasker.resource = resource
     tasker.controller = dbg_controller
@@ -142,8 +145,11 @@ async function api_test() {
         process.exit(1)
     }
     console.log('pipeline detail:', detail)
+    console.log('batched sink stats:', tasker.get_sink_stats(batched_sink))
 
     tasker.resource?.post_bundle('/path/to/resource')
+    console.log('latency stats:', tasker.latency_stats())
+    tasker.clear_latency_stats()
     tasker.clear_cache()
     const inited = tasker.inited
     const running = tasker.running
@@ -15,6 +15,7 @@ Python binding API 测试
 import os
 from pathlib import Path
 import sys
+import time
 import numpy
 import io
 
@@ -46,10 +47,10 @@ from maa.toolkit import Toolkit
 from maa.custom_action import CustomAction
 from maa.custom_recognition import CustomRecognition
 from maa.buffer import ImageBuffer
-from maa.define import LoggingLevelEnum, MaaWin32InputMethodEnum
+from maa.define import LoggingLevelEnum, MaaWin32InputMethodEnum, MaaControllerFeatureEnum
 from maa.context import Context, ContextEventSink
 from maa.event_sink import EventSink
-from maa.pipeline import JRecognitionType, JActionType, JOCR, JClick
+from maa.pipeline import JRecognitionType, JActionType, JOCR, JClick, JDirectHit
 
 analyzed: bool = False
 runned: bool = False
@@ -125,6 +126,16 @@ class MyRecognition(CustomRecognition):
         )
         print(f"  reco_direct_detail: {reco_direct_detail}")
 
+        # 测试 run_recognition_on_frame
+        frame_id = context.tasker.register_frame(argv.image)
+        assert frame_id, "register_frame should return a frame id"
+        reco_frame_detail = context.run_recognition_on_frame(
+            frame_id, JRecognitionType.DirectHit, JDirectHit()
+        )
+        print(f"  reco_frame_detail: {reco_frame_detail}")
+        assert reco_frame_detail and reco_frame_detail.hit
+        assert context.tasker.unregister_frame(frame_id)
+
         # 测试 run_action_direct
         action_direct_detail = context.run_action_direct(
             JActionType.Click, JClick(), (100, 100, 50, 50), ""
@@ -196,6 +207,31 @@ class MyRecognition(CustomRecognition):
         )
 
 
+class MyBatchRecognition(CustomRecognition):
+    batch_entries: list = []
+    batch_calls: int = 0
+
+    def analyze(
+        self,
+        context: Context,
+        argv: CustomRecognition.AnalyzeArg,
+    ) -> None:
+        return None
+
+    def analyze_batch(
+        self,
+        context: Context,
+        task_detail,
+        custom_recognition_name: str,
+        image: numpy.ndarray,
+        entries: list,
+    ) -> list:
+        print(f"on MyBatchRecognition.analyze_batch, entries: {entries}")
+        self.batch_calls += 1
+        self.batch_entries = [entry.node_name for entry in entries]
+        return [None if i == 0 else (1, 2, 3, 4) for i in range(len(entries))]
+
+
 class MyAction(CustomAction):
     def run(
         self,
@@ -265,7 +301,8 @@ def test_resource_api():
     sink_id = resource.add_sink(sink)
     print(f"  sink_id: {sink_id}")
 
-    # 加载有效资源
+    # 加载有效资源，同时预解码模板
+    assert resource.set_template_warm_up(True)
     resource.post_bundle(install_dir / "test" / "PipelineSmoking" / "resource").wait()
     print(f"  resource.loaded: {resource.loaded}")
 
@@ -291,6 +328,31 @@ def test_resource_api():
     node_list = resource.node_list
     print(f"  node_list count: {len(node_list)}")
 
+    # 测试模板缓存
+    assert resource.set_template_pinned_nodes(node_list[:1])
+    assert resource.set_template_cache_budget(64 * 1024 * 1024)
+    cache_stats = resource.template_cache_stats
+    print(f"  template_cache_stats: {cache_stats}")
+    assert cache_stats["budget"] == 64 * 1024 * 1024
+
+    # 测试预编译资源包，加载结果应与源目录一致
+    compiled_path = install_dir / "test" / "PipelineSmoking" / "resource.maabundle"
+    assert Resource.compile_bundle(install_dir / "test" / "PipelineSmoking" / "resource", compiled_path)
+    compiled = Resource()
+    compiled.post_bundle(compiled_path).wait()
+    assert compiled.loaded, "compiled bundle should be loaded"
+    assert sorted(compiled.node_list) == sorted(node_list), "compiled bundle node_list mismatch"
+    for name in node_list:
+        assert compiled.get_node_data(name) == resource.get_node_data(name), f"compiled node mismatch: {name}"
+
+    # 叠加在已有资源上时重新解析；逐文件核对源目录
+    assert compiled.set_compiled_bundle_verify_sources(True)
+    compiled.post_bundle(compiled_path).wait()
+    assert compiled.loaded, "compiled bundle should be loaded again"
+    for name in node_list:
+        assert compiled.get_node_data(name) == resource.get_node_data(name), f"reloaded node mismatch: {name}"
+    os.remove(compiled_path)
+
     # 测试 unregister
     resource.unregister_custom_recognition("MyRec")
     resource.unregister_custom_action("MyAct")
@@ -358,6 +420,61 @@ def test_resource_api():
     return resource
 
 
+def test_template_cache_lru():
+    print("\n=== test_template_cache_lru ===")
+
+    # 17 张同样大小的模板分布在 16 个分片上，预算恰好容纳 16 张；淘汰应按全局 LRU，与所在分片无关
+    count = 17
+    size = 8
+    image_bytes = size * size * 3
+    bundle_dir = install_dir / "test" / "TemplateCacheLru"
+    image_dir = bundle_dir / "image"
+    image_dir.mkdir(parents=True, exist_ok=True)
+    names = [f"T{i}.ppm" for i in range(count)]
+    for i, name in enumerate(names):
+        (image_dir / name).write_bytes(f"P6\n{size} {size}\n255\n".encode() + bytes([i * 15]) * image_bytes)
+
+    resource = Resource()
+    resource.post_bundle(bundle_dir).wait()
+    assert resource.loaded, "template bundle should be loaded"
+    assert resource.set_template_cache_budget((count - 1) * image_bytes)
+
+    controller = DbgController(install_dir / "test" / "PipelineSmoking" / "Screenshot")
+    controller.post_connection().wait()
+    tasker = Tasker()
+    tasker.bind(resource, controller)
+    assert tasker.inited, "tasker should be inited"
+
+    def use(name: str):
+        # 只识别一次，不关心是否命中
+        tasker.post_task(
+            "Use",
+            {
+                "Use": {"next": ["Probe"], "timeout": 0, "rate_limit": 0, "pre_delay": 0, "post_delay": 0},
+                "Probe": {"recognition": "TemplateMatch", "template": name, "pre_delay": 0, "post_delay": 0},
+            },
+        ).wait()
+
+    for name in names[:-1]:
+        use(name)
+    use(names[0])
+    use(names[-1])
+
+    # 全局最久未用的是 T1，无论 T16 落在哪个分片
+    stats = resource.template_cache_stats
+    print(f"  template_cache_stats: {stats}")
+    assert stats["entries"] == count - 1 and stats["evictions"] == 1
+
+    misses = stats["misses"]
+    for name in [names[0]] + names[2:]:
+        use(name)
+    assert resource.template_cache_stats["misses"] == misses, "survivors should still be cached"
+    use(names[1])
+    assert resource.template_cache_stats["misses"] == misses + 1, "T1 should have been evicted first"
+
+    print("  PASS: template cache lru")
+
+
 # ============================================================================
 # Controller API 测试
 # ============================================================================
@@ -458,6 +575,17 @@ def test_buffer_api():
     assert resized.shape[1] == 50, "width should be 50"
     assert resized.shape[0] == 25, "height should keep aspect ratio"
 
+    # 只读视图与 roi 视图，不拷贝
+    src[10:20, 30:50] = (1, 2, 3)
+    assert buf.set(src), "set should succeed"
+    view = buf.view()
+    assert view.shape == src.shape, "view should cover the whole image"
+    assert not view.flags.writeable, "view should be read-only"
+    roi_view = buf.view((30, 10, 20, 10))
+    assert roi_view.shape == (10, 20, 3), "roi view should match the roi"
+    assert (roi_view == (1, 2, 3)).all(), "roi view should expose the roi pixels"
+    assert buf.view((190, 90, 50, 50)).shape == (10, 10, 3), "roi view should be clipped"
+
     print("  PASS: buffer API")
 
 
@@ -490,6 +618,10 @@ def test_tasker_api(resource: Resource, controller: DbgController):
     context_sink_id = tasker.add_context_sink(context_sink)
     print(f"  tasker_sink_id: {tasker_sink_id}, context_sink_id: {context_sink_id}")
 
+    # 测试订阅过滤
+    assert tasker.set_sink_subscription(tasker_sink_id, ["Tasker.Task"])
+    assert tasker.set_context_sink_subscription(context_sink_id, [])
+
     # 绑定资源和控制器
     tasker.bind(resource, controller)
     print(f"  inited: {tasker.inited}")
@@ -563,9 +695,53 @@ def test_tasker_api(resource: Resource, controller: DbgController):
     latest_node = tasker.get_latest_node("Rec")
     print(f"  latest_node: {latest_node.name if latest_node else None}")
 
+    # 测试 get_latency_stats / clear_latency_stats
+    latency_stats = tasker.get_latency_stats()
+    print(f"  latency_stats categories: {list(latency_stats.keys())}")
+    tasker.clear_latency_stats()
+
     # 测试 clear_cache
     tasker.clear_cache()
 
+    # 测试帧注册：同一帧上多次识别
+    frame = numpy.zeros((720, 1280, 3), dtype=numpy.uint8)
+    frame_id = tasker.register_frame(frame)
+    assert frame_id, "register_frame should return a frame id"
+    hit_detail = (
+        tasker.post_recognition_on_frame(frame_id, JRecognitionType.DirectHit, JDirectHit())
+        .wait()
+        .get()
+    )
+    assert hit_detail and hit_detail.nodes and hit_detail.nodes[0].recognition.hit
+    for _ in range(2):
+        tasker.post_recognition_on_frame(frame_id, JRecognitionType.OCR, JOCR()).wait()
+    assert tasker.unregister_frame(frame_id)
+    assert not tasker.unregister_frame(frame_id), "frame should already be unregistered"
+
+    # 测试批量自定义识别：同一 next 列表中两个节点只回调一次 analyze_batch
+    batch_reco = MyBatchRecognition()
+    resource.register_custom_recognition("MyBatchRec", batch_reco)
+    batch_detail = (
+        tasker.post_task(
+            "BatchEntry",
+            {
+                "BatchEntry": {"next": ["BatchA", "BatchB"]},
+                "BatchA": {"recognition": "Custom", "custom_recognition": "MyBatchRec"},
+                "BatchB": {"recognition": "Custom", "custom_recognition": "MyBatchRec"},
+            },
+        )
+        .wait()
+        .get()
+    )
+    print(f"  batch_calls: {batch_reco.batch_calls}, batch_entries: {batch_reco.batch_entries}")
+    assert batch_reco.batch_calls == 1, "analyze_batch should be called exactly once"
+    assert batch_reco.batch_entries == [
+        "BatchA",
+        "BatchB",
+    ], "analyze_batch should be called once for both nodes"
+    assert batch_detail and batch_detail.nodes[-1].name == "BatchB"
+    resource.unregister_custom_recognition("MyBatchRec")
+
     # 测试 override_pipeline (通过 job 对象)
     task_job = tasker.post_task("Entry", ppover)
     override_result = task_job.override_pipeline({"Entry": {"next": []}})
@@ -596,6 +772,7 @@ class MyController(CustomController):
     def __init__(self):
         super().__init__()
         self.count = 0
+        self.calls = []
 
     def connect(self) -> bool:
         print("  on MyController.connect")
@@ -613,6 +790,7 @@ class MyController(CustomController):
     def start_app(self, intent: str) -> bool:
         print(f"  on MyController.start_app: {intent}")
         self.count += 1
+        self.calls.append("start_app")
         return True
 
     def stop_app(self, intent: str) -> bool:
@@ -623,11 +801,13 @@ class MyController(CustomController):
     def screencap(self) -> numpy.ndarray:
         print("  on MyController.screencap")
         self.count += 1
+        self.calls.append("screencap")
         return numpy.zeros((1080, 1920, 3), dtype=numpy.uint8)
 
     def click(self, x: int, y: int) -> bool:
         print(f"  on MyController.click: {x}, {y}")
         self.count += 1
+        self.calls.append("click")
         return True
 
     def swipe(self, x1: int, y1: int, x2: int, y2: int, duration: int) -> bool:
@@ -682,6 +862,17 @@ class MyController(CustomController):
         }
 
 
+class MyConcurrentController(MyController):
+    """仅供测试：声明截图与输入可并发，点击故意放慢"""
+
+    def get_features(self) -> int:
+        return MaaControllerFeatureEnum.ConcurrentScreencapAndInput
+
+    def click(self, x: int, y: int) -> bool:
+        time.sleep(0.2)
+        return super().click(x, y)
+
+
 def test_custom_controller():
     print("\n=== test_custom_controller ===")
 
@@ -720,6 +911,22 @@ def test_custom_controller():
     ret &= controller.post_inactive().wait().succeeded
 
     print(f"  controller.count: {controller.count}, ret: {ret}")
+
+    # 未声明并发的控制器按投递顺序执行，不等待中间结果
+    controller.calls.clear()
+    jobs = [controller.post_start_app("custom_ccc"), controller.post_click(1, 1), controller.post_screencap()]
+    assert all(job.wait().succeeded for job in jobs)
+    assert controller.calls == ["start_app", "click", "screencap"], controller.calls
+
+    # 声明并发后截图仍要等之前投递的输入
+    concurrent = MyConcurrentController()
+    assert concurrent.post_connection().wait().succeeded
+    jobs = [concurrent.post_click(1, 1), concurrent.post_screencap()]
+    assert all(job.wait().succeeded for job in jobs)
+    assert concurrent.calls == ["click", "screencap"], concurrent.calls
+    jobs = [concurrent.post_screencap(), concurrent.post_click(2, 2)]
+    assert all(job.wait().succeeded for job in jobs), "concurrent screencap and input should succeed"
+
     print("  PASS: custom controller")
 
 
@@ -901,6 +1108,7 @@ if __name__ == "__main__":
     controller = test_controller_api()
     test_buffer_api()
     tasker = test_tasker_api(resource, controller)
+    test_template_cache_lru()
 
     # 验证自定义识别和动作被调用
     if not analyzed or not runned:
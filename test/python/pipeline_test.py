@@ -1146,6 +1146,7 @@ def test_wait_freezes(context: Context):
                     "target": [100, 100, 200, 200],
                     "threshold": 0.98,
                     "method": 3,
+                    "block_size": 16,
                     "rate_limit": 500,
                     "timeout": 10000,
                 }
@@ -1157,6 +1158,7 @@ def test_wait_freezes(context: Context):
     assert_eq(obj.pre_wait_freezes.time, 800, "pre_wait_freezes.time")
     assert_eq(obj.pre_wait_freezes.threshold, 0.98, "threshold")
     assert_eq(obj.pre_wait_freezes.method, 3, "method")
+    assert_eq(obj.pre_wait_freezes.block_size, 16, "block_size")
     assert_eq(obj.pre_wait_freezes.rate_limit, 500, "rate_limit")
     assert_eq(obj.pre_wait_freezes.timeout, 10000, "timeout")
 
@@ -0,0 +1,23 @@
+#include <iostream>
+
+#include "MaaFramework/MaaAPI.h"
+#include "MaaToolkit/MaaToolkitAPI.h"
+
+int main(int argc, char** argv)
+{
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <bundle_dir> <output_file>" << std::endl;
+        return 1;
+    }
+
+    std::string user_path = "./";
+    MaaToolkitConfigInitOption(user_path.c_str(), "{}");
+
+    if (!MaaResourceCompileBundle(argv[1], argv[2])) {
+        std::cerr << "Failed to compile " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::cout << "Compiled " << argv[1] << " -> " << argv[2] << std::endl;
+    return 0;
+}